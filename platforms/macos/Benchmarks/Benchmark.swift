@@ -0,0 +1,120 @@
+import Foundation
+import Testing
+@testable import PortKiller
+
+/**
+ * Benchmark.swift
+ * PortKillerBenchmarks
+ *
+ * Timing harness and per-platform budgets. Each benchmark is run a few times to warm
+ * up, then timed over a fixed number of iterations; its median is compared with the
+ * budget recorded in `Baselines/macos.json`.
+ *
+ * The target only runs when asked, since timings from a loaded machine or a parallel
+ * test run mean nothing:
+ *
+ *     PORTKILLER_BENCHMARKS=1 swift test -c release -Xswiftc -enable-testing --filter PortKillerBenchmarks
+ *
+ * `PORTKILLER_SOAK=1` adds the 50k-cycle memory soak, and `PORTKILLER_BENCHMARK_TOLERANCE`
+ * scales every budget (e.g. 2 on a slow machine).
+ *
+ * Budgets are absolute, so medians over them are only reported unless
+ * `PORTKILLER_BENCHMARK_ENFORCE=1` is set, on a machine like the one the baseline was
+ * taken on; a shared CI runner's speed varies too much to fail on them.
+ */
+enum Benchmark {
+
+    static let isEnabled = ProcessInfo.processInfo.environment["PORTKILLER_BENCHMARKS"] != nil
+    static let isSoakEnabled = ProcessInfo.processInfo.environment["PORTKILLER_SOAK"] != nil
+    static let isEnforced = ProcessInfo.processInfo.environment["PORTKILLER_BENCHMARK_ENFORCE"] != nil
+
+    /// Timed runs per benchmark unless given, after `warmupIterations` untimed ones
+    static let defaultIterations = 25
+    static let warmupIterations = 3
+
+    /// Times `body` and reports its median against the baseline budget for `name`;
+    /// when enforced, expects it to be within the budget.
+    ///
+    /// `body` returns what it computed, so the optimizer can't drop the work.
+    @discardableResult
+    static func run<T>(
+        _ name: String,
+        iterations: Int = defaultIterations,
+        sourceLocation: SourceLocation = #_sourceLocation,
+        _ body: () throws -> T
+    ) rethrows -> Duration {
+        for _ in 0..<warmupIterations {
+            blackHole(try body())
+        }
+
+        let clock = ContinuousClock()
+        var histogram = LatencyHistogram()
+        for _ in 0..<iterations {
+            let start = clock.now
+            blackHole(try body())
+            histogram.record(clock.now - start)
+        }
+
+        let median = histogram.quantile(0.5)
+        guard let budget = BenchmarkBaseline.current.budget(for: name) else {
+            Issue.record("No budget for benchmark \(name) in the baseline", sourceLocation: sourceLocation)
+            return median
+        }
+        let report = "\(name): median \(median), budget \(budget) (max \(histogram.maximum))"
+        if isEnforced {
+            #expect(median <= budget, "\(report)", sourceLocation: sourceLocation)
+        } else {
+            print(median <= budget ? "ok   \(report)" : "SLOW \(report)")
+        }
+        return median
+    }
+
+    @inline(never)
+    private static func blackHole<T>(_ value: T) {
+        withExtendedLifetime(value) {}
+    }
+}
+
+/// Budgets of one platform, decoded from `Baselines/<platform>.json`
+struct BenchmarkBaseline: Decodable {
+
+    /// Soak test parameters and the resident-memory growth it tolerates
+    struct Soak: Decodable {
+        let cycles: Int
+        /// Cycles run before the starting RSS is taken, so caches and pools are full
+        let warmupCycles: Int
+        let socketsPerCycle: Int
+        /// One `ProcessExecutor` spawn every this many cycles, like the lsof scan
+        let spawnInterval: Int
+        let maxResidentGrowthMegabytes: Double
+    }
+
+    /// Median budget per benchmark, in milliseconds, for an optimized build
+    let budgetsMilliseconds: [String: Double]
+    /// Budget scale for debug builds
+    let debugMultiplier: Double
+    let soak: Soak
+
+    static let current: BenchmarkBaseline = {
+        guard let url = Bundle.module.url(forResource: "macos", withExtension: "json", subdirectory: "Baselines"),
+              let data = try? Data(contentsOf: url),
+              let baseline = try? JSONDecoder().decode(BenchmarkBaseline.self, from: data) else {
+            fatalError("Benchmarks/Baselines/macos.json is missing or malformed")
+        }
+        return baseline
+    }()
+
+    func budget(for name: String) -> Duration? {
+        guard let milliseconds = budgetsMilliseconds[name] else { return nil }
+        return .microseconds(Int64(milliseconds * scale * 1_000))
+    }
+
+    private var scale: Double {
+        let tolerance = ProcessInfo.processInfo.environment["PORTKILLER_BENCHMARK_TOLERANCE"].flatMap(Double.init) ?? 1
+        #if DEBUG
+        return tolerance * debugMultiplier
+        #else
+        return tolerance
+        #endif
+    }
+}
@@ -0,0 +1,156 @@
+import Foundation
+@testable import PortKiller
+
+/**
+ * BenchmarkFixtures.swift
+ * PortKillerBenchmarks
+ *
+ * Deterministic synthetic inputs for the benchmarks and the soak test: lsof output
+ * of any socket count, the PortInfo a scan would build from it, and kubectl list
+ * responses. The same arguments always produce the same bytes, so timings compare
+ * across runs and machines.
+ */
+@MainActor
+enum BenchmarkFixtures {
+
+    /// Socket counts every size-dependent benchmark runs at
+    nonisolated static let socketCounts = [100, 1_000, 10_000]
+
+    /// Process names as lsof prints them, escapes included, covering every process type
+    static let lsofProcessNames = [
+        "node", "postgres", "nginx", "Code\\x20Helper\\x20(Plugin)", "redis-server",
+        "python3.12", "launchd", "rapportd", "java", "\\xe4\\xbc\\x81\\xe4\\xb8\\x9a",
+        "ControlCenter", "mongod", "vite", "httpd", "Docker\\x20Desktop", "cargo"
+    ]
+
+    // MARK: - lsof
+
+    /// `lsof -iTCP -sTCP:LISTEN -P -n +c 0` output with `count` listening sockets.
+    ///
+    /// Two sockets per process (IPv4 and IPv6, as most servers listen). `generation`
+    /// moves a tenth of the processes to new PIDs and ports, the way a dev machine
+    /// churns between refreshes; it cycles every four generations, so repeated scans
+    /// see a bounded set of listeners, just like a real machine.
+    static func lsofOutput(sockets count: Int, generation: Int = 0) -> Data {
+        var output = "COMMAND     PID  USER   FD   TYPE             DEVICE SIZE/OFF NODE NAME\n"
+        output.reserveCapacity(count * 100)
+
+        for index in 0..<count {
+            let process = index / 2
+            let churned = process % 10 == generation % 10
+            let variant = churned ? generation % 4 : 0
+            let pid = 1_000 + process + variant * 100_000
+            let port = 1_024 + index + variant * 15_000
+            let name = lsofProcessNames[process % lsofProcessNames.count]
+            let fd = 19 + index % 7
+            let address = index.isMultiple(of: 2) ? "127.0.0.1:\(port)" : "[::1]:\(port)"
+            let type = index.isMultiple(of: 2) ? "IPv4" : "IPv6"
+            output += "\(name) \(pid)  user \(fd)u  \(type) 0x3d8015e195af\(String(index, radix: 16)) 0t0  TCP \(address) (LISTEN)\n"
+        }
+        return Data(output.utf8)
+    }
+
+    /// Ports a scan builds from `output`, resolving metadata once per PID like the
+    /// scanner's cache does. `metadata` plays that cache across calls and is pruned to
+    /// the PIDs still present.
+    static func ports(from output: Data, metadata: inout [Int: ProcessMetadata]) -> [PortInfo] {
+        output.withUnsafeBytes { bytes in
+            let records = LsofOutputParser.records(in: bytes)
+            var ports: [PortInfo] = []
+            ports.reserveCapacity(records.count)
+            var present = Set<Int>(minimumCapacity: records.count)
+
+            for record in records {
+                present.insert(record.pid)
+                let resolved: ProcessMetadata
+                if let cached = metadata[record.pid] {
+                    resolved = cached
+                } else {
+                    let processName = LsofOutputParser.decodeEscapes(
+                        UnsafeRawBufferPointer(rebasing: bytes[record.command])
+                    )
+                    resolved = ProcessMetadata.resolve(
+                        processName: processName,
+                        command: "/usr/local/bin/\(processName) --port \(record.port)",
+                        user: LsofOutputParser.text(record.user, in: bytes),
+                        classifier: .builtIn
+                    )
+                    metadata[record.pid] = resolved
+                }
+                ports.append(PortInfo.active(
+                    port: record.port,
+                    pid: record.pid,
+                    address: LsofOutputParser.text(record.address, in: bytes),
+                    fd: LsofOutputParser.text(record.fd, in: bytes),
+                    metadata: resolved
+                ))
+            }
+
+            metadata = metadata.filter { present.contains($0.key) }
+            return ports.sorted { $0.port < $1.port }
+        }
+    }
+
+    /// Ports of a synthetic scan with `count` sockets
+    static func ports(sockets count: Int, generation: Int = 0) -> [PortInfo] {
+        var metadata: [Int: ProcessMetadata] = [:]
+        return ports(from: lsofOutput(sockets: count, generation: generation), metadata: &metadata)
+    }
+
+    // MARK: - kubectl
+
+    /// `kubectl get services -o json` response listing `count` services, with the
+    /// labels, annotations and status blocks of a real cluster that the decoder skips.
+    static func kubectlServiceList(count: Int) -> Data {
+        let items = (0..<count).map { index in
+            """
+            {
+                "apiVersion": "v1",
+                "kind": "Service",
+                "metadata": {
+                    "name": "service-\(index)",
+                    "namespace": "team-\(index % 12)",
+                    "uid": "5e4b9c2a-\(String(format: "%04x", index))-4d1e-9a7b-2f0c8e6d1a3b",
+                    "resourceVersion": "\(184_000 + index)",
+                    "labels": { "app": "service-\(index)", "tier": "\(["web", "api", "db"][index % 3])" },
+                    "annotations": { "kubectl.kubernetes.io/last-applied-configuration": "{\\"kind\\":\\"Service\\",\\"spec\\":{}}" }
+                },
+                "spec": {
+                    "type": "ClusterIP",
+                    "clusterIP": "10.96.\(index / 250).\(index % 250 + 1)",
+                    "ports": [
+                        { "name": "http", "port": 80, "targetPort": \(8_000 + index % 1_000), "protocol": "TCP" },
+                        { "name": "metrics", "port": 9090, "targetPort": "metrics", "protocol": "TCP" }
+                    ],
+                    "selector": { "app": "service-\(index)" }
+                },
+                "status": { "loadBalancer": {} }
+            }
+            """
+        }
+        let response = """
+        { "apiVersion": "v1", "kind": "List", "items": [\(items.joined(separator: ",\n"))], "metadata": { "resourceVersion": "" } }
+        """
+        return Data(response.utf8)
+    }
+
+    // MARK: - Auto-Kill
+
+    /// Enabled rules of the mix a heavy user might keep: by name, by port, by both
+    static let autoKillRules = [
+        AutoKillRule(name: "Stale node", processPattern: "node*", timeoutMinutes: 60),
+        AutoKillRule(name: "Vite", processPattern: "vite", timeoutMinutes: 120),
+        AutoKillRule(name: "Dev port", port: 3_000, timeoutMinutes: 30),
+        AutoKillRule(name: "Python on 8000", processPattern: "python*", port: 8_000, timeoutMinutes: 45),
+        AutoKillRule(name: "Disabled", processPattern: "java", timeoutMinutes: 1, isEnabled: false)
+    ]
+}
+
+/// Notification service that drops everything, so auto-kill benchmarks never reach
+/// UserNotifications
+@MainActor
+final class SilentNotificationService: NotificationServiceProtocol {
+    func setup() {}
+    func notify(title: String, body: String) {}
+    func requestPermission() async -> Bool { false }
+}
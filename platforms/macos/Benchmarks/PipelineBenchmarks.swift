@@ -0,0 +1,122 @@
+import Foundation
+import Testing
+import Defaults
+@testable import PortKiller
+
+/**
+ * Benchmarks of the per-refresh state pipeline: snapshot diffing, the port table,
+ * filtering, grouping, process type detection and auto-kill tracking.
+ */
+@MainActor
+@Suite(.serialized, .enabled(if: Benchmark.isEnabled))
+struct PipelineBenchmarks {
+
+    // MARK: - Test Fixtures
+
+    let favorites: Set<Int> = [3_000, 5_432, 8_080]
+    let watched = [WatchedPort(port: 3_000), WatchedPort(port: 6_379)]
+
+    // MARK: - Diff Benchmarks
+
+    @Test(arguments: BenchmarkFixtures.socketCounts)
+    func diffAndApplySnapshot(sockets: Int) {
+        let previous = BenchmarkFixtures.ports(sockets: sockets, generation: 0)
+        let current = BenchmarkFixtures.ports(sockets: sockets, generation: 1)
+
+        Benchmark.run("state.diffAndApply.\(sockets)") {
+            var differ = PortSnapshotDiffer()
+            _ = differ.delta(for: previous)
+            let delta = differ.delta(for: current)
+            var table = PortTable(previous)
+            table.replaceAll(with: delta.ports)
+            return table
+        }
+    }
+
+    // MARK: - Filter Benchmarks
+
+    @Test(arguments: BenchmarkFixtures.socketCounts)
+    func filterPorts(sockets: Int) {
+        let ports = BenchmarkFixtures.ports(sockets: sockets)
+        var filter = PortFilter()
+        filter.minPort = 2_000
+        filter.processTypes.remove(.system)
+
+        Benchmark.run("filter.matches.\(sockets)") {
+            ports.filter { filter.matches($0, favorites: favorites, watched: watched) }
+        }
+    }
+
+    @Test(arguments: BenchmarkFixtures.socketCounts)
+    func searchPorts(sockets: Int) {
+        let ports = BenchmarkFixtures.ports(sockets: sockets)
+        var filter = PortFilter()
+        filter.searchText = "helper"
+
+        #expect(!ports.filter { filter.matches($0, favorites: favorites, watched: watched) }.isEmpty)
+
+        // Unindexed search, the worst case: every port's fields are lowercased and scanned
+        Benchmark.run("filter.search.\(sockets)") {
+            ports.filter { filter.matches($0, favorites: favorites, watched: watched) }
+        }
+    }
+
+    // MARK: - Grouping Benchmarks
+
+    @Test(arguments: BenchmarkFixtures.socketCounts)
+    func groupByProcess(sockets: Int) {
+        let ports = BenchmarkFixtures.ports(sockets: sockets)
+
+        Benchmark.run("grouping.byProcess.\(sockets)") {
+            PortGroupingService.shared.groupByProcess(ports)
+        }
+        Benchmark.run("grouping.withPriority.\(sockets)") {
+            PortGroupingService.shared.groupByProcessWithPriority(
+                ports,
+                favorites: favorites,
+                watched: Set(watched.map(\.port))
+            )
+        }
+    }
+
+    // MARK: - Process Type Benchmarks
+
+    @Test func detectProcessType() {
+        let names = BenchmarkFixtures.ports(sockets: 10_000).map(\.processName)
+
+        Benchmark.run("processType.detect.10000") {
+            names.map(ProcessType.detect)
+        }
+    }
+
+    // MARK: - Auto-Kill Benchmarks
+
+    @Test(arguments: BenchmarkFixtures.socketCounts)
+    func autoKillCheck(sockets: Int) {
+        let savedRules = Defaults[.autoKillRules]
+        Defaults[.autoKillRules] = BenchmarkFixtures.autoKillRules
+        defer { Defaults[.autoKillRules] = savedRules }
+
+        let first = BenchmarkFixtures.ports(sockets: sockets, generation: 0)
+        let next = BenchmarkFixtures.ports(sockets: sockets, generation: 1)
+        var killed = 0
+
+        // Every port seen for the first time: rule matching for all of them
+        Benchmark.run("autoKill.firstCheck.\(sockets)") {
+            let manager = AutoKillManager(notificationService: SilentNotificationService())
+            manager.check(ports: first) { _ in killed += 1 }
+            return manager
+        }
+
+        // Steady state: a tenth of the ports churned since the previous refresh
+        let manager = AutoKillManager(notificationService: SilentNotificationService())
+        manager.check(ports: first) { _ in killed += 1 }
+        var generation = 0
+        Benchmark.run("autoKill.steadyCheck.\(sockets)") {
+            generation += 1
+            manager.check(ports: generation.isMultiple(of: 2) ? first : next) { _ in killed += 1 }
+        }
+
+        #expect(killed == 0)
+    }
+}
@@ -0,0 +1,75 @@
+import Foundation
+import Testing
+@testable import PortKiller
+
+/**
+ * Benchmarks of the scan path: lsof output parsing, escape decoding, turning
+ * records into PortInfo, and incremental decoding of kubectl list responses.
+ */
+@MainActor
+@Suite(.serialized, .enabled(if: Benchmark.isEnabled))
+struct ScannerBenchmarks {
+
+    // MARK: - lsof Benchmarks
+
+    @Test(arguments: BenchmarkFixtures.socketCounts)
+    func parseLsofOutput(sockets: Int) {
+        let output = BenchmarkFixtures.lsofOutput(sockets: sockets)
+
+        let records = LsofOutputParser.records(in: output)
+        #expect(records.count == sockets)
+
+        Benchmark.run("lsof.parse.\(sockets)") {
+            LsofOutputParser.records(in: output)
+        }
+    }
+
+    @Test(arguments: BenchmarkFixtures.socketCounts)
+    func buildPorts(sockets: Int) {
+        let output = BenchmarkFixtures.lsofOutput(sockets: sockets)
+
+        // A cold metadata cache every time: the first scan after launch
+        Benchmark.run("lsof.buildPorts.\(sockets)") {
+            var metadata: [Int: ProcessMetadata] = [:]
+            return BenchmarkFixtures.ports(from: output, metadata: &metadata)
+        }
+    }
+
+    @Test func decodeLsofEscapes() {
+        let names = (0..<1_000).map { BenchmarkFixtures.lsofProcessNames[$0 % BenchmarkFixtures.lsofProcessNames.count] }
+
+        #expect(PortScanner.decodeLsofEscapes("Code\\x20Helper\\x20(Plugin)") == "Code Helper (Plugin)")
+
+        Benchmark.run("lsof.decodeEscapes.1000") {
+            names.map(PortScanner.decodeLsofEscapes)
+        }
+    }
+
+    // MARK: - kubectl Benchmarks
+
+    @Test(arguments: [100, 1_000])
+    func decodeKubectlServiceList(services: Int) {
+        let response = BenchmarkFixtures.kubectlServiceList(count: services)
+        // Fed in pipe-read sized chunks, as `ProcessExecutor.chunks` delivers them
+        let chunkSize = 64 * 1_024
+        let chunks = stride(from: 0, to: response.count, by: chunkSize).map {
+            response.subdata(in: $0..<min($0 + chunkSize, response.count))
+        }
+
+        func decode() -> KubernetesListDecoder<KubernetesService.ListResponse.Item> {
+            let decoder = KubernetesListDecoder<KubernetesService.ListResponse.Item>()
+            for chunk in chunks {
+                decoder.feed(chunk)
+            }
+            return decoder
+        }
+
+        let decoded = decode()
+        #expect(decoded.items.count == services)
+        #expect(decoded.isComplete)
+
+        Benchmark.run("kubectl.decodeServices.\(services)") {
+            decode().items
+        }
+    }
+}
@@ -0,0 +1,97 @@
+import Foundation
+import Testing
+import Defaults
+@testable import PortKiller
+
+/**
+ * Memory soak of the refresh path.
+ *
+ * Runs the baseline's cycle count (50k) of simulated refreshes: parse churning lsof
+ * output, resolve metadata, diff, apply to the port table, filter, sort, group and
+ * check auto-kill rules, with a real `ProcessExecutor` spawn every few cycles the
+ * way the lsof scan spawns. Resident memory after warmup and at the end must not
+ * differ by more than the baseline allows; a per-scan leak like the one fixed in
+ * `PortScanner` (~1.7 GB over 47,520 scans) fails it by two orders of magnitude.
+ */
+@MainActor
+@Suite(.serialized, .enabled(if: Benchmark.isEnabled && Benchmark.isSoakEnabled))
+struct SoakTests {
+
+    // MARK: - Test Fixtures
+
+    /// Distinct lsof outputs the cycles rotate through; generations repeat every four
+    let generationCount = 4
+
+    /// One refresh worth of state, carried from cycle to cycle like `AppState` does
+    struct RefreshState {
+        var metadata: [Int: ProcessMetadata] = [:]
+        var differ = PortSnapshotDiffer()
+        var table = PortTable()
+        let autoKill = AutoKillManager(notificationService: SilentNotificationService())
+    }
+
+    func refresh(_ state: inout RefreshState, output: Data, filter: PortFilter) -> Int {
+        PerformanceMonitor.shared.measure(.refresh) {
+            let ports = BenchmarkFixtures.ports(from: output, metadata: &state.metadata)
+            let delta = state.differ.delta(for: ports)
+            state.table.replaceAll(with: delta.ports)
+
+            let visible = PortViewPipeline.select(state.table, sidebarItem: .allPorts, favorites: [], watched: [])
+                .filter { filter.matches($0, favorites: [], watched: []) }
+            let sorted = PortViewPipeline.sort(visible, by: .process, ascending: true, favorites: [], watched: [])
+            let groups = PortGroupingService.shared.groupByProcess(sorted)
+
+            state.autoKill.check(ports: delta.ports) { _ in }
+            return groups.count
+        }
+    }
+
+    func residentMegabytes() throws -> Double {
+        Double(try #require(PerformanceMonitor.residentMemoryBytes())) / 1_048_576
+    }
+
+    // MARK: - Soak Tests
+
+    @Test(.timeLimit(.minutes(30)))
+    func residentMemoryStaysFlatOverRefreshCycles() async throws {
+        let soak = BenchmarkBaseline.current.soak
+        let savedRules = Defaults[.autoKillRules]
+        Defaults[.autoKillRules] = BenchmarkFixtures.autoKillRules
+        defer { Defaults[.autoKillRules] = savedRules }
+
+        let outputs = (0..<generationCount).map {
+            BenchmarkFixtures.lsofOutput(sockets: soak.socketsPerCycle, generation: $0)
+        }
+        var filter = PortFilter()
+        filter.processTypes.remove(.system)
+        var state = RefreshState()
+        let spawnFailuresBefore = ProcessExecutor.statistics.launchFailures
+
+        var baseline = 0.0
+        var peakGrowth = 0.0
+        for cycle in 0..<soak.cycles {
+            if cycle == soak.warmupCycles {
+                baseline = try residentMegabytes()
+            }
+
+            let groups = refresh(&state, output: outputs[cycle % generationCount], filter: filter)
+            #expect(groups > 0)
+
+            if cycle.isMultiple(of: soak.spawnInterval) {
+                _ = await ProcessExecutor.run("/usr/bin/true", arguments: [])
+            }
+            if cycle > soak.warmupCycles, cycle.isMultiple(of: 1_000) {
+                peakGrowth = max(peakGrowth, try residentMegabytes() - baseline)
+            }
+        }
+
+        let growth = try residentMegabytes() - baseline
+        #expect(
+            growth <= soak.maxResidentGrowthMegabytes,
+            "RSS grew \(growth) MB over \(soak.cycles - soak.warmupCycles) cycles (peak \(max(peakGrowth, growth)) MB)"
+        )
+        // Metadata is pruned to live PIDs; anything more means listeners leak between scans
+        #expect(state.metadata.count <= soak.socketsPerCycle / 2)
+        #expect(ProcessExecutor.statistics.launchFailures == spawnFailuresBefore)
+    }
+}
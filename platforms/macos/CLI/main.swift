@@ -0,0 +1,178 @@
+/**
+ * main.swift
+ * PortKillerCLI
+ *
+ * `portkiller-cli`: reads the port snapshot PortKiller publishes instead of scanning,
+ * so scripts and terminals share the app's scan.
+ *
+ *     portkiller-cli list [--json] [--refresh]
+ *     portkiller-cli who <port> [--json] [--refresh]
+ *     portkiller-cli watch [--json]
+ *
+ * `--refresh` asks the publisher for a fresh scan and waits briefly for it.
+ * Exit status: 0 on success, 1 when `who` finds nothing, 2 when no snapshot exists
+ * or the arguments are wrong.
+ */
+
+import Foundation
+import PortSnapshot
+import Synchronization
+
+private let usage = """
+usage: portkiller-cli list [--json] [--refresh]
+       portkiller-cli who <port> [--json] [--refresh]
+       portkiller-cli watch [--json]
+"""
+
+private func fail(_ message: String, status: Int32 = 2) -> Never {
+    FileHandle.standardError.write(Data((message + "\n").utf8))
+    exit(status)
+}
+
+/// The current snapshot, after a fresh scan if `refresh` is set
+private func loadSnapshot(refresh: Bool) -> SnapshotFile {
+    let current = SnapshotFile()
+    if refresh {
+        SnapshotNotification.rescanRequested.post()
+        let deadline = Date().addingTimeInterval(1)
+        while Date() < deadline {
+            usleep(10_000)
+            if let next = SnapshotFile(), next.generation > current?.generation ?? 0 {
+                return next
+            }
+        }
+    }
+    guard let current else {
+        fail("No port snapshot at \(SnapshotFile.defaultURL.path). Start PortKiller or enable its background scanner.")
+    }
+    if !current.isPublisherRunning {
+        FileHandle.standardError.write(Data("warning: snapshot publisher is not running; ports may be stale\n".utf8))
+    }
+    return current
+}
+
+private func write(_ ports: [SnapshotPort], json: Bool) {
+    if json {
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+        guard let data = try? encoder.encode(ports) else { fail("Encoding ports failed") }
+        FileHandle.standardOutput.write(data + Data("\n".utf8))
+        return
+    }
+    var output = "PORT\tPID\tPROCESS\tUSER\tADDRESS\tTYPE\n"
+    for port in ports {
+        output += "\(port.port)\t\(port.pid)\t\(port.processName)\t\(port.user)\t\(port.address)\t\(port.processType)\n"
+    }
+    FileHandle.standardOutput.write(Data(output.utf8))
+}
+
+/// Prints the changes of each new generation until interrupted
+private func watch(json: Bool) -> Never {
+    let printed = PrintedState(SnapshotFile())
+    let observation = SnapshotNotification.published.observe {
+        guard let snapshot = SnapshotFile(),
+              let change = printed.advance(to: snapshot) else { return }
+
+        if json {
+            let event = WatchEvent(generation: snapshot.generation, updated: change.updated, removed: change.removed)
+            if let data = try? JSONEncoder().encode(event) {
+                FileHandle.standardOutput.write(data + Data("\n".utf8))
+            }
+            return
+        }
+        var output = ""
+        for port in change.updated {
+            output += "+ \(port.port)\t\(port.pid)\t\(port.processName)\n"
+        }
+        for key in change.removed {
+            output += "- \(key.port)\t\(key.pid)\n"
+        }
+        FileHandle.standardOutput.write(Data(output.utf8))
+    }
+    withExtendedLifetime(observation) {
+        RunLoop.main.run()
+    }
+    exit(EXIT_SUCCESS)
+}
+
+/// Generation and listeners `watch` last printed. Notifications coalesce and may
+/// arrive after a newer one, so a snapshot isn't always one step past it.
+private final class PrintedState: Sendable {
+    private struct State {
+        var generation: UInt64
+        var ports: [SnapshotPort.Key: SnapshotPort]
+    }
+
+    private let state: Mutex<State>
+
+    init(_ snapshot: SnapshotFile?) {
+        let ports = snapshot?.ports ?? []
+        state = Mutex(State(
+            generation: snapshot?.generation ?? 0,
+            ports: Dictionary(ports.map { ($0.key, $0) }, uniquingKeysWith: { $1 })
+        ))
+    }
+
+    /// Changes from the printed listeners to `snapshot`'s, nil if it isn't newer.
+    /// Uses the file's own delta when it follows the printed generation, and diffs
+    /// the full port list when generations were skipped.
+    func advance(to snapshot: SnapshotFile) -> (updated: [SnapshotPort], removed: [SnapshotPort.Key])? {
+        state.withLock { state in
+            guard snapshot.generation > state.generation else { return nil }
+            defer { state.generation = snapshot.generation }
+
+            if snapshot.previousGeneration == state.generation {
+                let (updated, removed) = (snapshot.updated, snapshot.removed)
+                for key in removed {
+                    state.ports[key] = nil
+                }
+                for port in updated {
+                    state.ports[port.key] = port
+                }
+                return (updated, removed)
+            }
+
+            let current = Dictionary(snapshot.ports.map { ($0.key, $0) }, uniquingKeysWith: { $1 })
+            let updated = snapshot.ports.filter { state.ports[$0.key] != $0 }
+            let removed = state.ports.keys
+                .filter { current[$0] == nil }
+                .sorted { ($0.port, $0.pid) < ($1.port, $1.pid) }
+            state.ports = current
+            return (updated, removed)
+        }
+    }
+}
+
+/// One line of `watch --json`
+private struct WatchEvent: Encodable {
+    let generation: UInt64
+    let updated: [SnapshotPort]
+    let removed: [SnapshotPort.Key]
+}
+
+// MARK: - Arguments
+
+var arguments = Array(CommandLine.arguments.dropFirst())
+let json = arguments.contains("--json")
+let refresh = arguments.contains("--refresh")
+arguments.removeAll { $0 == "--json" || $0 == "--refresh" }
+
+switch arguments.first {
+case "list" where arguments.count == 1:
+    write(loadSnapshot(refresh: refresh).ports, json: json)
+case "who" where arguments.count == 2:
+    guard let port = Int(arguments[1]), (1...65_535).contains(port) else {
+        fail("Invalid port: \(arguments[1])")
+    }
+    let holders = loadSnapshot(refresh: refresh).ports(on: port)
+    guard !holders.isEmpty else {
+        if !json { fail("Nothing is listening on port \(port)", status: 1) }
+        write([], json: true)
+        exit(1)
+    }
+    write(holders, json: json)
+case "watch" where arguments.count == 1:
+    watch(json: json)
+default:
+    fail(usage)
+}
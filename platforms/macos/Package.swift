@@ -7,7 +7,8 @@ let package = Package(
         .macOS(.v15)
     ],
     products: [
-        .executable(name: "PortKiller", targets: ["PortKiller"])
+        .executable(name: "PortKiller", targets: ["PortKiller"]),
+        .executable(name: "portkiller-cli", targets: ["PortKillerCLI"])
     ],
     dependencies: [
         .package(url: "https://github.com/sindresorhus/KeyboardShortcuts", from: "2.4.0"),
@@ -16,9 +17,15 @@ let package = Package(
         .package(url: "https://github.com/sparkle-project/Sparkle", from: "2.8.1")
     ],
     targets: [
+        // Shared port snapshot format, read by the app and the CLI
+        .target(
+            name: "PortSnapshot",
+            path: "PortSnapshot"
+        ),
         .executableTarget(
             name: "PortKiller",
             dependencies: [
+                "PortSnapshot",
                 "KeyboardShortcuts",
                 "Defaults",
                 .product(name: "LaunchAtLogin", package: "LaunchAtLogin-Modern"),
@@ -39,10 +46,24 @@ let package = Package(
                 .enableExperimentalFeature("Span")
             ]
         ),
+        .executableTarget(
+            name: "PortKillerCLI",
+            dependencies: ["PortSnapshot"],
+            path: "CLI"
+        ),
         .testTarget(
             name: "PortKillerTests",
-            dependencies: ["PortKiller"],
+            dependencies: ["PortKiller", "PortSnapshot"],
             path: "Tests"
+        ),
+        // Timing budgets and the memory soak; opt-in, see Benchmarks/Benchmark.swift
+        .testTarget(
+            name: "PortKillerBenchmarks",
+            dependencies: ["PortKiller"],
+            path: "Benchmarks",
+            resources: [
+                .copy("Baselines")
+            ]
         )
     ]
 )
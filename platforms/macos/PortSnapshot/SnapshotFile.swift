@@ -0,0 +1,193 @@
+/**
+ * SnapshotFile.swift
+ * PortSnapshot
+ *
+ * Versioned binary snapshot of the listening ports, shared through a memory-mapped
+ * file so any number of readers (menu bar, main window, CLI, scripts) cost one scan.
+ */
+
+import Foundation
+import Darwin
+
+/// A published snapshot, memory-mapped read-only.
+///
+/// The publisher writes each generation to a temporary file and renames it over
+/// `SnapshotFile.defaultURL`, so a mapping always holds one complete generation and
+/// readers need no locking. Records are fixed-size and point into a UTF-8 string
+/// blob; text is only materialized for the records a reader asks for.
+///
+/// Layout (host byte order):
+/// ```
+/// header   64 bytes   magic, version, flags, generation, previous generation,
+///                     published-at (ms), record/removed/string sizes, publisher PID
+/// records  60 bytes   port, pid, updated flag, then (offset, length) of processName,
+///                     user, command, address, fd, processType in the blob
+/// removed   8 bytes   port, pid of each listener gone since the previous generation
+/// strings             UTF-8 blob
+/// ```
+public final class SnapshotFile: @unchecked Sendable {
+
+    /// Header flags
+    public struct Flags: OptionSet, Sendable {
+        public let rawValue: UInt16
+        public init(rawValue: UInt16) { self.rawValue = rawValue }
+
+        /// Published by the headless background scanner rather than an app window
+        public static let headless = Flags(rawValue: 1 << 0)
+    }
+
+    static let magic: UInt32 = 0x534B_5050 // "PPKS"
+    /// Bumped on any layout change; readers reject other versions
+    public static let formatVersion: UInt16 = 1
+    static let headerSize = 64
+    static let recordSize = 60
+    static let removedSize = 8
+
+    public let generation: UInt64
+    /// Generation the updated/removed sets are relative to (0 for the first one)
+    public let previousGeneration: UInt64
+    public let publishedAt: Date
+    public let publisherPID: Int32
+    public let flags: Flags
+    public let count: Int
+
+    private let base: UnsafeRawPointer
+    private let length: Int
+    private let removedCount: Int
+    private let stringsStart: Int
+    private let stringsLength: Int
+
+    // MARK: - Location
+
+    /// `~/Library/Application Support/PortKiller/ports.snapshot`
+    public static var defaultURL: URL {
+        URL.applicationSupportDirectory
+            .appending(path: "PortKiller", directoryHint: .isDirectory)
+            .appending(path: "ports.snapshot", directoryHint: .notDirectory)
+    }
+
+    // MARK: - Opening
+
+    /// Maps the snapshot at `url`; nil if it doesn't exist, isn't a snapshot, or was
+    /// written by another format version.
+    public init?(contentsOf url: URL = SnapshotFile.defaultURL) {
+        let descriptor = open(url.path, O_RDONLY | O_CLOEXEC)
+        guard descriptor >= 0 else { return nil }
+        defer { close(descriptor) }
+
+        var status = stat()
+        guard fstat(descriptor, &status) == 0, status.st_size >= Self.headerSize else { return nil }
+        let length = Int(status.st_size)
+        guard let mapping = mmap(nil, length, PROT_READ, MAP_PRIVATE, descriptor, 0),
+              mapping != MAP_FAILED else { return nil }
+        let base = UnsafeRawPointer(mapping)
+
+        func load<T>(_ offset: Int, as type: T.Type) -> T {
+            base.loadUnaligned(fromByteOffset: offset, as: type)
+        }
+
+        let count = Int(load(32, as: UInt32.self))
+        let removedCount = Int(load(36, as: UInt32.self))
+        let stringsLength = Int(load(40, as: UInt32.self))
+        let stringsStart = Self.headerSize + count * Self.recordSize + removedCount * Self.removedSize
+        guard load(0, as: UInt32.self) == Self.magic,
+              load(4, as: UInt16.self) == Self.formatVersion,
+              stringsStart + stringsLength == length else {
+            munmap(mapping, length)
+            return nil
+        }
+
+        self.base = base
+        self.length = length
+        self.flags = Flags(rawValue: load(6, as: UInt16.self))
+        self.generation = load(8, as: UInt64.self)
+        self.previousGeneration = load(16, as: UInt64.self)
+        self.publishedAt = Date(timeIntervalSince1970: Double(load(24, as: Int64.self)) / 1_000)
+        self.publisherPID = load(44, as: Int32.self)
+        self.count = count
+        self.removedCount = removedCount
+        self.stringsStart = stringsStart
+        self.stringsLength = stringsLength
+    }
+
+    deinit {
+        munmap(UnsafeMutableRawPointer(mutating: base), length)
+    }
+
+    // MARK: - Publisher
+
+    /// Whether the process that published this snapshot is still running
+    public var isPublisherRunning: Bool {
+        kill(publisherPID, 0) == 0 || errno == EPERM
+    }
+
+    public var age: TimeInterval { Date().timeIntervalSince(publishedAt) }
+
+    // MARK: - Records
+
+    /// Port number of record `index`, without touching its strings
+    public func portNumber(at index: Int) -> Int {
+        Int(base.loadUnaligned(fromByteOffset: recordOffset(index), as: UInt32.self))
+    }
+
+    /// Whether record `index` is new or changed since `previousGeneration`
+    public func isUpdated(at index: Int) -> Bool {
+        base.loadUnaligned(fromByteOffset: recordOffset(index) + 8, as: UInt32.self) & 1 != 0
+    }
+
+    public func port(at index: Int) -> SnapshotPort {
+        let offset = recordOffset(index)
+        var fieldOffset = offset + 12
+        func field() -> String {
+            let start = Int(base.loadUnaligned(fromByteOffset: fieldOffset, as: UInt32.self))
+            let count = Int(base.loadUnaligned(fromByteOffset: fieldOffset + 4, as: UInt32.self))
+            fieldOffset += 8
+            guard start + count <= stringsLength else { return "" }
+            let bytes = UnsafeRawBufferPointer(start: base + stringsStart + start, count: count)
+            return String(decoding: bytes, as: UTF8.self)
+        }
+
+        return SnapshotPort(
+            port: portNumber(at: index),
+            pid: Int(base.loadUnaligned(fromByteOffset: offset + 4, as: Int32.self)),
+            processName: field(),
+            user: field(),
+            command: field(),
+            address: field(),
+            fd: field(),
+            processType: field()
+        )
+    }
+
+    /// Every listener in the snapshot, in published order (ascending port)
+    public var ports: [SnapshotPort] {
+        (0..<count).map(port(at:))
+    }
+
+    /// Listeners on `port`; only their records are decoded
+    public func ports(on port: Int) -> [SnapshotPort] {
+        (0..<count).filter { portNumber(at: $0) == port }.map(self.port(at:))
+    }
+
+    /// Listeners new or changed since `previousGeneration`
+    public var updated: [SnapshotPort] {
+        (0..<count).filter(isUpdated(at:)).map(port(at:))
+    }
+
+    /// Listeners gone since `previousGeneration`
+    public var removed: [SnapshotPort.Key] {
+        let start = Self.headerSize + count * Self.recordSize
+        return (0..<removedCount).map { index in
+            let offset = start + index * Self.removedSize
+            return SnapshotPort.Key(
+                port: Int(base.loadUnaligned(fromByteOffset: offset, as: UInt32.self)),
+                pid: Int(base.loadUnaligned(fromByteOffset: offset + 4, as: Int32.self))
+            )
+        }
+    }
+
+    private func recordOffset(_ index: Int) -> Int {
+        precondition(index >= 0 && index < count, "Snapshot record \(index) out of range")
+        return Self.headerSize + index * Self.recordSize
+    }
+}
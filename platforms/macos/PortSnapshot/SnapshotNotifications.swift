@@ -0,0 +1,64 @@
+/**
+ * SnapshotNotifications.swift
+ * PortSnapshot
+ *
+ * Darwin notifications between the snapshot publisher and its readers.
+ */
+
+import Foundation
+
+/// System-wide notifications about the shared snapshot, through the Darwin notify
+/// center (no payload, any number of observers, any process of the user).
+public enum SnapshotNotification: String, Sendable {
+    /// A new generation was renamed into place
+    case published = "com.portkiller.snapshot.published"
+    /// A reader wants a fresh scan now instead of at the next interval
+    case rescanRequested = "com.portkiller.snapshot.rescan"
+
+    public func post() {
+        CFNotificationCenterPostNotification(
+            CFNotificationCenterGetDarwinNotifyCenter(),
+            CFNotificationName(rawValue as CFString),
+            nil,
+            nil,
+            true
+        )
+    }
+
+    /// Calls `handler` on the main run loop each time the notification is posted,
+    /// until the returned observation is released.
+    public func observe(_ handler: @escaping @Sendable () -> Void) -> SnapshotObservation {
+        SnapshotObservation(name: rawValue, handler: handler)
+    }
+}
+
+/// A registered Darwin notification observer; removed when released.
+public final class SnapshotObservation: @unchecked Sendable {
+    private let name: CFNotificationName
+    private let handler: @Sendable () -> Void
+
+    init(name: String, handler: @escaping @Sendable () -> Void) {
+        self.name = CFNotificationName(name as CFString)
+        self.handler = handler
+        CFNotificationCenterAddObserver(
+            CFNotificationCenterGetDarwinNotifyCenter(),
+            Unmanaged.passUnretained(self).toOpaque(),
+            { _, observer, _, _, _ in
+                guard let observer else { return }
+                Unmanaged<SnapshotObservation>.fromOpaque(observer).takeUnretainedValue().handler()
+            },
+            self.name.rawValue,
+            nil,
+            .deliverImmediately
+        )
+    }
+
+    deinit {
+        CFNotificationCenterRemoveObserver(
+            CFNotificationCenterGetDarwinNotifyCenter(),
+            Unmanaged.passUnretained(self).toOpaque(),
+            name,
+            nil
+        )
+    }
+}
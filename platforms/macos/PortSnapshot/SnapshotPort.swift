@@ -0,0 +1,54 @@
+/**
+ * SnapshotPort.swift
+ * PortSnapshot
+ *
+ * One listening socket as published in a shared port snapshot. Plain values only,
+ * so the snapshot format doesn't depend on the app's PortInfo.
+ */
+
+/// A listening socket in a published snapshot
+public struct SnapshotPort: Sendable, Hashable, Codable {
+    /// Port and PID, the identity of a listener across snapshots
+    public struct Key: Sendable, Hashable, Codable {
+        public let port: Int
+        public let pid: Int
+
+        public init(port: Int, pid: Int) {
+            self.port = port
+            self.pid = pid
+        }
+    }
+
+    public let port: Int
+    public let pid: Int
+    public let processName: String
+    public let user: String
+    public let command: String
+    /// Bound host ("127.0.0.1", "*", "[::1]")
+    public let address: String
+    public let fd: String
+    /// Raw value of the app's ProcessType, resolved by the publisher (overrides included)
+    public let processType: String
+
+    public var key: Key { Key(port: port, pid: pid) }
+
+    public init(
+        port: Int,
+        pid: Int,
+        processName: String,
+        user: String,
+        command: String,
+        address: String,
+        fd: String,
+        processType: String
+    ) {
+        self.port = port
+        self.pid = pid
+        self.processName = processName
+        self.user = user
+        self.command = command
+        self.address = address
+        self.fd = fd
+        self.processType = processType
+    }
+}
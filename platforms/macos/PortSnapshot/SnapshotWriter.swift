@@ -0,0 +1,89 @@
+/**
+ * SnapshotWriter.swift
+ * PortSnapshot
+ *
+ * Encodes and atomically publishes `SnapshotFile` generations.
+ */
+
+import Foundation
+
+/// Encodes snapshots in the `SnapshotFile` layout and publishes them by rename.
+public enum SnapshotWriter {
+
+    /// Encodes one generation.
+    ///
+    /// - Parameters:
+    ///   - ports: Every current listener, in the order readers should see them
+    ///   - updated: Keys of `ports` that are new or changed since `previousGeneration`
+    ///   - removed: Listeners gone since `previousGeneration`
+    public static func encode(
+        ports: [SnapshotPort],
+        updated: Set<SnapshotPort.Key>,
+        removed: [SnapshotPort.Key],
+        generation: UInt64,
+        previousGeneration: UInt64,
+        publishedAt: Date = Date(),
+        publisherPID: Int32 = getpid(),
+        flags: SnapshotFile.Flags = []
+    ) -> Data {
+        // Identical strings (a process's name on each of its sockets) are stored once
+        var strings: [UInt8] = []
+        var offsets: [String: (UInt32, UInt32)] = [:]
+        func intern(_ string: String) -> (UInt32, UInt32) {
+            if let existing = offsets[string] { return existing }
+            let reference = (UInt32(strings.count), UInt32(string.utf8.count))
+            strings.append(contentsOf: string.utf8)
+            offsets[string] = reference
+            return reference
+        }
+
+        var records = Data(capacity: ports.count * SnapshotFile.recordSize)
+        for port in ports {
+            records.append(UInt32(truncatingIfNeeded: port.port))
+            records.append(Int32(truncatingIfNeeded: port.pid))
+            records.append(UInt32(updated.contains(port.key) ? 1 : 0))
+            for field in [port.processName, port.user, port.command, port.address, port.fd, port.processType] {
+                let (offset, length) = intern(field)
+                records.append(offset)
+                records.append(length)
+            }
+        }
+
+        var data = Data(capacity: SnapshotFile.headerSize + records.count + removed.count * SnapshotFile.removedSize + strings.count)
+        data.append(SnapshotFile.magic)
+        data.append(SnapshotFile.formatVersion)
+        data.append(flags.rawValue)
+        data.append(generation)
+        data.append(previousGeneration)
+        data.append(Int64((publishedAt.timeIntervalSince1970 * 1_000).rounded()))
+        data.append(UInt32(ports.count))
+        data.append(UInt32(removed.count))
+        data.append(UInt32(strings.count))
+        data.append(publisherPID)
+        data.append(contentsOf: repeatElement(UInt8(0), count: SnapshotFile.headerSize - data.count))
+
+        data.append(records)
+        for key in removed {
+            data.append(UInt32(truncatingIfNeeded: key.port))
+            data.append(Int32(truncatingIfNeeded: key.pid))
+        }
+        data.append(contentsOf: strings)
+        return data
+    }
+
+    /// Writes `data` next to `url` and renames it into place, so readers only ever
+    /// map complete generations. Creates the directory on first use.
+    public static func publish(_ data: Data, to url: URL = SnapshotFile.defaultURL) throws {
+        try FileManager.default.createDirectory(
+            at: url.deletingLastPathComponent(),
+            withIntermediateDirectories: true
+        )
+        try data.write(to: url, options: .atomic)
+    }
+}
+
+private extension Data {
+    mutating func append<T: FixedWidthInteger>(_ value: T) {
+        Swift.withUnsafeBytes(of: value) { append(contentsOf: $0) }
+    }
+}
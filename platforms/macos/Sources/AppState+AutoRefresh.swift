@@ -6,18 +6,35 @@ extension AppState {
     func stopAutoRefresh() {
         refreshTask?.cancel()
         refreshTask = nil
+        processEventTask?.cancel()
+        processEventTask = nil
     }
 
     /// Starts a background task that periodically refreshes the port list.
-    func startAutoRefresh() {
+    ///
+    /// In event-driven mode (`Defaults[.eventDrivenRefresh]`), listener exits and execs
+    /// trigger targeted rescans right away; the polling loop below then only acts
+    /// as a safety net for listeners opened by processes we aren't watching yet.
+    ///
+    /// - Parameter deferringFirstScan: Wait `AppConstants.launchScanDelay` before the
+    ///   first scan and run it at utility priority, as at launch
+    func startAutoRefresh(deferringFirstScan: Bool = false) {
         stopAutoRefresh()
+        startProcessEventMonitoring()
         refreshTask = Task { @MainActor [weak self] in
             guard let self else { return }
             var unchangedCycles = 0
-            _ = await self.refresh()
+            if deferringFirstScan {
+                try? await Task.sleep(for: AppConstants.launchScanDelay)
+                guard !Task.isCancelled else { return }
+                _ = await Task(priority: .utility) { await self.refresh() }.value
+            } else {
+                _ = await self.refresh()
+            }
             while !Task.isCancelled {
                 let baseInterval = max(1, Defaults[.refreshInterval])
                 let delaySeconds = self.adaptiveRefreshDelay(baseInterval: baseInterval, unchangedCycles: unchangedCycles)
+                PerformanceMonitor.shared.setEffectiveRefreshInterval(.seconds(delaySeconds))
                 try? await Task.sleep(for: .seconds(delaySeconds))
                 guard !Task.isCancelled else { break }
 
@@ -27,6 +44,57 @@ extension AppState {
         }
     }
 
+    /// Registers the current listener PIDs with the process event monitor.
+    /// Called after every scan that changed the port list.
+    func syncProcessEventMonitor() {
+        guard Defaults[.eventDrivenRefresh] else {
+            processEventMonitor?.watch(pids: [])
+            return
+        }
+        processEventMonitor?.watch(pids: Set(portTable.indices.map(portTable.pid(at:))))
+    }
+
+    /// Rescans when a watched listener exits or execs.
+    ///
+    /// Exits rescan right away, each on its own child task, so they never wait behind
+    /// an exec burst. Execs are coalesced into one rescan per burst, run once no exec
+    /// has arrived for `processSpawnRescanDelay`, and at most `processSpawnSettleLimit`
+    /// after the burst's first one.
+    private func startProcessEventMonitoring() {
+        guard let events = processEventMonitor?.events else { return }
+        syncProcessEventMonitor()
+
+        processEventTask = Task { @MainActor [weak self] in
+            let burst = SpawnBurst()
+            await withDiscardingTaskGroup { group in
+                for await event in events {
+                    guard let self, !Task.isCancelled else { break }
+                    guard Defaults[.eventDrivenRefresh] else { continue }
+
+                    switch event {
+                    case .exited:
+                        group.addTask { @MainActor in
+                            try? await Task.sleep(for: AppConstants.processExitRescanDelay)
+                            guard !Task.isCancelled else { return }
+                            _ = await self.refresh()
+                        }
+                    case .spawned:
+                        // Later execs of a running burst only push its rescan back
+                        guard burst.record() else { continue }
+                        group.addTask { @MainActor in
+                            while let wait = burst.timeUntilRescan() {
+                                try? await Task.sleep(for: wait)
+                                guard !Task.isCancelled else { return }
+                            }
+                            _ = await self.refresh()
+                        }
+                    }
+                }
+                group.cancelAll()
+            }
+        }
+    }
+
     /// Dynamically backs off polling when the port list stays stable.
     private func adaptiveRefreshDelay(baseInterval: Int, unchangedCycles: Int) -> Double {
         let base = Double(baseInterval)
@@ -44,3 +112,32 @@ extension AppState {
         return min(base * multiplier, 30.0)
     }
 }
+
+/// Timing of the current burst of exec events, see `startProcessEventMonitoring`
+private final class SpawnBurst {
+    private var firstEvent: ContinuousClock.Instant?
+    private var lastEvent = ContinuousClock.now
+
+    /// Records an exec; true if it starts a new burst
+    func record() -> Bool {
+        lastEvent = .now
+        guard firstEvent == nil else { return false }
+        firstEvent = lastEvent
+        return true
+    }
+
+    /// Time left until the burst's rescan is due; nil once it is, which ends the burst
+    func timeUntilRescan() -> Duration? {
+        guard let firstEvent else { return nil }
+        let due = min(
+            lastEvent + AppConstants.processSpawnRescanDelay,
+            firstEvent + AppConstants.processSpawnSettleLimit
+        )
+        let now = ContinuousClock.now
+        guard due > now else {
+            self.firstEvent = nil
+            return nil
+        }
+        return due - now
+    }
+}
@@ -0,0 +1,48 @@
+import Foundation
+
+/// The Kubernetes and Cloudflare subsystems are created the first time something asks
+/// for them rather than in `AppState.init`, so a launch that never opens the port
+/// forwarder or a tunnel doesn't load saved connections, probe for cloudflared or sweep
+/// orphaned tunnel processes.
+extension AppState {
+    /// Manages Kubernetes port-forward connections
+    var portForwardManager: PortForwardManager {
+        if let loadedPortForwardManager { return loadedPortForwardManager }
+        let manager = PortForwardManager()
+        loadedPortForwardManager = manager
+        return manager
+    }
+
+    /// Manages Cloudflare Quick Tunnel connections (ephemeral `*.trycloudflare.com`)
+    var tunnelManager: TunnelManager {
+        if let loadedTunnelManager { return loadedTunnelManager }
+        let manager = TunnelManager(cloudflaredService: cloudflaredService)
+        loadedTunnelManager = manager
+        return manager
+    }
+
+    /// Manages persistent (named) Cloudflare tunnels discovered from `~/.cloudflared/`
+    var namedTunnelManager: NamedTunnelManager {
+        if let loadedNamedTunnelManager { return loadedNamedTunnelManager }
+        let manager = NamedTunnelManager(cloudflaredService: cloudflaredService)
+        loadedNamedTunnelManager = manager
+        return manager
+    }
+
+    /// cloudflared subprocesses, shared by both tunnel managers
+    private var cloudflaredService: CloudflaredService {
+        if let loadedCloudflaredService { return loadedCloudflaredService }
+        let service = CloudflaredService()
+        loadedCloudflaredService = service
+        return service
+    }
+
+    // MARK: - Shutdown
+
+    /// Kills port-forward children and quick tunnels before the app quits, skipping
+    /// subsystems that were never created
+    func shutDownManagers() async {
+        await loadedPortForwardManager?.killStuckProcesses()
+        await loadedTunnelManager?.stopAllTunnels()
+    }
+}
@@ -0,0 +1,36 @@
+import Foundation
+
+extension AppState {
+    /// Ports listed in the menu bar, see `PortViewPipeline.selectForMenuBar`.
+    /// Recomputed only when the table, the search or favorites change.
+    func menuBarPorts(searchText: String, hideSystemProcesses: Bool) -> [PortInfo] {
+        let table = portTable
+        let favorites = self.favorites
+        return pipeline.menuBar.output(for: .init(
+            tableGeneration: table.generation,
+            searchText: searchText,
+            hideSystemProcesses: hideSystemProcesses,
+            favorites: favorites
+        )) {
+            PortViewPipeline.selectForMenuBar(
+                table, searchText: searchText, hideSystemProcesses: hideSystemProcesses, favorites: favorites
+            )
+        }
+    }
+
+    /// `menuBarPorts` grouped by process for the menu bar's tree view, groups with
+    /// favorite or watched ports first. Regrouped only when those rows, favorites or
+    /// watched ports change, not on every scan.
+    func menuBarProcessGroups(searchText: String, hideSystemProcesses: Bool) -> [ProcessGroup] {
+        let ports = menuBarPorts(searchText: searchText, hideSystemProcesses: hideSystemProcesses)
+        let favorites = self.favorites
+        let watched = Set(watchedPorts.map(\.port))
+        return pipeline.priorityGroups.output(for: .init(
+            menuBarGeneration: pipeline.menuBar.generation,
+            favorites: favorites,
+            watched: watched
+        )) {
+            PortGroupingService.shared.groupByProcessWithPriority(ports, favorites: favorites, watched: watched)
+        }
+    }
+}
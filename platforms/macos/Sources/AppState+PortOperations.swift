@@ -11,18 +11,23 @@ extension AppState {
 
         var didChangeAny = false
 
+        let monitor = PerformanceMonitor.shared
         repeat {
             hasPendingRefreshRequest = false
             isScanning = true
+            let start = ContinuousClock.now
 
-            let scanned = await scanner.scanPorts()
-            let previousPorts = ports
-            let didChange = updatePorts(scanned)
+            let delta = await monitor.measure(.scan) { await scanner.scanDelta() }
+            let didChange = monitor.measure(.updatePorts) { applyScanDelta(delta) }
             didChangeAny = didChangeAny || didChange
+            if didChange {
+                syncProcessEventMonitor()
+            }
+            await portHistory.record(delta)
 
             // Check process type notifications for newly appeared ports
-            if didChange {
-                checkProcessTypeNotifications(oldPorts: previousPorts, newPorts: scanned)
+            if !delta.added.isEmpty {
+                checkProcessTypeNotifications(addedPorts: delta.added)
             }
 
             // Always update watcher state to keep transition baseline accurate.
@@ -34,56 +39,120 @@ extension AppState {
             }
 
             isScanning = false
+            monitor.record(.refresh, duration: ContinuousClock.now - start)
         } while hasPendingRefreshRequest
 
         return didChangeAny
     }
 
+    /// Applies an incremental scan result to the port list.
+    ///
+    /// Only the ports in the delta are touched; an empty delta is a no-op. After a local
+    /// optimistic removal (kill), the full snapshot is used instead so a surviving process
+    /// reappears even though the scanner saw no change.
+    @discardableResult
+    func applyScanDelta(_ delta: PortScanDelta) -> Bool {
+        if needsPortResync || isShowingCachedPorts {
+            needsPortResync = false
+            isShowingCachedPorts = false
+            return updatePorts(delta.ports)
+        }
+        guard !delta.isEmpty else { return false }
+
+        var replaced = Set(delta.removed.map(\.key))
+        replaced.formUnion(delta.changed.map(\.key))
+
+        // The rest keep their order; the delta's rows are merged in rather than the
+        // whole list sorted again, unless favorites changed since it was sorted
+        let kept = ports.filter { !replaced.contains($0.key) }
+        let incoming = sortedForDisplay(delta.changed + delta.added)
+        let order = displayOrder
+        ports = kept.isSorted(by: order) ? kept.mergingSorted(incoming, by: order) : sortedForDisplay(kept + incoming)
+        return true
+    }
+
+    /// Fills the list from the last snapshot published since boot, so the menu bar
+    /// renders before the deferred first scan, which then replaces it.
+    func showPublishedPorts() {
+        guard let published = SharedSnapshotScanner.publishedPorts() else { return }
+        ports = sortedForDisplay(published)
+        isShowingCachedPorts = true
+    }
+
     /// Updates the internal port list only if there are changes.
     @discardableResult
     func updatePorts(_ newPorts: [PortInfo]) -> Bool {
-        let newSet = Set(newPorts.map { "\($0.port)-\($0.pid)" })
-        let oldSet = Set(ports.map { "\($0.port)-\($0.pid)" })
+        let newSet = Set(newPorts.map(\.key))
+        let oldSet = Set(portTable.indices.map { PortKey(port: portTable.port(at: $0), pid: portTable.pid(at: $0)) })
         guard newSet != oldSet else { return false }
 
-        ports = newPorts.sorted { a, b in
+        ports = sortedForDisplay(newPorts)
+        return true
+    }
+
+    /// Favorites first, then ascending port number.
+    func sortedForDisplay(_ list: [PortInfo]) -> [PortInfo] {
+        list.sorted(by: displayOrder)
+    }
+
+    private var displayOrder: (PortInfo, PortInfo) -> Bool {
+        let favorites = self.favorites
+        return { a, b in
             let aFav = favorites.contains(a.port)
             let bFav = favorites.contains(b.port)
             if aFav != bFav { return aFav }
             return a.port < b.port
         }
-        return true
     }
 
     /// Kills the process using the specified port.
     func killPort(_ port: PortInfo) async {
-        if await scanner.killProcessGracefully(pid: port.pid) {
-            ports.removeAll { $0.id == port.id }
-            await refresh()
-        }
+        await killPorts([port])
+    }
+
+    /// Kills the processes using `ports` as one batch, so the grace periods overlap.
+    /// Like the other kills, does nothing while `isShowingCachedPorts`.
+    func killPorts(_ ports: [PortInfo]) async {
+        guard !isShowingCachedPorts else { return }
+        let terminated = await scanner.killProcesses(pids: Set(ports.map(\.pid)))
+        guard !terminated.isEmpty else { return }
+        removeRows(ownedBy: terminated)
+        await refresh()
     }
 
     /// Kills the listening process and all processes with ESTABLISHED connections to the port.
     func killPortDeep(_ port: PortInfo) async {
-        // 1. Kill the listener
-        _ = await scanner.killProcessGracefully(pid: port.pid)
-
-        // 2. Find and kill ESTABLISHED connections
-        let establishedPids = await scanner.findEstablishedPids(for: port.port)
-        for pid in establishedPids where pid != port.pid {
-            _ = await scanner.killProcessGracefully(pid: pid)
-        }
+        await killPortsDeep([port])
+    }
 
-        ports.removeAll { $0.id == port.id }
+    /// Deep-kills several ports at once: established peers of every port are found in one
+    /// lookup, taken before the listeners die (their clients would otherwise already be
+    /// closing), and everything is terminated in a single batch.
+    func killPortsDeep(_ ports: [PortInfo]) async {
+        guard !isShowingCachedPorts else { return }
+        var pids = await scanner.findEstablishedPids(for: Set(ports.map(\.port)))
+        // Never take ourselves down with a connection we hold (e.g. a port-forward relay).
+        pids.remove(Int(ProcessInfo.processInfo.processIdentifier))
+        pids.formUnion(ports.map(\.pid))
+
+        let terminated = await scanner.killProcesses(pids: pids)
+        removeRows(ownedBy: terminated.union(ports.map(\.pid)))
         await refresh()
     }
 
     /// Kills all processes currently using ports.
     func killAll() async {
-        for port in ports {
-            _ = await scanner.killProcessGracefully(pid: port.pid)
-        }
-        ports.removeAll()
+        guard !isShowingCachedPorts else { return }
+        let pids = Set(portTable.indices.map { portTable.pid(at: $0) })
+        _ = await scanner.killProcesses(pids: pids)
+        portTable.removeAll()
+        needsPortResync = true
         await refresh()
     }
+
+    /// Optimistically drops the rows of killed processes until the next full scan.
+    private func removeRows(ownedBy pids: Set<Int>) {
+        ports = ports.filter { !pids.contains($0.pid) }
+        needsPortResync = true
+    }
 }
@@ -2,17 +2,13 @@ import Foundation
 import Defaults
 
 extension AppState {
-    /// Checks for new ports matching enabled process type notifications.
-    /// Call after each scan to detect newly appeared ports.
-    func checkProcessTypeNotifications(oldPorts: [PortInfo], newPorts: [PortInfo]) {
+    /// Checks newly appeared ports against enabled process type notifications.
+    /// Call after each scan with the delta's `added` ports.
+    func checkProcessTypeNotifications(addedPorts: [PortInfo]) {
         let enabledTypes = Defaults[.notifyProcessTypes]
         guard !enabledTypes.isEmpty else { return }
 
-        let oldPortPids = Set(oldPorts.map { "\($0.port)-\($0.pid)" })
-
-        for port in newPorts {
-            let key = "\(port.port)-\(port.pid)"
-            guard !oldPortPids.contains(key) else { continue }
+        for port in addedPorts {
             guard enabledTypes.contains(port.processType.rawValue) else { continue }
 
             NotificationService.shared.notify(
@@ -13,8 +13,16 @@ extension Defaults.Keys {
     static let hideSystemProcesses = Key<Bool>("hideSystemProcesses", default: false)
     static let skipKillConfirmation = Key<Bool>("skipKillConfirmation", default: false)
     static let refreshInterval = Key<Int>("refreshInterval", default: 5)
+    static let portScanBackend = Key<PortScanBackend>("portScanBackend", default: .native)
+    static let eventDrivenRefresh = Key<Bool>("eventDrivenRefresh", default: true)
     static let cloudflaredProtocol = Key<CloudflaredProtocol>("cloudflaredProtocol", default: .http2)
 
+    // Log retention: lines kept per tunnel/port-forward, and total memory across all of them.
+    // 500 as tunnels kept before (port forwards kept 100 lines of full objects; now the budget caps them)
+    static let logLinesPerConnection = Key<Int>("logLinesPerConnection", default: 500)
+    static let logMemoryBudgetMB = Key<Int>("logMemoryBudgetMB", default: 32)
+    static let portHistoryLimitMB = Key<Int>("portHistoryLimitMB", default: 64)
+
     // Process type overrides (processName → ProcessType.rawValue)
     static let processTypeOverrides = Key<[String: String]>("processTypeOverrides", default: [:])
 
@@ -36,6 +44,9 @@ extension Defaults.Keys {
     // Onboarding
     static let hasCompletedOnboarding = Key<Bool>("hasCompletedOnboarding", default: false)
 
+    // Debug: adds the performance HUD to the Window menu (no UI toggle, set with `defaults write`)
+    static let showPerformanceHUD = Key<Bool>("showPerformanceHUD", default: false)
+
     // Sponsor-related keys
     static let sponsorCache = Key<SponsorCache?>("sponsorCache", default: nil)
     static let lastSponsorWindowShown = Key<Date?>("lastSponsorWindowShown", default: nil)
@@ -65,8 +76,15 @@ final class AppState {
 
     // MARK: - Port State
 
-    /// All currently scanned ports
-    var ports: [PortInfo] = []
+    /// All currently scanned ports, stored column-wise with interned strings.
+    /// Prefer its index-based accessors (`count`, `count(of:)`, `row(for:)`) in views.
+    var portTable = PortTable()
+
+    /// All currently scanned ports, materialized from `portTable`
+    var ports: [PortInfo] {
+        get { Array(portTable) }
+        set { portTable.replaceAll(with: newValue) }
+    }
 
     /// Whether a port scan is currently in progress
     var isScanning = false
@@ -80,12 +98,12 @@ final class AppState {
     var selectedSidebarItem: SidebarItem = .allPorts
 
     /// ID of the currently selected port in the detail view
-    var selectedPortID: String? = nil
+    var selectedPortID: PortInfo.ID? = nil
 
     /// The currently selected port, if any
     var selectedPort: PortInfo? {
         guard let id = selectedPortID else { return nil }
-        return ports.first { $0.id == id }
+        return portTable[id: id]
     }
 
     /// ID of the currently selected port-forward connection
@@ -106,92 +124,96 @@ final class AppState {
         return portForwardManager.connections.first { $0.id == id }
     }
 
-    // MARK: - Cached Filtered Ports (Memory Optimization)
-
-    /// Cache for filtered ports to avoid repeated allocations
-    @ObservationIgnored private var _cachedFilteredPorts: [PortInfo] = []
-    @ObservationIgnored private var _filterCacheKey: FilterCacheKey?
-
-    /// Cache key to detect when recalculation is needed
-    private struct FilterCacheKey: Equatable {
-        let portsCount: Int
-        let portsHash: Int
-        let sidebarItem: SidebarItem
-        let filterActive: Bool
-        let filterText: String
-        let hideSystem: Bool
-        let favoritesCount: Int
-        let watchedCount: Int
-    }
+    // MARK: - Derived Port Views
+
+    /// Memoized selection → filter → visibility → sort/group stages, see `PortViewPipeline`
+    @ObservationIgnored var pipeline = PortViewPipeline()
+    /// Search haystacks for `portTable`, built on the first search after each scan
+    @ObservationIgnored private var searchIndex: PortSearchIndex?
 
     /// Returns filtered ports based on sidebar selection and active filters.
-    /// Uses caching to avoid repeated array allocations on each access.
+    /// Each stage is recomputed only when its own inputs change.
     var filteredPorts: [PortInfo] {
-        let currentKey = FilterCacheKey(
-            portsCount: ports.count,
-            portsHash: ports.isEmpty ? 0 : ports[0].hashValue ^ ports.count,
-            sidebarItem: selectedSidebarItem,
-            filterActive: filter.isActive,
-            filterText: filter.searchText,
-            hideSystem: Defaults[.hideSystemProcesses],
-            favoritesCount: favorites.count,
-            watchedCount: watchedPorts.count
-        )
-
-        // Return cached value if nothing changed
-        if currentKey == _filterCacheKey {
-            return _cachedFilteredPorts
-        }
-
-        // Recompute and cache
-        _cachedFilteredPorts = computeFilteredPorts()
-        _filterCacheKey = currentKey
-        return _cachedFilteredPorts
+        PerformanceMonitor.shared.measure(.filteredPorts) { computeFilteredPorts() }
     }
 
-    /// Computes filtered ports (called only when cache is invalidated)
     private func computeFilteredPorts() -> [PortInfo] {
-        if case .settings = selectedSidebarItem { return [] }
-
-        var result: [PortInfo]
-
-        switch selectedSidebarItem {
-        case .allPorts, .settings, .sponsors, .kubernetesPortForward, .cloudflareTunnels:
-            result = ports
-        case .favorites:
-            var activePorts = Set<Int>()
-            result = ports.compactMap { port -> PortInfo? in
-                guard favorites.contains(port.port) else { return nil }
-                activePorts.insert(port.port)
-                return port
-            }
-            for favPort in favorites where !activePorts.contains(favPort) {
-                result.append(PortInfo.inactive(port: favPort))
-            }
-        case .watched:
-            let watchedPortNumbers = Set(watchedPorts.map { $0.port })
-            var activePorts = Set<Int>()
-            result = ports.compactMap { port -> PortInfo? in
-                guard watchedPortNumbers.contains(port.port) else { return nil }
-                activePorts.insert(port.port)
-                return port
-            }
-            for watchedPort in watchedPortNumbers where !activePorts.contains(watchedPort) {
-                result.append(PortInfo.inactive(port: watchedPort))
+        let favorites = self.favorites
+        let watchedPorts = self.watchedPorts
+        let watchedNumbers = Set(watchedPorts.map(\.port))
+        let sidebarItem = selectedSidebarItem
+
+        let selected = pipeline.selection.output(for: .init(
+            tableGeneration: portTable.generation,
+            sidebarItem: sidebarItem,
+            favorites: sidebarItem == .favorites ? favorites : [],
+            watched: sidebarItem == .watched ? watchedNumbers : []
+        )) {
+            PortViewPipeline.select(portTable, sidebarItem: sidebarItem, favorites: favorites, watched: watchedNumbers)
+        }
+
+        let filter = self.filter
+        let filtered = pipeline.filtered.output(for: .init(
+            selectionGeneration: pipeline.selection.generation,
+            filter: filter,
+            favorites: filter.showOnlyFavorites ? favorites : [],
+            watched: filter.showOnlyWatched ? watchedNumbers : []
+        )) {
+            guard filter.isActive else { return selected }
+            let searchHits = filter.searchText.isEmpty ? nil : searchMatches(for: filter.searchText)
+            return selected.filter {
+                filter.matches($0, favorites: favorites, watched: watchedPorts, searchHits: searchHits)
             }
-        case .processType(let type):
-            result = ports.filter { $0.processType == type }
         }
 
-        if filter.isActive {
-            result = result.filter { filter.matches($0, favorites: favorites, watched: watchedPorts) }
+        let hideSystem = Defaults[.hideSystemProcesses]
+        return pipeline.visible.output(for: .init(
+            filterGeneration: pipeline.filtered.generation,
+            hideSystemProcesses: hideSystem
+        )) {
+            hideSystem ? filtered.filter { $0.processType != .system } : filtered
         }
+    }
 
-        if Defaults[.hideSystemProcesses] {
-            result = result.filter { $0.processType != .system }
+    /// `filteredPorts` sorted by a table column, memoized per order
+    func sortedFilteredPorts(by order: SortOrder, ascending: Bool) -> [PortInfo] {
+        let visible = filteredPorts
+        let favorites = order == .actions ? self.favorites : []
+        let watched = order == .actions ? Set(watchedPorts.map(\.port)) : []
+
+        let inputs = PortViewPipeline.SortInputs(
+            visibleGeneration: pipeline.visible.generation,
+            order: order,
+            ascending: ascending,
+            favorites: favorites,
+            watched: watched
+        )
+        return pipeline.sorted.output(for: inputs) { previous, previousInputs in
+            guard inputs.hasSameOrder(as: previousInputs) else { return nil }
+            return PortViewPipeline.resort(
+                previous, to: visible, by: order, ascending: ascending, favorites: favorites, watched: watched
+            )
+        } compute: {
+            PortViewPipeline.sort(visible, by: order, ascending: ascending, favorites: favorites, watched: watched)
         }
+    }
 
-        return result
+    /// `filteredPorts` grouped by process for the tree view, alphabetically
+    var filteredProcessGroups: [ProcessGroup] {
+        let visible = filteredPorts
+        return pipeline.groups.output(for: .init(visibleGeneration: pipeline.visible.generation)) { previous, _ in
+            PortViewPipeline.regroup(previous, to: visible)
+        } compute: {
+            PortGroupingService.shared.groupByProcess(visible)
+        }
+    }
+
+    /// IDs of scanned ports matching `query`, from an index rebuilt only when the ports change
+    private func searchMatches(for query: String) -> Set<PortInfo.ID> {
+        if searchIndex?.generation != portTable.generation {
+            searchIndex = PortSearchIndex(table: portTable)
+        }
+        return searchIndex?.matchingIDs(for: query) ?? []
     }
 
     // MARK: - Backward Compatibility Accessors
@@ -219,18 +241,18 @@ final class AppState {
     /// Manages Sparkle auto-update functionality
     let updateManager = UpdateManager()
 
-    /// Manages Kubernetes port-forward connections
-    let portForwardManager = PortForwardManager()
-
-    /// Manages Cloudflare Quick Tunnel connections (ephemeral `*.trycloudflare.com`)
-    let tunnelManager: TunnelManager
-
-    /// Manages persistent (named) Cloudflare tunnels discovered from `~/.cloudflared/`
-    let namedTunnelManager: NamedTunnelManager
+    /// Kubernetes and Cloudflare managers once created, see `AppState+Managers`
+    @ObservationIgnored var loadedPortForwardManager: PortForwardManager?
+    @ObservationIgnored var loadedCloudflaredService: CloudflaredService?
+    @ObservationIgnored var loadedTunnelManager: TunnelManager?
+    @ObservationIgnored var loadedNamedTunnelManager: NamedTunnelManager?
 
     /// Evaluates auto-kill rules against the scanned ports
     let autoKillManager = AutoKillManager()
 
+    /// Persistent open/close timeline of every port, fed by `refresh()`
+    let portHistory = PortHistoryStore()
+
     // MARK: - Internal Properties (for extensions)
 
     /// Port scanning actor
@@ -238,13 +260,23 @@ final class AppState {
 
     /// Background task for auto-refresh
     @ObservationIgnored var refreshTask: Task<Void, Never>?
+    /// Watches listener PIDs for exit/exec to trigger immediate rescans
+    @ObservationIgnored let processEventMonitor = ProcessEventMonitor()
+    /// Consumes `processEventMonitor` events
+    @ObservationIgnored var processEventTask: Task<Void, Never>?
     /// Coalesces concurrent refresh requests into a single follow-up scan.
     @ObservationIgnored var hasPendingRefreshRequest = false
+    /// Set after `ports` is edited locally (e.g. optimistic removal on kill) so the next
+    /// scan replaces the list from its full snapshot instead of applying only the delta.
+    @ObservationIgnored var needsPortResync = false
+    /// Whether `ports` is still the last published snapshot, shown until the first scan;
+    /// its PIDs may have been reused since, so kills wait for that scan
+    var isShowingCachedPorts = false
 
     // MARK: - Initialization
 
     init(
-        scanner: PortScannerProtocol = PortScanner(),
+        scanner: PortScannerProtocol = SharedSnapshotScanner(),
         favoritesState: FavoritesState? = nil,
         watchedPortsState: WatchedPortsState? = nil
     ) {
@@ -252,15 +284,14 @@ final class AppState {
         self.favoritesState = favoritesState ?? FavoritesState()
         self.watchedPortsState = watchedPortsState ?? WatchedPortsState()
 
-        let cloudflared = CloudflaredService()
-        self.tunnelManager = TunnelManager(cloudflaredService: cloudflared)
-        self.namedTunnelManager = NamedTunnelManager(cloudflaredService: cloudflared)
-
+        showPublishedPorts()
         setupKeyboardShortcuts()
-        startAutoRefresh()
+        startAutoRefresh(deferringFirstScan: true)
     }
 
     deinit {
         refreshTask?.cancel()
+        processEventTask?.cancel()
+        processEventMonitor?.invalidate()
     }
 }
@@ -49,6 +49,86 @@ enum AppConstants {
     /// Grace period between SIGTERM and SIGKILL when killing processes
     static let killGracePeriod: Duration = .milliseconds(500)
 
+    /// Delay before rescanning after a watched listener exits
+    static let processExitRescanDelay: Duration = .milliseconds(50)
+
+    /// Quiet period after a watched listener's last exec before rescanning, giving the
+    /// new program time to bind its socket
+    static let processSpawnRescanDelay: Duration = .milliseconds(500)
+
+    /// Longest a burst of execs can postpone its rescan
+    static let processSpawnSettleLimit: Duration = .seconds(3)
+
+    /// Health-check interval for a healthy port-forward connection
+    static let connectionHealthInterval: Duration = .seconds(1)
+
+    /// Upper bound of the health-check backoff for a failing port-forward connection
+    static let connectionHealthMaxBackoff: Duration = .seconds(30)
+
+    /// Connect timeout for one batched pass of port-forward TCP probes
+    static let connectionProbeTimeout: Duration = .milliseconds(750)
+
+    /// How long a new kubectl port-forward may take to print "Forwarding from"
+    static let portForwardReadyTimeout: Duration = .seconds(15)
+
+    /// How long a socat proxy may take to bind its listening port
+    static let proxyReadyTimeout: Duration = .seconds(5)
+
+    /// How long cached Kubernetes discovery results stay fresh without a live watch
+    static let discoveryFreshness: Duration = .seconds(30)
+
+    /// Watched discovery results are still refetched this often, in case the watch
+    /// missed an event
+    static let discoveryWatchedFreshness: Duration = .seconds(600)
+
+    /// Live discovery watches that aren't read for this long are stopped
+    static let discoveryWatchIdleTimeout: Duration = .seconds(300)
+
+    /// Cap on cached Kubernetes service objects across all contexts and namespaces
+    static let discoveryMaxCachedServices: Int = 20_000
+
+    /// Namespaces whose services are kept current by a live watch at the same time
+    static let discoveryMaxServiceWatches: Int = 4
+
+    /// Interval of the local-only rediscovery sweep while the tunnels UI is open, a safety
+    /// net for missed FSEvents. The remote `cloudflared tunnel list` is fetched only on an
+    /// explicit refresh or a change in `~/.cloudflared/`.
+    static let cloudflareLocalSweepInterval: Duration = .seconds(120)
+
+    /// Metrics scrape interval of a named tunnel shown in the detail view
+    static let tunnelMetricsVisibleInterval: Duration = .seconds(2)
+
+    /// Metrics scrape interval of a running named tunnel nobody is looking at; keeps a
+    /// coarse history so the sparklines aren't empty when the view opens
+    static let tunnelMetricsBackgroundInterval: Duration = .seconds(30)
+
+    /// Samples kept per tunnel metric series
+    static let tunnelMetricsHistoryLength: Int = 90
+
+    /// Hard limit on a child run through `ProcessExecutor` (lsof, kubectl, cloudflared, ...)
+    /// before it is killed
+    static let processTimeout: Duration = .seconds(30)
+
+    /// Hard limit on a `brew install`, which downloads and may build from source
+    static let packageInstallTimeout: Duration = .seconds(900)
+
+    /// An unchanged scan still republishes the shared snapshot this often, so readers
+    /// can tell a quiet publisher from a stuck one
+    static let snapshotHeartbeat: Duration = .seconds(30)
+
+    /// A background scanner's snapshot older than this is not trusted over a local scan
+    static let snapshotMaxAge: Duration = .seconds(90)
+
+    /// How long the app waits for the background scanner to answer a rescan request
+    static let snapshotRescanTimeout: Duration = .seconds(1)
+
+    /// How long a kubectl/socat/cloudflared path lookup is trusted before it is re-probed
+    static let dependencyProbeLifetime: Duration = .seconds(30)
+
+    /// Delay before the first scan at launch, so launch at login doesn't compete with
+    /// everything else starting up; the last snapshot, if any, fills the list meanwhile
+    static let launchScanDelay: Duration = .seconds(2)
+
     /// Maximum length for displayed command strings
     static let maxCommandLength: Int = 200
 
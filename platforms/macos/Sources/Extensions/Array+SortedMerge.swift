@@ -0,0 +1,37 @@
+/**
+ * Array+SortedMerge.swift
+ * PortKiller
+ *
+ * Merging of already sorted lists, so a few new rows can be placed into a long
+ * sorted list in one linear pass instead of sorting everything again.
+ */
+
+import Foundation
+
+extension Array {
+    /// Whether the elements are in order by `areInIncreasingOrder`
+    nonisolated func isSorted(by areInIncreasingOrder: (Element, Element) -> Bool) -> Bool {
+        indices.dropFirst().allSatisfy { !areInIncreasingOrder(self[$0], self[$0 - 1]) }
+    }
+
+    /// The elements of this array and `other`, both sorted by `areInIncreasingOrder`,
+    /// as one sorted array; of two equal elements, the one from this array comes first.
+    nonisolated func mergingSorted(_ other: [Element], by areInIncreasingOrder: (Element, Element) -> Bool) -> [Element] {
+        var result: [Element] = []
+        result.reserveCapacity(count + other.count)
+        var index = startIndex
+        var otherIndex = other.startIndex
+        while index < endIndex, otherIndex < other.endIndex {
+            if areInIncreasingOrder(other[otherIndex], self[index]) {
+                result.append(other[otherIndex])
+                otherIndex += 1
+            } else {
+                result.append(self[index])
+                index += 1
+            }
+        }
+        result.append(contentsOf: self[index...])
+        result.append(contentsOf: other[otherIndex...])
+        return result
+    }
+}
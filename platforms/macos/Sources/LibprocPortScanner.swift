@@ -0,0 +1,322 @@
+import Foundation
+import Darwin
+import Defaults
+
+/**
+ * LibprocPortScanner enumerates listening TCP sockets directly from the kernel.
+ *
+ * Instead of spawning `lsof` on every refresh, it walks the process table with libproc:
+ * - `proc_listpids` lists every PID on the system
+ * - `proc_pidinfo(PROC_PIDLISTFDS)` lists each process's file descriptors
+ * - `proc_pidfdinfo(PROC_PIDFDSOCKETINFO)` inspects the socket descriptors
+ *
+ * Cost comparison per scan (~1,500 processes, ~30 listening ports):
+ *   lsof:    fork+exec + full socket table walk + text output + parse = 150–400ms
+ *   libproc: one PROC_PIDLISTFDS per process + one call per socket FD = a few ms
+ *
+ * Results go through the same `PortInfo.active` construction as `PortScanner`'s lsof
+ * parser, so callers cannot tell the backends apart. Process metadata is cached per
+ * (pid, start time), so steady-state scans only pay for socket enumeration.
+ *
+ * When `Defaults[.portScanBackend]` is `.lsof`, or the process table cannot be read,
+ * scans fall back to `PortScanner`. Process termination is delegated to it as well.
+ */
+actor LibprocPortScanner: PortScannerProtocol {
+
+    /// A listening socket owned by a single process
+    private typealias ListeningSocket = (port: Int, address: String, fd: String)
+
+    /// Extra slots allocated beyond the reported size, for PIDs/FDs created between calls
+    nonisolated private static let allocationHeadroom = 32
+
+    /// Buffer size for `proc_name` (2 × MAXCOMLEN + NUL)
+    nonisolated private static let processNameCapacity = 2 * Int(MAXCOMLEN) + 1
+
+    /// Buffer size for `getpwuid_r` string storage
+    nonisolated private static let passwdBufferSize = 1024
+
+    /// lsof-based scanner used as fallback and for kill operations
+    private let lsofScanner = PortScanner()
+
+    /// Per-process metadata kept across scans, keyed by (pid, start time)
+    private var metadataCache = ProcessMetadataCache()
+
+    /// UID → login name, resolved once per UID for the lifetime of the scanner
+    private var userNames: [uid_t: String] = [:]
+
+    /// Previous snapshot for `scanDelta()`
+    private var differ = PortSnapshotDiffer()
+
+    /**
+     * Scans all listening TCP ports using libproc, falling back to lsof.
+     *
+     * @returns Array of PortInfo objects representing all listening ports
+     */
+    func scanPorts() async -> [PortInfo] {
+        guard Defaults[.portScanBackend] == .native,
+              let ports = PerformanceMonitor.shared.measure(.socketEnumeration, { enumerateListeningPorts() }) else {
+            return await lsofScanner.scanPorts()
+        }
+        return ports
+    }
+
+    /**
+     * Scans ports and returns only what changed since the previous `scanDelta()` call.
+     *
+     * @returns Delta against the previous scan, including the full current snapshot
+     */
+    func scanDelta() async -> PortScanDelta {
+        let ports = await scanPorts()
+        return differ.delta(for: ports)
+    }
+
+    func killProcess(pid: Int, force: Bool = false) async -> Bool {
+        await lsofScanner.killProcess(pid: pid, force: force)
+    }
+
+    func killProcessGracefully(pid: Int) async -> Bool {
+        await lsofScanner.killProcessGracefully(pid: pid)
+    }
+
+    func killProcesses(pids: Set<Int>) async -> Set<Int> {
+        await lsofScanner.killProcesses(pids: pids)
+    }
+
+    func findEstablishedPids(for port: Int) async -> Set<Int> {
+        await findEstablishedPids(for: [port])
+    }
+
+    /// Walks every process's sockets once for connections on any of `ports`, instead of
+    /// one `lsof` per port. Falls back to lsof like `scanPorts()`.
+    func findEstablishedPids(for ports: Set<Int>) async -> Set<Int> {
+        guard !ports.isEmpty else { return [] }
+        guard Defaults[.portScanBackend] == .native, let pids = Self.allPids() else {
+            return await lsofScanner.findEstablishedPids(for: ports)
+        }
+        return Set(pids.filter { Self.hasEstablishedConnection(pid: $0, ports: ports) }.map(Int.init))
+    }
+
+    // MARK: - Enumeration
+
+    /// Walks every process and collects its listening TCP sockets.
+    /// Returns nil if the process table itself cannot be read.
+    ///
+    /// Only socket enumeration runs for every process; name, argv, user and type are
+    /// resolved once per (pid, start time) and served from `metadataCache` afterwards.
+    private func enumerateListeningPorts() -> [PortInfo]? {
+        guard let pids = Self.allPids() else { return nil }
+
+        metadataCache.validate(overrides: Defaults[.processTypeOverrides])
+        let classifier = metadataCache.classifier
+
+        var ports: [PortInfo] = []
+        var live = Set<ProcessIdentity>()
+
+        for pid in pids {
+            let sockets = Self.listeningSockets(for: pid)
+            guard !sockets.isEmpty else { continue }
+
+            let identity = ProcessInspector.identity(of: Int(pid))
+            if let identity { live.insert(identity) }
+
+            let metadata: ProcessMetadata
+            if let identity, let cached = metadataCache[identity] {
+                metadata = cached
+            } else {
+                metadata = resolveMetadata(for: pid, classifier: classifier)
+                if let identity { metadataCache.insert(metadata, for: identity) }
+            }
+
+            // Avoid duplicates (same port + pid), e.g. separate IPv4 and IPv6 listeners
+            var seenPorts = Set<Int>()
+            for socket in sockets where seenPorts.insert(socket.port).inserted {
+                ports.append(PortInfo.active(
+                    port: socket.port,
+                    pid: Int(pid),
+                    address: socket.address,
+                    fd: socket.fd,
+                    metadata: metadata
+                ))
+            }
+        }
+
+        metadataCache.retainOnly(live)
+        return ports.sorted { $0.port < $1.port }
+    }
+
+    /// Reads name, owner and argv for a process not yet in the cache.
+    private func resolveMetadata(for pid: pid_t, classifier: ProcessClassifier) -> ProcessMetadata {
+        let processName = Self.processName(for: pid) ?? "\(pid)"
+
+        let user: String
+        if let uid = Self.ownerUID(of: pid) {
+            if let cached = userNames[uid] {
+                user = cached
+            } else {
+                user = Self.userName(for: uid)
+                userNames[uid] = user
+            }
+        } else {
+            user = "-"
+        }
+
+        return ProcessMetadata.resolve(
+            processName: processName,
+            command: PerformanceMonitor.shared.measure(.commandLine) {
+                ProcessInspector.commandLine(for: Int(pid))
+            } ?? processName,
+            user: user,
+            classifier: classifier
+        )
+    }
+
+    /// Lists every PID on the system via `proc_listpids(PROC_ALL_PIDS)`.
+    nonisolated private static func allPids() -> [pid_t]? {
+        let needed = proc_listpids(UInt32(PROC_ALL_PIDS), 0, nil, 0)
+        guard needed > 0 else { return nil }
+
+        let stride = MemoryLayout<pid_t>.stride
+        let capacity = Int(needed) / stride + allocationHeadroom
+        var pids = [pid_t](repeating: 0, count: capacity)
+        let written = pids.withUnsafeMutableBytes { buffer in
+            proc_listpids(UInt32(PROC_ALL_PIDS), 0, buffer.baseAddress, Int32(buffer.count))
+        }
+        guard written > 0 else { return nil }
+
+        return pids.prefix(min(Int(written) / stride, capacity)).filter { $0 > 0 }
+    }
+
+    /// Returns the listening TCP sockets held by `pid` (empty if access is denied).
+    nonisolated private static func listeningSockets(for pid: pid_t) -> [ListeningSocket] {
+        socketDescriptors(of: pid).compactMap { listeningSocket(pid: pid, fd: $0) }
+    }
+
+    /// Whether `pid` holds an ESTABLISHED TCP connection whose local or remote port is in
+    /// `ports` (the same sockets `lsof -iTCP:<port> -sTCP:ESTABLISHED` lists).
+    nonisolated private static func hasEstablishedConnection(pid: pid_t, ports: Set<Int>) -> Bool {
+        socketDescriptors(of: pid).contains { fd in
+            guard let tcp = tcpSocketInfo(pid: pid, fd: fd),
+                  tcp.tcpsi_state == Int32(TSI_S_ESTABLISHED) else { return false }
+            let local = Int(UInt16(bigEndian: UInt16(truncatingIfNeeded: tcp.tcpsi_ini.insi_lport)))
+            let remote = Int(UInt16(bigEndian: UInt16(truncatingIfNeeded: tcp.tcpsi_ini.insi_fport)))
+            return ports.contains(local) || ports.contains(remote)
+        }
+    }
+
+    /// Socket file descriptors of `pid` (empty if access is denied).
+    nonisolated private static func socketDescriptors(of pid: pid_t) -> [Int32] {
+        let needed = proc_pidinfo(pid, PROC_PIDLISTFDS, 0, nil, 0)
+        guard needed > 0 else { return [] }
+
+        let stride = MemoryLayout<proc_fdinfo>.stride
+        var fds = [proc_fdinfo](repeating: proc_fdinfo(), count: Int(needed) / stride + allocationHeadroom)
+        let written = fds.withUnsafeMutableBytes { buffer in
+            proc_pidinfo(pid, PROC_PIDLISTFDS, 0, buffer.baseAddress, Int32(buffer.count))
+        }
+        guard written > 0 else { return [] }
+
+        return fds.prefix(Int(written) / stride)
+            .filter { $0.proc_fdtype == UInt32(PROX_FDTYPE_SOCKET) }
+            .map(\.proc_fd)
+    }
+
+    /// TCP details of a socket FD, or nil if it is not a TCP socket.
+    nonisolated private static func tcpSocketInfo(pid: pid_t, fd: Int32) -> tcp_sockinfo? {
+        var info = socket_fdinfo()
+        let size = Int32(MemoryLayout<socket_fdinfo>.size)
+        guard proc_pidfdinfo(pid, fd, PROC_PIDFDSOCKETINFO, &info, size) == size else { return nil }
+        guard info.psi.soi_kind == Int32(SOCKINFO_TCP) else { return nil }
+        return info.psi.soi_proto.pri_tcp
+    }
+
+    /// Inspects a single socket FD, returning it only if it is a TCP listener.
+    nonisolated private static func listeningSocket(pid: pid_t, fd: Int32) -> ListeningSocket? {
+        var info = socket_fdinfo()
+        let size = Int32(MemoryLayout<socket_fdinfo>.size)
+        guard proc_pidfdinfo(pid, fd, PROC_PIDFDSOCKETINFO, &info, size) == size else { return nil }
+        guard info.psi.soi_kind == Int32(SOCKINFO_TCP) else { return nil }
+
+        let tcp = info.psi.soi_proto.pri_tcp
+        guard tcp.tcpsi_state == Int32(TSI_S_LISTEN) else { return nil }
+
+        // insi_lport holds the port in network byte order
+        let port = Int(UInt16(bigEndian: UInt16(truncatingIfNeeded: tcp.tcpsi_ini.insi_lport)))
+        guard port > 0 else { return nil }
+
+        return (port, formatAddress(tcp.tcpsi_ini), "\(fd)\(accessMode(info.pfi.fi_openflags))")
+    }
+
+    // MARK: - Formatting
+
+    /// Formats a local address the way `lsof -n` prints it: "127.0.0.1", "[::1]" or "*".
+    nonisolated private static func formatAddress(_ ini: in_sockinfo) -> String {
+        if ini.insi_vflag & UInt8(INI_IPV4) != 0 {
+            var addr = ini.insi_laddr.ina_46.i46a_addr4
+            guard addr.s_addr != 0 else { return "*" }
+            return presentationAddress(family: AF_INET, address: &addr, length: INET_ADDRSTRLEN) ?? "*"
+        }
+
+        var addr6 = ini.insi_laddr.ina_6
+        let isWildcard = withUnsafeBytes(of: addr6) { $0.allSatisfy { $0 == 0 } }
+        guard !isWildcard,
+              let text = presentationAddress(family: AF_INET6, address: &addr6, length: INET6_ADDRSTRLEN) else {
+            return "*"
+        }
+        return "[\(text)]"
+    }
+
+    /// Converts a binary address to text via `inet_ntop`.
+    nonisolated private static func presentationAddress(
+        family: Int32,
+        address: UnsafeRawPointer,
+        length: Int32
+    ) -> String? {
+        var buffer = [CChar](repeating: 0, count: Int(length))
+        guard inet_ntop(family, address, &buffer, socklen_t(length)) != nil else { return nil }
+        return String(decoding: buffer.prefix { $0 != 0 }.map { UInt8(bitPattern: $0) }, as: UTF8.self)
+    }
+
+    /// lsof-style access mode suffix for the FD column ("u" read/write, "r" read, "w" write).
+    nonisolated private static func accessMode(_ openFlags: UInt32) -> String {
+        switch (openFlags & UInt32(FREAD) != 0, openFlags & UInt32(FWRITE) != 0) {
+        case (true, true): return "u"
+        case (true, false): return "r"
+        case (false, true): return "w"
+        case (false, false): return ""
+        }
+    }
+
+    // MARK: - Process Metadata
+
+    /// Reads the process name via `proc_name` (no lsof-style escaping needed).
+    nonisolated private static func processName(for pid: pid_t) -> String? {
+        var buffer = [CChar](repeating: 0, count: processNameCapacity)
+        let length = proc_name(pid, &buffer, UInt32(buffer.count))
+        guard length > 0 else { return nil }
+        return String(decoding: buffer.prefix(Int(length)).map { UInt8(bitPattern: $0) }, as: UTF8.self)
+    }
+
+    /// Reads the owning UID via `proc_pidinfo(PROC_PIDT_SHORTBSDINFO)`.
+    nonisolated private static func ownerUID(of pid: pid_t) -> uid_t? {
+        var info = proc_bsdshortinfo()
+        let size = Int32(MemoryLayout<proc_bsdshortinfo>.size)
+        guard proc_pidinfo(pid, PROC_PIDT_SHORTBSDINFO, 0, &info, size) == size else { return nil }
+        return info.pbsi_uid
+    }
+
+    /// Resolves a UID to a login name, falling back to the numeric UID like lsof does.
+    nonisolated private static func userName(for uid: uid_t) -> String {
+        var entry = passwd()
+        var result: UnsafeMutablePointer<passwd>?
+        var buffer = [CChar](repeating: 0, count: passwdBufferSize)
+
+        return buffer.withUnsafeMutableBufferPointer { storage in
+            guard getpwuid_r(uid, &entry, storage.baseAddress, storage.count, &result) == 0,
+                  result != nil,
+                  let name = entry.pw_name else {
+                return String(uid)
+            }
+            return String(cString: name)
+        }
+    }
+}
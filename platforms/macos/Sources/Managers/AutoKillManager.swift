@@ -1,65 +1,209 @@
 import Foundation
 import Defaults
 
-/// Evaluates auto-kill rules against the current port list and kills ports that have
-/// been listening longer than their rule's timeout.
+/// Tracks listening ports against the auto-kill rules and kills each one when its
+/// rule's timeout elapses.
 ///
 /// Extracted from `AppState` so the first-seen tracking is instance state (not a global
 /// static) and the notification dependency is injectable.
+///
+/// Rules are matched once per port, when it is first seen (or when the rules change):
+/// by process name through a compiled `ProcessClassifier`, and by port through an index.
+/// The resulting deadline goes into a heap, and a single timer sleeps until the earliest
+/// one, so kills happen at the deadline rather than on the next refresh, whatever the
+/// refresh interval.
 @MainActor
 final class AutoKillManager {
-    /// Tracks when each port was first seen (`"port-pid"` → first seen date).
-    private var portFirstSeen: [String: Date] = [:]
+    /// A port being tracked, with the rule that will kill it
+    private struct TrackedPort {
+        let port: PortInfo
+        let firstSeen: ContinuousClock.Instant
+        /// Index into `rules` of the rule to apply, nil if none matches
+        var rule: Int?
+        var deadline: ContinuousClock.Instant?
+    }
+
+    private var tracked: [PortKey: TrackedPort] = [:]
+    private var deadlines = DeadlineHeap<PortKey>()
+
+    /// Enabled rules the indices below were built from
+    private var rules: [AutoKillRule] = []
+    /// Matches rules with a process pattern by name
+    private var classifier = ProcessClassifier()
+    /// Rules without a process pattern, by port
+    private var rulesByPort: [Int: [Int]] = [:]
+
+    private var timerTask: Task<Void, Never>?
+    private var armedDeadline: ContinuousClock.Instant?
+    /// Kill callback from the latest `check(ports:kill:)`
+    private var kill: ((PortInfo) -> Void)?
 
+    private let clock = ContinuousClock()
     private let notificationService: any NotificationServiceProtocol
+    /// Every saved rule, enabled or not
+    private let savedRules: () -> [AutoKillRule]
+    /// Real length of a timeout minute; tests shorten it
+    private let minute: Duration
 
-    init(notificationService: any NotificationServiceProtocol = NotificationService.shared) {
+    init(
+        notificationService: any NotificationServiceProtocol = NotificationService.shared,
+        rules: @escaping () -> [AutoKillRule] = { Defaults[.autoKillRules] },
+        minute: Duration = .seconds(60)
+    ) {
         self.notificationService = notificationService
+        self.savedRules = rules
+        self.minute = minute
     }
 
-    /// Checks auto-kill rules against `ports`, invoking `kill` for matches that exceed
-    /// their timeout. `kill` is called at most once per matching port.
+    /// Updates tracking from the latest scan and (re)arms the kill timer. `kill` is
+    /// called once per port whose rule timeout elapses, at the deadline.
     func check(ports: [PortInfo], kill: @escaping (PortInfo) -> Void) {
-        let enabledRules = Defaults[.autoKillRules].filter(\.isEnabled)
-        guard !enabledRules.isEmpty else { return }
+        PerformanceMonitor.shared.measure(.autoKillCheck) {
+            update(with: ports, kill: kill)
+        }
+    }
 
-        let now = Date()
+    private func update(with ports: [PortInfo], kill: @escaping (PortInfo) -> Void) {
+        self.kill = kill
+        reloadRulesIfChanged()
+        guard !rules.isEmpty else { return }
 
-        // Update first-seen tracking: drop ports that are gone, stamp newly seen ones.
-        let currentKeys = Set(ports.map(Self.key))
-        portFirstSeen = portFirstSeen.filter { currentKeys.contains($0.key) }
+        let now = clock.now
+        var present = Set<PortKey>(minimumCapacity: ports.count)
         for port in ports {
-            let key = Self.key(for: port)
-            if portFirstSeen[key] == nil {
-                portFirstSeen[key] = now
+            let key = port.key
+            present.insert(key)
+            if tracked[key] == nil {
+                track(port, key: key, firstSeen: now)
             }
         }
+        // Every present port is tracked, so equal counts mean nothing is gone.
+        if tracked.count != present.count {
+            tracked = tracked.filter { present.contains($0.key) }
+            compactDeadlinesIfNeeded()
+        }
 
-        for port in ports {
-            let key = Self.key(for: port)
-            guard let firstSeen = portFirstSeen[key] else { continue }
+        armTimer()
+    }
+
+    // MARK: - Rules
+
+    /// Rebuilds the rule indices and re-matches tracked ports if the enabled rules changed.
+    /// First-seen times are kept, so editing a rule doesn't restart anyone's timeout.
+    private func reloadRulesIfChanged() {
+        let enabledRules = savedRules().filter(\.isEnabled)
+        guard enabledRules != rules else { return }
+
+        rules = enabledRules
+        classifier = ProcessClassifier(rules: enabledRules)
+        rulesByPort = [:]
+        for (index, rule) in enabledRules.enumerated() where rule.processPattern.isEmpty && rule.port > 0 {
+            rulesByPort[rule.port, default: []].append(index)
+        }
+
+        deadlines.removeAll()
+        guard !rules.isEmpty else {
+            tracked.removeAll()
+            cancelTimer()
+            return
+        }
+        let existing = tracked
+        tracked.removeAll(keepingCapacity: true)
+        for (key, entry) in existing {
+            track(entry.port, key: key, firstSeen: entry.firstSeen)
+        }
+    }
+
+    /// The rule that fires first for `port`: shortest timeout, then rule order, matching
+    /// the rule a per-scan check would have applied once the timeout elapsed.
+    private func applicableRule(for port: PortInfo) -> Int? {
+        var candidates = classifier.classification(for: port.processName).matchingRules
+            .filter { rules[$0].matchesPort(port.port) }
+        candidates.append(contentsOf: rulesByPort[port.port] ?? [])
+        return candidates.min { a, b in
+            (rules[a].timeoutMinutes, a) < (rules[b].timeoutMinutes, b)
+        }
+    }
+
+    private func track(_ port: PortInfo, key: PortKey, firstSeen: ContinuousClock.Instant) {
+        var entry = TrackedPort(port: port, firstSeen: firstSeen)
+        if let rule = applicableRule(for: port) {
+            let deadline = firstSeen + minute * rules[rule].timeoutMinutes
+            entry.rule = rule
+            entry.deadline = deadline
+            deadlines.insert(key, deadline: deadline)
+        }
+        tracked[key] = entry
+    }
 
-            for rule in enabledRules where rule.matches(port) {
-                let elapsedMinutes = now.timeIntervalSince(firstSeen) / 60.0
-                guard elapsedMinutes >= Double(rule.timeoutMinutes) else { continue }
+    // MARK: - Timer
 
-                if rule.notifyBeforeKill {
-                    notificationService.notify(
-                        title: "Auto-Kill: \(port.processName)",
-                        body: "Port \(port.port) killed after \(rule.timeoutMinutes) min (rule: \(rule.name))"
-                    )
-                }
+    /// Makes sure the timer sleeps until the earliest live deadline.
+    private func armTimer() {
+        discardStaleHead()
+        guard let next = deadlines.first?.deadline else {
+            cancelTimer()
+            return
+        }
+        guard next != armedDeadline else { return }
 
-                kill(port)
+        timerTask?.cancel()
+        armedDeadline = next
+        timerTask = Task { [weak self, clock] in
+            try? await Task.sleep(until: next, clock: clock)
+            guard !Task.isCancelled else { return }
+            self?.fireDueDeadlines()
+        }
+    }
+
+    private func cancelTimer() {
+        timerTask?.cancel()
+        timerTask = nil
+        armedDeadline = nil
+    }
 
-                // Stop tracking so the rule doesn't re-trigger on the next scan.
-                portFirstSeen.removeValue(forKey: key)
-                break // Only the first matching rule applies.
+    /// Kills every port whose deadline has passed, then re-arms for the next one.
+    private func fireDueDeadlines() {
+        armedDeadline = nil
+        reloadRulesIfChanged()
+
+        let now = clock.now
+        while let head = deadlines.first, head.deadline <= now {
+            deadlines.popFirst()
+            guard let entry = tracked[head.key], entry.deadline == head.deadline,
+                  let ruleIndex = entry.rule else { continue }
+            let rule = rules[ruleIndex]
+            let port = entry.port
+
+            if rule.notifyBeforeKill {
+                notificationService.notify(
+                    title: "Auto-Kill: \(port.processName)",
+                    body: "Port \(port.port) killed after \(rule.timeoutMinutes) min (rule: \(rule.name))"
+                )
             }
+
+            kill?(port)
+
+            // Stop tracking so the rule doesn't re-trigger; a survivor is re-tracked
+            // (with a fresh timeout) on the next scan.
+            tracked.removeValue(forKey: head.key)
+        }
+
+        armTimer()
+    }
+
+    // MARK: - Private Helpers
+
+    /// Pops entries for ports that are gone or were rescheduled.
+    private func discardStaleHead() {
+        while let head = deadlines.first, tracked[head.key]?.deadline != head.deadline {
+            deadlines.popFirst()
         }
     }
 
-    private static func key(for port: PortInfo) -> String {
-        "\(port.port)-\(port.pid)"
+    /// Rebuilds the heap once entries for departed ports outnumber the live ones.
+    private func compactDeadlinesIfNeeded() {
+        guard deadlines.count > 2 * tracked.count + 64 else { return }
+        deadlines.removeAll { tracked[$0.key]?.deadline != $0.deadline }
     }
 }
@@ -0,0 +1,507 @@
+import Foundation
+
+// MARK: - Discovery Change
+
+/// Published when cached discovery data changes (revalidation or a watch event).
+/// `isComplete` is false for partial lists published while a fetch is still streaming.
+enum KubernetesDiscoveryChange: Sendable {
+    case namespaces([KubernetesNamespace], isComplete: Bool)
+    case services(namespace: String, [KubernetesService], isComplete: Bool)
+}
+
+// MARK: - Kubernetes Discovery Cache
+
+/// Namespaces and services per kube context, served from memory.
+///
+/// Reads are stale-while-revalidate: a cached list is returned immediately and, if it is
+/// older than `AppConstants.discoveryFreshness` (or the caller asks), refreshed in the
+/// background. After a list is fetched, a long-lived watch started from the list's
+/// `resourceVersion` keeps it current incrementally, without missing changes made between
+/// the list and the watch. A watched entry is still refetched after
+/// `AppConstants.discoveryWatchedFreshness`, in case an event was lost. Changes are
+/// published on `changes()`.
+///
+/// Cached service objects are capped at `AppConstants.discoveryMaxCachedServices`
+/// (least recently read namespaces are evicted first) and only the most recently read
+/// namespaces keep a service watch. Watches nobody reads are stopped after
+/// `AppConstants.discoveryWatchIdleTimeout`.
+actor KubernetesDiscoveryCache {
+
+    /// A cached list and the watch stream that keeps it current
+    enum Key: Hashable, Sendable {
+        case namespaces(context: String)
+        case services(context: String, namespace: String)
+
+        var context: String {
+            switch self {
+            case .namespaces(let context), .services(let context, _): context
+            }
+        }
+    }
+
+    private struct Entry<Value> {
+        var value: Value
+        var fetchedAt: ContinuousClock.Instant
+        var lastAccess: ContinuousClock.Instant
+    }
+
+    /// A running watch and its partially received JSON object
+    private struct Watch {
+        let process: Process
+        let generation: UUID
+        var lastAccess: ContinuousClock.Instant
+        var pendingObject = ""
+        var depth = 0
+    }
+
+    private struct EventType: Decodable {
+        let type: String
+    }
+
+    /// How long the resolved kube context is trusted before asking kubectl again
+    private static let contextTTL: Duration = .seconds(10)
+
+    /// Minimum spacing of partial-list updates while a fetch streams in
+    private static let partialPublishInterval: Duration = .milliseconds(100)
+
+    private let processManager: PortForwardProcessManager
+    private var context: (name: String, resolvedAt: ContinuousClock.Instant)?
+
+    private var namespaceEntries: [Key: Entry<[KubernetesNamespace]>] = [:]
+    private var serviceEntries: [Key: Entry<[KubernetesService]>] = [:]
+    private var namespaceLoads: [Key: Task<KubernetesList<KubernetesNamespace>, Error>] = [:]
+    private var serviceLoads: [Key: Task<KubernetesList<KubernetesService>, Error>] = [:]
+
+    private var watches: [Key: Watch] = [:]
+    private let outputReader = ChildOutputReader<Key>()
+    private var outputTask: Task<Void, Never>?
+    private var sweepTask: Task<Void, Never>?
+
+    private var subscribers: [UUID: AsyncStream<KubernetesDiscoveryChange>.Continuation] = [:]
+
+    init(processManager: PortForwardProcessManager) {
+        self.processManager = processManager
+    }
+
+    // MARK: - Reads
+
+    /// Changes to cached data for the current context.
+    func changes() -> AsyncStream<KubernetesDiscoveryChange> {
+        let (stream, continuation) = AsyncStream.makeStream(of: KubernetesDiscoveryChange.self)
+        let id = UUID()
+        subscribers[id] = continuation
+        continuation.onTermination = { [weak self] _ in
+            Task { await self?.removeSubscriber(id) }
+        }
+        return stream
+    }
+
+    /// Namespaces of the current context; cached if available.
+    /// - Parameter revalidate: Refresh in the background even if the cache is fresh
+    func namespaces(revalidate: Bool = false) async throws -> [KubernetesNamespace] {
+        let context = await currentContext()
+        let key = Key.namespaces(context: context)
+
+        guard var entry = namespaceEntries[key] else {
+            return try await loadNamespaces(key)
+        }
+
+        entry.lastAccess = .now
+        namespaceEntries[key] = entry
+        touchWatch(key)
+        if revalidate || isStale(entry.fetchedAt, key: key) {
+            Task { _ = try? await self.loadNamespaces(key) }
+        }
+        return entry.value
+    }
+
+    /// Services in `namespace` of the current context; cached if available.
+    /// - Parameter revalidate: Refresh in the background even if the cache is fresh
+    func services(in namespace: String, revalidate: Bool = false) async throws -> [KubernetesService] {
+        let context = await currentContext()
+        let key = Key.services(context: context, namespace: namespace)
+
+        guard var entry = serviceEntries[key] else {
+            return try await loadServices(key)
+        }
+
+        entry.lastAccess = .now
+        serviceEntries[key] = entry
+        touchWatch(key)
+        if revalidate || isStale(entry.fetchedAt, key: key) {
+            Task { _ = try? await self.loadServices(key) }
+        }
+        return entry.value
+    }
+
+    /// Stops every watch; cached lists are kept and revalidated on next read.
+    func stopWatching() {
+        for key in Array(watches.keys) {
+            stopWatch(key)
+        }
+    }
+
+    // MARK: - Loading
+
+    private func loadNamespaces(_ key: Key) async throws -> [KubernetesNamespace] {
+        if let load = namespaceLoads[key] {
+            return try await load.value.items
+        }
+
+        let processManager = self.processManager
+        let context = key.context
+        let (progress, continuation) = AsyncStream.makeStream(of: [KubernetesNamespace].self)
+        let load = Task {
+            defer { continuation.finish() }
+            return try await processManager.fetchNamespaces(context: context) { continuation.yield($0) }
+        }
+        namespaceLoads[key] = load
+        defer { namespaceLoads[key] = nil }
+
+        let publisher = Task {
+            await self.publishProgress(progress, for: key, by: { $0.name < $1.name }) {
+                .namespaces($0, isComplete: false)
+            }
+        }
+        let result = await load.result
+        await publisher.value
+        let list = try result.get()
+        let value = list.items
+
+        let now = ContinuousClock.now
+        namespaceEntries[key] = Entry(value: value, fetchedAt: now, lastAccess: now)
+        restartWatch(key, from: list.resourceVersion)
+        publish(.namespaces(value, isComplete: true), for: key)
+        return value
+    }
+
+    private func loadServices(_ key: Key) async throws -> [KubernetesService] {
+        guard case .services(let context, let namespace) = key else { return [] }
+        if let load = serviceLoads[key] {
+            return try await load.value.items
+        }
+
+        let processManager = self.processManager
+        let (progress, continuation) = AsyncStream.makeStream(of: [KubernetesService].self)
+        let load = Task {
+            defer { continuation.finish() }
+            return try await processManager.fetchServices(namespace: namespace, context: context) {
+                continuation.yield($0)
+            }
+        }
+        serviceLoads[key] = load
+        defer { serviceLoads[key] = nil }
+
+        let publisher = Task {
+            await self.publishProgress(progress, for: key, by: { $0.name < $1.name }) {
+                .services(namespace: namespace, $0, isComplete: false)
+            }
+        }
+        let result = await load.result
+        await publisher.value
+        let list = try result.get()
+        let value = list.items
+
+        let now = ContinuousClock.now
+        serviceEntries[key] = Entry(value: value, fetchedAt: now, lastAccess: now)
+        enforceServiceCap(keeping: key)
+        restartWatch(key, from: list.resourceVersion)
+        publish(.services(namespace: namespace, value, isComplete: true), for: key)
+        return value
+    }
+
+    private func isStale(_ fetchedAt: ContinuousClock.Instant, key: Key) -> Bool {
+        let freshness = watches[key] == nil ? AppConstants.discoveryFreshness : AppConstants.discoveryWatchedFreshness
+        return ContinuousClock.now - fetchedAt > freshness
+    }
+
+    /// Resolves kubectl's current context, dropping watches of a context we switched away from.
+    private func currentContext() async -> String {
+        if let context, ContinuousClock.now - context.resolvedAt < Self.contextTTL {
+            return context.name
+        }
+
+        // No context configured: key by "" and let the list fetch report the error
+        let name = (try? await processManager.currentContext()) ?? ""
+        if let previous = context?.name, previous != name {
+            for key in watches.keys where key.context == previous {
+                stopWatch(key)
+            }
+        }
+        context = (name, .now)
+        return name
+    }
+
+    /// Evicts least recently read namespaces until the service cap is met.
+    private func enforceServiceCap(keeping key: Key) {
+        var total = serviceEntries.values.reduce(0) { $0 + $1.value.count }
+        while total > AppConstants.discoveryMaxCachedServices,
+              let victim = serviceEntries.filter({ $0.key != key }).min(by: { $0.value.lastAccess < $1.value.lastAccess }) {
+            total -= victim.value.value.count
+            serviceEntries[victim.key] = nil
+            stopWatch(victim.key)
+        }
+    }
+
+    // MARK: - Watches
+
+    /// Replaces any watch of `key` with one continuing from the list just fetched.
+    private func restartWatch(_ key: Key, from resourceVersion: String?) {
+        stopWatch(key)
+        startWatch(key, from: resourceVersion)
+    }
+
+    /// Watches `key` from `resourceVersion` through the raw API, so events between the
+    /// list and the watch are delivered too. Without a version (an old server or an
+    /// unexpected response), falls back to `kubectl get --watch-only`, which starts
+    /// from now.
+    private func startWatch(_ key: Key, from resourceVersion: String?) {
+        guard watches[key] == nil, let kubectlPath = DependencyChecker.shared.kubectlPath else { return }
+
+        let path: String
+        var arguments: [String]
+        switch key {
+        case .namespaces:
+            path = "/api/v1/namespaces"
+            arguments = ["get", "namespaces"]
+        case .services(_, let namespace):
+            path = "/api/v1/namespaces/\(namespace)/services"
+            arguments = ["get", "services", "-n", namespace]
+            limitServiceWatches()
+        }
+        if let resourceVersion {
+            arguments = ["get", "--raw", "\(path)?watch=1&allowWatchBookmarks=true&resourceVersion=\(resourceVersion)"]
+        } else {
+            arguments += ["--watch-only", "--output-watch-events", "-o", "json"]
+        }
+        arguments += PortForwardProcessManager.contextArguments(key.context)
+
+        let process = Process()
+        process.executableURL = URL(fileURLWithPath: kubectlPath)
+        process.arguments = arguments
+        let pipe = Pipe()
+        process.standardOutput = pipe
+        process.standardError = FileHandle.nullDevice
+
+        let generation = UUID()
+        do {
+            try process.run()
+        } catch {
+            return
+        }
+        ChildProcessSupervisor.shared.supervise(process) { [weak self] _ in
+            Task { await self?.watchEnded(key, generation: generation) }
+        }
+
+        watches[key] = Watch(process: process, generation: generation, lastAccess: .now)
+        outputReader.attach(pipe, key: key)
+        startReadingWatches()
+        startSweeping()
+    }
+
+    /// Keeps at most `discoveryMaxServiceWatches - 1` service watches before a new one starts.
+    private func limitServiceWatches() {
+        let serviceWatches = watches.filter {
+            if case .services = $0.key { return true }
+            return false
+        }
+        guard serviceWatches.count >= AppConstants.discoveryMaxServiceWatches else { return }
+
+        let excess = serviceWatches.count - AppConstants.discoveryMaxServiceWatches + 1
+        for (key, _) in serviceWatches.sorted(by: { $0.value.lastAccess < $1.value.lastAccess }).prefix(excess) {
+            stopWatch(key)
+        }
+    }
+
+    private func touchWatch(_ key: Key) {
+        watches[key]?.lastAccess = .now
+    }
+
+    private func stopWatch(_ key: Key) {
+        guard let watch = watches.removeValue(forKey: key) else { return }
+        outputReader.detach(key)
+        if watch.process.isRunning {
+            watch.process.terminate()
+        }
+    }
+
+    private func watchEnded(_ key: Key, generation: UUID) {
+        guard watches[key]?.generation == generation else { return }
+        // Without a watch the entry ages normally and is revalidated on a stale read
+        stopWatch(key)
+    }
+
+    private func startReadingWatches() {
+        guard outputTask == nil else { return }
+        let batches = outputReader.batches
+        outputTask = Task { [weak self] in
+            for await batch in batches {
+                await self?.handleWatchOutput(batch)
+            }
+        }
+    }
+
+    /// Stops watches nobody has read for a while.
+    private func startSweeping() {
+        guard sweepTask == nil else { return }
+        sweepTask = Task { [weak self] in
+            while !Task.isCancelled {
+                try? await Task.sleep(for: .seconds(60))
+                guard let self, await self.sweepIdleWatches() else { break }
+            }
+        }
+    }
+
+    /// Returns false once no watches are left, ending the sweep task.
+    private func sweepIdleWatches() -> Bool {
+        let now = ContinuousClock.now
+        for (key, watch) in watches where now - watch.lastAccess > AppConstants.discoveryWatchIdleTimeout {
+            stopWatch(key)
+        }
+        if watches.isEmpty {
+            sweepTask = nil
+            return false
+        }
+        return true
+    }
+
+    // MARK: - Watch Events
+
+    /// Reassembles kubectl's pretty-printed event objects from lines and applies them.
+    private func handleWatchOutput(_ batch: ChildOutputBatch<Key>) {
+        guard var watch = watches[batch.key] else { return }
+
+        var objects: [String] = []
+        for line in batch.lines {
+            watch.pendingObject += line
+            watch.pendingObject += "\n"
+            watch.depth += Self.braceDelta(line)
+            if watch.depth <= 0 {
+                objects.append(watch.pendingObject)
+                watch.pendingObject = ""
+                watch.depth = 0
+            }
+        }
+        watches[batch.key] = watch
+
+        for object in objects {
+            apply(Data(object.utf8), to: batch.key)
+        }
+    }
+
+    private func apply(_ event: Data, to key: Key) {
+        let decoder = JSONDecoder()
+        guard let type = try? decoder.decode(EventType.self, from: event).type else { return }
+
+        if type == "ERROR" {
+            // Usually "resource version too old": drop the watch and refetch on next read
+            stopWatch(key)
+            namespaceEntries[key]?.fetchedAt = .now - AppConstants.discoveryFreshness * 2
+            serviceEntries[key]?.fetchedAt = .now - AppConstants.discoveryFreshness * 2
+            return
+        }
+
+        switch key {
+        case .namespaces:
+            guard var entry = namespaceEntries[key],
+                  let item = try? decoder.decode(
+                      KubernetesWatchEvent<KubernetesNamespace.ListResponse.Item>.self, from: event
+                  ).object else { return }
+            let namespace = KubernetesNamespace(name: item.metadata.name)
+            guard Self.apply(type, namespace, to: &entry.value) else { return }
+            namespaceEntries[key] = entry
+            publish(.namespaces(entry.value, isComplete: true), for: key)
+
+        case .services(_, let namespace):
+            guard var entry = serviceEntries[key],
+                  let item = try? decoder.decode(
+                      KubernetesWatchEvent<KubernetesService.ListResponse.Item>.self, from: event
+                  ).object else { return }
+            guard Self.apply(type, KubernetesService.from(item: item), to: &entry.value) else { return }
+            serviceEntries[key] = entry
+            publish(.services(namespace: namespace, entry.value, isComplete: true), for: key)
+        }
+    }
+
+    /// Applies one event to a name-sorted list; returns whether the list changed.
+    private static func apply<Item: Identifiable & Equatable>(_ type: String, _ item: Item, to items: inout [Item]) -> Bool
+    where Item.ID: Comparable {
+        let index = items.firstIndex { $0.id >= item.id }
+        let isPresent = index.map { items[$0].id == item.id } ?? false
+
+        switch type {
+        case "ADDED", "MODIFIED":
+            if isPresent, let index {
+                guard items[index] != item else { return false }
+                items[index] = item
+            } else {
+                items.insert(item, at: index ?? items.endIndex)
+            }
+            return true
+        case "DELETED":
+            guard isPresent, let index else { return false }
+            items.remove(at: index)
+            return true
+        default:
+            return false
+        }
+    }
+
+    /// Net `{`/`}` count of a line, ignoring braces inside JSON strings.
+    /// JSON strings can't contain raw newlines, so each line is scanned on its own.
+    private static func braceDelta(_ line: String) -> Int {
+        var delta = 0
+        var inString = false
+        var escaped = false
+        for byte in line.utf8 {
+            if inString {
+                if escaped {
+                    escaped = false
+                } else if byte == UInt8(ascii: "\\") {
+                    escaped = true
+                } else if byte == UInt8(ascii: "\"") {
+                    inString = false
+                }
+            } else if byte == UInt8(ascii: "\"") {
+                inString = true
+            } else if byte == UInt8(ascii: "{") {
+                delta += 1
+            } else if byte == UInt8(ascii: "}") {
+                delta -= 1
+            }
+        }
+        return delta
+    }
+
+    // MARK: - Publishing
+
+    /// Publishes what a streaming fetch has decoded so far, throttled to
+    /// `partialPublishInterval`, until the fetch finishes.
+    private func publishProgress<Item: Sendable>(
+        _ progress: AsyncStream<[Item]>,
+        for key: Key,
+        by areInIncreasingOrder: (Item, Item) -> Bool,
+        change: ([Item]) -> KubernetesDiscoveryChange
+    ) async {
+        var received: [Item] = []
+        var lastPublish = ContinuousClock.now
+        for await batch in progress {
+            received.append(contentsOf: batch)
+            if ContinuousClock.now - lastPublish >= Self.partialPublishInterval {
+                lastPublish = .now
+                publish(change(received.sorted(by: areInIncreasingOrder)), for: key)
+            }
+        }
+    }
+
+    private func publish(_ change: KubernetesDiscoveryChange, for key: Key) {
+        guard key.context == context?.name else { return }
+        for continuation in subscribers.values {
+            continuation.yield(change)
+        }
+    }
+
+    private func removeSubscriber(_ id: UUID) {
+        subscribers[id] = nil
+    }
+}
@@ -27,15 +27,28 @@ final class KubernetesDiscoveryManager: Identifiable {
     var namespaceState: KubernetesDiscoveryState = .idle
     var serviceState: KubernetesDiscoveryState = .idle
 
-    private let processManager: PortForwardProcessManager
+    private let cache: KubernetesDiscoveryCache
+    @ObservationIgnored private var changesTask: Task<Void, Never>?
+
+    init(cache: KubernetesDiscoveryCache) {
+        self.cache = cache
+        changesTask = Task { [weak self] in
+            for await change in await cache.changes() {
+                guard let self else { break }
+                self.apply(change)
+            }
+        }
+    }
 
-    init(processManager: PortForwardProcessManager) {
-        self.processManager = processManager
+    deinit {
+        changesTask?.cancel()
     }
 
     // MARK: - Actions
 
-    func loadNamespaces() async {
+    /// Loads namespaces, served from the cache when possible.
+    /// - Parameter revalidate: Also refresh from the cluster in the background
+    func loadNamespaces(revalidate: Bool = false) async {
         namespaceState = .loading
         namespaces = []
         services = []
@@ -44,20 +57,8 @@ final class KubernetesDiscoveryManager: Identifiable {
         selectedPort = nil
 
         do {
-            let fetchedNamespaces = try await processManager.fetchNamespaces()
-            // Merge with custom namespaces
-            let customNamespaceNames = Defaults[.customNamespaces]
-            let customNamespaces = customNamespaceNames.map { KubernetesNamespace(name: $0, isCustom: true) }
-
-            // Combine and remove duplicates (prefer auto-fetched over custom)
-            var combinedNamespaces = fetchedNamespaces
-            for customNS in customNamespaces {
-                if !combinedNamespaces.contains(where: { $0.name == customNS.name }) {
-                    combinedNamespaces.append(customNS)
-                }
-            }
-
-            namespaces = combinedNamespaces.sorted { $0.name < $1.name }
+            let fetchedNamespaces = try await cache.namespaces(revalidate: revalidate)
+            namespaces = Self.mergingCustomNamespaces(into: fetchedNamespaces)
             namespaceState = .loaded
         } catch {
             // On error, fall back to custom namespaces only
@@ -81,14 +82,62 @@ final class KubernetesDiscoveryManager: Identifiable {
         serviceState = .loading
 
         do {
-            services = try await processManager.fetchServices(namespace: namespace.name)
+            let fetched = try await cache.services(in: namespace.name)
+            // The user may have picked another namespace while this one loaded
+            guard selectedNamespace == namespace else { return }
+            services = fetched
             serviceState = .loaded
         } catch {
+            guard selectedNamespace == namespace else { return }
             let message = (error as? KubectlError)?.errorDescription ?? error.localizedDescription
             serviceState = .error(message)
         }
     }
 
+    /// Applies a background refresh, watch event or partial list from the cache.
+    private func apply(_ change: KubernetesDiscoveryChange) {
+        switch change {
+        case .namespaces(let fetched, isComplete: false):
+            // Show namespaces as they stream in; a background refresh keeps the old list
+            guard namespaceState == .loading else { return }
+            namespaces = Self.mergingCustomNamespaces(into: fetched)
+
+        case .namespaces(let fetched, isComplete: true):
+            guard namespaceState == .loaded else { return }
+            namespaces = Self.mergingCustomNamespaces(into: fetched)
+            if let selected = selectedNamespace, !namespaces.contains(selected) {
+                selectedNamespace = nil
+                selectedService = nil
+                selectedPort = nil
+                services = []
+                serviceState = .idle
+            }
+
+        case .services(let namespace, let fetched, isComplete: false):
+            guard selectedNamespace?.name == namespace, serviceState == .loading else { return }
+            services = fetched
+
+        case .services(let namespace, let fetched, isComplete: true):
+            guard selectedNamespace?.name == namespace, serviceState == .loaded else { return }
+            services = fetched
+            if let selected = selectedService {
+                selectedService = fetched.first { $0.id == selected.id }
+                if let port = selectedPort, selectedService?.ports.contains(port) != true {
+                    selectedPort = selectedService?.ports.first
+                }
+            }
+        }
+    }
+
+    /// Adds custom namespaces not reported by the cluster (auto-fetched ones win).
+    private static func mergingCustomNamespaces(into fetched: [KubernetesNamespace]) -> [KubernetesNamespace] {
+        var combinedNamespaces = fetched
+        for name in Defaults[.customNamespaces] where !combinedNamespaces.contains(where: { $0.name == name }) {
+            combinedNamespaces.append(KubernetesNamespace(name: name, isCustom: true))
+        }
+        return combinedNamespaces.sorted { $0.name < $1.name }
+    }
+
     func selectService(_ service: KubernetesService) {
         selectedService = service
         selectedPort = service.ports.first
@@ -27,7 +27,16 @@ final class NamedTunnelManager {
 
     private let cloudflaredService: CloudflaredService
     private let discoveryService: CloudflaredDiscoveryService
+    private let metricsScraper = CloudflaredMetricsScraper()
     @ObservationIgnored private var refreshTask: Task<Void, Never>?
+    /// FSEvents on `~/.cloudflared/` while the tunnels UI is visible
+    @ObservationIgnored private var configWatchTask: Task<Void, Never>?
+    /// `refreshRemote` of a discovery requested while one was running, nil if none
+    @ObservationIgnored private var pendingDiscovery: Bool?
+    @ObservationIgnored private var metricsTask: Task<Void, Never>?
+    /// Open detail views per tunnel ID; those tunnels are scraped at the fast interval
+    @ObservationIgnored private var metricsViewers: [String: Int] = [:]
+    @ObservationIgnored private var nextMetricsScrape: [String: ContinuousClock.Instant] = [:]
 
     init(
         cloudflaredService: CloudflaredService,
@@ -39,6 +48,8 @@ final class NamedTunnelManager {
 
     deinit {
         refreshTask?.cancel()
+        configWatchTask?.cancel()
+        metricsTask?.cancel()
     }
 
     /// Start best-effort discovery while the Cloudflare Tunnels UI is visible.
@@ -46,16 +57,20 @@ final class NamedTunnelManager {
     /// We avoid doing this from app launch because `cloudflared tunnel list` can hit
     /// the user's Cloudflare account, and that should only happen when the user
     /// opens tunnel management UI or explicitly refreshes.
+    ///
+    /// Local files are watched with FSEvents and re-read only when they change; the
+    /// remote list is refreshed only on an explicit refresh or when a credentials file
+    /// changes. A slow local-only sweep covers missed file events.
     func startRefreshing() {
         discoverIfNeeded()
+        startWatchingConfigDirectory()
         guard refreshTask == nil else { return }
 
         refreshTask = Task { [weak self] in
             while !Task.isCancelled {
-                try? await Task.sleep(for: .seconds(30))
+                try? await Task.sleep(for: AppConstants.cloudflareLocalSweepInterval)
                 guard let self = self else { return }
-                if self.isDiscovering { continue }
-                await self.discoverAsync()
+                await self.discoverAsync(refreshRemote: false)
             }
         }
     }
@@ -63,6 +78,28 @@ final class NamedTunnelManager {
     func stopRefreshing() {
         refreshTask?.cancel()
         refreshTask = nil
+        configWatchTask?.cancel()
+        configWatchTask = nil
+    }
+
+    /// Rediscovers when something in `~/.cloudflared/` changes. A `config.yml` edit only
+    /// re-reads local files; new or removed credentials (`tunnel create` / `delete`) or a
+    /// new login also refresh the remote list. No-op if the directory doesn't exist yet.
+    private func startWatchingConfigDirectory() {
+        guard configWatchTask == nil,
+              let watcher = DirectoryWatcher(directory: discoveryService.configDirectory) else { return }
+
+        configWatchTask = Task { [weak self] in
+            for await paths in watcher.changes {
+                guard !Task.isCancelled, let self else { break }
+                let touchesAccount = paths.contains { path in
+                    let name = (path as NSString).lastPathComponent
+                    return name.hasSuffix(".json") || name == "cert.pem"
+                }
+                await self.discoverAsync(refreshRemote: touchesAccount)
+            }
+            watcher.invalidate()
+        }
     }
 
     // MARK: - Computed
@@ -122,9 +159,10 @@ final class NamedTunnelManager {
 
     // MARK: - Discovery
 
+    /// `force` also refreshes the remote tunnel list, even if the cached one is fresh.
     func discover(force: Bool = false) {
         guard force || !isDiscovering else { return }
-        Task { await discoverAsync() }
+        Task { await discoverAsync(refreshRemote: force) }
     }
 
     func discoverIfNeeded() {
@@ -132,18 +170,34 @@ final class NamedTunnelManager {
         discover()
     }
 
-    func discoverAsync() async {
-        guard !isDiscovering else { return }
-        isDiscovering = true
-        defer {
-            isDiscovering = false
-            hasDiscovered = true
+    func discoverAsync(refreshRemote: Bool = false) async {
+        guard !isDiscovering else {
+            // Run once more afterwards, so a change seen mid-discovery isn't lost
+            pendingDiscovery = refreshRemote || pendingDiscovery == true
+            return
         }
+        isDiscovering = true
 
         let cloudflaredPath = cloudflaredService.cloudflaredPath
-        let discovered = await discoveryService.discover(cloudflaredPath: cloudflaredPath)
+        let discovered = await discoveryService.discover(cloudflaredPath: cloudflaredPath, refreshRemote: refreshRemote)
+        merge(discovered)
+
+        isDiscovering = false
+        hasDiscovered = true
+
+        if let pendingRefreshRemote = pendingDiscovery {
+            pendingDiscovery = nil
+            await discoverAsync(refreshRemote: pendingRefreshRemote)
+        }
+    }
 
-        // Merge with existing tunnels, preserving runtime state for ones we're currently running.
+    /// Merges discovery results into `tunnels` in place, preserving runtime state for
+    /// ones we're currently running.
+    ///
+    /// Existing tunnel objects are updated rather than replaced, and only properties
+    /// whose value changed are written, so views observing an unchanged tunnel aren't
+    /// invalidated. `tunnels` itself is reassigned only if the set or order of tunnels changed.
+    private func merge(_ discovered: [DiscoveredTunnel]) {
         var existingByID: [String: NamedCloudflareTunnel] = [:]
         for t in tunnels { existingByID[t.tunnelID] = t }
 
@@ -152,18 +206,18 @@ final class NamedTunnelManager {
             let tunnel: NamedCloudflareTunnel
             if let existing = existingByID[d.tunnelID] {
                 tunnel = existing
-                tunnel.credentialsPath = d.credentialsPath
+                tunnel.updateIfChanged(\.credentialsPath, to: d.credentialsPath)
                 // While we're running the tunnel ourselves, the live connection state
                 // comes from log parsing (`activeConnectionCount`). Don't let a background
                 // `tunnel list` refresh clobber `edgeConnections` / ingress out from under
                 // a running or starting tunnel — leave its runtime-derived state intact.
                 let isLocallyActive = existing.status == .running || existing.status == .starting
                 if !isLocallyActive {
-                    tunnel.edgeConnections = d.edgeConnections
+                    tunnel.updateIfChanged(\.edgeConnections, to: d.edgeConnections)
                     // Only overwrite ingress from config.yml if we haven't picked up a runtime version.
                     if tunnel.ingressSource != .runtimeLog, !d.localIngress.isEmpty {
-                        tunnel.ingressRules = d.localIngress
-                        tunnel.ingressSource = .localConfig
+                        tunnel.updateIfChanged(\.ingressRules, to: d.localIngress)
+                        tunnel.updateIfChanged(\.ingressSource, to: .localConfig)
                     }
                 }
             } else {
@@ -179,7 +233,7 @@ final class NamedTunnelManager {
             // even if a later runtime config replaces ingressRules. Otherwise we'd misclassify
             // it as `.managedElsewhere` after it connects and acquires its own edge connections.
             if !d.localIngress.isEmpty {
-                tunnel.hasLocalConfigMatch = true
+                tunnel.updateIfChanged(\.hasLocalConfigMatch, to: true)
             }
             merged.append(tunnel)
         }
@@ -191,7 +245,10 @@ final class NamedTunnelManager {
             }
         }
 
-        tunnels = merged.sorted { $0.name.localizedCaseInsensitiveCompare($1.name) == .orderedAscending }
+        merged.sort { $0.name.localizedCaseInsensitiveCompare($1.name) == .orderedAscending }
+        if !merged.elementsEqual(tunnels, by: ===) {
+            tunnels = merged
+        }
     }
 
     // MARK: - Run / Stop
@@ -211,6 +268,7 @@ final class NamedTunnelManager {
         tunnel.lastError = nil
         tunnel.metricsPort = nil
         tunnel.activeConnectionCount = 0
+        tunnel.metrics = TunnelMetrics()
 
         Task { [weak self, weak tunnel] in
             guard let self = self, let tunnel = tunnel else { return }
@@ -251,16 +309,87 @@ final class NamedTunnelManager {
         }
     }
 
+    // MARK: - Metrics
+
+    /// Marks a tunnel's metrics as on screen (calls must be balanced). Visible tunnels are
+    /// scraped every `tunnelMetricsVisibleInterval`, others every
+    /// `tunnelMetricsBackgroundInterval`.
+    func setMetricsVisible(_ isVisible: Bool, for tunnelID: String) {
+        let viewers = (metricsViewers[tunnelID] ?? 0) + (isVisible ? 1 : -1)
+        metricsViewers[tunnelID] = viewers > 0 ? viewers : nil
+        guard isVisible else { return }
+
+        // Fresh numbers now rather than at the end of a background interval
+        nextMetricsScrape[tunnelID] = nil
+        metricsTask?.cancel()
+        metricsTask = nil
+        startMetricsScraping()
+    }
+
+    /// Starts the scrape loop unless it runs already; it ends once no tunnel has metrics.
+    private func startMetricsScraping() {
+        guard metricsTask == nil else { return }
+        metricsTask = Task { [weak self] in
+            while !Task.isCancelled, let wake = await self?.scrapeDueMetrics() {
+                try? await Task.sleep(until: wake, clock: .continuous)
+            }
+        }
+    }
+
+    /// Scrapes every running tunnel whose turn has come, concurrently.
+    /// - Returns: When the next tunnel is due, or nil if no tunnel exposes metrics.
+    private func scrapeDueMetrics() async -> ContinuousClock.Instant? {
+        let targets = tunnels.compactMap { tunnel in
+            tunnel.runID != nil ? tunnel.metricsPort.map { (tunnel: tunnel, port: $0) } : nil
+        }
+        nextMetricsScrape = nextMetricsScrape.filter { entry in targets.contains { $0.tunnel.tunnelID == entry.key } }
+        guard !targets.isEmpty else {
+            // A cancelled loop must not clear its replacement
+            if !Task.isCancelled { metricsTask = nil }
+            return nil
+        }
+
+        let now = ContinuousClock.now
+        let due = targets.filter { (nextMetricsScrape[$0.tunnel.tunnelID] ?? now) <= now }
+        let scraper = metricsScraper
+        let snapshots = await withTaskGroup(of: (Int, CloudflaredMetricsSnapshot?).self) { group in
+            for port in due.map(\.port) {
+                group.addTask { (port, await scraper.scrape(port: port)) }
+            }
+            var snapshots: [Int: CloudflaredMetricsSnapshot] = [:]
+            for await (port, snapshot) in group {
+                snapshots[port] = snapshot
+            }
+            return snapshots
+        }
+
+        let scrapedAt = ContinuousClock.now
+        for target in due {
+            // A restarted tunnel gets a new metrics port and a fresh history
+            guard target.tunnel.metricsPort == target.port else { continue }
+            if let snapshot = snapshots[target.port] {
+                target.tunnel.metrics.record(snapshot, at: scrapedAt)
+            }
+            let isVisible = metricsViewers[target.tunnel.tunnelID] != nil
+            nextMetricsScrape[target.tunnel.tunnelID] = scrapedAt + (isVisible
+                ? AppConstants.tunnelMetricsVisibleInterval
+                : AppConstants.tunnelMetricsBackgroundInterval)
+        }
+        return targets.map { nextMetricsScrape[$0.tunnel.tunnelID] ?? scrapedAt }.min()
+    }
+
     // MARK: - Internal
 
     private func startNamedTunnel(runID: UUID, tunnel: NamedCloudflareTunnel) async {
         // Log handler: capture every line, parse for state transitions.
-        let logHandler: @Sendable (String) -> Void = { [weak self, weak tunnel] line in
-            let entry = TunnelLogEntry.parse(line)
+        let logHandler: @Sendable ([String]) -> Void = { [weak self, weak tunnel] lines in
+            let classified = lines.map { (message: $0, level: TunnelLogEntry.level(of: $0)) }
             Task { @MainActor [weak self, weak tunnel] in
                 guard let tunnel = tunnel else { return }
-                tunnel.addLogEntry(entry)
-                self?.applyLogLine(line, to: tunnel)
+                tunnel.addLogLines(classified)
+                for line in lines {
+                    self?.applyLogLine(line, to: tunnel)
+                }
             }
         }
         await cloudflaredService.setLogHandler(for: runID, handler: logHandler)
@@ -279,21 +408,9 @@ final class NamedTunnelManager {
         do {
             let process = try await cloudflaredService.runNamedTunnel(id: runID, tunnelName: tunnel.name)
             tunnel.startedAt = Date()
-            // Give it ~3s to register at least one connection; otherwise leave it in .starting and
-            // let log parsing flip to .running when "Registered tunnel connection" arrives.
-            try? await Task.sleep(for: .seconds(3))
-
-            if !process.isRunning && tunnel.status != .running {
-                await cloudflaredService.removeHandlers(for: runID)
-                tunnel.status = .error
-                if tunnel.lastError == nil {
-                    tunnel.lastError = "cloudflared exited unexpectedly"
-                }
-                tunnel.runID = nil
-                return
-            }
-
-            await monitorProcess(process, runID: runID, tunnel: tunnel)
+            // Stays .starting until log parsing sees "Registered tunnel connection".
+            let exit = await ChildProcessSupervisor.shared.exit(of: process)
+            await processDidExit(exit, runID: runID, tunnel: tunnel)
         } catch {
             await cloudflaredService.removeHandlers(for: runID)
             tunnel.status = .error
@@ -302,24 +419,26 @@ final class NamedTunnelManager {
         }
     }
 
-    private func monitorProcess(_ process: Process, runID: UUID, tunnel: NamedCloudflareTunnel) async {
-        while process.isRunning && !Task.isCancelled {
-            try? await Task.sleep(for: .seconds(1))
-        }
-
+    /// Settles the tunnel's state once its cloudflared exits (reported by the kernel, not polled).
+    private func processDidExit(_ exit: ChildExit, runID: UUID, tunnel: NamedCloudflareTunnel) async {
         guard tunnel.runID == runID else { return }
         await cloudflaredService.removeHandlers(for: runID)
 
+        let wasRunning = tunnel.status == .running
         tunnel.runID = nil
         tunnel.activeConnectionCount = 0
         tunnel.metricsPort = nil
 
-        if tunnel.status == .stopping || process.terminationStatus == 0 {
+        if tunnel.status == .stopping || (wasRunning && exit.isSuccess) {
             tunnel.status = .stopped
         } else {
             tunnel.status = .error
             if tunnel.lastError == nil {
-                tunnel.lastError = "cloudflared exited with status \(process.terminationStatus)"
+                if wasRunning, let status = exit.status {
+                    tunnel.lastError = "cloudflared exited with status \(status)"
+                } else {
+                    tunnel.lastError = "cloudflared exited unexpectedly"
+                }
             }
         }
     }
@@ -341,6 +460,7 @@ final class NamedTunnelManager {
         if line.contains("Starting metrics server on"),
            let port = parseMetricsPort(from: line) {
             tunnel.metricsPort = port
+            startMetricsScraping()
         }
 
         // Runtime ingress config from the dashboard arrives as:
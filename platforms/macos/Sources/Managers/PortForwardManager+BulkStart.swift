@@ -0,0 +1,79 @@
+import Foundation
+import Darwin
+import Defaults
+
+extension PortForwardManager {
+    /// Brings up `states` as one pipeline.
+    ///
+    /// 1. One listener scan covers every local and proxy port of the batch; whatever still
+    ///    holds one of them (typically a kubectl or socat left over from an earlier run)
+    ///    is killed before anything is spawned, instead of each child failing with
+    ///    "address already in use" and recovering one by one.
+    /// 2. kubectl children are launched in parallel, at most `portForwardStartConcurrency`
+    ///    at a time. A slot is held until the child reports "Forwarding from" (or fails),
+    ///    so the limit bounds concurrent kubectl handshakes rather than spawns alone.
+    ///
+    /// The post-spawn conflict handler stays in place for ports taken after the scan.
+    func startConnections(_ states: [PortForwardConnectionState]) async {
+        await reclaimPorts(for: states)
+
+        let limit = max(1, Defaults[.portForwardStartConcurrency])
+        var launched = Set<UUID>()
+        await withTaskGroup(of: Void.self) { group in
+            var running = 0
+            for state in states {
+                if running >= limit {
+                    await group.next()
+                    running -= 1
+                }
+                guard !Task.isCancelled else { break }
+                // Skip connections stopped or removed while queued
+                guard connection(for: state.id) === state, state.portForwardStatus == .connecting,
+                      state.portForwardTask == nil, !isKillingProcesses else { continue }
+
+                let task = launchConnection(state)
+                launched.insert(state.id)
+                group.addTask { await task.value }
+                running += 1
+            }
+        }
+
+        // `startAll()` held the queue as connecting; release whatever the pipeline skipped
+        // (cancelled, or a kill began), which neither the monitor nor `startConnection`
+        // would ever pick up otherwise
+        for state in states where !launched.contains(state.id) && state.portForwardStatus == .connecting
+            && state.portForwardTask == nil {
+            state.portForwardStatus = .disconnected
+        }
+    }
+
+    /// Kills whatever listens on the ports `states` are about to bind, found with one scan.
+    /// Listeners owned by this app (in-process relays of other connections) are left alone.
+    private func reclaimPorts(for states: [PortForwardConnectionState]) async {
+        var owners: [Int: PortForwardConnectionState] = [:]
+        for state in states {
+            let isDirectExec = state.config.useDirectExec && state.config.proxyPort != nil
+            if !isDirectExec {
+                owners[state.config.localPort] = state
+            }
+            if let proxyPort = state.config.proxyPort {
+                owners[proxyPort] = state
+            }
+        }
+        guard !owners.isEmpty else { return }
+
+        let ownPid = Int(getpid())
+        let occupied = await scanner.scanPorts().filter { port in
+            port.isActive && port.pid != ownPid && owners[port.port] != nil
+        }
+        guard !occupied.isEmpty else { return }
+
+        for port in occupied {
+            owners[port.port]?.appendLog(
+                "Port \(port.port) held by \(port.processName) (\(port.pid)), freeing before start",
+                type: .portForward
+            )
+        }
+        await processManager.killProcesses(pids: Set(occupied.map { Int32($0.pid) }))
+    }
+}
@@ -3,6 +3,9 @@ import Defaults
 
 extension PortForwardManager {
     /// Runs the port forward process for a connection.
+    ///
+    /// The forward counts as connected once kubectl prints "Forwarding from". If that line
+    /// never shows up in time but the child is alive, a probe of the local port decides.
     func runPortForward(for state: PortForwardConnectionState, config: PortForwardConnectionConfig) async {
         // Direct exec mode: don't use kubectl port-forward, start exec proxy directly
         if config.useDirectExec, config.proxyPort != nil {
@@ -18,10 +21,22 @@ extension PortForwardManager {
                 localPort: config.localPort,
                 remotePort: config.remotePort
             )
+            state.markStartup(\.spawn)
 
-            try await Task.sleep(for: .seconds(2))
+            var isReady = await processManager.waitUntilReady(
+                for: state.id,
+                timeout: AppConstants.portForwardReadyTimeout
+            )
+            guard !Task.isCancelled else { return }
+            if !isReady && process.isRunning {
+                isReady = await PortHealthChecker.probe(
+                    ports: [config.localPort],
+                    timeout: AppConstants.connectionProbeTimeout
+                )[config.localPort]?.isOpen == true
+            }
 
-            if process.isRunning {
+            if isReady && process.isRunning {
+                state.markStartup(\.ready)
                 state.portForwardStatus = .connected
 
                 if config.proxyPort != nil {
@@ -57,10 +72,17 @@ extension PortForwardManager {
                 externalPort: proxyPort,
                 remotePort: config.remotePort
             )
+            state.markStartup(\.spawn)
 
-            try await Task.sleep(for: .seconds(1))
+            // kubectl runs per client connection here, so socat's listener is the readiness signal
+            let isListening = await PortHealthChecker.waitUntilOpen(
+                port: proxyPort,
+                timeout: AppConstants.proxyReadyTimeout
+            )
+            guard !Task.isCancelled else { return }
 
-            if process.isRunning {
+            if isListening && process.isRunning {
+                state.markStartup(\.proxyReady)
                 state.proxyStatus = .connected
                 sendConnectNotificationIfEnabled(for: config)
             } else {
@@ -75,10 +97,33 @@ extension PortForwardManager {
         }
     }
 
-    /// Runs the socat proxy process.
+    /// Starts the proxy for a connection: the in-process relay, or socat when opted into.
     func runProxy(for state: PortForwardConnectionState, config: PortForwardConnectionConfig) async {
         guard let proxyPort = config.proxyPort else { return }
 
+        if Defaults[.portForwardUseSocatProxy] {
+            await runSocatProxy(for: state, config: config, proxyPort: proxyPort)
+            return
+        }
+
+        do {
+            // Ready once the listener is bound; no start-up delay to wait out
+            try await processManager.startRelay(
+                id: state.id,
+                externalPort: proxyPort,
+                internalPort: config.localPort
+            )
+            state.markStartup(\.proxyReady)
+            state.proxyStatus = .connected
+            sendConnectNotificationIfEnabled(for: config)
+        } catch {
+            state.proxyStatus = .error
+            state.lastError = error.localizedDescription
+        }
+    }
+
+    /// Runs the socat proxy process.
+    private func runSocatProxy(for state: PortForwardConnectionState, config: PortForwardConnectionConfig, proxyPort: Int) async {
         do {
             let process = try await processManager.startProxy(
                 id: state.id,
@@ -86,9 +131,14 @@ extension PortForwardManager {
                 internalPort: config.localPort
             )
 
-            try await Task.sleep(for: .seconds(1))
+            let isListening = await PortHealthChecker.waitUntilOpen(
+                port: proxyPort,
+                timeout: AppConstants.proxyReadyTimeout
+            )
+            guard !Task.isCancelled else { return }
 
-            if process.isRunning {
+            if isListening && process.isRunning {
+                state.markStartup(\.proxyReady)
                 state.proxyStatus = .connected
                 sendConnectNotificationIfEnabled(for: config)
             } else {
@@ -1,5 +1,48 @@
 import Foundation
 
+/// When a connection is next due for a health check. Failing connections back off
+/// exponentially so a dead endpoint isn't hammered (or re-spawned) every second.
+struct ConnectionHealthSchedule {
+    var nextCheck: ContinuousClock.Instant = .now
+    var consecutiveFailures = 0
+
+    mutating func recordHealthy(at now: ContinuousClock.Instant) {
+        consecutiveFailures = 0
+        nextCheck = now + AppConstants.connectionHealthInterval
+    }
+
+    mutating func recordFailure(at now: ContinuousClock.Instant) {
+        consecutiveFailures += 1
+        let backoff = AppConstants.connectionHealthInterval * (1 << min(consecutiveFailures - 1, 5))
+        nextCheck = now + min(backoff, AppConstants.connectionHealthMaxBackoff)
+    }
+
+    /// Checks again next interval without touching the failure count, so a connection
+    /// that fails on every reconnect still backs off
+    mutating func recordPending(at now: ContinuousClock.Instant) {
+        nextCheck = now + AppConstants.connectionHealthInterval
+    }
+}
+
+/// Outcome of one health check
+enum ConnectionHealth {
+    /// Connected, and every probed port answered
+    case healthy
+    /// Found broken; a reconnect was started
+    case failed
+    /// Still connecting or restarting, so not evaluated
+    case pending
+}
+
+/// Health of one connection, gathered once per monitoring tick
+struct ConnectionProbe: Sendable {
+    let processRunning: Bool
+    let hasRecentError: Bool
+    /// nil when the port wasn't probed (connection not marked connected)
+    let portOpen: Bool?
+    let proxyOpen: Bool?
+}
+
 extension PortForwardManager {
     /// Starts the connection monitoring task.
     func startMonitoring() {
@@ -12,7 +55,7 @@ extension PortForwardManager {
         monitorTask = Task {
             while !Task.isCancelled && isMonitoring {
                 await checkConnections()
-                try? await Task.sleep(for: .seconds(1))
+                await sleepUntilNextCheck()
             }
         }
     }
@@ -22,118 +65,231 @@ extension PortForwardManager {
         isMonitoring = false
         monitorTask?.cancel()
         monitorTask = nil
+        monitorSleep?.cancel()
+    }
+
+    /// Checks a connection right away when one of its children dies, rather than on the
+    /// next tick. Exits arrive from `ChildProcessSupervisor`, so liveness needs no polling;
+    /// the tick remains for port probes. Connections in backoff keep their schedule.
+    func childDidExit(_ id: UUID) {
+        guard isMonitoring, (healthSchedules[id]?.consecutiveFailures ?? 0) == 0 else { return }
+        healthSchedules[id]?.nextCheck = .now
+        if let monitorSleep {
+            monitorSleep.cancel()
+        } else {
+            isMonitorWakeRequested = true
+        }
+    }
+
+    /// Sleeps one health interval, or until `childDidExit` cuts it short.
+    private func sleepUntilNextCheck() async {
+        guard !isMonitorWakeRequested else {
+            isMonitorWakeRequested = false
+            return
+        }
+        let sleeper = Task { try? await Task.sleep(for: AppConstants.connectionHealthInterval) }
+        monitorSleep = sleeper
+        await sleeper.value
+        monitorSleep = nil
     }
 
-    /// Checks all connections and reconnects if needed.
+    /// Checks all due connections and reconnects if needed.
+    ///
+    /// Every due connection's ports are probed together in one non-blocking pass
+    /// (`PortHealthChecker.probe`), so a tick costs at most one probe timeout no matter
+    /// how many connections there are. Results are then applied on the main actor.
     func checkConnections() async {
         guard !isKillingProcesses else { return }
+        await PerformanceMonitor.shared.measure(.connectionCheck) {
+            await performConnectionChecks()
+        }
+    }
+
+    private func performConnectionChecks() async {
+        let now = ContinuousClock.now
+
         // Take a snapshot to avoid data race during iteration
         let snapshot = connections
-        for state in snapshot {
-            guard state.config.isEnabled && state.config.autoReconnect else { continue }
+        let liveIDs = Set(snapshot.map(\.id))
+        healthSchedules = healthSchedules.filter { liveIDs.contains($0.key) }
+
+        for state in snapshot where state.config.proxyPort != nil {
+            state.relayStats = state.proxyStatus == .connected
+                ? await processManager.relayStatistics(for: state.id)
+                : nil
+        }
+
+        let due = snapshot.filter { state in
+            state.config.isEnabled && state.config.autoReconnect
+                && (healthSchedules[state.id]?.nextCheck ?? now) <= now
+        }
+        guard !due.isEmpty else { return }
 
+        let probes = await probeConnections(due)
+
+        for state in due {
+            // Skip connections removed or restarted by the user while probing
+            guard !isKillingProcesses, connection(for: state.id) === state, let probe = probes[state.id] else { continue }
+
+            let health: ConnectionHealth
             if state.config.useDirectExec, state.config.proxyPort != nil {
-                await checkDirectExecConnection(state)
-                continue
+                health = await checkDirectExecConnection(state, probe: probe)
+            } else {
+                health = await applyProbe(probe, to: state)
             }
 
-            let localPort = state.config.localPort
-            let processRunning = await processManager.isProcessRunning(for: state.id, type: .portForward)
-            let hasError = await processManager.hasRecentError(for: state.id)
-            let pfWorking = await processManager.isPortOpen(port: localPort)
-
-            // Reconnect if disconnected or error
-            if state.portForwardStatus == .disconnected || state.portForwardStatus == .error {
-                await processManager.clearError(for: state.id)
-                startConnection(state.id)
-                continue
+            let checkedAt = ContinuousClock.now
+            switch health {
+            case .healthy:
+                healthSchedules[state.id, default: ConnectionHealthSchedule()].recordHealthy(at: checkedAt)
+            case .failed:
+                healthSchedules[state.id, default: ConnectionHealthSchedule()].recordFailure(at: checkedAt)
+            case .pending:
+                healthSchedules[state.id, default: ConnectionHealthSchedule()].recordPending(at: checkedAt)
             }
+        }
+    }
 
-            // Reconnect on error
-            if state.portForwardStatus == .connected && hasError {
-                let wasConnected = state.isFullyConnected
-                state.lastError = "kubectl port-forward error on port \(localPort)"
-                state.portForwardStatus = .disconnected
-                state.proxyStatus = .disconnected
-                if wasConnected {
-                    sendDisconnectNotificationIfEnabled(for: state.config, wasIntentional: state.isIntentionallyStopped)
-                }
-                await processManager.killProcesses(for: state.id)
-                await processManager.clearError(for: state.id)
-                startConnection(state.id)
-                continue
+    /// Gathers process state and runs one batched TCP probe pass for `states`.
+    private func probeConnections(_ states: [PortForwardConnectionState]) async -> [UUID: ConnectionProbe] {
+        // Capture plain values; connection state is main-actor bound
+        let targets = states.map { state in
+            let isDirectExec = state.config.useDirectExec && state.config.proxyPort != nil
+            return (
+                id: state.id,
+                type: isDirectExec ? PortForwardProcessType.proxy : .portForward,
+                port: !isDirectExec && state.portForwardStatus == .connected ? state.config.localPort : nil,
+                proxyPort: !isDirectExec && state.proxyStatus == .connected ? state.config.proxyPort : nil
+            )
+        }
+
+        let ports = Set(targets.flatMap { [$0.port, $0.proxyPort].compactMap { $0 } })
+        async let portResults = PortHealthChecker.probe(ports: ports, timeout: AppConstants.connectionProbeTimeout)
+
+        var processStates: [UUID: (running: Bool, recentError: Bool)] = [:]
+        for target in targets {
+            processStates[target.id] = (
+                await processManager.isProcessRunning(for: target.id, type: target.type),
+                await processManager.hasRecentError(for: target.id)
+            )
+        }
+
+        let openPorts = await portResults
+        var probes: [UUID: ConnectionProbe] = [:]
+        for target in targets {
+            guard let process = processStates[target.id] else { continue }
+            probes[target.id] = ConnectionProbe(
+                processRunning: process.running,
+                hasRecentError: process.recentError,
+                portOpen: target.port.map { openPorts[$0]?.isOpen ?? false },
+                proxyOpen: target.proxyPort.map { openPorts[$0]?.isOpen ?? false }
+            )
+        }
+        return probes
+    }
+
+    /// Reconnects a kubectl (+ optional proxy) connection based on its probe.
+    /// Only a connection whose probed ports all answered counts as healthy.
+    private func applyProbe(_ probe: ConnectionProbe, to state: PortForwardConnectionState) async -> ConnectionHealth {
+        let localPort = state.config.localPort
+
+        // Reconnect if disconnected or error
+        if state.portForwardStatus == .disconnected || state.portForwardStatus == .error {
+            await processManager.clearError(for: state.id)
+            startConnection(state.id)
+            return .failed
+        }
+
+        // Reconnect on error
+        if state.portForwardStatus == .connected && probe.hasRecentError {
+            let wasConnected = state.isFullyConnected
+            state.lastError = "kubectl port-forward error on port \(localPort)"
+            state.portForwardStatus = .disconnected
+            state.proxyStatus = .disconnected
+            if wasConnected {
+                sendDisconnectNotificationIfEnabled(for: state.config, wasIntentional: state.isIntentionallyStopped)
             }
+            await processManager.killProcesses(for: state.id)
+            await processManager.clearError(for: state.id)
+            startConnection(state.id)
+            return .failed
+        }
 
-            // Reconnect if process died
-            if state.portForwardStatus == .connected && !processRunning {
-                let wasConnected = state.isFullyConnected
-                state.lastError = "Process terminated"
-                state.portForwardStatus = .disconnected
-                state.proxyStatus = .disconnected
-                if wasConnected {
-                    sendDisconnectNotificationIfEnabled(for: state.config, wasIntentional: state.isIntentionallyStopped)
-                }
-                startConnection(state.id)
-                continue
+        // Reconnect if process died
+        if state.portForwardStatus == .connected && !probe.processRunning {
+            let wasConnected = state.isFullyConnected
+            state.lastError = "Process terminated"
+            state.portForwardStatus = .disconnected
+            state.proxyStatus = .disconnected
+            if wasConnected {
+                sendDisconnectNotificationIfEnabled(for: state.config, wasIntentional: state.isIntentionallyStopped)
             }
+            startConnection(state.id)
+            return .failed
+        }
 
-            // Reconnect if port not responding
-            if state.portForwardStatus == .connected && !pfWorking {
-                let wasConnected = state.isFullyConnected
-                state.lastError = "Connection lost"
-                state.portForwardStatus = .disconnected
-                state.proxyStatus = .disconnected
-                if wasConnected {
-                    sendDisconnectNotificationIfEnabled(for: state.config, wasIntentional: state.isIntentionallyStopped)
-                }
-                await processManager.killProcesses(for: state.id)
-                startConnection(state.id)
-                continue
+        // Reconnect if port not responding
+        if state.portForwardStatus == .connected && probe.portOpen == false {
+            let wasConnected = state.isFullyConnected
+            state.lastError = "Connection lost"
+            state.portForwardStatus = .disconnected
+            state.proxyStatus = .disconnected
+            if wasConnected {
+                sendDisconnectNotificationIfEnabled(for: state.config, wasIntentional: state.isIntentionallyStopped)
             }
+            await processManager.killProcesses(for: state.id)
+            startConnection(state.id)
+            return .failed
+        }
+
+        // Still connecting: the port wasn't probed
+        guard state.portForwardStatus == .connected, probe.processRunning, probe.portOpen == true else {
+            return .pending
+        }
 
-            // Check proxy if enabled
-            if let proxyPort = state.config.proxyPort {
-                if state.proxyStatus == .disconnected && state.portForwardStatus == .connected {
-                    state.proxyStatus = .connecting
-                    state.proxyTask = Task {
-                        await runProxy(for: state, config: state.config)
-                    }
-                    continue
+        // Check proxy if enabled
+        if state.config.proxyPort != nil {
+            if state.proxyStatus == .disconnected || state.proxyStatus == .error {
+                let failed = state.proxyStatus == .error
+                state.proxyStatus = .connecting
+                state.proxyTask = Task {
+                    await runProxy(for: state, config: state.config)
                 }
+                return failed ? .failed : .pending
+            }
 
-                let proxyWorking = await processManager.isPortOpen(port: proxyPort)
-                if state.proxyStatus == .connected && !proxyWorking {
-                    state.proxyStatus = .error
-                    state.lastError = "Proxy connection lost"
-                    if state.portForwardStatus == .connected {
-                        state.proxyStatus = .connecting
-                        state.proxyTask = Task {
-                            await runProxy(for: state, config: state.config)
-                        }
-                    }
+            if state.proxyStatus == .connected && probe.proxyOpen == false {
+                state.proxyStatus = .error
+                state.lastError = "Proxy connection lost"
+                state.proxyStatus = .connecting
+                state.proxyTask = Task {
+                    await runProxy(for: state, config: state.config)
                 }
+                return .failed
             }
+
+            guard state.proxyStatus == .connected, probe.proxyOpen == true else { return .pending }
         }
+
+        return .healthy
     }
 
     /// Checks a direct exec connection and reconnects if needed.
-    func checkDirectExecConnection(_ state: PortForwardConnectionState) async {
-        guard state.config.proxyPort != nil else { return }
+    /// Only a connected, running proxy counts as healthy.
+    func checkDirectExecConnection(_ state: PortForwardConnectionState, probe: ConnectionProbe) async -> ConnectionHealth {
+        guard state.config.proxyPort != nil else { return .pending }
 
         if state.proxyStatus == .connecting {
-            return
+            return .pending
         }
 
-        let proxyRunning = await processManager.isProcessRunning(for: state.id, type: .proxy)
-        let hasError = await processManager.hasRecentError(for: state.id)
-
         if state.proxyStatus == .disconnected || state.proxyStatus == .error {
             await processManager.clearError(for: state.id)
             startConnection(state.id)
-            return
+            return .failed
         }
 
-        if state.proxyStatus == .connected && hasError {
+        if state.proxyStatus == .connected && probe.hasRecentError {
             let wasConnected = state.isFullyConnected
             state.lastError = "Proxy error on port \(state.config.proxyPort ?? 0)"
             state.portForwardStatus = .disconnected
@@ -144,10 +300,10 @@ extension PortForwardManager {
             await processManager.killProcesses(for: state.id)
             await processManager.clearError(for: state.id)
             startConnection(state.id)
-            return
+            return .failed
         }
 
-        if state.proxyStatus == .connected && !proxyRunning {
+        if state.proxyStatus == .connected && !probe.processRunning {
             let wasConnected = state.isFullyConnected
             state.lastError = "Proxy terminated"
             state.portForwardStatus = .disconnected
@@ -156,7 +312,9 @@ extension PortForwardManager {
                 sendDisconnectNotificationIfEnabled(for: state.config, wasIntentional: state.isIntentionallyStopped)
             }
             startConnection(state.id)
-            return
+            return .failed
         }
+
+        return state.proxyStatus == .connected ? .healthy : .pending
     }
 }
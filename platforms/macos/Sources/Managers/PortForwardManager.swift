@@ -9,6 +9,10 @@ extension Defaults.Keys {
     static let portForwardShowNotifications = Key<Bool>("portForwardShowNotifications", default: true)
     static let customKubectlPath = Key<String?>("customKubectlPath", default: nil)
     static let customSocatPath = Key<String?>("customSocatPath", default: nil)
+    /// Run proxies as socat children instead of the in-process relay
+    static let portForwardUseSocatProxy = Key<Bool>("portForwardUseSocatProxy", default: false)
+    /// How many kubectl children "Start All" brings up at the same time
+    static let portForwardStartConcurrency = Key<Int>("portForwardStartConcurrency", default: 4)
     static let customCloudflaredPath = Key<String?>("customCloudflaredPath", default: nil)
 }
 
@@ -22,7 +26,19 @@ final class PortForwardManager {
     var isKillingProcesses = false
 
     var monitorTask: Task<Void, Never>?
+    /// The monitor's sleep between ticks; cancelled to run the next check early
+    var monitorSleep: Task<Void, Never>?
+    /// A child exited while the monitor was busy; skip the next sleep
+    var isMonitorWakeRequested = false
+    /// The running "Start All" pipeline, see `startConnections(_:)`
+    var bulkStartTask: Task<Void, Never>?
+    /// Per-connection health-check schedule, see `checkConnections()`
+    var healthSchedules: [UUID: ConnectionHealthSchedule] = [:]
     let processManager: PortForwardProcessManager
+    /// Namespaces and services shared by every Kubernetes browser and picker
+    let discoveryCache: KubernetesDiscoveryCache
+    /// Finds what already listens on connection ports before a bulk start
+    let scanner: any PortScannerProtocol
 
     var allConnected: Bool {
         guard !connections.isEmpty else { return false }
@@ -49,9 +65,21 @@ final class PortForwardManager {
         connections.firstIndex { $0.id == id }
     }
 
-    init(processManager: PortForwardProcessManager = PortForwardProcessManager()) {
+    init(
+        processManager: PortForwardProcessManager = PortForwardProcessManager(),
+        scanner: any PortScannerProtocol = LibprocPortScanner()
+    ) {
         self.processManager = processManager
+        self.scanner = scanner
+        self.discoveryCache = KubernetesDiscoveryCache(processManager: processManager)
         loadConnections()
+
+        let exitHandler: ChildExitHandler = { [weak self] id, _ in
+            Task { @MainActor [weak self] in
+                self?.childDidExit(id)
+            }
+        }
+        Task { await processManager.setChildExitHandler(exitHandler) }
     }
 
     // MARK: - Persistence
@@ -94,17 +122,42 @@ final class PortForwardManager {
 
     // MARK: - Bulk Operations
 
+    /// Starts every enabled connection through the bulk pipeline (one port pre-check,
+    /// then up to `portForwardStartConcurrency` kubectl children at once).
     func startAll() {
-        for connection in connections where connection.config.isEnabled {
-            startConnection(connection.id)
+        guard !isKillingProcesses, bulkStartTask == nil else {
+            startMonitoring()
+            return
+        }
+
+        let queued = connections.filter { $0.config.isEnabled && canStart($0) }
+        // Held as connecting so the monitor doesn't start them ahead of the queue
+        for state in queued {
+            state.isIntentionallyStopped = false
+            state.portForwardStatus = .connecting
+        }
+
+        if !queued.isEmpty {
+            bulkStartTask = Task { [weak self] in
+                await self?.startConnections(queued)
+                self?.bulkStartTask = nil
+            }
         }
         startMonitoring()
     }
 
     func stopAll() {
         stopMonitoring()
+        bulkStartTask?.cancel()
+        bulkStartTask = nil
+
         for connection in connections {
-            stopConnection(connection.id)
+            resetForStop(connection)
+        }
+
+        let ids = connections.map(\.id)
+        Task {
+            await processManager.killProcesses(for: ids)
         }
     }
 
@@ -135,27 +188,39 @@ final class PortForwardManager {
 
     func startConnection(_ id: UUID) {
         guard !isKillingProcesses else { return }
-        guard let state = connection(for: id) else { return }
-        guard state.portForwardTask == nil, state.proxyTask == nil else { return }
-        guard state.portForwardStatus != .connecting, state.proxyStatus != .connecting else { return }
-        guard !state.isFullyConnected else { return }
-        let config = state.config
+        guard let state = connection(for: id), canStart(state) else { return }
+        guard state.portForwardStatus != .connecting else { return }
 
         // Reset intentional stop flag when starting
         state.isIntentionallyStopped = false
 
         state.portForwardStatus = .connecting
+        launchConnection(state)
+    }
+
+    /// Whether `state` has nothing running or starting, so a start may begin
+    func canStart(_ state: PortForwardConnectionState) -> Bool {
+        state.portForwardTask == nil && state.proxyTask == nil
+            && state.proxyStatus != .connecting && !state.isFullyConnected
+    }
+
+    /// Spawns the connection's children; `state` must already be marked connecting.
+    /// - Returns: The task that finishes once the port forward is ready or has failed
+    @discardableResult
+    func launchConnection(_ state: PortForwardConnectionState) -> Task<Void, Never> {
+        let id = state.id
+        let config = state.config
+        state.beginStartup()
 
         // Set up handlers and start port forward in a single task to ensure proper ordering
-        state.portForwardTask = Task { [weak self, weak state] in
+        let task = Task { [weak self, weak state] in
             guard let self = self, let state = state else { return }
 
             // Set log handler with proper weak capture (including inner Task)
-            let logHandler: LogHandler = { [weak state] message, type, isError in
+            let logHandler: LogHandler = { [weak state] lines, type in
                 guard let state = state else { return }
                 Task { @MainActor [weak state] in
-                    guard let state = state else { return }
-                    state.appendLog(message, type: type, isError: isError)
+                    state?.appendLogs(lines, type: type)
                 }
             }
             await self.processManager.setLogHandler(for: id, handler: logHandler)
@@ -179,13 +244,25 @@ final class PortForwardManager {
 
             await self.runPortForward(for: state, config: config)
         }
+        state.portForwardTask = task
+        return task
     }
 
     func stopConnection(_ id: UUID) {
         guard let state = connection(for: id) else { return }
+        resetForStop(state)
 
+        Task {
+            // killProcesses also drops the stored log/port-conflict handlers.
+            await processManager.killProcesses(for: id)
+        }
+    }
+
+    /// Cancels a connection's tasks and marks it stopped; the children are killed by the caller.
+    private func resetForStop(_ state: PortForwardConnectionState) {
         // Mark as intentionally stopped to avoid disconnect notification
         state.isIntentionallyStopped = true
+        healthSchedules[state.id] = nil
 
         state.proxyTask?.cancel()
         state.proxyTask = nil
@@ -197,11 +274,6 @@ final class PortForwardManager {
 
         // Clear logs to free memory when connection is stopped
         state.clearLogs()
-
-        Task {
-            // killProcesses also drops the stored log/port-conflict handlers.
-            await processManager.killProcesses(for: id)
-        }
     }
 
     func restartConnection(_ id: UUID) {
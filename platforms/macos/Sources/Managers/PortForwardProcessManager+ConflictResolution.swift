@@ -9,24 +9,14 @@ extension PortForwardProcessManager {
             arguments: ["-ti", "tcp:\(port)"]
         ) ?? ""
 
-        // Kill logic uses Darwin.kill (pure C) and await
-        if !output.isEmpty {
-            let pids = output.split(separator: "\n")
-            for pidStr in pids {
-                if let pid = Int32(pidStr.trimmingCharacters(in: .whitespaces)) {
-                    kill(pid, SIGTERM)
-                }
-            }
-
-            try? await Task.sleep(for: .milliseconds(300))
-
-            for pidStr in pids {
-                if let pid = Int32(pidStr.trimmingCharacters(in: .whitespaces)) {
-                    if kill(pid, 0) == 0 {
-                        kill(pid, SIGKILL)
-                    }
-                }
-            }
+        let pids = output.split(separator: "\n").compactMap {
+            Int32($0.trimmingCharacters(in: .whitespaces))
         }
+        await killProcesses(pids: Set(pids))
+    }
+
+    /// Sends SIGTERM to every PID, then SIGKILL to those still alive after a short grace.
+    func killProcesses(pids: Set<Int32>) async {
+        _ = await ProcessTerminator.terminate(pids: Set(pids.map(Int.init)), gracePeriod: .milliseconds(300))
     }
 }
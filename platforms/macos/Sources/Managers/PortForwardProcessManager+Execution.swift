@@ -27,12 +27,13 @@ extension PortForwardProcessManager {
         process.standardOutput = pipe
         process.standardError = pipe
 
-        outputTasks[id]?[.portForward]?.cancel()
         if let existing = processes[id]?[.portForward], existing.isRunning {
             existing.terminate()
         }
+        readyConnections.remove(id)
 
         try process.run()
+        superviseExit(of: process, id: id, type: .portForward)
 
         if processes[id] == nil {
             processes[id] = [:]
@@ -65,12 +66,13 @@ extension PortForwardProcessManager {
         process.standardOutput = pipe
         process.standardError = pipe
 
-        outputTasks[id]?[.proxy]?.cancel()
+        relays.removeValue(forKey: id)?.stop()
         if let existing = processes[id]?[.proxy], existing.isRunning {
             existing.terminate()
         }
 
         try process.run()
+        superviseExit(of: process, id: id, type: .proxy)
 
         if processes[id] == nil {
             processes[id] = [:]
@@ -82,6 +84,32 @@ extension PortForwardProcessManager {
         return process
     }
 
+    /// Starts the in-process proxy from `externalPort` to the kubectl port.
+    /// It is ready as soon as this returns: the listener is bound.
+    func startRelay(
+        id: UUID,
+        externalPort: Int,
+        internalPort: Int
+    ) throws {
+        relays.removeValue(forKey: id)?.stop()
+        if let existing = processes[id]?[.proxy], existing.isRunning {
+            existing.terminate()
+        }
+
+        let relay = TCPRelay(listenPort: externalPort, targetPort: internalPort) { [weak self] message, isError in
+            Task { await self?.handleRelayEvent(id: id, message: message, isError: isError) }
+        }
+
+        do {
+            try relay.start()
+        } catch TCPRelayError.addressInUse(let port) {
+            portConflictHandlers[id]?(port)
+            throw TCPRelayError.addressInUse(port)
+        }
+
+        relays[id] = relay
+    }
+
     /// Starts a direct exec proxy for multi-connection support.
     func startDirectExecProxy(
         id: UUID,
@@ -126,12 +154,13 @@ extension PortForwardProcessManager {
         process.standardOutput = pipe
         process.standardError = pipe
 
-        outputTasks[id]?[.proxy]?.cancel()
+        relays.removeValue(forKey: id)?.stop()
         if let existing = processes[id]?[.proxy], existing.isRunning {
             existing.terminate()
         }
 
         try process.run()
+        superviseExit(of: process, id: id, type: .proxy)
 
         if processes[id] == nil {
             processes[id] = [:]
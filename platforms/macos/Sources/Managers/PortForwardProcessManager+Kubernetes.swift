@@ -1,36 +1,106 @@
 import Foundation
+import os
 
 extension PortForwardProcessManager {
-    /// Fetches all Kubernetes namespaces.
-    func fetchNamespaces() async throws -> [KubernetesNamespace] {
-        let output = try await executeKubectl(arguments: ["get", "namespaces", "-o", "json"])
+    nonisolated private static let kubectlLogger = Logger(subsystem: "com.portkiller.app", category: "Kubernetes")
 
-        do {
-            let response = try JSONDecoder().decode(
-                KubernetesNamespace.ListResponse.self,
-                from: Data(output.utf8)
-            )
-            let namespaces = KubernetesNamespace.from(response: response)
-            return namespaces.sorted { $0.name < $1.name }
-        } catch {
-            throw KubectlError.parsingFailed(error.localizedDescription)
-        }
+    /// Fetches all Kubernetes namespaces.
+    /// - Parameters:
+    ///   - context: kube context to query; nil uses the current context
+    ///   - onProgress: Receives namespaces as they are decoded, before the list completes
+    nonisolated func fetchNamespaces(
+        context: String? = nil,
+        onProgress: (@Sendable ([KubernetesNamespace]) -> Void)? = nil
+    ) async throws -> KubernetesList<KubernetesNamespace> {
+        let list = try await streamKubectlList(
+            KubernetesNamespace.ListResponse.Item.self,
+            arguments: ["get", "namespaces", "-o", "json"] + Self.contextArguments(context),
+            onItems: onProgress.map { onProgress in
+                { @Sendable items in onProgress(items.map { KubernetesNamespace(name: $0.metadata.name) }) }
+            }
+        )
+        return KubernetesList(
+            items: list.items.map { KubernetesNamespace(name: $0.metadata.name) }.sorted { $0.name < $1.name },
+            resourceVersion: list.resourceVersion
+        )
     }
 
     /// Fetches services in a specific namespace.
-    func fetchServices(namespace: String) async throws -> [KubernetesService] {
-        let output = try await executeKubectl(arguments: ["get", "services", "-n", namespace, "-o", "json"])
+    /// - Parameters:
+    ///   - context: kube context to query; nil uses the current context
+    ///   - onProgress: Receives services as they are decoded, before the list completes
+    nonisolated func fetchServices(
+        namespace: String,
+        context: String? = nil,
+        onProgress: (@Sendable ([KubernetesService]) -> Void)? = nil
+    ) async throws -> KubernetesList<KubernetesService> {
+        let list = try await streamKubectlList(
+            KubernetesService.ListResponse.Item.self,
+            arguments: ["get", "services", "-n", namespace, "-o", "json"] + Self.contextArguments(context),
+            onItems: onProgress.map { onProgress in
+                { @Sendable items in onProgress(items.map(KubernetesService.from(item:))) }
+            }
+        )
+        return KubernetesList(
+            items: list.items.map(KubernetesService.from(item:)).sorted { $0.name < $1.name },
+            resourceVersion: list.resourceVersion
+        )
+    }
+
+    /// Runs a kubectl list command, decoding items straight off the pipe.
+    ///
+    /// Items are decoded one at a time as they arrive (`KubernetesListDecoder`), so neither
+    /// the raw JSON nor a full `ListResponse` is ever held in memory.
+    nonisolated func streamKubectlList<Item: Decodable & Sendable>(
+        _ type: Item.Type,
+        arguments: [String],
+        onItems: (@Sendable ([Item]) -> Void)?
+    ) async throws -> KubernetesList<Item> {
+        guard let kubectlPath = DependencyChecker.shared.kubectlPath else {
+            throw KubectlError.kubectlNotFound
+        }
 
+        let decoder = KubernetesListDecoder<Item>()
         do {
-            let response = try JSONDecoder().decode(
-                KubernetesService.ListResponse.self,
-                from: Data(output.utf8)
+            for try await chunk in ProcessExecutor.chunks(kubectlPath, arguments: arguments) {
+                let added = decoder.feed(chunk)
+                if added > 0, let onItems {
+                    onItems(Array(decoder.items.suffix(added)))
+                }
+            }
+        } catch ProcessExecutorError.launchFailed {
+            throw KubectlError.kubectlNotFound
+        } catch ProcessExecutorError.failed(_, let standardError) {
+            throw Self.kubectlError(standardError: String(decoding: standardError, as: UTF8.self))
+        } catch ProcessExecutorError.timedOut {
+            throw KubectlError.executionFailed("Timed out")
+        }
+        guard decoder.isComplete else {
+            throw KubectlError.parsingFailed("Incomplete list response")
+        }
+        if decoder.failedItemCount > 0 {
+            // One odd item shouldn't hide the rest, but a list of nothing but odd items
+            // means the response isn't what `Item` expects
+            guard !decoder.items.isEmpty else {
+                throw KubectlError.parsingFailed("None of the \(decoder.failedItemCount) items could be decoded")
+            }
+            Self.kubectlLogger.warning(
+                "Skipped \(decoder.failedItemCount) undecodable items of kubectl \(arguments.prefix(2).joined(separator: " "))"
             )
-            let services = KubernetesService.from(response: response)
-            return services.sorted { $0.name < $1.name }
-        } catch {
-            throw KubectlError.parsingFailed(error.localizedDescription)
         }
+        return KubernetesList(items: decoder.items, resourceVersion: decoder.resourceVersion)
+    }
+
+    /// Returns the name of kubectl's current context.
+    func currentContext() async throws -> String {
+        try await executeKubectl(arguments: ["config", "current-context"])
+            .trimmingCharacters(in: .whitespacesAndNewlines)
+    }
+
+    /// `--context` arguments for kubectl, empty for the current context.
+    nonisolated static func contextArguments(_ context: String?) -> [String] {
+        guard let context, !context.isEmpty else { return [] }
+        return ["--context", context]
     }
 
     /// Executes a kubectl command and returns the output.
@@ -44,18 +114,22 @@ extension PortForwardProcessManager {
         }
 
         guard result.succeeded else {
-            let errorOutput = result.standardError
-            if errorOutput.contains("Unable to connect") ||
-               errorOutput.contains("connection refused") ||
-               errorOutput.contains("no configuration") ||
-               errorOutput.contains("dial tcp") {
-                throw KubectlError.clusterNotConnected
-            }
-            throw KubectlError.executionFailed(
-                errorOutput.isEmpty ? "Unknown error" : errorOutput.trimmingCharacters(in: .whitespacesAndNewlines)
-            )
+            throw Self.kubectlError(standardError: result.standardError)
         }
 
         return result.standardOutput
     }
+
+    /// Maps kubectl's stderr to the error shown to the user.
+    nonisolated static func kubectlError(standardError errorOutput: String) -> KubectlError {
+        if errorOutput.contains("Unable to connect") ||
+           errorOutput.contains("connection refused") ||
+           errorOutput.contains("no configuration") ||
+           errorOutput.contains("dial tcp") {
+            return .clusterNotConnected
+        }
+        return .executionFailed(
+            errorOutput.isEmpty ? "Unknown error" : errorOutput.trimmingCharacters(in: .whitespacesAndNewlines)
+        )
+    }
 }
@@ -1,16 +1,31 @@
 import Foundation
 import Darwin
 
+/// Identifies one child's output pipe: the kubectl or socat process of a connection
+struct PortForwardOutputKey: Hashable, Sendable {
+    let id: UUID
+    let type: PortForwardProcessType
+}
+
 // MARK: - Process Manager Actor
 
 actor PortForwardProcessManager {
     // MARK: - Internal Properties (for extensions)
 
     var processes: [UUID: [PortForwardProcessType: Process]] = [:]
-    var outputTasks: [UUID: [PortForwardProcessType: Task<Void, Never>]] = [:]
+    /// In-process proxies, used instead of a socat child unless socat is opted into
+    var relays: [UUID: TCPRelay] = [:]
+    /// Reads every kubectl/socat pipe; drained by the single `outputTask`
+    let outputReader = ChildOutputReader<PortForwardOutputKey>()
+    var outputTask: Task<Void, Never>?
     var connectionErrors: [UUID: Date] = [:]
     var logHandlers: [UUID: LogHandler] = [:]
     var portConflictHandlers: [UUID: PortConflictHandler] = [:]
+    var childExitHandler: ChildExitHandler?
+    /// Connections whose kubectl has printed "Forwarding from" since it was spawned
+    var readyConnections: Set<UUID> = []
+    /// Callers of `waitUntilReady(for:timeout:)`, resumed on readiness, exit, kill or timeout
+    var readinessWaiters: [UUID: [CheckedContinuation<Bool, Never>]] = [:]
 
     // MARK: - Handler Management
 
@@ -22,48 +37,111 @@ actor PortForwardProcessManager {
         portConflictHandlers[id] = handler
     }
 
+    /// Called whenever a connection's child dies unexpectedly, see `childDidExit`.
+    func setChildExitHandler(_ handler: @escaping ChildExitHandler) {
+        childExitHandler = handler
+    }
+
     // MARK: - Output Reading
 
     func startReadingOutput(pipe: Pipe, id: UUID, type: PortForwardProcessType) {
-        outputTasks[id]?[type]?.cancel()
-
-        let task = Task { [weak self] in
-            let handle = pipe.fileHandleForReading
-
-            // Use async bytes stream for non-blocking read
-            // This avoids potential deadlock from blocking availableData calls
-            do {
-                for try await line in handle.bytes.lines {
-                    guard !Task.isCancelled else { break }
-
-                    let trimmedLine = line.trimmingCharacters(in: .whitespacesAndNewlines)
-                    guard !trimmedLine.isEmpty else { continue }
-
-                    let isError = PortForwardOutputParser.isErrorLine(trimmedLine)
-
-                    if isError {
-                        await self?.markConnectionError(id: id)
-                    }
-
-                    if let port = PortForwardOutputParser.detectPortConflict(in: trimmedLine) {
-                        if let handler = await self?.portConflictHandlers[id] {
-                            handler(port)
-                        }
-                    }
-
-                    if let handler = await self?.logHandlers[id] {
-                        handler(trimmedLine, type, isError)
-                    }
-                }
-            } catch {
-                // Stream ended or was cancelled - this is expected when process terminates
+        outputReader.attach(pipe, key: PortForwardOutputKey(id: id, type: type))
+
+        guard outputTask == nil else { return }
+        let batches = outputReader.batches
+        outputTask = Task { [weak self] in
+            for await batch in batches {
+                guard !Task.isCancelled else { break }
+                await self?.handleOutput(batch)
+            }
+        }
+    }
+
+    /// Routes one batch of output lines to the error, conflict and log handlers.
+    private func handleOutput(_ batch: ChildOutputBatch<PortForwardOutputKey>) {
+        let id = batch.key.id
+        var logLines: [PortForwardLogLine] = []
+        logLines.reserveCapacity(batch.lines.count)
+
+        for line in batch.lines {
+            let isError = PortForwardOutputParser.isErrorLine(line)
+            if isError {
+                markConnectionError(id: id)
+            }
+
+            if let port = PortForwardOutputParser.detectPortConflict(in: line) {
+                portConflictHandlers[id]?(port)
+            }
+
+            if batch.key.type == .portForward, PortForwardOutputParser.isForwardingReady(line) {
+                resolveReadiness(for: id, isReady: true)
             }
+
+            logLines.append(PortForwardLogLine(message: line, isError: isError))
+        }
+
+        logHandlers[id]?(logLines, batch.key.type)
+    }
+
+    /// Routes a relay event to the log handler; errors count like socat error output.
+    func handleRelayEvent(id: UUID, message: String, isError: Bool) {
+        if isError {
+            markConnectionError(id: id)
+        }
+        logHandlers[id]?([PortForwardLogLine(message: message, isError: isError)], .proxy)
+    }
+
+    // MARK: - Readiness
+
+    /// Waits until the connection's kubectl reports "Forwarding from".
+    ///
+    /// Returns false if the child exits, is killed, or `timeout` passes first.
+    func waitUntilReady(for id: UUID, timeout: Duration) async -> Bool {
+        if readyConnections.contains(id) { return true }
+        guard processes[id]?[.portForward]?.isRunning == true else { return false }
+
+        let timeoutTask = Task { [weak self] in
+            try? await Task.sleep(for: timeout)
+            guard !Task.isCancelled else { return }
+            await self?.resolveReadiness(for: id, isReady: false)
+        }
+        defer { timeoutTask.cancel() }
+
+        return await withCheckedContinuation { continuation in
+            readinessWaiters[id, default: []].append(continuation)
+        }
+    }
+
+    /// Resumes everyone waiting on `id`; a positive result is remembered for later callers.
+    func resolveReadiness(for id: UUID, isReady: Bool) {
+        if isReady {
+            readyConnections.insert(id)
+        }
+        for waiter in readinessWaiters.removeValue(forKey: id) ?? [] {
+            waiter.resume(returning: isReady)
+        }
+    }
+
+    // MARK: - Exit Tracking
+
+    /// Registers a freshly spawned child with the supervisor, so its exit reaches
+    /// `childDidExit` (and the exit handler) as soon as the kernel reports it.
+    func superviseExit(of process: Process, id: UUID, type: PortForwardProcessType) {
+        let identifier = ObjectIdentifier(process)
+        ChildProcessSupervisor.shared.supervise(process) { [weak self] _ in
+            Task { await self?.childDidExit(id: id, type: type, process: identifier) }
         }
+    }
 
-        if outputTasks[id] == nil {
-            outputTasks[id] = [:]
+    /// Called when a kubectl or socat child exits; ignores children that were killed
+    /// on purpose or already replaced by a newer one.
+    func childDidExit(id: UUID, type: PortForwardProcessType, process: ObjectIdentifier) {
+        guard let current = processes[id]?[type], ObjectIdentifier(current) == process else { return }
+        if type == .portForward {
+            readyConnections.remove(id)
+            resolveReadiness(for: id, isReady: false)
         }
-        outputTasks[id]?[type] = task
+        childExitHandler?(id, type)
     }
 
     // MARK: - Error Tracking
@@ -84,12 +162,11 @@ actor PortForwardProcessManager {
     // MARK: - Process Lifecycle
 
     func killProcesses(for id: UUID) {
-        if let tasks = outputTasks[id] {
-            for (_, task) in tasks {
-                task.cancel()
-            }
-        }
-        outputTasks[id] = nil
+        outputReader.detach(PortForwardOutputKey(id: id, type: .portForward))
+        outputReader.detach(PortForwardOutputKey(id: id, type: .proxy))
+        relays.removeValue(forKey: id)?.stop()
+        readyConnections.remove(id)
+        resolveReadiness(for: id, isReady: false)
 
         guard let procs = processes[id] else { return }
 
@@ -110,12 +187,23 @@ actor PortForwardProcessManager {
         try? FileManager.default.removeItem(atPath: scriptPath)
     }
 
+    /// Kills the children of several connections in one actor hop.
+    func killProcesses(for ids: [UUID]) {
+        for id in ids {
+            killProcesses(for: id)
+        }
+    }
+
     func isProcessRunning(for id: UUID, type: PortForwardProcessType) -> Bool {
-        processes[id]?[type]?.isRunning ?? false
+        if type == .proxy, let relay = relays[id] {
+            return relay.isRunning
+        }
+        return processes[id]?[type]?.isRunning ?? false
     }
 
-    func isPortOpen(port: Int) -> Bool {
-        PortHealthChecker.isPortOpen(port: port)
+    /// Counters of the in-process proxy, nil when the connection has none.
+    func relayStatistics(for id: UUID) -> TCPRelay.Statistics? {
+        relays[id]?.statistics()
     }
 
     func killAllPortForwarderProcesses() async {
@@ -134,10 +222,13 @@ actor PortForwardProcessManager {
         try? await Task.sleep(for: .milliseconds(500))
 
         processes.removeAll()
-        for (_, tasks) in outputTasks {
-            for (_, task) in tasks { task.cancel() }
+        relays.values.forEach { $0.stop() }
+        relays.removeAll()
+        outputReader.detachAll()
+        readyConnections.removeAll()
+        for id in Array(readinessWaiters.keys) {
+            resolveReadiness(for: id, isReady: false)
         }
-        outputTasks.removeAll()
         connectionErrors.removeAll()
         logHandlers.removeAll()
         portConflictHandlers.removeAll()
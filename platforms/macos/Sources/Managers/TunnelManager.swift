@@ -55,6 +55,7 @@ final class TunnelManager {
 
     /// Re-check cloudflared installation status (call after user installs)
     func recheckInstallation() {
+        PathProbeCache.shared.invalidate()
         state.setInstalled(cloudflaredService.isInstalled)
     }
 
@@ -128,26 +129,27 @@ final class TunnelManager {
             await self.cloudflaredService.setErrorHandler(for: tunnelState.id, handler: errorHandler)
 
             // Set log handler to capture all output lines
-            let logHandler: @Sendable (String) -> Void = { [weak tunnelState] line in
-                guard let tunnelState = tunnelState else { return }
-                let entry = TunnelLogEntry.parse(line)
+            let logHandler: @Sendable ([String]) -> Void = { [weak tunnelState] lines in
+                guard tunnelState != nil else { return }
+                let classified = lines.map { (message: $0, level: TunnelLogEntry.level(of: $0)) }
                 Task { @MainActor [weak tunnelState] in
-                    tunnelState?.addLogEntry(entry)
+                    tunnelState?.addLogLines(classified)
                 }
             }
             await self.cloudflaredService.setLogHandler(for: tunnelState.id, handler: logHandler)
 
             do {
                 let process = try await self.cloudflaredService.startTunnel(id: tunnelState.id, port: port)
-                try? await Task.sleep(for: .seconds(3))
+                _ = await ChildProcessSupervisor.shared.exit(of: process)
 
-                if !process.isRunning && tunnelState.status != .active {
-                    // Clean up handlers when process terminates unexpectedly
-                    await self.cloudflaredService.removeHandlers(for: tunnelState.id)
-                    await MainActor.run {
-                        tunnelState.status = .error
-                        tunnelState.lastError = "Process terminated unexpectedly"
-                    }
+                // Stopped on purpose; `stopTunnel` cleans up
+                guard tunnelState.status != .stopping else { return }
+                // Clean up handlers when process terminates unexpectedly
+                await self.cloudflaredService.removeHandlers(for: tunnelState.id)
+                await MainActor.run {
+                    tunnelState.status = .error
+                    tunnelState.tunnelURL = nil
+                    tunnelState.lastError = "Process terminated unexpectedly"
                 }
             } catch {
                 // Clean up handlers on error
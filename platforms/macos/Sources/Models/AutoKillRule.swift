@@ -42,43 +42,16 @@ struct AutoKillRule: Codable, Identifiable, Hashable, Sendable, Defaults.Seriali
 
         // Check process pattern match
         if !processPattern.isEmpty {
-            return matchesGlob(portInfo.processName, pattern: processPattern)
+            return ProcessNamePattern(processPattern).matches(portInfo.processName)
         }
 
         // At least one criterion must be specified
         return port > 0
     }
 
-    /// Simple glob matching with * wildcard support.
-    private func matchesGlob(_ string: String, pattern: String) -> Bool {
-        let lowered = string.lowercased()
-        let pat = pattern.lowercased()
-
-        if !pat.contains("*") {
-            return lowered == pat
-        }
-
-        let parts = pat.split(separator: "*", omittingEmptySubsequences: false).map(String.init)
-
-        if parts.count == 1 { return lowered == pat }
-
-        // Check prefix
-        if let first = parts.first, !first.isEmpty, !lowered.hasPrefix(first) {
-            return false
-        }
-        // Check suffix
-        if let last = parts.last, !last.isEmpty, !lowered.hasSuffix(last) {
-            return false
-        }
-
-        // Check all parts appear in order
-        var searchStart = lowered.startIndex
-        for part in parts where !part.isEmpty {
-            guard let range = lowered.range(of: part, range: searchStart..<lowered.endIndex) else {
-                return false
-            }
-            searchStart = range.upperBound
-        }
-        return true
+    /// Checks only the port criterion, for a port whose process name is already known to
+    /// satisfy the pattern (see `ProcessClassification.matchingRules`).
+    func matchesPort(_ portNumber: Int) -> Bool {
+        port == 0 || port == portNumber
     }
 }
@@ -34,22 +34,19 @@ final class CloudflareTunnelState: Identifiable, Sendable {
     var tunnelURL: String?
     var lastError: String?
     var startTime: Date?
-    var logs: [TunnelLogEntry] = []
+    let logBuffer = LogRingBuffer<TunnelLogEntry>()
 
-    /// Maximum number of log entries to keep per tunnel
-    private static let maxLogEntries = 500
+    /// Buffered log lines, oldest first
+    var logs: [TunnelLogEntry] { logBuffer.entries }
 
-    /// Adds a log entry, keeping the buffer bounded
-    func addLogEntry(_ entry: TunnelLogEntry) {
-        logs.append(entry)
-        if logs.count > Self.maxLogEntries {
-            logs.removeFirst(logs.count - Self.maxLogEntries)
-        }
+    /// Adds a batch of classified log lines; the buffer stays bounded
+    func addLogLines(_ lines: [(message: String, level: TunnelLogEntry.LogLevel)]) {
+        logBuffer.append(contentsOf: lines.map { ($0.message, $0.level.rawValue, 0) })
     }
 
     /// Clears all log entries
     func clearLogs() {
-        logs.removeAll()
+        logBuffer.removeAll()
     }
 
     init(id: UUID = UUID(), port: Int, portInfoId: String? = nil) {
@@ -0,0 +1,88 @@
+/**
+ * DeadlineHeap.swift
+ * PortKiller
+ *
+ * Binary min-heap of (deadline, key) pairs, for timers that only ever need to know
+ * which deadline comes next.
+ */
+
+import Foundation
+
+/// Min-heap ordered by deadline.
+///
+/// Entries are never removed out of order; a caller that cancels or reschedules a key
+/// leaves its old entry behind and skips it when popped (lazy deletion), and compacts
+/// with `removeAll(where:)` if stale entries pile up.
+struct DeadlineHeap<Key: Hashable & Sendable>: Sendable {
+    struct Entry: Sendable {
+        let deadline: ContinuousClock.Instant
+        let key: Key
+    }
+
+    private var entries: [Entry] = []
+
+    nonisolated var count: Int { entries.count }
+    nonisolated var isEmpty: Bool { entries.isEmpty }
+
+    /// Entry with the earliest deadline
+    nonisolated var first: Entry? { entries.first }
+
+    nonisolated mutating func insert(_ key: Key, deadline: ContinuousClock.Instant) {
+        entries.append(Entry(deadline: deadline, key: key))
+        siftUp(from: entries.count - 1)
+    }
+
+    /// Removes and returns the entry with the earliest deadline.
+    @discardableResult
+    nonisolated mutating func popFirst() -> Entry? {
+        guard !entries.isEmpty else { return nil }
+        entries.swapAt(0, entries.count - 1)
+        let entry = entries.removeLast()
+        if !entries.isEmpty {
+            siftDown(from: 0)
+        }
+        return entry
+    }
+
+    /// Drops every entry matching `shouldRemove` and restores heap order.
+    nonisolated mutating func removeAll(where shouldRemove: (Entry) -> Bool) {
+        entries.removeAll(where: shouldRemove)
+        for index in stride(from: entries.count / 2 - 1, through: 0, by: -1) {
+            siftDown(from: index)
+        }
+    }
+
+    nonisolated mutating func removeAll() {
+        entries.removeAll()
+    }
+
+    // MARK: - Private Helpers
+
+    nonisolated private mutating func siftUp(from index: Int) {
+        var child = index
+        while child > 0 {
+            let parent = (child - 1) / 2
+            guard entries[child].deadline < entries[parent].deadline else { return }
+            entries.swapAt(child, parent)
+            child = parent
+        }
+    }
+
+    nonisolated private mutating func siftDown(from index: Int) {
+        var parent = index
+        while true {
+            let left = 2 * parent + 1
+            let right = left + 1
+            var smallest = parent
+            if left < entries.count, entries[left].deadline < entries[smallest].deadline {
+                smallest = left
+            }
+            if right < entries.count, entries[right].deadline < entries[smallest].deadline {
+                smallest = right
+            }
+            guard smallest != parent else { return }
+            entries.swapAt(parent, smallest)
+            parent = smallest
+        }
+    }
+}
@@ -44,6 +44,21 @@ struct KubernetesService: Identifiable, Codable, Sendable, Hashable {
 
 // MARK: - kubectl JSON Response Parsing
 
+/// Items of a kubectl list response, with the resource version a watch resumes from
+struct KubernetesList<Item: Sendable>: Sendable {
+    let items: [Item]
+    /// nil if the response carried none
+    let resourceVersion: String?
+}
+
+/// One event of `kubectl get --watch --output-watch-events -o json`, or of a raw
+/// `?watch=1` API stream
+struct KubernetesWatchEvent<Object: Decodable>: Decodable {
+    /// ADDED, MODIFIED, DELETED, BOOKMARK or ERROR
+    let type: String
+    let object: Object
+}
+
 extension KubernetesNamespace {
     struct ListResponse: Codable {
         let items: [Item]
@@ -126,21 +141,23 @@ extension KubernetesService {
     }
 
     static func from(response: ListResponse) -> [KubernetesService] {
-        response.items.map { item in
-            KubernetesService(
-                name: item.metadata.name,
-                namespace: item.metadata.namespace,
-                type: item.spec.type ?? "ClusterIP",
-                clusterIP: item.spec.clusterIP,
-                ports: item.spec.ports?.map { port in
-                    ServicePort(
-                        name: port.name,
-                        port: port.port,
-                        targetPort: port.targetPort?.intValue ?? port.port,
-                        protocol: port.protocol
-                    )
-                } ?? []
-            )
-        }
+        response.items.map(from(item:))
+    }
+
+    static func from(item: ListResponse.Item) -> KubernetesService {
+        KubernetesService(
+            name: item.metadata.name,
+            namespace: item.metadata.namespace,
+            type: item.spec.type ?? "ClusterIP",
+            clusterIP: item.spec.clusterIP,
+            ports: item.spec.ports?.map { port in
+                ServicePort(
+                    name: port.name,
+                    port: port.port,
+                    targetPort: port.targetPort?.intValue ?? port.port,
+                    protocol: port.protocol
+                )
+            } ?? []
+        )
     }
 }
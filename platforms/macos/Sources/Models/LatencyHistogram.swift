@@ -0,0 +1,87 @@
+/**
+ * LatencyHistogram.swift
+ * PortKiller
+ *
+ * Fixed-size log-linear histogram of durations, cheap enough to record into on every
+ * scan phase and precise enough for p50/p99 in the performance HUD.
+ */
+
+/// Durations bucketed by power of two of nanoseconds, each power split into
+/// `subBucketCount` linear buckets, so a quantile is off by at most 1/8 of its value.
+/// Recording is a few integer ops and one array increment; nothing allocates after init.
+struct LatencyHistogram: Sendable, Equatable {
+    nonisolated private static let subBucketBits = 3
+    nonisolated private static let subBucketCount = 1 << subBucketBits
+    /// Enough buckets for every positive `Int64` nanosecond value
+    nonisolated private static let bucketCount = (64 - subBucketBits + 1) * subBucketCount
+
+    private(set) var count = 0
+    private(set) var total: Duration = .zero
+    private(set) var maximum: Duration = .zero
+
+    private var buckets: [Int]
+
+    nonisolated init() {
+        buckets = Array(repeating: 0, count: Self.bucketCount)
+    }
+
+    nonisolated var isEmpty: Bool { count == 0 }
+
+    nonisolated var mean: Duration {
+        count > 0 ? total / count : .zero
+    }
+
+    nonisolated mutating func record(_ duration: Duration) {
+        let nanoseconds = Swift.max(0, Self.nanoseconds(of: duration))
+        buckets[Self.bucketIndex(of: UInt64(nanoseconds))] += 1
+        count += 1
+        total += duration
+        maximum = Swift.max(maximum, duration)
+    }
+
+    /// The duration below which a fraction `q` of the recorded samples fall (midpoint
+    /// of the bucket holding that rank); zero if nothing was recorded.
+    nonisolated func quantile(_ q: Double) -> Duration {
+        guard count > 0 else { return .zero }
+        let rank = Swift.max(1, Int((q * Double(count)).rounded(.up)))
+        var seen = 0
+        for (index, bucketCount) in buckets.enumerated() where bucketCount > 0 {
+            seen += bucketCount
+            if seen >= rank {
+                let (lower, width) = Self.bounds(ofBucket: index)
+                // Never report more than was actually observed
+                return Swift.min(.nanoseconds(Int64(lower + width / 2)), maximum)
+            }
+        }
+        return maximum
+    }
+
+    nonisolated mutating func reset() {
+        self = LatencyHistogram()
+    }
+
+    // MARK: - Private Helpers
+
+    /// Values below `subBucketCount` get a bucket each; above, the top `subBucketBits`
+    /// bits after the leading one pick the sub-bucket within the value's power of two.
+    nonisolated private static func bucketIndex(of value: UInt64) -> Int {
+        guard value >= UInt64(subBucketCount) else { return Int(value) }
+        let exponent = 63 - value.leadingZeroBitCount
+        let mantissa = Int(value >> UInt64(exponent - subBucketBits)) & (subBucketCount - 1)
+        return (exponent - subBucketBits + 1) * subBucketCount + mantissa
+    }
+
+    nonisolated private static func bounds(ofBucket index: Int) -> (lower: UInt64, width: UInt64) {
+        guard index >= subBucketCount else { return (UInt64(index), 1) }
+        let exponent = index / subBucketCount + subBucketBits - 1
+        let mantissa = UInt64(index % subBucketCount)
+        let width = UInt64(1) << UInt64(exponent - subBucketBits)
+        return ((UInt64(subBucketCount) + mantissa) * width, width)
+    }
+
+    nonisolated private static func nanoseconds(of duration: Duration) -> Int64 {
+        let (seconds, attoseconds) = duration.components
+        guard seconds < Int64.max / 1_000_000_000 - 1 else { return .max }
+        return seconds * 1_000_000_000 + attoseconds / 1_000_000_000
+    }
+}
@@ -0,0 +1,198 @@
+/**
+ * LogRingBuffer.swift
+ * PortKiller
+ *
+ * Fixed-capacity log storage for tunnel and port-forward output.
+ * Lines are stored as compacted UTF-8 with a timestamp and severity/tag bytes;
+ * `String`s are only decoded for rows a view actually reads.
+ */
+
+import Foundation
+import Defaults
+
+/// One stored log line
+struct LogSlot: Sendable {
+    /// Longest line kept; longer lines are truncated (cloudflared debug lines can be huge)
+    nonisolated static let maxLineBytes = 4 * 1024
+
+    /// Per-slot bookkeeping cost on top of the UTF-8 bytes
+    nonisolated static let overhead = 48
+
+    /// Monotonic per-buffer sequence number, used as the row identity
+    let sequence: UInt64
+    let timestamp: Date
+    /// Producer-defined severity (e.g. `TunnelLogEntry.LogLevel.rawValue`)
+    let severity: UInt8
+    /// Producer-defined source tag (e.g. kubectl vs socat)
+    let tag: UInt8
+    let utf8: ContiguousArray<UInt8>
+
+    /// Approximate heap cost, counted against the global memory budget
+    nonisolated var cost: Int { utf8.count + Self.overhead }
+
+    nonisolated var message: String { String(decoding: utf8, as: UTF8.self) }
+}
+
+/// A log row type that can be read from a `LogSlot`
+protocol LogRingEntry: Sendable {
+    nonisolated init(slot: LogSlot)
+}
+
+/// What `LogMemoryBudget` needs from a buffer, independent of its entry type
+@MainActor
+protocol BudgetedLogBuffer: AnyObject {
+    var byteCount: Int { get }
+    var count: Int { get }
+    func removeOldest(_ count: Int)
+}
+
+/// Bounded, per-connection log buffer.
+///
+/// Holds at most `Defaults[.logLinesPerConnection]` lines by default; a buffer given a
+/// capacity at init keeps that many instead. Appending beyond the limit overwrites the
+/// oldest slot in place. All buffers together are also kept under
+/// `Defaults[.logMemoryBudgetMB]` by `LogMemoryBudget`.
+@Observable
+@MainActor
+final class LogRingBuffer<Entry: LogRingEntry>: BudgetedLogBuffer {
+
+    /// Ring storage; once full, `head` is the oldest slot
+    private var slots: [LogSlot] = []
+    private var head = 0
+    private var nextSequence: UInt64 = 0
+
+    /// Approximate bytes held by this buffer
+    private(set) var byteCount = 0
+
+    /// Lines kept regardless of settings, if given
+    @ObservationIgnored private let fixedCapacity: Int?
+
+    /// - Parameter capacity: lines to keep; nil follows `Defaults[.logLinesPerConnection]`
+    init(capacity: Int? = nil) {
+        fixedCapacity = capacity
+        LogMemoryBudget.shared.register(self)
+    }
+
+    var count: Int { slots.count }
+    var isEmpty: Bool { slots.isEmpty }
+
+    /// All lines, oldest first. Entries are cheap views over the stored bytes.
+    var entries: [Entry] {
+        (0..<slots.count).map { Entry(slot: slots[(head + $0) % slots.count]) }
+    }
+
+    var last: Entry? {
+        guard !slots.isEmpty else { return nil }
+        return Entry(slot: slots[(head + slots.count - 1) % slots.count])
+    }
+
+    /// Appends one line, evicting the oldest if the buffer is full.
+    func append(_ message: String, severity: UInt8, tag: UInt8 = 0, timestamp: Date = Date()) {
+        insert(message, severity: severity, tag: tag, timestamp: timestamp, capacity: capacity)
+        LogMemoryBudget.shared.enforce()
+    }
+
+    /// Appends a batch of lines with a single budget check.
+    func append(contentsOf lines: [(message: String, severity: UInt8, tag: UInt8)], timestamp: Date = Date()) {
+        let capacity = self.capacity
+        for line in lines {
+            insert(line.message, severity: line.severity, tag: line.tag, timestamp: timestamp, capacity: capacity)
+        }
+        LogMemoryBudget.shared.enforce()
+    }
+
+    func removeAll() {
+        slots.removeAll()
+        head = 0
+        byteCount = 0
+    }
+
+    /// Drops the oldest `count` lines.
+    func removeOldest(_ count: Int) {
+        linearize()
+        let dropped = min(count, slots.count)
+        byteCount -= slots.prefix(dropped).reduce(0) { $0 + $1.cost }
+        slots.removeFirst(dropped)
+    }
+
+    // MARK: - Private Methods
+
+    private var capacity: Int { max(1, fixedCapacity ?? Defaults[.logLinesPerConnection]) }
+
+    /// `message`'s UTF-8, cut to at most `LogSlot.maxLineBytes` on a scalar boundary
+    private static func truncatedUTF8(_ message: String) -> ContiguousArray<UInt8> {
+        let utf8 = message.utf8
+        guard utf8.count > LogSlot.maxLineBytes else { return ContiguousArray(utf8) }
+        var end = utf8.index(utf8.startIndex, offsetBy: LogSlot.maxLineBytes)
+        // Back off over continuation bytes (10xxxxxx) to the start of the cut scalar
+        while end > utf8.startIndex, utf8[end] & 0xC0 == 0x80 {
+            utf8.formIndex(before: &end)
+        }
+        return ContiguousArray(utf8[..<end])
+    }
+
+    private func insert(_ message: String, severity: UInt8, tag: UInt8, timestamp: Date, capacity: Int) {
+        let slot = LogSlot(
+            sequence: nextSequence,
+            timestamp: timestamp,
+            severity: severity,
+            tag: tag,
+            utf8: Self.truncatedUTF8(message)
+        )
+        nextSequence &+= 1
+
+        if slots.count > capacity {
+            // The per-connection cap was lowered in settings
+            removeOldest(slots.count - capacity)
+        }
+
+        byteCount += slot.cost
+        if slots.count < capacity {
+            linearize()
+            slots.append(slot)
+        } else {
+            byteCount -= slots[head].cost
+            slots[head] = slot
+            head = (head + 1) % slots.count
+        }
+    }
+
+    /// Rotates storage so the oldest slot is at index 0.
+    private func linearize() {
+        guard head != 0 else { return }
+        slots = Array(slots[head...] + slots[..<head])
+        head = 0
+    }
+}
+
+/// Keeps all log buffers together under `Defaults[.logMemoryBudgetMB]`, trimming the
+/// largest buffers (oldest lines first) when the total is exceeded.
+@MainActor
+final class LogMemoryBudget {
+    static let shared = LogMemoryBudget()
+
+    private struct WeakBuffer {
+        weak var buffer: (any BudgetedLogBuffer)?
+    }
+
+    private var buffers: [WeakBuffer] = []
+
+    func register(_ buffer: any BudgetedLogBuffer) {
+        buffers.append(WeakBuffer(buffer: buffer))
+    }
+
+    func enforce() {
+        buffers.removeAll { $0.buffer == nil }
+        let live = buffers.compactMap(\.buffer)
+
+        let budget = max(1, Defaults[.logMemoryBudgetMB]) * 1024 * 1024
+        var total = live.reduce(0) { $0 + $1.byteCount }
+
+        while total > budget, let largest = live.max(by: { $0.byteCount < $1.byteCount }), largest.count > 0 {
+            // Drop a quarter at a time so a full budget doesn't trim on every line
+            let before = largest.byteCount
+            largest.removeOldest(max(1, largest.count / 4))
+            total -= before - largest.byteCount
+        }
+    }
+}
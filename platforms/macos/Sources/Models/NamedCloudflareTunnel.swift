@@ -90,9 +90,12 @@ final class NamedCloudflareTunnel: Identifiable, Sendable {
     var lastError: String?
     var metricsPort: Int?
     var activeConnectionCount: Int = 0
-    var logs: [TunnelLogEntry] = []
+    /// Throughput and latency history from the metrics endpoint, reset on every run
+    var metrics = TunnelMetrics()
+    let logBuffer = LogRingBuffer<TunnelLogEntry>()
 
-    private static let maxLogEntries = 500
+    /// Buffered log lines, oldest first
+    var logs: [TunnelLogEntry] { logBuffer.entries }
 
     nonisolated var id: String { tunnelID }
 
@@ -102,15 +105,19 @@ final class NamedCloudflareTunnel: Identifiable, Sendable {
         self.createdAt = createdAt
     }
 
-    func addLogEntry(_ entry: TunnelLogEntry) {
-        logs.append(entry)
-        if logs.count > Self.maxLogEntries {
-            logs.removeFirst(logs.count - Self.maxLogEntries)
-        }
+    func addLogLines(_ lines: [(message: String, level: TunnelLogEntry.LogLevel)]) {
+        logBuffer.append(contentsOf: lines.map { ($0.message, $0.level.rawValue, 0) })
     }
 
     func clearLogs() {
-        logs.removeAll()
+        logBuffer.removeAll()
+    }
+
+    /// Writes `value` only if it differs, so observers aren't invalidated by no-op updates.
+    func updateIfChanged<Value: Equatable>(_ keyPath: ReferenceWritableKeyPath<NamedCloudflareTunnel, Value>, to value: Value) {
+        if self[keyPath: keyPath] != value {
+            self[keyPath: keyPath] = value
+        }
     }
 
     enum IngressSource: String, Sendable {
@@ -17,16 +17,25 @@ struct PortFilter: Equatable, Sendable {
         showOnlyWatched
     }
 
-    func matches(_ port: PortInfo, favorites: Set<Int>, watched: [WatchedPort]) -> Bool {
+    /// Whether `port` passes every criterion.
+    ///
+    /// - Parameter searchHits: IDs matching `searchText` from a `PortSearchIndex`; when
+    ///   given, scanned ports are looked up there instead of being searched one by one.
+    ///   Ports outside the index (inactive placeholders) are still searched directly.
+    func matches(
+        _ port: PortInfo,
+        favorites: Set<Int>,
+        watched: [WatchedPort],
+        searchHits: Set<PortInfo.ID>? = nil
+    ) -> Bool {
         // Search text filter
         if !searchText.isEmpty {
-            let query = searchText.lowercased()
-            let matches = port.processName.lowercased().contains(query) ||
-                          String(port.port).contains(query) ||
-                          String(port.pid).contains(query) ||
-                          port.address.lowercased().contains(query) ||
-                          port.user.lowercased().contains(query) ||
-                          port.command.lowercased().contains(query)
+            let matches: Bool
+            if let searchHits, port.isActive {
+                matches = searchHits.contains(port.id)
+            } else {
+                matches = matchesSearch(port)
+            }
             if !matches { return false }
         }
 
@@ -46,6 +55,17 @@ struct PortFilter: Equatable, Sendable {
         return true
     }
 
+    /// Direct case-insensitive search of one port, for ports not covered by an index
+    func matchesSearch(_ port: PortInfo) -> Bool {
+        let query = searchText.lowercased()
+        return port.processName.lowercased().contains(query) ||
+               String(port.port).contains(query) ||
+               String(port.pid).contains(query) ||
+               port.address.lowercased().contains(query) ||
+               port.user.lowercased().contains(query) ||
+               port.command.lowercased().contains(query)
+    }
+
     mutating func reset() {
         searchText = ""
         minPort = nil
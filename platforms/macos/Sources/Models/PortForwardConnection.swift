@@ -104,15 +104,47 @@ enum PortForwardStatus: String, Sendable {
     }
 }
 
+// MARK: - Startup Timing
+
+/// How long each stage of the last start took, each measured from the start request
+struct PortForwardStartupTiming: Equatable, Sendable {
+    /// Until the kubectl child (or the direct exec socat) was running
+    var spawn: Duration?
+    /// Until kubectl reported "Forwarding from", i.e. the local port accepts connections
+    var ready: Duration?
+    /// Until the proxy port was listening
+    var proxyReady: Duration?
+
+    var isEmpty: Bool { spawn == nil && ready == nil && proxyReady == nil }
+}
+
 // MARK: - Connection Runtime State
 
-/// A single log entry for a port-forward connection
-struct PortForwardLogEntry: Identifiable, Sendable {
-    let id = UUID()
+/// A single log entry for a port-forward connection, read from a `LogRingBuffer` slot
+struct PortForwardLogEntry: Identifiable, Sendable, LogRingEntry {
+    let id: UInt64
     let timestamp: Date
-    let message: String
     let type: PortForwardProcessType
     let isError: Bool
+    private let slot: LogSlot
+
+    /// Decoded on access, so only rendered rows pay for a String
+    var message: String { slot.message }
+
+    nonisolated init(slot: LogSlot) {
+        self.id = slot.sequence
+        self.timestamp = slot.timestamp
+        self.type = slot.tag == Self.proxyTag ? .proxy : .portForward
+        self.isError = slot.severity != 0
+        self.slot = slot
+    }
+
+    nonisolated static let portForwardTag: UInt8 = 0
+    nonisolated static let proxyTag: UInt8 = 1
+
+    nonisolated static func tag(for type: PortForwardProcessType) -> UInt8 {
+        type == .proxy ? proxyTag : portForwardTag
+    }
 }
 
 /// Runtime state for a port-forward connection (not persisted)
@@ -126,24 +158,44 @@ final class PortForwardConnectionState: Identifiable, Hashable {
     var portForwardTask: Task<Void, Never>?
     var proxyTask: Task<Void, Never>?
     var lastError: String?
-    var logs: [PortForwardLogEntry] = []
+    let logBuffer = LogRingBuffer<PortForwardLogEntry>()
+    /// Counters of the in-process proxy, refreshed by the monitoring loop
+    var relayStats: TCPRelay.Statistics?
     /// Tracks if the connection was stopped intentionally by the user (vs unexpected disconnect)
     var isIntentionallyStopped: Bool = false
+    /// Startup stages of the current (or last) start, see `markStartup(_:)`
+    var startupTiming = PortForwardStartupTiming()
+    /// When the current start was requested
+    private var startupBegan: ContinuousClock.Instant?
 
-    /// Maximum log entries to keep per connection (memory optimization)
-    private static let maxLogEntries = 100
+    /// Buffered log lines, oldest first
+    var logs: [PortForwardLogEntry] { logBuffer.entries }
 
     func appendLog(_ message: String, type: PortForwardProcessType, isError: Bool = false) {
-        let entry = PortForwardLogEntry(timestamp: Date(), message: message, type: type, isError: isError)
-        logs.append(entry)
-        // Keep only last N log entries to prevent memory accumulation
-        if logs.count > Self.maxLogEntries {
-            logs.removeFirst(logs.count - Self.maxLogEntries)
-        }
+        logBuffer.append(message, severity: isError ? 1 : 0, tag: PortForwardLogEntry.tag(for: type))
+    }
+
+    /// Appends a batch of output lines from one process; the buffer stays bounded
+    func appendLogs(_ lines: [PortForwardLogLine], type: PortForwardProcessType) {
+        let tag = PortForwardLogEntry.tag(for: type)
+        logBuffer.append(contentsOf: lines.map { ($0.message, $0.isError ? 1 : 0, tag) })
     }
 
     func clearLogs() {
-        logs.removeAll()
+        logBuffer.removeAll()
+    }
+
+    /// Starts timing a new start request, clearing the previous breakdown
+    func beginStartup() {
+        startupBegan = .now
+        startupTiming = PortForwardStartupTiming()
+    }
+
+    /// Records that the current start reached `stage`. Only the first time counts, so a
+    /// proxy restarted later by the monitor doesn't overwrite the startup figure.
+    func markStartup(_ stage: WritableKeyPath<PortForwardStartupTiming, Duration?>) {
+        guard let startupBegan, startupTiming[keyPath: stage] == nil else { return }
+        startupTiming[keyPath: stage] = ContinuousClock.now - startupBegan
     }
 
     /// Whether the connection is fully established (port-forward + optional proxy)
@@ -31,8 +31,17 @@ enum KubectlError: Error, LocalizedError, Sendable {
 
 // MARK: - Callback Types
 
-/// Callback for log output from port-forward processes
-typealias LogHandler = @Sendable (String, PortForwardProcessType, Bool) -> Void
+/// One output line from a port-forward process
+struct PortForwardLogLine: Sendable {
+    let message: String
+    let isError: Bool
+}
+
+/// Callback for log output from port-forward processes, delivered in batches
+typealias LogHandler = @Sendable ([PortForwardLogLine], PortForwardProcessType) -> Void
 
 /// Callback for port conflict errors (address already in use)
 typealias PortConflictHandler = @Sendable (Int) -> Void
+
+/// Callback for a connection's kubectl or socat child exiting unexpectedly
+typealias ChildExitHandler = @Sendable (UUID, PortForwardProcessType) -> Void
@@ -0,0 +1,34 @@
+/**
+ * PortHistoryEvent.swift
+ * PortKiller
+ *
+ * One entry of the persistent port history: a listener appearing or going away.
+ */
+
+import Foundation
+
+/// A listener opening or closing a port, as recorded in the port history
+nonisolated struct PortHistoryEvent: Hashable, Sendable, Identifiable {
+    enum Kind: UInt8, Sendable {
+        /// Started listening
+        case opened = 1
+        /// Stopped listening (or was gone at the next scan after a restart)
+        case closed = 2
+        /// Already listening when this part of the history began (app launch, a new
+        /// segment, or the start of a query range)
+        case running = 3
+    }
+
+    let timestamp: Date
+    let port: Int
+    let pid: Int
+    let processName: String
+    let kind: Kind
+
+    var id: String { "\(timestamp.timeIntervalSince1970)-\(port)-\(pid)-\(kind.rawValue)" }
+
+    var key: PortKey { PortKey(port: port, pid: pid) }
+
+    /// Whether the listener holds the port from this event on
+    var isHolding: Bool { kind != .closed }
+}
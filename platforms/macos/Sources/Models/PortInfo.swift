@@ -15,9 +15,13 @@ import Defaults
 /// PortInfo encapsulates all details about a listening network port, including
 /// the process that owns it, the address it's bound to, and whether it's currently active.
 struct PortInfo: Identifiable, Hashable, Sendable {
+    /// Packed (port, pid, fd number, isActive), see `stableID(port:pid:fd:isActive:)`
+    typealias ID = UInt64
+
     /// Stable identifier for diffing in SwiftUI.
-    /// Using a deterministic key prevents rebuilding every row when scans refresh.
-    var id: String { "\(port):\(pid):\(fd):\(isActive)" }
+    /// A deterministic integer computed once at construction, so the same listener keeps
+    /// its row across scans and SwiftUI compares a word instead of a formatted string.
+    let id: ID
 
     /// The port number (e.g., 3000, 8080)
     let port: Int
@@ -49,6 +53,45 @@ struct PortInfo: Identifiable, Hashable, Sendable {
     /// Formatted port number for display (e.g., ":3000")
     var displayPort: String { ":\(port)" }
 
+    nonisolated init(
+        port: Int,
+        pid: Int,
+        processName: String,
+        address: String,
+        user: String,
+        command: String,
+        fd: String,
+        isActive: Bool,
+        processType: ProcessType
+    ) {
+        self.id = Self.stableID(port: port, pid: pid, fd: fd, isActive: isActive)
+        self.port = port
+        self.pid = pid
+        self.processName = processName
+        self.address = address
+        self.user = user
+        self.command = command
+        self.fd = fd
+        self.isActive = isActive
+        self.processType = processType
+    }
+
+    /// Packs the identity of a listener into 64 bits: port (16) | pid (32) | fd number (15) | active (1).
+    ///
+    /// The fd number is the leading digits of `fd` ("19u" → 19); descriptors above 32767
+    /// wrap, which only matters for one process holding the same port on two such fds.
+    nonisolated static func stableID(port: Int, pid: Int, fd: String, isActive: Bool) -> ID {
+        var descriptor: UInt64 = 0
+        for byte in fd.utf8 {
+            guard byte >= UInt8(ascii: "0"), byte <= UInt8(ascii: "9") else { break }
+            descriptor = descriptor &* 10 &+ UInt64(byte - UInt8(ascii: "0"))
+        }
+        return UInt64(UInt16(truncatingIfNeeded: port)) << 48
+            | UInt64(UInt32(truncatingIfNeeded: pid)) << 16
+            | (descriptor & 0x7FFF) << 1
+            | (isActive ? 1 : 0)
+    }
+
     /// Create an inactive placeholder for a favorited/watched port
     ///
     /// - Parameter port: The port number
@@ -100,4 +143,30 @@ struct PortInfo: Identifiable, Hashable, Sendable {
             processType: processType
         )
     }
+
+    /// Create an active port from scanner-cached process metadata
+    ///
+    /// Skips the override lookup and type detection done by `active(port:pid:processName:...)`;
+    /// the metadata already carries the resolved process type.
+    ///
+    /// - Parameters:
+    ///   - port: The port number
+    ///   - pid: Process ID
+    ///   - address: Network address
+    ///   - fd: File descriptor information
+    ///   - metadata: Cached name, command, user and type of the owning process
+    /// - Returns: An active PortInfo instance
+    static func active(port: Int, pid: Int, address: String, fd: String, metadata: ProcessMetadata) -> PortInfo {
+        PortInfo(
+            port: port,
+            pid: pid,
+            processName: metadata.processName,
+            address: address,
+            user: metadata.user,
+            command: metadata.command,
+            fd: fd,
+            isActive: true,
+            processType: metadata.processType
+        )
+    }
 }
@@ -0,0 +1,17 @@
+import Defaults
+import Foundation
+
+/// How listening sockets are enumerated on each refresh.
+enum PortScanBackend: String, CaseIterable, Codable, Defaults.Serializable, Sendable {
+    /// Query the kernel directly through libproc (no process spawn).
+    case native = "native"
+    /// Spawn `lsof` and parse its text output.
+    case lsof = "lsof"
+
+    var displayName: String {
+        switch self {
+        case .native: return "Native"
+        case .lsof: return "lsof"
+        }
+    }
+}
@@ -0,0 +1,77 @@
+/**
+ * PortScanDelta.swift
+ * PortKiller
+ *
+ * Describes how the set of listening ports changed between two scans.
+ * Scanners keep the previous snapshot so consumers only process what changed.
+ */
+
+import Foundation
+
+/// Identity of a listening port for diffing: the same port held by the same process.
+///
+/// Replaces the formatted `"port-pid"` strings previously allocated on every comparison.
+struct PortKey: Hashable, Sendable {
+    let port: Int
+    let pid: Int
+}
+
+extension PortInfo {
+    /// Port + PID identity used for scan diffing and first-seen tracking
+    nonisolated var key: PortKey { PortKey(port: port, pid: pid) }
+}
+
+/// Result of an incremental scan
+struct PortScanDelta: Sendable {
+    /// Complete list of listening ports after this scan, sorted by port number
+    let ports: [PortInfo]
+
+    /// Ports whose (port, pid) was not present in the previous scan
+    let added: [PortInfo]
+
+    /// Ports from the previous scan that are no longer listening
+    let removed: [PortInfo]
+
+    /// Ports still held by the same process whose details changed (address, fd, command, type)
+    let changed: [PortInfo]
+
+    /// True when nothing changed since the previous scan
+    nonisolated var isEmpty: Bool {
+        added.isEmpty && removed.isEmpty && changed.isEmpty
+    }
+}
+
+/// Remembers the previous scan and computes deltas against it.
+///
+/// Owned by a scanner actor; not thread-safe on its own.
+struct PortSnapshotDiffer: Sendable {
+    private var previous: [PortKey: PortInfo] = [:]
+
+    /// Diffs `ports` against the previous snapshot and makes it the new baseline.
+    ///
+    /// Unchanged ports built from the same cached metadata share string storage, so the
+    /// equality check is effectively a pointer comparison per field.
+    nonisolated mutating func delta(for ports: [PortInfo]) -> PortScanDelta {
+        var current = [PortKey: PortInfo](minimumCapacity: ports.count)
+        var added: [PortInfo] = []
+        var changed: [PortInfo] = []
+
+        for port in ports {
+            let key = port.key
+            current[key] = port
+            if let old = previous[key] {
+                if old != port { changed.append(port) }
+            } else {
+                added.append(port)
+            }
+        }
+
+        var removed: [PortInfo] = []
+        for (key, old) in previous where current[key] == nil {
+            removed.append(old)
+        }
+
+        previous = current
+        return PortScanDelta(ports: ports, added: added, removed: removed, changed: changed)
+    }
+}
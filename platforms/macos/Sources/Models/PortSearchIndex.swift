@@ -0,0 +1,119 @@
+/**
+ * PortSearchIndex.swift
+ * PortKiller
+ *
+ * Search haystacks for the port list, built once per scan instead of per keystroke.
+ */
+
+import Foundation
+import Darwin
+
+/// Lowercased search text for every row of a `PortTable`, matched with `memmem`.
+///
+/// Rows share their process name, address, user and command through the table's
+/// interner, so each distinct string is folded once and tested once per query: 5,000
+/// listeners of one Java process cost one scan of its command line, not 5,000.
+/// Port and PID digits are kept per row and only consulted for all-digit queries.
+///
+/// When a query extends the previous one (typing "post" → "postg"), only the previous
+/// matches are re-tested, since anything containing the longer query contains the shorter.
+struct PortSearchIndex: Sendable {
+    /// Generation of the table this index was built from
+    let generation: UInt64
+
+    /// Lowercased UTF-8 of each interned string, same indices as the table's interner
+    private let foldedStrings: [[UInt8]]
+    /// Interned (name, address, user, command) indices, four per row
+    private let rowStrings: [Int32]
+    /// Decimal port and PID of each row, in one buffer with per-row bounds
+    private let digits: [UInt8]
+    private let digitBounds: [(port: Range<Int>, pid: Range<Int>)]
+    private let ids: [PortInfo.ID]
+
+    /// Previous query and its matching rows, for incremental narrowing
+    private var lastQuery: [UInt8] = []
+    private var lastMatches: [Int] = []
+
+    nonisolated init(table: PortTable) {
+        generation = table.generation
+        foldedStrings = table.internedStrings.map { Array($0.lowercased().utf8) }
+
+        var rowStrings: [Int32] = []
+        var digits: [UInt8] = []
+        var digitBounds: [(port: Range<Int>, pid: Range<Int>)] = []
+        rowStrings.reserveCapacity(table.count * 4)
+        digitBounds.reserveCapacity(table.count)
+
+        for row in table.indices {
+            let strings = table.stringIndices(at: row)
+            rowStrings.append(contentsOf: [strings.processName, strings.address, strings.user, strings.command])
+
+            let portStart = digits.count
+            digits.append(contentsOf: String(table.port(at: row)).utf8)
+            let pidStart = digits.count
+            digits.append(contentsOf: String(table.pid(at: row)).utf8)
+            digitBounds.append((portStart..<pidStart, pidStart..<digits.count))
+        }
+
+        self.rowStrings = rowStrings
+        self.digits = digits
+        self.digitBounds = digitBounds
+        self.ids = table.indices.map(table.id(at:))
+    }
+
+    /// Rows whose name, port, PID, address, user or command contains `query`
+    /// (case-insensitive), in table order.
+    nonisolated mutating func matchingRows(for query: String) -> [Int] {
+        let needle = Array(query.lowercased().utf8)
+        guard !needle.isEmpty else { return Array(ids.indices) }
+
+        let candidates: [Int]
+        if !lastQuery.isEmpty, Self.contains(needle[...], lastQuery) {
+            candidates = lastMatches
+        } else {
+            candidates = Array(ids.indices)
+        }
+
+        let isNumeric = needle.allSatisfy { $0 >= UInt8(ascii: "0") && $0 <= UInt8(ascii: "9") }
+        // Per interned string: 0 = untested, 1 = match, 2 = no match
+        var stringResults = [UInt8](repeating: 0, count: foldedStrings.count)
+
+        let matches = candidates.filter { row in
+            if isNumeric {
+                let bounds = digitBounds[row]
+                if Self.contains(digits[bounds.port], needle) || Self.contains(digits[bounds.pid], needle) {
+                    return true
+                }
+            }
+            for slot in (row * 4)..<(row * 4 + 4) {
+                let string = Int(rowStrings[slot])
+                if stringResults[string] == 0 {
+                    stringResults[string] = Self.contains(foldedStrings[string][...], needle) ? 1 : 2
+                }
+                if stringResults[string] == 1 { return true }
+            }
+            return false
+        }
+
+        lastQuery = needle
+        lastMatches = matches
+        return matches
+    }
+
+    /// IDs of the rows matching `query`
+    nonisolated mutating func matchingIDs(for query: String) -> Set<PortInfo.ID> {
+        Set(matchingRows(for: query).map { ids[$0] })
+    }
+
+    // MARK: - Private Helpers
+
+    /// Byte substring test; `needle` must not be empty.
+    nonisolated private static func contains(_ haystack: ArraySlice<UInt8>, _ needle: [UInt8]) -> Bool {
+        guard haystack.count >= needle.count else { return false }
+        return haystack.withUnsafeBufferPointer { hay in
+            needle.withUnsafeBufferPointer { pin in
+                memmem(hay.baseAddress, hay.count, pin.baseAddress, pin.count) != nil
+            }
+        }
+    }
+}
@@ -0,0 +1,200 @@
+/**
+ * PortTable.swift
+ * PortKiller
+ *
+ * Column-wise storage for the scanned port list.
+ * A test runner or dev server can hold thousands of listeners that all share one
+ * process name, user and command; storing each row as six Strings multiplied that
+ * per port. Here the strings live once in an interner and rows are plain integers.
+ */
+
+import Foundation
+
+/// Deduplicating string store: each distinct string is kept once and referred to by index.
+struct StringInterner: Sendable {
+    private(set) var strings: [String] = []
+    private var indices: [String: Int32] = [:]
+
+    /// Number of distinct strings stored
+    nonisolated var count: Int { strings.count }
+
+    /// Returns the index of `string`, storing it on first sight.
+    nonisolated mutating func intern(_ string: String) -> Int32 {
+        if let index = indices[string] { return index }
+        let index = Int32(strings.count)
+        strings.append(string)
+        indices[string] = index
+        return index
+    }
+
+    nonisolated subscript(index: Int32) -> String { strings[Int(index)] }
+}
+
+/// The scanned ports, one column per field, with interned strings and integer row IDs.
+///
+/// Views that only need a field or two (counts, port numbers, types, selection lookup)
+/// read it by row index without building a `PortInfo`. Iterating the table, or
+/// subscripting a row, materializes a `PortInfo` whose strings point at the interned
+/// storage, so copies of it share memory instead of duplicating it.
+struct PortTable: RandomAccessCollection, Sendable {
+    /// Bumped on every mutation; lets views observe changes with one integer compare
+    private(set) var generation: UInt64 = 0
+
+    // Columns, one entry per row
+    private var portColumn: [UInt16] = []
+    private var pidColumn: [Int32] = []
+    private var nameColumn: [Int32] = []
+    private var userColumn: [Int32] = []
+    private var commandColumn: [Int32] = []
+    private var addressColumn: [Int32] = []
+    /// Short enough ("19u") to be stored inline by String, so not worth interning
+    private var fdColumn: [String] = []
+    private var activeColumn: [Bool] = []
+    private var typeColumn: [ProcessType] = []
+    private var idColumn: [PortInfo.ID] = []
+
+    /// Row of each stable ID
+    private var rowsByID: [PortInfo.ID: Int] = [:]
+    /// Rows per process type, for sidebar badges
+    private var typeCounts: [ProcessType: Int] = [:]
+
+    /// Process names, users, commands and addresses of every row
+    private var strings = StringInterner()
+
+    /// The interner is rebuilt once it holds this many times more strings than rows,
+    /// so names of long-gone processes don't accumulate forever
+    nonisolated private static let internerSlack = 4
+
+    init() {}
+
+    init(_ ports: some Collection<PortInfo>) {
+        replaceAll(with: ports)
+    }
+
+    // MARK: - Collection
+
+    nonisolated var startIndex: Int { 0 }
+    nonisolated var endIndex: Int { idColumn.count }
+
+    /// Materializes the row at `position`
+    nonisolated subscript(position: Int) -> PortInfo {
+        PortInfo(
+            port: Int(portColumn[position]),
+            pid: Int(pidColumn[position]),
+            processName: strings[nameColumn[position]],
+            address: strings[addressColumn[position]],
+            user: strings[userColumn[position]],
+            command: strings[commandColumn[position]],
+            fd: fdColumn[position],
+            isActive: activeColumn[position],
+            processType: typeColumn[position]
+        )
+    }
+
+    // MARK: - Column Access
+
+    nonisolated func id(at row: Int) -> PortInfo.ID { idColumn[row] }
+    nonisolated func port(at row: Int) -> Int { Int(portColumn[row]) }
+    nonisolated func pid(at row: Int) -> Int { Int(pidColumn[row]) }
+    nonisolated func processName(at row: Int) -> String { strings[nameColumn[row]] }
+    nonisolated func processType(at row: Int) -> ProcessType { typeColumn[row] }
+
+    /// Row holding the port with `id`, if it is in the table
+    nonisolated func row(for id: PortInfo.ID) -> Int? { rowsByID[id] }
+
+    /// The port with `id`, if it is in the table
+    nonisolated subscript(id id: PortInfo.ID) -> PortInfo? {
+        rowsByID[id].map { self[$0] }
+    }
+
+    /// Number of rows of `type`
+    nonisolated func count(of type: ProcessType) -> Int { typeCounts[type] ?? 0 }
+
+    /// Distinct strings currently interned (for memory diagnostics)
+    nonisolated var internedStringCount: Int { strings.count }
+
+    /// Every interned string, indexed by the values of `stringIndices(at:)`
+    nonisolated var internedStrings: [String] { strings.strings }
+
+    /// Interned indices of a row's searchable strings
+    nonisolated func stringIndices(at row: Int) -> (processName: Int32, address: Int32, user: Int32, command: Int32) {
+        (nameColumn[row], addressColumn[row], userColumn[row], commandColumn[row])
+    }
+
+    // MARK: - Mutation
+
+    /// Replaces every row with `ports`, keeping their order.
+    nonisolated mutating func replaceAll(with ports: some Collection<PortInfo>) {
+        if strings.count > max(256, ports.count * Self.internerSlack) {
+            strings = StringInterner()
+        }
+
+        removeRows(keepingCapacity: true)
+        reserveRows(ports.count)
+        for port in ports {
+            appendRow(port)
+        }
+        generation &+= 1
+    }
+
+    /// Removes the row with `id`; returns whether it was present.
+    @discardableResult
+    nonisolated mutating func remove(id: PortInfo.ID) -> Bool {
+        guard rowsByID[id] != nil else { return false }
+        let remaining = filter { $0.id != id }
+        replaceAll(with: remaining)
+        return true
+    }
+
+    /// Removes every row.
+    nonisolated mutating func removeAll() {
+        removeRows(keepingCapacity: false)
+        generation &+= 1
+    }
+
+    // MARK: - Private Helpers
+
+    nonisolated private mutating func appendRow(_ port: PortInfo) {
+        rowsByID[port.id] = idColumn.count
+        idColumn.append(port.id)
+        portColumn.append(UInt16(truncatingIfNeeded: port.port))
+        pidColumn.append(Int32(truncatingIfNeeded: port.pid))
+        nameColumn.append(strings.intern(port.processName))
+        userColumn.append(strings.intern(port.user))
+        commandColumn.append(strings.intern(port.command))
+        addressColumn.append(strings.intern(port.address))
+        fdColumn.append(port.fd)
+        activeColumn.append(port.isActive)
+        typeColumn.append(port.processType)
+        typeCounts[port.processType, default: 0] += 1
+    }
+
+    nonisolated private mutating func reserveRows(_ count: Int) {
+        idColumn.reserveCapacity(count)
+        portColumn.reserveCapacity(count)
+        pidColumn.reserveCapacity(count)
+        nameColumn.reserveCapacity(count)
+        userColumn.reserveCapacity(count)
+        commandColumn.reserveCapacity(count)
+        addressColumn.reserveCapacity(count)
+        fdColumn.reserveCapacity(count)
+        activeColumn.reserveCapacity(count)
+        typeColumn.reserveCapacity(count)
+        rowsByID.reserveCapacity(count)
+    }
+
+    nonisolated private mutating func removeRows(keepingCapacity: Bool) {
+        idColumn.removeAll(keepingCapacity: keepingCapacity)
+        portColumn.removeAll(keepingCapacity: keepingCapacity)
+        pidColumn.removeAll(keepingCapacity: keepingCapacity)
+        nameColumn.removeAll(keepingCapacity: keepingCapacity)
+        userColumn.removeAll(keepingCapacity: keepingCapacity)
+        commandColumn.removeAll(keepingCapacity: keepingCapacity)
+        addressColumn.removeAll(keepingCapacity: keepingCapacity)
+        fdColumn.removeAll(keepingCapacity: keepingCapacity)
+        activeColumn.removeAll(keepingCapacity: keepingCapacity)
+        typeColumn.removeAll(keepingCapacity: keepingCapacity)
+        rowsByID.removeAll(keepingCapacity: keepingCapacity)
+        typeCounts.removeAll(keepingCapacity: true)
+    }
+}
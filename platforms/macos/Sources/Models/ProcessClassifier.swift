@@ -0,0 +1,287 @@
+/**
+ * ProcessClassifier.swift
+ * PortKiller
+ *
+ * Process-name classification compiled once from the built-in type keywords, the
+ * user's process-type overrides and auto-kill rule patterns. A name is classified in
+ * one pass over its bytes, instead of one substring search per keyword and rule.
+ */
+
+import Foundation
+
+/// What the classifier knows about a process name
+struct ProcessClassification: Equatable, Sendable {
+    /// Detected type, or the user's override for this name
+    let processType: ProcessType
+    /// Indices (ascending) of the rules whose process pattern accepts this name
+    let matchingRules: [Int]
+}
+
+/// A lowercased `*`-glob over process names, split into its literal parts once.
+///
+/// Without a `*` the pattern must equal the name; otherwise the first part is a prefix,
+/// the last a suffix, and every part must appear in order. Matching is case-insensitive.
+struct ProcessNamePattern: Hashable, Sendable {
+    /// Literal parts between `*`s; a single part means an exact match
+    let parts: [String]
+
+    nonisolated init(_ pattern: String) {
+        parts = pattern.lowercased().split(separator: "*", omittingEmptySubsequences: false).map(String.init)
+    }
+
+    /// Whether the pattern has no `*`
+    nonisolated var isExact: Bool { parts.count == 1 }
+
+    /// Longest literal part: a name can only match if it contains this
+    nonisolated var requiredLiteral: String {
+        parts.max { $0.utf8.count < $1.utf8.count } ?? ""
+    }
+
+    nonisolated func matches(_ name: String) -> Bool {
+        matches(lowercased: name.lowercased())
+    }
+
+    /// Like `matches(_:)`, for a name that is already lowercased.
+    nonisolated func matches(lowercased name: String) -> Bool {
+        guard let first = parts.first, let last = parts.last else { return false }
+        if isExact { return name == first }
+
+        if !first.isEmpty, !name.hasPrefix(first) { return false }
+        if !last.isEmpty, !name.hasSuffix(last) { return false }
+
+        var searchStart = name.startIndex
+        for part in parts where !part.isEmpty {
+            guard let range = name.range(of: part, range: searchStart..<name.endIndex) else {
+                return false
+            }
+            searchStart = range.upperBound
+        }
+        return true
+    }
+}
+
+/// Classifies process names against every keyword and rule pattern at once.
+///
+/// Type keywords and the required literal of each glob rule are compiled into an
+/// Aho–Corasick automaton over lowercased UTF-8, so a name is walked once to find every
+/// keyword it contains; only rules whose literal was found run their full glob check.
+/// Overrides and exact-name rules are dictionary lookups.
+///
+/// The classifier is immutable and rebuilt when its overrides or rules change.
+/// `classification(for:)` memoizes per name, since one process usually holds many ports.
+struct ProcessClassifier: Sendable {
+    /// Built-in keywords only, used by `ProcessType.detect(from:)`
+    nonisolated static let builtIn = ProcessClassifier()
+
+    /// Memo entries kept before the memo is dropped and refilled
+    nonisolated private static let memoLimit = 1024
+
+    private let automaton: KeywordAutomaton
+    /// Detected types in precedence order, as in `ProcessType.detectionKeywords`
+    private let rankedTypes: [ProcessType]
+    /// Index into `rankedTypes` of each type keyword, by keyword id; rule literals follow
+    private let keywordRanks: [Int]
+    /// Rule index of each rule literal, by keyword id minus `keywordRanks.count`
+    private let literalRules: [Int]
+
+    /// User-chosen type, by exact process name
+    private let overrides: [String: ProcessType]
+    private let rulePatterns: [ProcessNamePattern?]
+    /// Rules on an exact name, by lowercased name
+    private let exactRules: [String: [Int]]
+    /// Rules whose pattern accepts every name (only `*`s)
+    private let anyNameRules: [Int]
+
+    private var memo: [String: ProcessClassification] = [:]
+
+    /// Compiles the built-in keywords together with `overrides` (process name → type raw
+    /// value, as stored in `processTypeOverrides`) and the process patterns of `rules`.
+    ///
+    /// Rules without a process pattern have no name criterion and are left out; callers
+    /// match those by port. Port criteria of the other rules are also left to the caller.
+    nonisolated init(overrides: [String: String] = [:], rules: [AutoKillRule] = []) {
+        var keywords: [String] = []
+        var keywordRanks: [Int] = []
+        for (rank, entry) in ProcessType.detectionKeywords.enumerated() {
+            keywords.append(contentsOf: entry.keywords)
+            keywordRanks.append(contentsOf: repeatElement(rank, count: entry.keywords.count))
+        }
+
+        var literalRules: [Int] = []
+        var patterns: [ProcessNamePattern?] = []
+        var exactRules: [String: [Int]] = [:]
+        var anyNameRules: [Int] = []
+        for (index, rule) in rules.enumerated() {
+            guard !rule.processPattern.isEmpty else {
+                patterns.append(nil)
+                continue
+            }
+            let pattern = ProcessNamePattern(rule.processPattern)
+            patterns.append(pattern)
+            if pattern.isExact {
+                exactRules[pattern.parts[0], default: []].append(index)
+            } else if pattern.requiredLiteral.isEmpty {
+                anyNameRules.append(index)
+            } else {
+                keywords.append(pattern.requiredLiteral)
+                literalRules.append(index)
+            }
+        }
+
+        self.automaton = KeywordAutomaton(keywords: keywords)
+        self.rankedTypes = ProcessType.detectionKeywords.map(\.type)
+        self.keywordRanks = keywordRanks
+        self.literalRules = literalRules
+        self.overrides = overrides.compactMapValues(ProcessType.init(rawValue:))
+        self.rulePatterns = patterns
+        self.exactRules = exactRules
+        self.anyNameRules = anyNameRules
+    }
+
+    /// Type of `processName`: the user's override, else the detected type.
+    nonisolated func processType(of processName: String) -> ProcessType {
+        if let override = overrides[processName] { return override }
+        var best = Int.max
+        automaton.forEachMatch(in: processName.lowercased()) { keyword in
+            if keyword < keywordRanks.count {
+                best = min(best, keywordRanks[keyword])
+            }
+        }
+        return detectedType(rank: best)
+    }
+
+    /// Type and matching rules of `processName`, in one pass over the name.
+    nonisolated func classify(_ processName: String) -> ProcessClassification {
+        let lowered = processName.lowercased()
+        var best = Int.max
+        var rules = anyNameRules
+        rules.append(contentsOf: exactRules[lowered] ?? [])
+        var verified = Set<Int>()
+
+        automaton.forEachMatch(in: lowered) { keyword in
+            if keyword < keywordRanks.count {
+                best = min(best, keywordRanks[keyword])
+                return
+            }
+            // The glob check covers the whole name, not this occurrence of the literal,
+            // so its first result holds for any later occurrence too
+            let rule = literalRules[keyword - keywordRanks.count]
+            if verified.insert(rule).inserted, rulePatterns[rule]?.matches(lowercased: lowered) == true {
+                rules.append(rule)
+            }
+        }
+
+        return ProcessClassification(
+            processType: overrides[processName] ?? detectedType(rank: best),
+            matchingRules: rules.sorted()
+        )
+    }
+
+    /// `classify(_:)`, served from the memo after the first call for a name.
+    nonisolated mutating func classification(for processName: String) -> ProcessClassification {
+        if let cached = memo[processName] { return cached }
+        if memo.count >= Self.memoLimit {
+            memo.removeAll(keepingCapacity: true)
+        }
+        let classification = classify(processName)
+        memo[processName] = classification
+        return classification
+    }
+
+    // MARK: - Private Helpers
+
+    nonisolated private func detectedType(rank: Int) -> ProcessType {
+        rank < rankedTypes.count ? rankedTypes[rank] : .other
+    }
+}
+
+// MARK: - Keyword Automaton
+
+/// Aho–Corasick automaton over UTF-8 bytes, with failure links folded into a dense
+/// transition table so each input byte is a single lookup.
+///
+/// Bytes that occur in no keyword share one alphabet class that always leads back to
+/// the root, which keeps the table at (states × distinct keyword bytes).
+private struct KeywordAutomaton: Sendable {
+    /// Alphabet class of each byte; 0 for bytes in no keyword
+    private let byteClasses: [UInt16]
+    private let classCount: Int
+    /// `transitions[state * classCount + class]` is the next state
+    private let transitions: [Int32]
+    /// Ids of the keywords ending at each state, including via failure links
+    private let outputs: [[Int]]
+
+    nonisolated init(keywords: [String]) {
+        var byteClasses = [UInt16](repeating: 0, count: 256)
+        var classCount = 1
+        for keyword in keywords {
+            for byte in keyword.utf8 where byteClasses[Int(byte)] == 0 {
+                byteClasses[Int(byte)] = UInt16(classCount)
+                classCount += 1
+            }
+        }
+
+        // Trie, with -1 for missing edges
+        var transitions = [Int32](repeating: -1, count: classCount)
+        var outputs: [[Int]] = [[]]
+        for (id, keyword) in keywords.enumerated() where !keyword.isEmpty {
+            var state = 0
+            for byte in keyword.utf8 {
+                let slot = state * classCount + Int(byteClasses[Int(byte)])
+                if transitions[slot] < 0 {
+                    transitions[slot] = Int32(outputs.count)
+                    transitions.append(contentsOf: repeatElement(-1, count: classCount))
+                    outputs.append([])
+                }
+                state = Int(transitions[slot])
+            }
+            outputs[state].append(id)
+        }
+
+        // Breadth-first: point missing edges where the failure link's edge goes and
+        // inherit the failure link's outputs.
+        var failure = [Int](repeating: 0, count: outputs.count)
+        var queue: [Int] = []
+        for symbol in 0..<classCount {
+            let next = Int(transitions[symbol])
+            if next > 0 {
+                queue.append(next)
+            } else {
+                transitions[symbol] = 0
+            }
+        }
+        var head = 0
+        while head < queue.count {
+            let state = queue[head]
+            head += 1
+            outputs[state].append(contentsOf: outputs[failure[state]])
+            for symbol in 0..<classCount {
+                let slot = state * classCount + symbol
+                let next = Int(transitions[slot])
+                let fallback = Int(transitions[failure[state] * classCount + symbol])
+                if next > 0 {
+                    failure[next] = fallback
+                    queue.append(next)
+                } else {
+                    transitions[slot] = Int32(fallback)
+                }
+            }
+        }
+
+        self.byteClasses = byteClasses
+        self.classCount = classCount
+        self.transitions = transitions
+        self.outputs = outputs
+    }
+
+    /// Calls `body` with the id of every keyword occurrence in `text`.
+    nonisolated func forEachMatch(in text: String, _ body: (Int) -> Void) {
+        var state = 0
+        for byte in text.utf8 {
+            state = Int(transitions[state * classCount + Int(byteClasses[Int(byte)])])
+            for id in outputs[state] {
+                body(id)
+            }
+        }
+    }
+}
@@ -61,32 +61,18 @@ enum ProcessType: String, CaseIterable, Identifiable, Sendable {
     /// ProcessType.detect(from: "unknown") // .other
     /// ```
     static func detect(from processName: String) -> ProcessType {
-        let name = processName.lowercased()
-
-        // Web servers
-        let webServers = ["nginx", "apache", "httpd", "caddy", "traefik", "lighttpd"]
-        if webServers.contains(where: { name.contains($0) }) {
-            return .webServer
-        }
-
-        // Databases
-        let databases = ["postgres", "mysql", "mariadb", "redis", "mongo", "sqlite", "cockroach", "clickhouse"]
-        if databases.contains(where: { name.contains($0) }) {
-            return .database
-        }
-
-        // Development tools
-        let devTools = ["node", "npm", "yarn", "python", "ruby", "php", "java", "go", "cargo", "swift", "vite", "webpack", "esbuild", "next", "nuxt", "remix"]
-        if devTools.contains(where: { name.contains($0) }) {
-            return .development
-        }
-
-        // System processes
-        let systemProcs = ["launchd", "rapportd", "sharingd", "airplay", "control", "kernel", "mds", "spotlight"]
-        if systemProcs.contains(where: { name.contains($0) }) {
-            return .system
-        }
-
-        return .other
+        ProcessClassifier.builtIn.processType(of: processName)
     }
+
+    /// Name keywords of each detected category, in precedence order: a name containing
+    /// keywords of several categories gets the first one ("mongo-node" is a database).
+    ///
+    /// Compiled once into `ProcessClassifier`; edit here to change detection.
+    nonisolated static let detectionKeywords: [(type: ProcessType, keywords: [String])] = [
+        (.webServer, ["nginx", "apache", "httpd", "caddy", "traefik", "lighttpd"]),
+        (.database, ["postgres", "mysql", "mariadb", "redis", "mongo", "sqlite", "cockroach", "clickhouse"]),
+        (.development, ["node", "npm", "yarn", "python", "ruby", "php", "java", "go", "cargo", "swift",
+                        "vite", "webpack", "esbuild", "next", "nuxt", "remix"]),
+        (.system, ["launchd", "rapportd", "sharingd", "airplay", "control", "kernel", "mds", "spotlight"])
+    ]
 }
@@ -1,21 +1,23 @@
 import Foundation
 
-/// A log entry from cloudflared tunnel output
-@Observable
-@MainActor
-final class TunnelLogEntry: Identifiable, Sendable {
-    let id = UUID()
+/// A log entry from cloudflared tunnel output, read from a `LogRingBuffer` slot
+struct TunnelLogEntry: Identifiable, Sendable, LogRingEntry {
+    let id: UInt64
     let timestamp: Date
-    let message: String
     let level: LogLevel
+    private let slot: LogSlot
 
-    nonisolated init(timestamp: Date = Date(), message: String, level: LogLevel = .info) {
-        self.timestamp = timestamp
-        self.message = message
-        self.level = level
+    /// Decoded on access, so only rendered rows pay for a String
+    var message: String { slot.message }
+
+    nonisolated init(slot: LogSlot) {
+        self.id = slot.sequence
+        self.timestamp = slot.timestamp
+        self.level = LogLevel(rawValue: slot.severity) ?? .info
+        self.slot = slot
     }
 
-    enum LogLevel: Sendable {
+    enum LogLevel: UInt8, Sendable {
         case info
         case warning
         case error
@@ -31,23 +33,20 @@ final class TunnelLogEntry: Identifiable, Sendable {
         }
     }
 
-    /// Parses a cloudflared log line to determine level and clean message.
-    nonisolated static func parse(_ line: String) -> TunnelLogEntry {
+    /// Classifies a cloudflared log line by level.
+    nonisolated static func level(of line: String) -> LogLevel {
         let lowered = line.lowercased()
 
-        let level: LogLevel
         if lowered.contains("error") || lowered.contains("failed") || lowered.contains("unable to") {
-            level = .error
+            return .error
         } else if lowered.contains("warn") {
-            level = .warning
+            return .warning
         } else if lowered.contains("request") || lowered.contains("200") || lowered.contains("404") ||
                     lowered.contains("get ") || lowered.contains("post ") || lowered.contains("put ") ||
                     lowered.contains("delete ") || lowered.contains("status") {
-            level = .request
+            return .request
         } else {
-            level = .info
+            return .info
         }
-
-        return TunnelLogEntry(message: line, level: level)
     }
 }
@@ -0,0 +1,158 @@
+/**
+ * TunnelMetrics.swift
+ * PortKiller
+ *
+ * Live throughput and latency of a running named tunnel, derived from successive
+ * scrapes of cloudflared's metrics endpoint and kept in fixed-size series for sparklines.
+ */
+
+import Foundation
+
+/// Cumulative counters and gauges from one `/metrics` scrape, see `CloudflaredMetricsParser`
+struct CloudflaredMetricsSnapshot: Sendable, Equatable {
+    /// One cumulative histogram bucket (Prometheus `le` semantics)
+    struct LatencyBucket: Sendable, Equatable {
+        /// Upper bound in milliseconds; `.infinity` for the `+Inf` bucket
+        let upperBound: Double
+        let cumulativeCount: Double
+    }
+
+    var totalRequests: Double = 0
+    var requestErrors: Double = 0
+    /// Requests currently being proxied (gauge)
+    var activeStreams: Double = 0
+    /// Bytes sent to / received from the edge over QUIC
+    var bytesSent: Double = 0
+    var bytesReceived: Double = 0
+    /// Origin connect latency histogram, ascending by bound
+    var latencyBuckets: [LatencyBucket] = []
+}
+
+/// Fixed-capacity ring of samples; appending beyond capacity drops the oldest.
+struct MetricSeries: Sendable, Equatable {
+    let capacity: Int
+
+    private var storage: [Double] = []
+    /// Once full, the index of the oldest sample
+    private var head = 0
+
+    nonisolated init(capacity: Int) {
+        self.capacity = max(1, capacity)
+        storage.reserveCapacity(self.capacity)
+    }
+
+    nonisolated var isEmpty: Bool { storage.isEmpty }
+
+    /// Samples, oldest first
+    nonisolated var values: [Double] {
+        Array(storage[head...] + storage[..<head])
+    }
+
+    nonisolated var latest: Double? {
+        guard !storage.isEmpty else { return nil }
+        return storage[(head + storage.count - 1) % storage.count]
+    }
+
+    nonisolated mutating func append(_ value: Double) {
+        if storage.count < capacity {
+            storage.append(value)
+        } else {
+            storage[head] = value
+            head = (head + 1) % capacity
+        }
+    }
+}
+
+/// Per-second rates and gauges of one tunnel, one sample per scrape.
+///
+/// Counters are turned into rates against the previous scrape, so the first scrape only
+/// sets the baseline. A counter going backwards (cloudflared restarted) resets it.
+struct TunnelMetrics: Sendable, Equatable {
+    private struct Baseline: Sendable, Equatable {
+        let snapshot: CloudflaredMetricsSnapshot
+        let instant: ContinuousClock.Instant
+    }
+
+    var requestsPerSecond: MetricSeries
+    var errorsPerSecond: MetricSeries
+    /// 95th percentile origin connect latency over the scrape interval, in milliseconds.
+    /// An interval without requests repeats the previous value rather than plotting 0;
+    /// `requestsPerSecond` shows the idleness.
+    var latencyP95: MetricSeries
+    var activeStreams: MetricSeries
+    var bytesInPerSecond: MetricSeries
+    var bytesOutPerSecond: MetricSeries
+
+    private var baseline: Baseline?
+
+    nonisolated init(capacity: Int = AppConstants.tunnelMetricsHistoryLength) {
+        requestsPerSecond = MetricSeries(capacity: capacity)
+        errorsPerSecond = MetricSeries(capacity: capacity)
+        latencyP95 = MetricSeries(capacity: capacity)
+        activeStreams = MetricSeries(capacity: capacity)
+        bytesInPerSecond = MetricSeries(capacity: capacity)
+        bytesOutPerSecond = MetricSeries(capacity: capacity)
+    }
+
+    /// False until two scrapes have produced a rate
+    nonisolated var hasSamples: Bool { !requestsPerSecond.isEmpty }
+
+    nonisolated mutating func record(_ snapshot: CloudflaredMetricsSnapshot, at instant: ContinuousClock.Instant) {
+        defer { baseline = Baseline(snapshot: snapshot, instant: instant) }
+        guard let baseline, !Self.didReset(from: baseline.snapshot, to: snapshot) else { return }
+
+        let elapsed = (instant - baseline.instant) / .seconds(1)
+        guard elapsed > 0 else { return }
+        let previous = baseline.snapshot
+
+        requestsPerSecond.append((snapshot.totalRequests - previous.totalRequests) / elapsed)
+        errorsPerSecond.append((snapshot.requestErrors - previous.requestErrors) / elapsed)
+        bytesOutPerSecond.append((snapshot.bytesSent - previous.bytesSent) / elapsed)
+        bytesInPerSecond.append((snapshot.bytesReceived - previous.bytesReceived) / elapsed)
+        activeStreams.append(snapshot.activeStreams)
+        if let p95 = Self.quantile(0.95, from: previous.latencyBuckets, to: snapshot.latencyBuckets) ?? latencyP95.latest {
+            latencyP95.append(p95)
+        }
+    }
+
+    // MARK: - Private Helpers
+
+    nonisolated private static func didReset(from old: CloudflaredMetricsSnapshot, to new: CloudflaredMetricsSnapshot) -> Bool {
+        new.totalRequests < old.totalRequests
+            || new.requestErrors < old.requestErrors
+            || new.bytesSent < old.bytesSent
+            || new.bytesReceived < old.bytesReceived
+    }
+
+    /// Quantile of the observations made between two histogram scrapes, interpolated
+    /// linearly inside the bucket (as Prometheus' `histogram_quantile` does).
+    /// nil if nothing was observed in between.
+    nonisolated static func quantile(
+        _ q: Double,
+        from old: [CloudflaredMetricsSnapshot.LatencyBucket],
+        to new: [CloudflaredMetricsSnapshot.LatencyBucket]
+    ) -> Double? {
+        var oldCounts: [Double: Double] = [:]
+        for bucket in old {
+            oldCounts[bucket.upperBound] = bucket.cumulativeCount
+        }
+        let deltas = new.map { ($0.upperBound, $0.cumulativeCount - (oldCounts[$0.upperBound] ?? 0)) }
+        guard let total = deltas.last?.1, total > 0 else { return nil }
+
+        let rank = q * total
+        var lowerBound = 0.0
+        var countBelow = 0.0
+        for (upperBound, cumulative) in deltas {
+            if cumulative >= rank {
+                // The +Inf bucket has no width; report its lower edge
+                guard upperBound.isFinite else { return lowerBound }
+                let inBucket = cumulative - countBelow
+                guard inBucket > 0 else { return upperBound }
+                return lowerBound + (upperBound - lowerBound) * (rank - countBelow) / inBucket
+            }
+            lowerBound = upperBound
+            countBelow = cumulative
+        }
+        return lowerBound
+    }
+}
@@ -48,8 +48,7 @@ final class AppDelegate: NSObject, NSApplicationDelegate {
 
         // Kill all port-forward connections and tunnels before terminating
         Task {
-            await appState.portForwardManager.killStuckProcesses()
-            await appState.tunnelManager.stopAllTunnels()
+            await appState.shutDownManagers()
             await MainActor.run {
                 NSApp.reply(toApplicationShouldTerminate: true)
             }
@@ -59,7 +58,18 @@ final class AppDelegate: NSObject, NSApplicationDelegate {
     }
 }
 
+/// Process entry point: the background scanner when launched by its launch agent,
+/// the menu bar app otherwise.
 @main
+enum PortKillerEntry {
+    static func main() {
+        if HeadlessScanner.isRequested {
+            HeadlessScanner.run()
+        }
+        PortKillerApp.main()
+    }
+}
+
 struct PortKillerApp: App {
     @NSApplicationDelegateAdaptor(AppDelegate.self) var appDelegate
     @State private var state = AppState()
@@ -122,6 +132,16 @@ struct PortKillerApp: App {
                 }
                 .keyboardShortcut("k", modifiers: [.command, .shift])
             }
+
+            CommandGroup(after: .windowList) {
+                if Defaults[.showPerformanceHUD] {
+                    Button("Performance HUD") {
+                        NSApp.activate(ignoringOtherApps: true)
+                        openWindow(id: "performance-hud")
+                    }
+                    .keyboardShortcut("p", modifiers: [.command, .option])
+                }
+            }
         }
 
         // Port Forwarder Window
@@ -132,16 +152,30 @@ struct PortKillerApp: App {
         .windowStyle(.automatic)
         .defaultSize(width: 900, height: 650)
 
+        // Performance HUD (hidden debug window, see Defaults[.showPerformanceHUD])
+        Window("Performance", id: "performance-hud") {
+            PerformanceHUDView()
+        }
+        .windowResizability(.contentSize)
+
         // Menu Bar (quick access)
         MenuBarExtra {
             MenuBarView(state: state)
         } label: {
-            Image(nsImage: menuBarIcon())
+            Image(nsImage: Self.menuBarIcon)
+                .onAppear {
+                    PerformanceMonitor.shared.recordFirstFrame()
+                    // The main window may never open; quitting still has to stop tunnels
+                    appDelegate.appState = state
+                }
         }
         .menuBarExtraStyle(.window)
     }
 
-    private func menuBarIcon() -> NSImage {
+    /// Loaded once; the label body is re-evaluated on every state change
+    private static let menuBarIcon = loadMenuBarIcon()
+
+    private static func loadMenuBarIcon() -> NSImage {
         // Try various bundle paths for icon
         let paths = [
             Bundle.main.resourceURL?.appendingPathComponent("PortKiller_PortKiller.bundle"),
@@ -14,6 +14,10 @@ protocol PortScannerProtocol: Sendable {
     /// - Returns: Array of PortInfo representing active ports
     func scanPorts() async -> [PortInfo]
 
+    /// Scans for listening ports and diffs them against the previous `scanDelta()` call
+    /// - Returns: Added, removed and changed ports plus the full current snapshot
+    func scanDelta() async -> PortScanDelta
+
     /// Kills a process by PID
     /// - Parameters:
     ///   - pid: Process ID to kill
@@ -26,8 +30,20 @@ protocol PortScannerProtocol: Sendable {
     /// - Returns: True if the process was successfully killed
     func killProcessGracefully(pid: Int) async -> Bool
 
+    /// Kills processes as one batch: SIGTERM to all, then SIGKILL to those still running
+    /// once they exit or the grace period ends, whichever comes first
+    /// - Parameter pids: Process IDs to kill
+    /// - Returns: PIDs that are gone afterwards
+    func killProcesses(pids: Set<Int>) async -> Set<Int>
+
     /// Finds PIDs of processes with ESTABLISHED connections to a port
     /// - Parameter port: Port number to check
     /// - Returns: Set of PIDs with established connections (excludes the listener)
     func findEstablishedPids(for port: Int) async -> Set<Int>
+
+    /// Finds PIDs of processes with ESTABLISHED connections to any of `ports`, in one
+    /// socket enumeration
+    /// - Parameter ports: Port numbers to check
+    /// - Returns: Set of PIDs with established connections to any of them
+    func findEstablishedPids(for ports: Set<Int>) async -> Set<Int>
 }
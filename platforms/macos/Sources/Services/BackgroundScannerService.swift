@@ -0,0 +1,50 @@
+/**
+ * BackgroundScannerService.swift
+ * PortKiller
+ *
+ * Registers the headless background scanner (`HeadlessScanner`) as a launch agent.
+ */
+
+import Foundation
+import ServiceManagement
+import os
+
+/// Turns the background scanner launch agent on and off.
+///
+/// The agent (`Contents/Library/LaunchAgents/com.portkiller.scanner.plist`) runs the
+/// app binary with `--headless` at login and keeps it alive, so the shared snapshot is
+/// always fresh for the menu bar, the main window and `portkiller-cli`.
+@MainActor
+@Observable
+final class BackgroundScannerService {
+    static let shared = BackgroundScannerService()
+
+    private static let logger = Logger(subsystem: "com.portkiller.app", category: "BackgroundScanner")
+
+    @ObservationIgnored
+    private let service = SMAppService.agent(plistName: "com.portkiller.scanner.plist")
+
+    /// Whether the agent is registered (or waiting for approval in Login Items)
+    private(set) var isEnabled = false
+
+    private init() {
+        refreshStatus()
+    }
+
+    func refreshStatus() {
+        isEnabled = service.status == .enabled || service.status == .requiresApproval
+    }
+
+    func setEnabled(_ enabled: Bool) {
+        do {
+            if enabled {
+                try service.register()
+            } else {
+                try service.unregister()
+            }
+        } catch {
+            Self.logger.error("Updating background scanner failed: \(error.localizedDescription)")
+        }
+        refreshStatus()
+    }
+}
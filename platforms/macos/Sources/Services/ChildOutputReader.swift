@@ -0,0 +1,153 @@
+import Foundation
+import Darwin
+
+/// Lines read from one child process's output pipe in a single wakeup
+struct ChildOutputBatch<Key: Hashable & Sendable>: Sendable {
+    let key: Key
+    /// Complete, whitespace-trimmed, non-empty lines in arrival order
+    let lines: [String]
+}
+
+/// Serial queue shared by every `ChildOutputReader`, so all child pipes are serviced by
+/// one dispatch queue (GCD multiplexes the read sources over kqueue).
+enum ChildOutputQueue {
+    nonisolated static let shared = DispatchQueue(label: "com.portkiller.child-output", qos: .utility)
+}
+
+/// Reads stdout/stderr of many child processes (kubectl, socat, cloudflared) without a
+/// task per child.
+///
+/// Each pipe gets a `DispatchSourceRead` on `ChildOutputQueue.shared`. A wakeup drains
+/// what's available, splits it into lines off-actor, and yields them as one batch on
+/// `batches`, so the owning actor does one hop per chunk instead of one per line.
+/// The owner consumes `batches` from a single task regardless of how many children run.
+nonisolated final class ChildOutputReader<Key: Hashable & Sendable>: @unchecked Sendable {
+
+    /// Bytes read per wakeup
+    private static var readChunkSize: Int { 64 * 1024 }
+
+    /// A partial line longer than this is emitted as-is rather than buffered further
+    private static var maxPendingLineLength: Int { 64 * 1024 }
+
+    private struct Stream {
+        let source: DispatchSourceRead
+        var pending: [UInt8] = []
+    }
+
+    /// Output batches from every attached pipe
+    let batches: AsyncStream<ChildOutputBatch<Key>>
+
+    private let continuation: AsyncStream<ChildOutputBatch<Key>>.Continuation
+    private let queue = ChildOutputQueue.shared
+
+    /// Attached pipes. Only touched on `queue`.
+    private var streams: [Key: Stream] = [:]
+
+    /// Reused read buffer. Only touched on `queue`.
+    private var readBuffer: [UInt8]
+
+    init() {
+        (batches, continuation) = AsyncStream.makeStream(of: ChildOutputBatch<Key>.self)
+        readBuffer = [UInt8](repeating: 0, count: Self.readChunkSize)
+    }
+
+    deinit {
+        continuation.finish()
+    }
+
+    /// Starts reading `pipe`, replacing any pipe previously attached under `key`.
+    func attach(_ pipe: Pipe, key: Key) {
+        let handle = pipe.fileHandleForReading
+        queue.async { [weak self] in
+            guard let self else { return }
+            self.cancelStream(for: key)
+
+            let source = DispatchSource.makeReadSource(fileDescriptor: handle.fileDescriptor, queue: self.queue)
+            source.setEventHandler { [weak self] in
+                self?.drain(key: key, source: source)
+            }
+            // Keep the FileHandle (and with it the descriptor) alive until the source is gone
+            source.setCancelHandler { _ = handle }
+            self.streams[key] = Stream(source: source)
+            source.resume()
+        }
+    }
+
+    /// Stops reading the pipe attached under `key`. Unread output is dropped.
+    func detach(_ key: Key) {
+        queue.async { [weak self] in
+            self?.cancelStream(for: key)
+        }
+    }
+
+    /// Stops reading every attached pipe.
+    func detachAll() {
+        queue.async { [weak self] in
+            guard let self else { return }
+            for key in Array(self.streams.keys) {
+                self.cancelStream(for: key)
+            }
+        }
+    }
+
+    // MARK: - Private Methods
+
+    private func cancelStream(for key: Key) {
+        streams.removeValue(forKey: key)?.source.cancel()
+    }
+
+    private func drain(key: Key, source: DispatchSourceRead) {
+        // A replaced stream may still deliver one event for its old source
+        guard streams[key]?.source === source else { return }
+        PerformanceMonitor.shared.measure(.childOutputRead) {
+            drainAvailable(key: key, source: source)
+        }
+    }
+
+    private func drainAvailable(key: Key, source: DispatchSourceRead) {
+        guard var stream = streams[key] else { return }
+
+        let count = readBuffer.withUnsafeMutableBytes { buffer in
+            read(Int32(source.handle), buffer.baseAddress, buffer.count)
+        }
+
+        if count < 0 && (errno == EAGAIN || errno == EINTR) { return }
+
+        guard count > 0 else {
+            // EOF: the child closed its end (exited). Flush the unterminated last line.
+            let lines = Self.splitLines(&stream.pending, flushRemainder: true)
+            if !lines.isEmpty { continuation.yield(ChildOutputBatch(key: key, lines: lines)) }
+            cancelStream(for: key)
+            return
+        }
+
+        stream.pending.append(contentsOf: readBuffer[0..<count])
+        let lines = Self.splitLines(&stream.pending, flushRemainder: stream.pending.count > Self.maxPendingLineLength)
+        streams[key] = stream
+        if !lines.isEmpty { continuation.yield(ChildOutputBatch(key: key, lines: lines)) }
+    }
+
+    /// Removes complete lines from `pending`, returning them trimmed and non-empty.
+    private static func splitLines(_ pending: inout [UInt8], flushRemainder: Bool) -> [String] {
+        var lines: [String] = []
+        var lineStart = 0
+
+        for index in pending.indices where pending[index] == UInt8(ascii: "\n") {
+            appendLine(pending[lineStart..<index], to: &lines)
+            lineStart = index + 1
+        }
+
+        if flushRemainder {
+            appendLine(pending[lineStart...], to: &lines)
+            pending.removeAll(keepingCapacity: true)
+        } else {
+            pending.removeFirst(lineStart)
+        }
+        return lines
+    }
+
+    private static func appendLine(_ bytes: ArraySlice<UInt8>, to lines: inout [String]) {
+        let line = String(decoding: bytes, as: UTF8.self).trimmingCharacters(in: .whitespacesAndNewlines)
+        if !line.isEmpty { lines.append(line) }
+    }
+}
@@ -0,0 +1,171 @@
+import Foundation
+import Darwin
+
+/// How a supervised child ended
+struct ChildExit: Sendable, Equatable {
+    let pid: Int32
+    /// Exit code, or the signal number when `wasSignaled` — like `Process.terminationStatus`.
+    /// nil if the child was already reaped before it could be watched and its status is unknown.
+    let status: Int32?
+    let wasSignaled: Bool
+
+    /// Decodes a `wait(2)` status word.
+    nonisolated init(pid: Int32, waitStatus: Int32) {
+        self.pid = pid
+        let signal = waitStatus & 0x7f
+        if signal == 0 {
+            status = (waitStatus >> 8) & 0xff
+            wasSignaled = false
+        } else {
+            status = signal
+            wasSignaled = true
+        }
+    }
+
+    nonisolated init(pid: Int32, status: Int32?, wasSignaled: Bool) {
+        self.pid = pid
+        self.status = status
+        self.wasSignaled = wasSignaled
+    }
+
+    /// Exited with status 0
+    nonisolated var isSuccess: Bool { status == 0 && !wasSignaled }
+}
+
+/// Reports the exit of every kubectl/socat/cloudflared child through a single kqueue
+/// (`EVFILT_PROC` / `NOTE_EXIT`).
+///
+/// Owners register a child right after `run()` and are called back the moment it exits,
+/// so nothing has to poll `isRunning`. One kqueue and one dispatch read source serve
+/// every child; idle children cost no wakeups.
+nonisolated final class ChildProcessSupervisor: @unchecked Sendable {
+    typealias ExitHandler = @Sendable (ChildExit) -> Void
+
+    static let shared = ChildProcessSupervisor()
+
+    /// Upper bound of kevents drained per wakeup
+    private static let eventBatchSize = 32
+
+    private let queue = DispatchQueue(label: "com.portkiller.child-exits", qos: .utility)
+    private let kqueueDescriptor: Int32
+    private let readSource: DispatchSourceRead?
+
+    /// Exit handlers of registered children. Only touched on `queue`.
+    private var handlers: [pid_t: [ExitHandler]] = [:]
+
+    init() {
+        kqueueDescriptor = kqueue()
+        guard kqueueDescriptor >= 0 else {
+            // Children are then watched through Foundation's termination handler.
+            readSource = nil
+            return
+        }
+
+        let descriptor = kqueueDescriptor
+        let source = DispatchSource.makeReadSource(fileDescriptor: descriptor, queue: queue)
+        source.setCancelHandler {
+            close(descriptor)
+        }
+        readSource = source
+        source.setEventHandler { [weak self] in
+            self?.drainEvents()
+        }
+        source.resume()
+    }
+
+    deinit {
+        readSource?.cancel()
+    }
+
+    /// Calls `onExit` once, on the supervisor's queue, when `process` exits.
+    ///
+    /// Call right after `run()`. A child that is already gone is reported immediately.
+    func supervise(_ process: Process, onExit: @escaping ExitHandler) {
+        let pid = process.processIdentifier
+        queue.async { [self] in
+            if handlers[pid] != nil {
+                handlers[pid]?.append(onExit)
+                return
+            }
+            handlers[pid] = [onExit]
+            guard readSource != nil else {
+                superviseWithoutKqueue(process)
+                return
+            }
+            if register(pid) { return }
+            if errno == ESRCH {
+                // Exited and reaped before we got here; Foundation has its status.
+                deliver(Self.exit(ofReaped: process))
+            } else {
+                superviseWithoutKqueue(process)
+            }
+        }
+    }
+
+    /// Suspends until `process` exits.
+    func exit(of process: Process) async -> ChildExit {
+        await withCheckedContinuation { continuation in
+            supervise(process) { continuation.resume(returning: $0) }
+        }
+    }
+
+    // MARK: - Private Methods
+
+    private func register(_ pid: pid_t) -> Bool {
+        var change = kevent(
+            ident: UInt(pid),
+            filter: Int16(EVFILT_PROC),
+            flags: UInt16(EV_ADD | EV_ONESHOT),
+            // NOTE_EXITSTATUS puts the wait(2) status in `data`; only valid for our children
+            fflags: UInt32(NOTE_EXIT) | UInt32(NOTE_EXITSTATUS),
+            data: 0,
+            udata: nil
+        )
+        return kevent(kqueueDescriptor, &change, 1, nil, 0, nil) == 0
+    }
+
+    private func drainEvents() {
+        var received = [kevent](repeating: kevent(), count: Self.eventBatchSize)
+        var timeout = timespec(tv_sec: 0, tv_nsec: 0)
+        let count = kevent(kqueueDescriptor, nil, 0, &received, Int32(received.count), &timeout)
+        guard count > 0 else { return }
+
+        for event in received.prefix(Int(count)) where event.fflags & UInt32(NOTE_EXIT) != 0 {
+            deliver(ChildExit(pid: pid_t(event.ident), waitStatus: Int32(truncatingIfNeeded: event.data)))
+        }
+    }
+
+    /// Calls and drops the handlers of `exit.pid`; later deliveries for it are no-ops.
+    private func deliver(_ exit: ChildExit) {
+        for handler in handlers.removeValue(forKey: exit.pid) ?? [] {
+            handler(exit)
+        }
+    }
+
+    /// Used when the kqueue can't watch the child; Foundation watches it instead.
+    /// A termination handler the caller already set keeps running, before ours.
+    private func superviseWithoutKqueue(_ process: Process) {
+        let previousHandler = process.terminationHandler
+        process.terminationHandler = { [weak self] process in
+            previousHandler?(process)
+            let exit = Self.exit(ofReaped: process)
+            self?.queue.async { self?.deliver(exit) }
+        }
+        // The child may have exited before the handler was set.
+        if !process.isRunning {
+            deliver(Self.exit(ofReaped: process))
+        }
+    }
+
+    private static func exit(ofReaped process: Process) -> ChildExit {
+        // `terminationStatus` raises while Foundation hasn't caught up with the exit yet.
+        guard !process.isRunning else {
+            return ChildExit(pid: process.processIdentifier, status: nil, wasSignaled: false)
+        }
+        return ChildExit(
+            pid: process.processIdentifier,
+            status: process.terminationStatus,
+            wasSignaled: process.terminationReason == .uncaughtSignal
+        )
+    }
+}
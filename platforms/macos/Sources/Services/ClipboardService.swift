@@ -23,7 +23,7 @@ enum ClipboardService: ClipboardServiceProtocol {
 
         for log in logs {
             let timestamp = dateFormatter.string(from: log.timestamp)
-            let source = log.type == .portForward ? "kubectl" : "socat"
+            let source = log.type == .portForward ? "kubectl" : "proxy"
             let prefix = log.isError ? "[ERROR]" : ""
             markdown += "\(timestamp) [\(source)] \(prefix)\(log.message)\n"
         }
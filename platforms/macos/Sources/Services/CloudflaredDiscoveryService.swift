@@ -8,10 +8,31 @@ import Foundation
 ///   1. `~/.cloudflared/<UUID>.json` — credentials files (gives us tunnel ID + AccountTag offline)
 ///   2. `cloudflared --output json tunnel list` — authoritative tunnel list with live edge connections
 ///   3. `~/.cloudflared/config.yml` — local ingress rules (may not exist for dashboard-managed tunnels)
+///
+/// Discovery is incremental: local files are re-read only when their modification date
+/// or size changed, and the remote list is fetched once and then only when a caller asks
+/// for it, so a repeated `discover` normally costs a directory listing and nothing else.
 actor CloudflaredDiscoveryService {
-    /// Default cloudflared config directory.
-    nonisolated var configDirectory: URL {
-        URL(fileURLWithPath: NSHomeDirectory()).appendingPathComponent(".cloudflared", isDirectory: true)
+    /// Modification date and size of a file when it was last parsed
+    private struct FileStamp: Equatable {
+        let modified: Date?
+        let size: Int?
+
+        init(_ values: URLResourceValues?) {
+            modified = values?.contentModificationDate
+            size = values?.fileSize
+        }
+    }
+
+    /// cloudflared config directory (`~/.cloudflared/` unless overridden).
+    nonisolated let configDirectory: URL
+
+    private var credentialCache: [URL: (stamp: FileStamp, credential: LocalCredential)] = [:]
+    private var localConfigCache: (stamp: FileStamp, config: LocalConfig?)?
+    private var remoteCache: [RemoteTunnel]?
+
+    init(configDirectory: URL = URL(fileURLWithPath: NSHomeDirectory()).appendingPathComponent(".cloudflared", isDirectory: true)) {
+        self.configDirectory = configDirectory
     }
 
     nonisolated var configFile: URL {
@@ -34,8 +55,10 @@ actor CloudflaredDiscoveryService {
     /// Strategy:
     ///   - Always start with credentials files on disk (works offline).
     ///   - If cloudflared is available, augment with `tunnel list` (adds remote name + connections).
+    ///     The list is fetched again only if `refreshRemote` is set (or it was never fetched);
+    ///     a failed fetch keeps the previous list.
     ///   - Merge ingress rules from local `config.yml` if any tunnel name matches the `tunnel:` field.
-    func discover(cloudflaredPath: String?) async -> [DiscoveredTunnel] {
+    func discover(cloudflaredPath: String?, refreshRemote: Bool = false) async -> [DiscoveredTunnel] {
         var byID: [String: DiscoveredTunnel] = [:]
 
         // 1. Local credentials files
@@ -51,7 +74,7 @@ actor CloudflaredDiscoveryService {
 
         // 2. `cloudflared tunnel list` (authoritative when reachable)
         if let cloudflaredPath = cloudflaredPath,
-           let listed = await runTunnelList(cloudflaredPath: cloudflaredPath) {
+           let listed = await remoteTunnels(cloudflaredPath: cloudflaredPath, refresh: refreshRemote) {
             for remote in listed {
                 if var existing = byID[remote.id] {
                     existing.name = remote.name
@@ -88,33 +111,67 @@ actor CloudflaredDiscoveryService {
 
     // MARK: - Credentials Files
 
-    private nonisolated func readCredentialsFiles() -> [LocalCredential] {
-        guard let entries = try? FileManager.default.contentsOfDirectory(at: configDirectory, includingPropertiesForKeys: nil) else {
+    /// Credentials of every `<UUID>.json` in the config directory; files unchanged since
+    /// the last call are not read again.
+    private func readCredentialsFiles() -> [LocalCredential] {
+        let keys: Set<URLResourceKey> = [.contentModificationDateKey, .fileSizeKey]
+        guard let entries = try? FileManager.default.contentsOfDirectory(
+            at: configDirectory,
+            includingPropertiesForKeys: Array(keys)
+        ) else {
+            credentialCache.removeAll()
             return []
         }
+
         var result: [LocalCredential] = []
+        var seen = Set<URL>()
         for url in entries where url.pathExtension == "json" {
             // Tunnel credentials filename is the UUID itself.
             let stem = url.deletingPathExtension().lastPathComponent
             guard isUUID(stem) else { continue }
-            // Sanity-check by reading the file. We accept either {TunnelID: ...} or just trust the filename.
-            if let data = try? Data(contentsOf: url),
-               let json = try? JSONSerialization.jsonObject(with: data) as? [String: Any] {
-                let id = (json["TunnelID"] as? String) ?? stem
-                result.append(LocalCredential(tunnelID: id, path: url.path))
-            } else {
-                result.append(LocalCredential(tunnelID: stem, path: url.path))
+            seen.insert(url)
+
+            let stamp = FileStamp(try? url.resourceValues(forKeys: keys))
+            if let cached = credentialCache[url], cached.stamp == stamp {
+                result.append(cached.credential)
+                continue
             }
+            let credential = readCredential(at: url, stem: stem)
+            credentialCache[url] = (stamp, credential)
+            result.append(credential)
         }
+        credentialCache = credentialCache.filter { seen.contains($0.key) }
         return result
     }
 
+    private nonisolated func readCredential(at url: URL, stem: String) -> LocalCredential {
+        // Sanity-check by reading the file. We accept either {TunnelID: ...} or just trust the filename.
+        if let data = try? Data(contentsOf: url),
+           let json = try? JSONSerialization.jsonObject(with: data) as? [String: Any] {
+            let id = (json["TunnelID"] as? String) ?? stem
+            return LocalCredential(tunnelID: id, path: url.path)
+        }
+        return LocalCredential(tunnelID: stem, path: url.path)
+    }
+
     private nonisolated func isUUID(_ s: String) -> Bool {
         UUID(uuidString: s) != nil
     }
 
     // MARK: - Remote List
 
+    /// The cached `tunnel list`, fetched again only when asked to.
+    private func remoteTunnels(cloudflaredPath: String, refresh: Bool) async -> [RemoteTunnel]? {
+        if !refresh, let remoteCache {
+            return remoteCache
+        }
+        guard let listed = await runTunnelList(cloudflaredPath: cloudflaredPath) else {
+            return remoteCache
+        }
+        remoteCache = listed
+        return listed
+    }
+
     private func runTunnelList(cloudflaredPath: String) async -> [RemoteTunnel]? {
         // `cloudflared tunnel list` is a network call that can take seconds. The
         // blocking pipe-read + `waitUntilExit()` runs on a detached task so it does
@@ -129,9 +186,15 @@ actor CloudflaredDiscoveryService {
 
     // MARK: - Local Config
 
-    private nonisolated func readLocalConfig() -> LocalConfig? {
-        guard let raw = try? String(contentsOf: configFile, encoding: .utf8) else { return nil }
-        return parseConfigYAML(raw)
+    /// The parsed `config.yml`, re-parsed only when the file changed.
+    private func readLocalConfig() -> LocalConfig? {
+        let stamp = FileStamp(try? configFile.resourceValues(forKeys: [.contentModificationDateKey, .fileSizeKey]))
+        if let localConfigCache, localConfigCache.stamp == stamp {
+            return localConfigCache.config
+        }
+        let config = (try? String(contentsOf: configFile, encoding: .utf8)).flatMap { parseConfigYAML($0) }
+        localConfigCache = (stamp, config)
+        return config
     }
 
     /// Tiny purpose-built parser for the subset of cloudflared `config.yml` we need.
@@ -0,0 +1,158 @@
+import Foundation
+
+/// Single-pass, byte-level parser for cloudflared's Prometheus `/metrics` text.
+///
+/// cloudflared exports a few hundred series; we need about six. Each line's metric name
+/// is compared against a small table before anything else is looked at, so unwanted
+/// lines are skipped without being split or decoded. Only wanted values (and histogram
+/// `le` labels) are converted to numbers. Series with several label sets (per edge
+/// connection, per status code) are summed.
+///
+/// Expected format:
+/// ```
+/// # TYPE cloudflared_tunnel_total_requests counter
+/// cloudflared_tunnel_total_requests 42
+/// quic_client_sent_bytes{conn_index="0"} 1.234e+06
+/// cloudflared_proxy_connect_latency_bucket{le="10"} 7
+/// ```
+enum CloudflaredMetricsParser {
+
+    /// Snapshot fields a metric line contributes to
+    private enum Field {
+        case totalRequests
+        case requestErrors
+        case activeStreams
+        case concurrentRequests
+        case bytesSent
+        case bytesReceived
+        case latencyBucket
+    }
+
+    nonisolated private static let fields: [(name: [UInt8], field: Field)] = [
+        ("cloudflared_tunnel_total_requests", .totalRequests),
+        ("cloudflared_tunnel_request_errors", .requestErrors),
+        ("cloudflared_tunnel_active_streams", .activeStreams),
+        ("cloudflared_tunnel_concurrent_requests_per_tunnel", .concurrentRequests),
+        ("quic_client_sent_bytes", .bytesSent),
+        ("quic_client_receive_bytes", .bytesReceived),
+        ("cloudflared_proxy_connect_latency_bucket", .latencyBucket)
+    ].map { (Array($0.0.utf8), $0.1) }
+
+    nonisolated private static let newline = UInt8(ascii: "\n")
+    nonisolated private static let space = UInt8(ascii: " ")
+    nonisolated private static let hash = UInt8(ascii: "#")
+    nonisolated private static let openBrace = UInt8(ascii: "{")
+    nonisolated private static let closeBrace = UInt8(ascii: "}")
+    nonisolated private static let quote = UInt8(ascii: "\"")
+    nonisolated private static let leLabel = Array("le=\"".utf8)
+
+    /// Longest number token accepted (values and `le` bounds)
+    nonisolated private static let maxNumberLength = 63
+
+    // MARK: - Parsing
+
+    nonisolated static func snapshot(in data: Data) -> CloudflaredMetricsSnapshot {
+        data.withUnsafeBytes { snapshot(in: $0) }
+    }
+
+    nonisolated static func snapshot(in bytes: UnsafeRawBufferPointer) -> CloudflaredMetricsSnapshot {
+        var snapshot = CloudflaredMetricsSnapshot()
+        var hasActiveStreams = false
+        var concurrentRequests = 0.0
+        var buckets: [Double: Double] = [:]
+
+        var lineStart = 0
+        while lineStart < bytes.count {
+            let lineEnd = bytes[lineStart...].firstIndex(of: newline) ?? bytes.count
+            defer { lineStart = lineEnd + 1 }
+            guard lineEnd > lineStart, bytes[lineStart] != hash else { continue }
+
+            let line = lineStart..<lineEnd
+            let nameEnd = bytes[line].firstIndex { $0 == openBrace || $0 == space } ?? lineEnd
+            guard let field = field(named: lineStart..<nameEnd, in: bytes) else { continue }
+
+            var valueStart = nameEnd
+            var labels: Range<Int>?
+            if nameEnd < lineEnd, bytes[nameEnd] == openBrace {
+                guard let close = bytes[nameEnd..<lineEnd].firstIndex(of: closeBrace) else { continue }
+                labels = (nameEnd + 1)..<close
+                valueStart = close + 1
+            }
+            guard let value = number(after: valueStart, end: lineEnd, in: bytes) else { continue }
+
+            switch field {
+            case .totalRequests: snapshot.totalRequests += value
+            case .requestErrors: snapshot.requestErrors += value
+            case .activeStreams:
+                snapshot.activeStreams += value
+                hasActiveStreams = true
+            case .concurrentRequests: concurrentRequests += value
+            case .bytesSent: snapshot.bytesSent += value
+            case .bytesReceived: snapshot.bytesReceived += value
+            case .latencyBucket:
+                guard let labels, let bound = upperBound(in: labels, of: bytes) else { continue }
+                buckets[bound, default: 0] += value
+            }
+        }
+
+        // Older cloudflared builds only export the per-tunnel request gauge
+        if !hasActiveStreams {
+            snapshot.activeStreams = concurrentRequests
+        }
+        snapshot.latencyBuckets = buckets
+            .map { CloudflaredMetricsSnapshot.LatencyBucket(upperBound: $0.key, cumulativeCount: $0.value) }
+            .sorted { $0.upperBound < $1.upperBound }
+        return snapshot
+    }
+
+    // MARK: - Private Methods
+
+    nonisolated private static func field(named name: Range<Int>, in bytes: UnsafeRawBufferPointer) -> Field? {
+        for entry in fields where entry.name.count == name.count {
+            if entry.name.elementsEqual(bytes[name]) {
+                return entry.field
+            }
+        }
+        return nil
+    }
+
+    /// Parses the sample value: the first token after `start` (a timestamp may follow).
+    nonisolated private static func number(after start: Int, end: Int, in bytes: UnsafeRawBufferPointer) -> Double? {
+        var tokenStart = start
+        while tokenStart < end, bytes[tokenStart] == space { tokenStart += 1 }
+        let tokenEnd = bytes[tokenStart..<end].firstIndex(of: space) ?? end
+        return number(in: tokenStart..<tokenEnd, of: bytes)
+    }
+
+    /// The `le` label of a histogram bucket line.
+    nonisolated private static func upperBound(in labels: Range<Int>, of bytes: UnsafeRawBufferPointer) -> Double? {
+        var index = labels.lowerBound
+        while index + leLabel.count <= labels.upperBound {
+            // Match at the start or after a separating comma
+            let atLabelStart = index == labels.lowerBound || bytes[index - 1] == UInt8(ascii: ",")
+            if atLabelStart, leLabel.elementsEqual(bytes[index..<(index + leLabel.count)]) {
+                let valueStart = index + leLabel.count
+                guard let valueEnd = bytes[valueStart..<labels.upperBound].firstIndex(of: quote) else { return nil }
+                return number(in: valueStart..<valueEnd, of: bytes)
+            }
+            index += 1
+        }
+        return nil
+    }
+
+    /// Decodes a Prometheus float ("42", "1.5e+06", "+Inf", "NaN") without building a String.
+    nonisolated private static func number(in token: Range<Int>, of bytes: UnsafeRawBufferPointer) -> Double? {
+        guard !token.isEmpty, token.count <= maxNumberLength else { return nil }
+        return withUnsafeTemporaryAllocation(of: CChar.self, capacity: token.count + 1) { buffer in
+            for (offset, byte) in bytes[token].enumerated() {
+                buffer[offset] = CChar(bitPattern: byte)
+            }
+            buffer[token.count] = 0
+
+            var parsedEnd: UnsafeMutablePointer<CChar>?
+            let value = strtod(buffer.baseAddress!, &parsedEnd)
+            guard let parsedEnd, parsedEnd == buffer.baseAddress! + token.count else { return nil }
+            return value
+        }
+    }
+}
@@ -0,0 +1,27 @@
+import Foundation
+
+/// Fetches and parses cloudflared's Prometheus endpoint (`--metrics 127.0.0.1:0`).
+///
+/// Uses its own ephemeral session, so scrapes never touch the shared URL cache or cookie
+/// store, and keeps the loopback connection alive between scrapes.
+nonisolated struct CloudflaredMetricsScraper: Sendable {
+    private let session: URLSession
+
+    init(timeout: TimeInterval = 2) {
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.timeoutIntervalForRequest = timeout
+        configuration.requestCachePolicy = .reloadIgnoringLocalCacheData
+        configuration.connectionProxyDictionary = [:]
+        configuration.httpMaximumConnectionsPerHost = 1
+        session = URLSession(configuration: configuration)
+    }
+
+    /// One snapshot of the tunnel's counters, or nil if the endpoint didn't answer.
+    @concurrent
+    func scrape(port: Int) async -> CloudflaredMetricsSnapshot? {
+        guard let url = URL(string: "http://127.0.0.1:\(port)/metrics"),
+              let (data, response) = try? await session.data(from: url),
+              (response as? HTTPURLResponse)?.statusCode == 200 else { return nil }
+        return CloudflaredMetricsParser.snapshot(in: data)
+    }
+}
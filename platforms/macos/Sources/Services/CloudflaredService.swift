@@ -7,10 +7,12 @@ import Defaults
 /// Manages cloudflared tunnel subprocesses
 actor CloudflaredService {
     private var processes: [UUID: Process] = [:]
-    private var outputTasks: [UUID: Task<Void, Never>] = [:]
+    /// Reads every cloudflared pipe; drained by the single `outputTask`
+    private let outputReader = ChildOutputReader<UUID>()
+    private var outputTask: Task<Void, Never>?
     private var urlHandlers: [UUID: @Sendable (String) -> Void] = [:]
     private var errorHandlers: [UUID: @Sendable (String) -> Void] = [:]
-    private var logHandlers: [UUID: @Sendable (String) -> Void] = [:]
+    private var logHandlers: [UUID: @Sendable ([String]) -> Void] = [:]
 
     // MARK: - Dependency Check
 
@@ -18,14 +20,14 @@ actor CloudflaredService {
         // Check custom path first
         if let custom = Defaults[.customCloudflaredPath],
            !custom.isEmpty,
-           FileManager.default.fileExists(atPath: custom) {
+           PathProbeCache.shared.exists(custom) {
             return custom
         }
         let paths = [
             "/opt/homebrew/bin/cloudflared",
             "/usr/local/bin/cloudflared"
         ]
-        return paths.first { FileManager.default.fileExists(atPath: $0) }
+        return PathProbeCache.shared.firstExisting(paths)
     }
 
     nonisolated var isInstalled: Bool {
@@ -35,7 +37,7 @@ actor CloudflaredService {
     nonisolated var isUsingCustomPath: Bool {
         if let custom = Defaults[.customCloudflaredPath],
            !custom.isEmpty,
-           FileManager.default.fileExists(atPath: custom) {
+           PathProbeCache.shared.exists(custom) {
             return true
         }
         return false
@@ -46,7 +48,7 @@ actor CloudflaredService {
             "/opt/homebrew/bin/cloudflared",
             "/usr/local/bin/cloudflared"
         ]
-        return paths.first { FileManager.default.fileExists(atPath: $0) }
+        return PathProbeCache.shared.firstExisting(paths)
     }
 
     // MARK: - Handler Management
@@ -59,7 +61,8 @@ actor CloudflaredService {
         errorHandlers[id] = handler
     }
 
-    func setLogHandler(for id: UUID, handler: @escaping @Sendable (String) -> Void) {
+    /// Log lines arrive in batches, one call per chunk read from the pipe.
+    func setLogHandler(for id: UUID, handler: @escaping @Sendable ([String]) -> Void) {
         logHandlers[id] = handler
     }
 
@@ -109,9 +112,8 @@ actor CloudflaredService {
     }
 
     func stopTunnel(id: UUID) async {
-        // Cancel output reading task
-        outputTasks[id]?.cancel()
-        outputTasks.removeValue(forKey: id)
+        // Stop reading output
+        outputReader.detach(id)
 
         // Terminate process gracefully
         guard let process = processes[id] else { return }
@@ -144,52 +146,38 @@ actor CloudflaredService {
     // MARK: - Output Parsing
 
     private func startReadingOutput(pipe: Pipe, id: UUID) {
-        let task = Task { [weak self] in
-            let handle = pipe.fileHandleForReading
-
-            while !Task.isCancelled {
-                // Use autoreleasepool to prevent memory accumulation from FileHandle reads
-                var output: String = ""
-                autoreleasepool {
-                    let data = handle.availableData
-                    if data.isEmpty {
-                        output = ""
-                    } else {
-                        output = String(data: data, encoding: .utf8)?
-                            .trimmingCharacters(in: .whitespacesAndNewlines) ?? ""
-                    }
-                }
-
-                if output.isEmpty { break }
-
-                // Use split for zero-copy iteration
-                let lines = output.split(separator: "\n", omittingEmptySubsequences: true)
-                for line in lines {
-                    await self?.parseLine(String(line), for: id)
-                }
+        outputReader.attach(pipe, key: id)
+
+        guard outputTask == nil else { return }
+        let batches = outputReader.batches
+        outputTask = Task { [weak self] in
+            for await batch in batches {
+                guard !Task.isCancelled else { break }
+                await self?.parseLines(batch.lines, for: batch.key)
             }
         }
-        outputTasks[id] = task
     }
 
-    private func parseLine(_ line: String, for id: UUID) {
+    private func parseLines(_ lines: [String], for id: UUID) {
         // Forward all lines to log handler
-        logHandlers[id]?(line)
+        logHandlers[id]?(lines)
 
-        // cloudflared outputs the URL like:
-        // "Your quick Tunnel has been created! Visit it at (it may take some time to be reachable):
-        // https://something-random.trycloudflare.com"
-        // OR in newer versions with table format:
-        // "| https://something-random.trycloudflare.com |"
+        for line in lines {
+            // cloudflared outputs the URL like:
+            // "Your quick Tunnel has been created! Visit it at (it may take some time to be reachable):
+            // https://something-random.trycloudflare.com"
+            // OR in newer versions with table format:
+            // "| https://something-random.trycloudflare.com |"
 
-        if let url = extractTunnelURL(from: line) {
-            urlHandlers[id]?(url)
-        }
+            if let url = extractTunnelURL(from: line) {
+                urlHandlers[id]?(url)
+            }
 
-        // Check for errors
-        let lowercased = line.lowercased()
-        if lowercased.contains("error") || lowercased.contains("failed") || lowercased.contains("unable to") {
-            errorHandlers[id]?(line)
+            // Check for errors
+            let lowercased = line.lowercased()
+            if lowercased.contains("error") || lowercased.contains("failed") || lowercased.contains("unable to") {
+                errorHandlers[id]?(line)
+            }
         }
     }
 
@@ -10,11 +10,11 @@ struct PortForwardDependency: Sendable {
     let isRequired: Bool
 
     var isInstalled: Bool {
-        possiblePaths.contains { FileManager.default.fileExists(atPath: $0) }
+        installedPath != nil
     }
 
     var installedPath: String? {
-        possiblePaths.first { FileManager.default.fileExists(atPath: $0) }
+        PathProbeCache.shared.firstExisting(possiblePaths)
     }
 }
 
@@ -69,7 +69,7 @@ actor DependencyChecker {
         // Check custom path first
         if let custom = Defaults[.customKubectlPath],
            !custom.isEmpty,
-           FileManager.default.fileExists(atPath: custom) {
+           PathProbeCache.shared.exists(custom) {
             return custom
         }
         return kubectl.installedPath
@@ -79,7 +79,7 @@ actor DependencyChecker {
         // Check custom path first
         if let custom = Defaults[.customSocatPath],
            !custom.isEmpty,
-           FileManager.default.fileExists(atPath: custom) {
+           PathProbeCache.shared.exists(custom) {
             return custom
         }
         return socat.installedPath
@@ -88,7 +88,7 @@ actor DependencyChecker {
     nonisolated var isUsingCustomKubectl: Bool {
         if let custom = Defaults[.customKubectlPath],
            !custom.isEmpty,
-           FileManager.default.fileExists(atPath: custom) {
+           PathProbeCache.shared.exists(custom) {
             return true
         }
         return false
@@ -97,7 +97,7 @@ actor DependencyChecker {
     nonisolated var isUsingCustomSocat: Bool {
         if let custom = Defaults[.customSocatPath],
            !custom.isEmpty,
-           FileManager.default.fileExists(atPath: custom) {
+           PathProbeCache.shared.exists(custom) {
             return true
         }
         return false
@@ -126,12 +126,18 @@ actor DependencyChecker {
             results.append("\(dep.name): \(result.success ? "Installed" : "Failed - \(result.message)")")
         }
 
+        // Let the next lookup see what brew just installed
+        PathProbeCache.shared.invalidate()
         let allSuccess = missing.allSatisfy(\.isInstalled)
         return (allSuccess, results.joined(separator: "\n"))
     }
 
     private func installWithBrew(brewPath: String, package: String) async -> (success: Bool, message: String) {
-        guard let result = await ProcessExecutor.run(brewPath, arguments: ["install", package]) else {
+        guard let result = await ProcessExecutor.run(
+            brewPath,
+            arguments: ["install", package],
+            timeout: AppConstants.packageInstallTimeout
+        ) else {
             return (false, "Failed to launch brew")
         }
         return result.succeeded
@@ -0,0 +1,81 @@
+import Foundation
+import CoreServices
+
+/// Reports file changes under a directory through FSEvents.
+///
+/// Used for `~/.cloudflared/`, so tunnel discovery re-reads local files only when one
+/// actually changed instead of on a timer. Events for the same burst (an editor's
+/// atomic save, `cloudflared tunnel create` writing several files) arrive as one batch.
+nonisolated final class DirectoryWatcher: @unchecked Sendable {
+
+    /// Paths changed since the last batch, coalesced while the consumer is busy
+    let changes: AsyncStream<[String]>
+
+    private let continuation: AsyncStream<[String]>.Continuation
+    private let queue = DispatchQueue(label: "com.portkiller.directory-watcher", qos: .utility)
+    private var stream: FSEventStreamRef?
+
+    /// Returns nil if `directory` doesn't exist or the stream cannot be started.
+    init?(directory: URL, latency: TimeInterval = 0.3) {
+        var isDirectory: ObjCBool = false
+        guard FileManager.default.fileExists(atPath: directory.path, isDirectory: &isDirectory),
+              isDirectory.boolValue else { return nil }
+
+        (changes, continuation) = AsyncStream.makeStream(of: [String].self, bufferingPolicy: .bufferingNewest(8))
+
+        var context = FSEventStreamContext(
+            version: 0,
+            info: Unmanaged.passUnretained(self).toOpaque(),
+            retain: nil,
+            release: nil,
+            copyDescription: nil
+        )
+        let callback: FSEventStreamCallback = { _, info, _, paths, _, _ in
+            guard let info else { return }
+            let watcher = Unmanaged<DirectoryWatcher>.fromOpaque(info).takeUnretainedValue()
+            // kFSEventStreamCreateFlagUseCFTypes: `paths` is a CFArray of CFString
+            let changed = unsafeBitCast(paths, to: NSArray.self) as? [String] ?? []
+            watcher.continuation.yield(changed)
+        }
+        let flags = FSEventStreamCreateFlags(
+            kFSEventStreamCreateFlagUseCFTypes | kFSEventStreamCreateFlagFileEvents | kFSEventStreamCreateFlagNoDefer
+        )
+        guard let stream = FSEventStreamCreate(
+            nil,
+            callback,
+            &context,
+            [directory.resolvingSymlinksInPath().path] as CFArray,
+            FSEventStreamEventId(kFSEventStreamEventIdSinceNow),
+            latency,
+            flags
+        ) else {
+            continuation.finish()
+            return nil
+        }
+
+        FSEventStreamSetDispatchQueue(stream, queue)
+        guard FSEventStreamStart(stream) else {
+            FSEventStreamInvalidate(stream)
+            FSEventStreamRelease(stream)
+            continuation.finish()
+            return nil
+        }
+        self.stream = stream
+    }
+
+    deinit {
+        invalidate()
+    }
+
+    /// Stops watching and finishes `changes`.
+    func invalidate() {
+        queue.sync {
+            guard let stream else { return }
+            FSEventStreamStop(stream)
+            FSEventStreamInvalidate(stream)
+            FSEventStreamRelease(stream)
+            self.stream = nil
+        }
+        continuation.finish()
+    }
+}
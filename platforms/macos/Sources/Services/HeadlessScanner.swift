@@ -0,0 +1,89 @@
+import AppKit
+import Defaults
+import PortSnapshot
+import Synchronization
+
+/// The background scanner: PortKiller launched with `--headless` by its launch agent.
+///
+/// It scans on the user's refresh interval, and at once when any reader posts
+/// `SnapshotNotification.rescanRequested`, and publishes every generation to the
+/// shared snapshot. The menu bar, the main window and `portkiller-cli` all read that
+/// snapshot (see `SharedSnapshotScanner`), so one process table walk serves them all.
+/// While it runs it also writes the port history (`PortHistoryStore`).
+/// No window, no Dock icon, no menu bar item.
+@MainActor
+final class HeadlessScanner {
+    static let launchArgument = "--headless"
+
+    static var isRequested: Bool {
+        CommandLine.arguments.contains(launchArgument)
+    }
+
+    private let scanner: PortScannerProtocol
+    private let publisher: SnapshotPublisher
+    private let history: PortHistoryStore
+
+    init(
+        scanner: PortScannerProtocol = LibprocPortScanner(),
+        url: URL = SnapshotFile.defaultURL,
+        history: PortHistoryStore = PortHistoryStore()
+    ) {
+        self.scanner = scanner
+        self.publisher = SnapshotPublisher(url: url, headless: true)
+        self.history = history
+    }
+
+    /// Runs the scanner until the process is terminated; never returns.
+    static func run() -> Never {
+        let app = NSApplication.shared
+        app.setActivationPolicy(.prohibited)
+        let headless = HeadlessScanner()
+        let task = Task { await headless.scanLoop() }
+        app.run()
+        task.cancel()
+        exit(EXIT_SUCCESS)
+    }
+
+    /// Scans whenever a tick or a rescan request arrives. Requests that pile up during
+    /// a scan collapse into one follow-up scan.
+    ///
+    /// Only a scan answering a request is published unconditionally, since its reader
+    /// waits for the next generation; ticks follow the publisher's heartbeat rule.
+    func scanLoop() async {
+        let (triggers, continuation) = AsyncStream.makeStream(of: Void.self, bufferingPolicy: .bufferingNewest(1))
+        let rescan = RescanRequest()
+        let observation = SnapshotNotification.rescanRequested.observe {
+            rescan.isPending.withLock { $0 = true }
+            continuation.yield()
+        }
+        let ticker = Task {
+            while !Task.isCancelled {
+                try? await Task.sleep(for: .seconds(max(1, Defaults[.refreshInterval])))
+                continuation.yield()
+            }
+        }
+        defer {
+            ticker.cancel()
+            withExtendedLifetime(observation) {}
+        }
+
+        continuation.yield()
+        let monitor = PerformanceMonitor.shared
+        for await _ in triggers {
+            // Taken before scanning, so a request arriving mid-scan gets a scan of its own
+            let force = rescan.isPending.withLock { requested in
+                defer { requested = false }
+                return requested
+            }
+            let delta = await monitor.measure(.scan) { await scanner.scanDelta() }
+            await publisher.publish(delta, force: force)
+            await history.record(delta)
+        }
+    }
+}
+
+/// Whether a reader asked for a rescan since the last scan began; set from the
+/// notification callback, taken by the scan loop
+nonisolated private final class RescanRequest: Sendable {
+    let isPending = Mutex(false)
+}
@@ -0,0 +1,137 @@
+import Foundation
+
+/// Incremental decoder for `kubectl get ... -o json` list responses.
+///
+/// Bytes are fed as they arrive from the pipe. A single-pass scanner tracks nesting and
+/// string state, finds the top-level `"items"` array and cuts out each element once its
+/// closing brace arrives; only that element is handed to `JSONDecoder`, decoding just the
+/// fields `Item` declares. Peak memory is one item plus the unread tail of the current
+/// chunk instead of the whole multi-megabyte response. The list's own `metadata` object
+/// is cut out the same way, for the `resourceVersion` a watch resumes from.
+///
+/// Not thread-safe: feed it from one reader, and read `items` once feeding is done.
+nonisolated final class KubernetesListDecoder<Item: Decodable>: @unchecked Sendable {
+
+    /// Every item decoded so far, in response order
+    private(set) var items: [Item] = []
+
+    /// Whether the closing bracket of the `items` array has been seen
+    private(set) var isComplete = false
+
+    /// Items that failed to decode (skipped rather than failing the whole list)
+    private(set) var failedItemCount = 0
+
+    /// `metadata.resourceVersion` of the list, once its metadata has been seen
+    private(set) var resourceVersion: String?
+
+    private let decoder = JSONDecoder()
+
+    // Scanner state
+    private var depth = 0
+    private var inString = false
+    private var escaped = false
+    /// Depth of the `items` array's elements, once inside it
+    private var itemsDepth: Int?
+    /// The last string closed directly inside the root object, and the key it became
+    private var rootString: [UInt8] = []
+    private var rootKey: [UInt8] = []
+    /// Bytes of the item being received
+    private var current: [UInt8] = []
+    private var inItem = false
+    /// Whether the object being received is the list's metadata rather than an item
+    private var inMetadata = false
+
+    private struct ListMetadata: Decodable {
+        let resourceVersion: String?
+    }
+
+    private static var itemsKey: [UInt8] { Array("items".utf8) }
+    private static var metadataKey: [UInt8] { Array("metadata".utf8) }
+
+    /// Feeds the next chunk and returns how many items it completed.
+    @discardableResult
+    func feed(_ data: Data) -> Int {
+        data.withUnsafeBytes { feed($0) }
+    }
+
+    /// Feeds the next chunk and returns how many items it completed.
+    @discardableResult
+    func feed(_ bytes: UnsafeRawBufferPointer) -> Int {
+        let before = items.count
+        var itemStart = inItem ? 0 : nil as Int?
+
+        for index in bytes.indices {
+            let byte = bytes[index]
+
+            if inString {
+                if escaped {
+                    escaped = false
+                } else if byte == UInt8(ascii: "\\") {
+                    escaped = true
+                } else if byte == UInt8(ascii: "\"") {
+                    inString = false
+                } else if depth == 1 {
+                    rootString.append(byte)
+                }
+                continue
+            }
+
+            switch byte {
+            case UInt8(ascii: "\""):
+                inString = true
+                if depth == 1 { rootString.removeAll(keepingCapacity: true) }
+
+            case UInt8(ascii: ":") where depth == 1:
+                rootKey = rootString
+
+            case UInt8(ascii: "{"), UInt8(ascii: "["):
+                if byte == UInt8(ascii: "[") && depth == 1 && itemsDepth == nil && rootKey == Self.itemsKey {
+                    itemsDepth = depth + 1
+                } else if byte == UInt8(ascii: "{") && depth == itemsDepth && !inItem {
+                    inItem = true
+                    itemStart = index
+                } else if byte == UInt8(ascii: "{") && depth == 1 && !inItem && rootKey == Self.metadataKey {
+                    inItem = true
+                    inMetadata = true
+                    itemStart = index
+                }
+                depth += 1
+
+            case UInt8(ascii: "}"), UInt8(ascii: "]"):
+                depth -= 1
+                if inItem && depth == (inMetadata ? 1 : itemsDepth) {
+                    let start = itemStart ?? 0
+                    current.append(contentsOf: UnsafeRawBufferPointer(rebasing: bytes[start...index]))
+                    decodeCurrent()
+                    inItem = false
+                    itemStart = nil
+                } else if let itemsDepth, depth == itemsDepth - 1, byte == UInt8(ascii: "]") {
+                    isComplete = true
+                }
+
+            default:
+                break
+            }
+        }
+
+        // Carry the unfinished item over to the next chunk
+        if inItem, let start = itemStart {
+            current.append(contentsOf: UnsafeRawBufferPointer(rebasing: bytes[start...]))
+        }
+        return items.count - before
+    }
+
+    private func decodeCurrent() {
+        defer { current.removeAll(keepingCapacity: true) }
+        if inMetadata {
+            inMetadata = false
+            resourceVersion = (try? decoder.decode(ListMetadata.self, from: Data(current)))?.resourceVersion
+            return
+        }
+        do {
+            items.append(try decoder.decode(Item.self, from: Data(current)))
+        } catch {
+            failedItemCount += 1
+        }
+    }
+}
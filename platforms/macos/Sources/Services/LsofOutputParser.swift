@@ -0,0 +1,254 @@
+import Foundation
+
+/// Single-pass, byte-level parser for `lsof -iTCP -P -n` output.
+///
+/// Walks the raw stdout bytes once, splitting lines and columns in place. Each record
+/// stores byte ranges into the buffer instead of `String`s, so a scan allocates only the
+/// records array; callers materialize text just for the fields they actually need (e.g.
+/// the process name of a PID that isn't in the metadata cache yet).
+///
+/// Expected format:
+/// ```
+/// COMMAND    PID  USER   FD   TYPE             DEVICE SIZE/OFF NODE NAME
+/// node     34805  code   19u  IPv6 0x3d8015e195af1f3f      0t0  TCP [::1]:3000 (LISTEN)
+/// ```
+enum LsofOutputParser {
+
+    /// One listening socket line. Ranges are byte offsets into the parsed buffer.
+    struct Record: Sendable, Equatable {
+        let pid: Int
+        let port: Int
+        /// COMMAND column, still lsof-escaped (`\xHH`)
+        let command: Range<Int>
+        let user: Range<Int>
+        let fd: Range<Int>
+        /// Host part of the NAME column ("127.0.0.1", "*", "[::1]"); may be empty
+        let address: Range<Int>
+    }
+
+    nonisolated private static let newline = UInt8(ascii: "\n")
+    nonisolated private static let space = UInt8(ascii: " ")
+    nonisolated private static let colon = UInt8(ascii: ":")
+    nonisolated private static let backslash = UInt8(ascii: "\\")
+    nonisolated private static let openBracket = UInt8(ascii: "[")
+    nonisolated private static let closeBracket = UInt8(ascii: "]")
+
+    /// Columns before NAME (COMMAND PID USER FD TYPE DEVICE SIZE/OFF NODE)
+    nonisolated private static let nameColumnIndex = 8
+
+    /// Longest decimal PID or port accepted; keeps `integer(in:of:)` overflow-free
+    nonisolated private static let maxIntegerDigits = 10
+
+    // MARK: - Parsing
+
+    /// Parses listening sockets from raw lsof output.
+    nonisolated static func records(in data: Data) -> [Record] {
+        data.withUnsafeBytes { records(in: $0) }
+    }
+
+    /// Parses listening sockets from raw lsof output, skipping the header line and any
+    /// line that doesn't carry a PID and an address:port NAME column.
+    nonisolated static func records(in bytes: UnsafeRawBufferPointer) -> [Record] {
+        var records: [Record] = []
+        // Reused for every line so column splitting doesn't allocate
+        var columns: [Range<Int>] = []
+        columns.reserveCapacity(nameColumnIndex + 2)
+
+        forEachDataLine(in: bytes) { line in
+            splitColumns(of: line, in: bytes, into: &columns)
+            if let record = record(from: columns, in: bytes) {
+                records.append(record)
+            }
+        }
+        return records
+    }
+
+    /// Extracts unique PIDs (second column) without parsing the rest of each line.
+    /// Used for ESTABLISHED-connection lookups, where nothing else is needed.
+    nonisolated static func pids(in data: Data) -> Set<Int> {
+        data.withUnsafeBytes { bytes in
+            var pids = Set<Int>()
+            forEachDataLine(in: bytes) { line in
+                var cursor = line.lowerBound
+                guard nextColumn(in: bytes, from: &cursor, end: line.upperBound) != nil,
+                      let pidColumn = nextColumn(in: bytes, from: &cursor, end: line.upperBound),
+                      let pid = integer(in: bytes, of: pidColumn) else { return }
+                pids.insert(pid)
+            }
+            return pids
+        }
+    }
+
+    /// Materializes a text field of a record. Short fields (FD, IPv4 addresses, most
+    /// user names) fit Swift's small-string storage, so this doesn't allocate for them.
+    nonisolated static func text(_ range: Range<Int>, in bytes: UnsafeRawBufferPointer) -> String {
+        String(decoding: UnsafeRawBufferPointer(rebasing: bytes[range]), as: UTF8.self)
+    }
+
+    /**
+     * Decodes lsof hex escape sequences (\xHH) into proper characters.
+     *
+     * lsof escapes non-ASCII bytes and some special characters as \xHH sequences.
+     * Escaped bytes are collected and decoded as UTF-8 together with the literal bytes,
+     * which correctly handles multi-byte characters (e.g., \xe4\xbc\x81 → 企).
+     * Names without a backslash (the common case) are decoded directly.
+     */
+    nonisolated static func decodeEscapes(_ bytes: UnsafeRawBufferPointer) -> String {
+        guard bytes.contains(backslash) else { return String(decoding: bytes, as: UTF8.self) }
+
+        var decoded: [UInt8] = []
+        decoded.reserveCapacity(bytes.count)
+        var index = 0
+        while index < bytes.count {
+            if bytes[index] == backslash,
+               index + 3 < bytes.count,
+               bytes[index + 1] == UInt8(ascii: "x"),
+               let high = hexValue(bytes[index + 2]),
+               let low = hexValue(bytes[index + 3]) {
+                decoded.append(high << 4 | low)
+                index += 4
+                continue
+            }
+            decoded.append(bytes[index])
+            index += 1
+        }
+        return String(decoding: decoded, as: UTF8.self)
+    }
+
+    // MARK: - Private Methods
+
+    /// Calls `body` with the byte range of every non-empty line after the header.
+    nonisolated private static func forEachDataLine(
+        in bytes: UnsafeRawBufferPointer,
+        _ body: (Range<Int>) -> Void
+    ) {
+        var lineStart = 0
+        var isHeader = true
+        while lineStart < bytes.count {
+            var lineEnd = lineStart
+            while lineEnd < bytes.count && bytes[lineEnd] != newline { lineEnd += 1 }
+
+            if isHeader {
+                isHeader = false
+            } else if lineEnd > lineStart {
+                body(lineStart..<lineEnd)
+            }
+            lineStart = lineEnd + 1
+        }
+    }
+
+    /// Splits a line on runs of spaces, replacing the contents of `columns`.
+    nonisolated private static func splitColumns(
+        of line: Range<Int>,
+        in bytes: UnsafeRawBufferPointer,
+        into columns: inout [Range<Int>]
+    ) {
+        columns.removeAll(keepingCapacity: true)
+        var cursor = line.lowerBound
+        while let column = nextColumn(in: bytes, from: &cursor, end: line.upperBound) {
+            columns.append(column)
+        }
+    }
+
+    /// Returns the next space-delimited column at or after `cursor`, advancing it.
+    nonisolated private static func nextColumn(
+        in bytes: UnsafeRawBufferPointer,
+        from cursor: inout Int,
+        end: Int
+    ) -> Range<Int>? {
+        while cursor < end && bytes[cursor] == space { cursor += 1 }
+        guard cursor < end else { return nil }
+        let start = cursor
+        while cursor < end && bytes[cursor] != space { cursor += 1 }
+        return start..<cursor
+    }
+
+    nonisolated private static func record(from columns: [Range<Int>], in bytes: UnsafeRawBufferPointer) -> Record? {
+        guard columns.count > nameColumnIndex,
+              let pid = integer(in: bytes, of: columns[1]) else { return nil }
+
+        // The NAME column is usually second-to-last, before "(LISTEN)". Search backwards
+        // for a column with ":" that isn't a device ID (0x...) or size (0t...).
+        var name: Range<Int>?
+        for index in stride(from: columns.count - 1, through: nameColumnIndex, by: -1) {
+            let column = columns[index]
+            if contains(colon, in: bytes, range: column) && !isHexOrOffset(column, in: bytes) {
+                name = column
+                break
+            }
+        }
+
+        guard let name, let split = splitAddress(name, in: bytes) else { return nil }
+
+        return Record(
+            pid: pid,
+            port: split.port,
+            command: columns[0],
+            user: columns[2],
+            fd: columns[3],
+            address: split.address
+        )
+    }
+
+    /// Splits "127.0.0.1:3000", "*:8080" or "[::1]:3000" into host range and port.
+    nonisolated private static func splitAddress(
+        _ range: Range<Int>,
+        in bytes: UnsafeRawBufferPointer
+    ) -> (address: Range<Int>, port: Int)? {
+        let separator: Int
+        if bytes[range.lowerBound] == openBracket {
+            // IPv6: the port follows "]:"
+            guard let bracketEnd = firstIndex(of: closeBracket, in: bytes, range: range),
+                  bracketEnd + 1 < range.upperBound,
+                  bytes[bracketEnd + 1] == colon else { return nil }
+            separator = bracketEnd + 1
+        } else {
+            // IPv4: the port follows the last ":"
+            guard let lastColon = lastIndex(of: colon, in: bytes, range: range) else { return nil }
+            separator = lastColon
+        }
+
+        guard let port = integer(in: bytes, of: (separator + 1)..<range.upperBound) else { return nil }
+
+        return (range.lowerBound..<separator, port)
+    }
+
+    /// Parses an unsigned decimal column; nil if empty, too long, or not all digits.
+    nonisolated private static func integer(in bytes: UnsafeRawBufferPointer, of range: Range<Int>) -> Int? {
+        guard !range.isEmpty, range.count <= maxIntegerDigits else { return nil }
+        var value = 0
+        for index in range {
+            let digit = bytes[index] &- UInt8(ascii: "0")
+            guard digit < 10 else { return nil }
+            value = value * 10 + Int(digit)
+        }
+        return value
+    }
+
+    nonisolated private static func isHexOrOffset(_ range: Range<Int>, in bytes: UnsafeRawBufferPointer) -> Bool {
+        guard range.count >= 2, bytes[range.lowerBound] == UInt8(ascii: "0") else { return false }
+        let marker = bytes[range.lowerBound + 1]
+        return marker == UInt8(ascii: "x") || marker == UInt8(ascii: "t")
+    }
+
+    nonisolated private static func contains(_ byte: UInt8, in bytes: UnsafeRawBufferPointer, range: Range<Int>) -> Bool {
+        firstIndex(of: byte, in: bytes, range: range) != nil
+    }
+
+    nonisolated private static func firstIndex(of byte: UInt8, in bytes: UnsafeRawBufferPointer, range: Range<Int>) -> Int? {
+        range.first { bytes[$0] == byte }
+    }
+
+    nonisolated private static func lastIndex(of byte: UInt8, in bytes: UnsafeRawBufferPointer, range: Range<Int>) -> Int? {
+        range.reversed().first { bytes[$0] == byte }
+    }
+
+    nonisolated private static func hexValue(_ byte: UInt8) -> UInt8? {
+        switch byte {
+        case UInt8(ascii: "0")...UInt8(ascii: "9"): return byte - UInt8(ascii: "0")
+        case UInt8(ascii: "a")...UInt8(ascii: "f"): return byte - UInt8(ascii: "a") + 10
+        case UInt8(ascii: "A")...UInt8(ascii: "F"): return byte - UInt8(ascii: "A") + 10
+        default: return nil
+        }
+    }
+}
@@ -0,0 +1,60 @@
+/**
+ * PathProbeCache.swift
+ * PortKiller
+ *
+ * Remembered answers to "does this executable exist", for the kubectl, socat and
+ * cloudflared lookups that views and child launches repeat many times a second.
+ */
+
+import Foundation
+import Synchronization
+
+/// Caches `fileExists` results per path for `AppConstants.dependencyProbeLifetime`.
+///
+/// Without it, every render of a port-forwarder or settings view stats each candidate
+/// path again. Expiry picks up installs made outside the app; `invalidate()` picks up
+/// ones made through it right away. Custom paths are probed like any other, so
+/// changing one in settings takes effect on the next lookup.
+nonisolated final class PathProbeCache: Sendable {
+
+    static let shared = PathProbeCache()
+
+    private struct Entry {
+        let exists: Bool
+        let checkedAt: ContinuousClock.Instant
+    }
+
+    private let lifetime: Duration
+    private let probe: @Sendable (String) -> Bool
+    private let entries = Mutex<[String: Entry]>([:])
+
+    init(
+        lifetime: Duration = AppConstants.dependencyProbeLifetime,
+        probe: @escaping @Sendable (String) -> Bool = { FileManager.default.fileExists(atPath: $0) }
+    ) {
+        self.lifetime = lifetime
+        self.probe = probe
+    }
+
+    /// Whether `path` exists, as of at most `lifetime` ago
+    func exists(_ path: String) -> Bool {
+        let now = ContinuousClock.now
+        if let entry = entries.withLock({ $0[path] }), now - entry.checkedAt < lifetime {
+            return entry.exists
+        }
+        // Probe outside the lock; a concurrent miss on the same path just probes twice
+        let exists = probe(path)
+        entries.withLock { $0[path] = Entry(exists: exists, checkedAt: now) }
+        return exists
+    }
+
+    /// The first of `paths` that exists
+    func firstExisting(_ paths: [String]) -> String? {
+        paths.first(where: exists)
+    }
+
+    /// Forgets every result, e.g. after installing a dependency
+    func invalidate() {
+        entries.withLock { $0.removeAll() }
+    }
+}
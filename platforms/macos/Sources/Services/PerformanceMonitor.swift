@@ -0,0 +1,187 @@
+import Foundation
+import Darwin
+import os
+import Synchronization
+
+/// Work timed by `PerformanceMonitor`, one signpost interval name and histogram each
+nonisolated enum PerformancePhase: Int, CaseIterable, Sendable, Identifiable {
+    /// One whole `scanDelta()`, whichever backend
+    case scan
+    /// Walking the process table and socket descriptors (libproc backend)
+    case socketEnumeration
+    /// Spawning lsof and reading its output (lsof backend)
+    case lsofSpawn
+    case lsofParse
+    /// Start-time identities of listener PIDs, the metadata cache key
+    case processIdentity
+    /// argv of processes not in the metadata cache
+    case commandLine
+    /// One `AppState.refresh()` pass: scan, apply, watchers, auto-kill
+    case refresh
+    /// Applying a scan delta to `AppState.portTable`
+    case updatePorts
+    /// `AppState.filteredPorts`, memoized stages included
+    case filteredPorts
+    case connectionCheck
+    case autoKillCheck
+    /// One wakeup of a `ChildOutputReader` pipe
+    case childOutputRead
+    /// Process start to the first frame of the menu bar item, once per launch
+    case launch
+
+    var id: Int { rawValue }
+
+    var title: String {
+        switch self {
+        case .scan: "Scan"
+        case .socketEnumeration: "libproc sockets"
+        case .lsofSpawn: "lsof spawn + read"
+        case .lsofParse: "lsof parse"
+        case .processIdentity: "Process identity"
+        case .commandLine: "Command line"
+        case .refresh: "Refresh"
+        case .updatePorts: "Update ports"
+        case .filteredPorts: "Filtered ports"
+        case .connectionCheck: "Port-forward check"
+        case .autoKillCheck: "Auto-kill check"
+        case .childOutputRead: "Child output read"
+        case .launch: "Launch to first frame"
+        }
+    }
+
+    /// os_signpost wants a static string per interval name
+    fileprivate var signpostName: StaticString {
+        switch self {
+        case .scan: "Scan"
+        case .socketEnumeration: "SocketEnumeration"
+        case .lsofSpawn: "LsofSpawn"
+        case .lsofParse: "LsofParse"
+        case .processIdentity: "ProcessIdentity"
+        case .commandLine: "CommandLine"
+        case .refresh: "Refresh"
+        case .updatePorts: "UpdatePorts"
+        case .filteredPorts: "FilteredPorts"
+        case .connectionCheck: "ConnectionCheck"
+        case .autoKillCheck: "AutoKillCheck"
+        case .childOutputRead: "ChildOutputRead"
+        case .launch: "Launch"
+        }
+    }
+}
+
+/// Latency summary of one phase for the performance HUD
+nonisolated struct PerformancePhaseSummary: Sendable, Identifiable {
+    let phase: PerformancePhase
+    let count: Int
+    let p50: Duration
+    let p99: Duration
+    let maximum: Duration
+
+    var id: Int { phase.id }
+}
+
+/// Times scan, refresh and monitor phases as os_signpost intervals (visible in
+/// Instruments under the "Performance" category of `com.portkiller.app`) and into an
+/// in-memory `LatencyHistogram` per phase, read by the hidden performance HUD.
+///
+/// Always on: a measurement is two clock reads, a signpost (close to free while no
+/// tool is recording) and one histogram increment under a lock.
+nonisolated final class PerformanceMonitor: Sendable {
+
+    static let shared = PerformanceMonitor()
+
+    private let signposter = OSSignposter(subsystem: "com.portkiller.app", category: "Performance")
+    private let histograms = Mutex(PerformancePhase.allCases.map { _ in LatencyHistogram() })
+    private let refreshInterval = Mutex<Duration?>(nil)
+    private let hasRecordedLaunch = Mutex(false)
+
+    init() {}
+
+    // MARK: - Measuring
+
+    func measure<T>(_ phase: PerformancePhase, _ body: () throws -> T) rethrows -> T {
+        let interval = signposter.beginInterval(phase.signpostName)
+        let start = ContinuousClock.now
+        defer {
+            record(phase, duration: ContinuousClock.now - start)
+            signposter.endInterval(phase.signpostName, interval)
+        }
+        return try body()
+    }
+
+    func measure<T>(_ phase: PerformancePhase, _ body: () async throws -> T) async rethrows -> T {
+        let interval = signposter.beginInterval(phase.signpostName)
+        let start = ContinuousClock.now
+        defer {
+            record(phase, duration: ContinuousClock.now - start)
+            signposter.endInterval(phase.signpostName, interval)
+        }
+        return try await body()
+    }
+
+    func record(_ phase: PerformancePhase, duration: Duration) {
+        histograms.withLock { $0[phase.rawValue].record(duration) }
+    }
+
+    /// Records `.launch` as the time since the kernel started this process, so dyld
+    /// and static initializers count too. Only the first call of a launch counts.
+    func recordFirstFrame() {
+        let isFirst = hasRecordedLaunch.withLock { recorded in
+            defer { recorded = true }
+            return !recorded
+        }
+        guard isFirst, let identity = ProcessInspector.identity(of: Int(getpid())) else { return }
+        let started = Date(timeIntervalSince1970: Double(identity.startTime) / 1_000_000)
+        record(.launch, duration: .seconds(Date().timeIntervalSince(started)))
+        signposter.emitEvent("FirstFrame")
+    }
+
+    // MARK: - Gauges
+
+    /// Delay the auto-refresh loop is currently sleeping between scans, after backoff
+    var effectiveRefreshInterval: Duration? {
+        refreshInterval.withLock { $0 }
+    }
+
+    func setEffectiveRefreshInterval(_ interval: Duration) {
+        refreshInterval.withLock { $0 = interval }
+    }
+
+    /// Resident set size of this process, nil if the kernel won't say
+    static func residentMemoryBytes() -> UInt64? {
+        var info = mach_task_basic_info()
+        var count = mach_msg_type_number_t(MemoryLayout<mach_task_basic_info>.size / MemoryLayout<natural_t>.size)
+        let result = withUnsafeMutablePointer(to: &info) { pointer in
+            pointer.withMemoryRebound(to: integer_t.self, capacity: Int(count)) {
+                task_info(mach_task_self_, task_flavor_t(MACH_TASK_BASIC_INFO), $0, &count)
+            }
+        }
+        return result == KERN_SUCCESS ? info.resident_size : nil
+    }
+
+    // MARK: - Reading
+
+    /// Phases measured at least once, in declaration order
+    func summaries() -> [PerformancePhaseSummary] {
+        let histograms = histograms.withLock { $0 }
+        return PerformancePhase.allCases.compactMap { phase in
+            let histogram = histograms[phase.rawValue]
+            guard !histogram.isEmpty else { return nil }
+            return PerformancePhaseSummary(
+                phase: phase,
+                count: histogram.count,
+                p50: histogram.quantile(0.5),
+                p99: histogram.quantile(0.99),
+                maximum: histogram.maximum
+            )
+        }
+    }
+
+    func reset() {
+        histograms.withLock { histograms in
+            for index in histograms.indices {
+                histograms[index].reset()
+            }
+        }
+    }
+}
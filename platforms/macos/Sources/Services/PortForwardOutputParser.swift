@@ -13,6 +13,12 @@ enum PortForwardOutputParser {
                lowercased.contains("an error occurred")
     }
 
+    /// Checks if kubectl reports the local listener as bound
+    /// (e.g. "Forwarding from 127.0.0.1:7700 -> 80"), so the forward is usable
+    static func isForwardingReady(_ line: String) -> Bool {
+        line.hasPrefix("Forwarding from ")
+    }
+
     /// Detects port conflict from log line and returns the conflicting port if found
     static func detectPortConflict(in line: String) -> Int? {
         let lowercased = line.lowercased()
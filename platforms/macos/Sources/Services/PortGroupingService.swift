@@ -13,6 +13,8 @@ import Foundation
 /// PortGroupingService provides centralized logic for organizing ports
 /// in different ways, such as grouping by process (PID) or by process type.
 /// This eliminates duplicate grouping logic across multiple views.
+/// The grouping functions are pure, so they are `nonisolated` and can run synchronously
+/// inside the derived-view stages on the main actor.
 actor PortGroupingService {
     /// Singleton instance
     static let shared = PortGroupingService()
@@ -32,7 +34,7 @@ actor PortGroupingService {
     /// let groups = await PortGroupingService.shared.groupByProcess(ports)
     /// // groups[0] might contain: ProcessGroup(id: 1234, processName: "node", ports: [3000, 3001])
     /// ```
-    func groupByProcess(_ ports: [PortInfo]) -> [ProcessGroup] {
+    nonisolated func groupByProcess(_ ports: [PortInfo]) -> [ProcessGroup] {
         let grouped = Dictionary(grouping: ports) { $0.processName }
         return grouped.map { name, ports in
             ProcessGroup(
@@ -54,7 +56,7 @@ actor PortGroupingService {
     ///   - favorites: Set of favorited port numbers
     ///   - watched: Set of watched port numbers
     /// - Returns: Array of ProcessGroup instances, sorted by priority then name
-    func groupByProcessWithPriority(_ ports: [PortInfo], favorites: Set<Int>, watched: Set<Int>) -> [ProcessGroup] {
+    nonisolated func groupByProcessWithPriority(_ ports: [PortInfo], favorites: Set<Int>, watched: Set<Int>) -> [ProcessGroup] {
         let grouped = Dictionary(grouping: ports) { $0.processName }
         return grouped.map { name, ports in
             ProcessGroup(
@@ -97,7 +99,7 @@ actor PortGroupingService {
     /// let webServers = grouped[.webServer] // All ports for web servers
     /// let databases = grouped[.database]   // All ports for databases
     /// ```
-    func groupByType(_ ports: [PortInfo]) -> [ProcessType: [PortInfo]] {
+    nonisolated func groupByType(_ ports: [PortInfo]) -> [ProcessType: [PortInfo]] {
         Dictionary(grouping: ports) { $0.processType }
     }
 }
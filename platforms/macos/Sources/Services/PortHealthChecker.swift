@@ -1,28 +1,203 @@
 import Foundation
 import Darwin
 
+/// Result of probing one local TCP port
+struct PortProbeResult: Sendable {
+    let isOpen: Bool
+    /// Time until the first successful connect over IPv4 or IPv6; nil if closed
+    let latency: Duration?
+
+    nonisolated static let closed = PortProbeResult(isOpen: false, latency: nil)
+}
+
 /// Utility for checking TCP port availability
+///
+/// Probes many ports in one pass: a non-blocking connect is started to 127.0.0.1 and ::1
+/// for every port, and all of them are waited on together with a single `poll` loop
+/// bounded by one deadline. A pass over N ports costs at most `timeout`, not N × timeout.
 enum PortHealthChecker {
+
+    /// Connect timeout used when callers don't specify one
+    nonisolated static let defaultTimeout: Duration = .seconds(1)
+
+    /// One in-flight connect attempt
+    private struct Attempt {
+        let port: Int
+        let descriptor: Int32
+    }
+
+    private enum ConnectStart {
+        case connected
+        case pending(Int32)
+        case failed
+    }
+
     /// Check if a port is actually accepting connections (TCP health check)
-    static func isPortOpen(port: Int) -> Bool {
-        let sock = Darwin.socket(AF_INET, SOCK_STREAM, 0)
-        guard sock >= 0 else { return false }
-        defer { Darwin.close(sock) }
-
-        var timeout = timeval(tv_sec: 1, tv_usec: 0)
-        setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &timeout, socklen_t(MemoryLayout<timeval>.size))
-
-        var addr = sockaddr_in()
-        addr.sin_family = sa_family_t(AF_INET)
-        addr.sin_port = in_port_t(port).bigEndian
-        addr.sin_addr.s_addr = inet_addr("127.0.0.1")
-
-        let result = withUnsafePointer(to: &addr) {
-            $0.withMemoryRebound(to: sockaddr.self, capacity: 1) {
-                Darwin.connect(sock, $0, socklen_t(MemoryLayout<sockaddr_in>.size))
+    nonisolated static func isPortOpen(port: Int, timeout: Duration = defaultTimeout) -> Bool {
+        runProbes(ports: [port], timeout: timeout)[port]?.isOpen ?? false
+    }
+
+    /// Probes all `ports` on loopback in a single pass, off the caller's actor.
+    ///
+    /// - Parameters:
+    ///   - ports: Local TCP ports to probe
+    ///   - timeout: Deadline for the whole pass (and therefore for each probe)
+    /// - Returns: A result for every requested port
+    @concurrent
+    nonisolated static func probe(ports: Set<Int>, timeout: Duration = defaultTimeout) async -> [Int: PortProbeResult] {
+        runProbes(ports: ports, timeout: timeout)
+    }
+
+    /// Probes `port` every `pollInterval` until it accepts a connection or `timeout` passes.
+    ///
+    /// Used where a child gives no readiness signal of its own (socat): the port is ready
+    /// the moment its listener is bound, instead of after a fixed sleep.
+    /// - Returns: Whether the port opened in time; false if the task was cancelled
+    @concurrent
+    nonisolated static func waitUntilOpen(
+        port: Int,
+        timeout: Duration,
+        pollInterval: Duration = .milliseconds(50)
+    ) async -> Bool {
+        let clock = ContinuousClock()
+        let deadline = clock.now + timeout
+
+        while !Task.isCancelled {
+            let remaining = clock.now.duration(to: deadline)
+            guard remaining > .zero else { return false }
+            if runProbes(ports: [port], timeout: min(remaining, defaultTimeout))[port]?.isOpen == true {
+                return true
             }
+            try? await Task.sleep(for: min(pollInterval, remaining))
         }
+        return false
+    }
+
+    // MARK: - Private Methods
+
+    nonisolated private static func runProbes(ports: Set<Int>, timeout: Duration) -> [Int: PortProbeResult] {
+        let clock = ContinuousClock()
+        let start = clock.now
+        let deadline = start + timeout
+
+        var results: [Int: PortProbeResult] = [:]
+        results.reserveCapacity(ports.count)
+        var pending: [Attempt] = []
+
+        for port in ports where (1...Int(UInt16.max)).contains(port) {
+            for family in [AF_INET, AF_INET6] where results[port] == nil {
+                switch startConnect(port: port, family: family) {
+                case .connected:
+                    results[port] = PortProbeResult(isOpen: true, latency: clock.now - start)
+                case .pending(let descriptor):
+                    pending.append(Attempt(port: port, descriptor: descriptor))
+                case .failed:
+                    break
+                }
+            }
+        }
+
+        var pollDescriptors: [pollfd] = []
+        while !pending.isEmpty {
+            // Attempts for ports that are already known to be open aren't needed anymore
+            pending.removeAll { attempt in
+                guard results[attempt.port] != nil else { return false }
+                close(attempt.descriptor)
+                return true
+            }
+
+            let remaining = deadline - clock.now
+            guard !pending.isEmpty, remaining > .zero else { break }
+
+            pollDescriptors = pending.map { pollfd(fd: $0.descriptor, events: Int16(POLLOUT), revents: 0) }
+            let ready = poll(&pollDescriptors, nfds_t(pollDescriptors.count), milliseconds(remaining))
+            if ready < 0 && errno == EINTR { continue }
+            guard ready > 0 else { break }
+
+            var stillPending: [Attempt] = []
+            for (attempt, descriptor) in zip(pending, pollDescriptors) {
+                guard descriptor.revents != 0 else {
+                    stillPending.append(attempt)
+                    continue
+                }
+                if results[attempt.port] == nil && socketError(attempt.descriptor) == 0 {
+                    results[attempt.port] = PortProbeResult(isOpen: true, latency: clock.now - start)
+                }
+                close(attempt.descriptor)
+            }
+            pending = stillPending
+        }
+
+        for attempt in pending {
+            close(attempt.descriptor)
+        }
+        for port in ports where results[port] == nil {
+            results[port] = .closed
+        }
+        return results
+    }
+
+    /// Starts a non-blocking connect to loopback (127.0.0.1 or ::1).
+    nonisolated private static func startConnect(port: Int, family: Int32) -> ConnectStart {
+        let descriptor = socket(family, SOCK_STREAM, 0)
+        guard descriptor >= 0 else { return .failed }
+
+        let flags = fcntl(descriptor, F_GETFL, 0)
+        var noSigPipe: Int32 = 1
+        guard fcntl(descriptor, F_SETFL, flags | O_NONBLOCK) == 0 else {
+            close(descriptor)
+            return .failed
+        }
+        setsockopt(descriptor, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, socklen_t(MemoryLayout<Int32>.size))
+
+        let result: Int32
+        if family == AF_INET {
+            var addr = sockaddr_in()
+            addr.sin_len = UInt8(MemoryLayout<sockaddr_in>.size)
+            addr.sin_family = sa_family_t(AF_INET)
+            addr.sin_port = in_port_t(port).bigEndian
+            addr.sin_addr.s_addr = inet_addr("127.0.0.1")
+            result = withUnsafePointer(to: &addr) {
+                $0.withMemoryRebound(to: sockaddr.self, capacity: 1) {
+                    connect(descriptor, $0, socklen_t(MemoryLayout<sockaddr_in>.size))
+                }
+            }
+        } else {
+            var addr = sockaddr_in6()
+            addr.sin6_len = UInt8(MemoryLayout<sockaddr_in6>.size)
+            addr.sin6_family = sa_family_t(AF_INET6)
+            addr.sin6_port = in_port_t(port).bigEndian
+            addr.sin6_addr = in6addr_loopback
+            result = withUnsafePointer(to: &addr) {
+                $0.withMemoryRebound(to: sockaddr.self, capacity: 1) {
+                    connect(descriptor, $0, socklen_t(MemoryLayout<sockaddr_in6>.size))
+                }
+            }
+        }
+
+        if result == 0 {
+            close(descriptor)
+            return .connected
+        }
+        if errno == EINPROGRESS {
+            return .pending(descriptor)
+        }
+        close(descriptor)
+        return .failed
+    }
+
+    /// Reads the outcome of a finished non-blocking connect (0 on success).
+    nonisolated private static func socketError(_ descriptor: Int32) -> Int32 {
+        var error: Int32 = 0
+        var length = socklen_t(MemoryLayout<Int32>.size)
+        guard getsockopt(descriptor, SOL_SOCKET, SO_ERROR, &error, &length) == 0 else { return errno }
+        return error
+    }
 
-        return result == 0
+    /// Converts a remaining duration to a `poll` timeout, rounding up so we never spin.
+    nonisolated private static func milliseconds(_ duration: Duration) -> Int32 {
+        let (seconds, attoseconds) = duration.components
+        let millis = seconds * 1000 + (attoseconds + 999_999_999_999_999) / 1_000_000_000_000_000
+        return Int32(clamping: max(1, millis))
     }
 }
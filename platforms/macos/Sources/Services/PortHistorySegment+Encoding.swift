@@ -0,0 +1,77 @@
+/**
+ * PortHistorySegment+Encoding.swift
+ * PortKiller
+ *
+ * Byte encoding of history segments: headers, sealed files and record checksums.
+ */
+
+import Foundation
+
+extension PortHistorySegment {
+
+    /// Writes `records` as a sealed segment at `url`, replacing any file there, with
+    /// `names` as its name table
+    nonisolated static func writeSealed(_ records: [Record], names: [String], startTime: Int64, to url: URL) throws {
+        var data = header(
+            count: records.count,
+            capacity: records.count,
+            startTime: startTime,
+            endTime: records.last?.time ?? startTime,
+            sealed: true
+        )
+        data.reserveCapacity(recordsOffset + records.count * recordSize)
+        var bitmap = [UInt8](repeating: 0, count: bitmapSize)
+        for record in records {
+            bitmap[Int(record.port) / 8] |= 1 << UInt8(record.port % 8)
+        }
+        data.append(contentsOf: bitmap)
+
+        var encoded = Data(capacity: recordSize)
+        for record in records {
+            encoded.removeAll(keepingCapacity: true)
+            encoded.appendValue(record.time)
+            encoded.appendValue(record.pid)
+            encoded.appendValue(record.nameID)
+            encoded.appendValue(record.port)
+            encoded.appendValue(record.kind.rawValue)
+            encoded.append(0)
+            encoded.appendValue(encoded.withUnsafeBytes { checksum($0) })
+            data.append(encoded)
+        }
+
+        // Names first: they only ever grow, so readers of the old file stay consistent
+        try Data(names.map { $0 + "\n" }.joined().utf8).write(to: namesURL(for: url), options: .atomic)
+        try data.write(to: url, options: .atomic)
+    }
+
+    nonisolated static func header(count: Int, capacity: Int, startTime: Int64, endTime: Int64, sealed: Bool) -> Data {
+        var data = Data(capacity: headerSize)
+        data.appendValue(magic)
+        data.appendValue(formatVersion)
+        data.appendValue(UInt16(sealed ? 1 : 0))
+        data.appendValue(UInt32(count))
+        data.appendValue(UInt32(capacity))
+        data.appendValue(startTime)
+        data.appendValue(endTime)
+        data.append(contentsOf: repeatElement(UInt8(0), count: headerSize - 32))
+        return data
+    }
+
+    /// FNV-1a of a record's first `checksummedSize` bytes. Never 0 for a zero-filled
+    /// slot, so a record whose bytes aren't visible yet doesn't pass.
+    nonisolated static func checksum(_ bytes: UnsafeRawBufferPointer) -> UInt32 {
+        var hash: UInt32 = 0x811C_9DC5
+        for byte in bytes.prefix(checksummedSize) {
+            hash = (hash ^ UInt32(byte)) &* 0x0100_0193
+        }
+        return hash
+    }
+}
+
+// MARK: - Encoding
+
+private extension Data {
+    nonisolated mutating func appendValue<T: FixedWidthInteger>(_ value: T) {
+        Swift.withUnsafeBytes(of: value) { append(contentsOf: $0) }
+    }
+}
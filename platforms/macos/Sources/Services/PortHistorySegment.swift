@@ -0,0 +1,267 @@
+/**
+ * PortHistorySegment.swift
+ * PortKiller
+ *
+ * One file of the persistent port history log, memory-mapped. Records are fixed-size
+ * and time-ordered, so a query binary-searches its start and only touches the pages
+ * it reads.
+ */
+
+import Foundation
+import Darwin
+
+/// A segment of the port history log.
+///
+/// The active segment is created at full capacity and mapped shared and writable;
+/// each record is written before the count that publishes it. Plain stores to a shared
+/// mapping aren't ordered for readers in other processes, though, so one may see the
+/// new count before the record's bytes: every record carries a checksum, and readers
+/// leave out trailing records that don't match it yet. Sealed segments are rewritten at
+/// their used size and renamed into place rather than truncated, since a reader may
+/// still have the old file mapped.
+///
+/// Layout (host byte order):
+/// ```
+/// header    64 bytes     magic, version, flags (sealed), count, capacity,
+///                        start and end time (ms since 1970)
+/// ports   8192 bytes     bitmap of every port with a record, so port queries skip
+///                        segments that never saw the port
+/// records   24 bytes     time (ms), pid, name id, port, kind, checksum at 20
+/// ```
+/// Process names are interned per segment in a `.names` sidecar, one per line
+/// (the name id is the line number), and only read when an event is materialized.
+nonisolated final class PortHistorySegment {
+
+    /// A raw record; `nameID` indexes the segment's names
+    struct Record: Equatable {
+        let time: Int64
+        let pid: Int32
+        let nameID: UInt32
+        let port: UInt16
+        let kind: PortHistoryEvent.Kind
+    }
+
+    static let magic: UInt32 = 0x5348_4B50 // "PKHS"
+    static let formatVersion: UInt16 = 2
+    static let fileExtension = "history"
+    static let headerSize = 64
+    static let bitmapSize = 65_536 / 8
+    static let recordSize = 24
+    static let recordsOffset = headerSize + bitmapSize
+    /// Leading bytes of a record covered by the checksum that follows them
+    static let checksummedSize = 20
+    private static let sealedFlag: UInt16 = 1
+
+    let url: URL
+    let capacity: Int
+    let startTime: Int64
+    let isWritable: Bool
+
+    private let base: UnsafeMutableRawPointer
+    private let length: Int
+    private var names: [String] = []
+    private var nameIDs: [String: UInt32] = [:]
+    private var namesHandle: FileHandle?
+
+    // MARK: - Opening
+
+    /// Creates an empty writable segment with room for `capacity` records
+    static func create(at url: URL, capacity: Int, startTime: Int64) throws -> PortHistorySegment {
+        let descriptor = open(url.path, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0o644)
+        guard descriptor >= 0 else { throw CocoaError(.fileWriteFileExists) }
+        defer { close(descriptor) }
+        guard ftruncate(descriptor, off_t(recordsOffset + capacity * recordSize)) == 0 else {
+            throw CocoaError(.fileWriteOutOfSpace)
+        }
+        let header = Self.header(count: 0, capacity: capacity, startTime: startTime, endTime: startTime, sealed: false)
+        guard header.withUnsafeBytes({ pwrite(descriptor, $0.baseAddress, $0.count, 0) }) == header.count else {
+            throw CocoaError(.fileWriteUnknown)
+        }
+        FileManager.default.createFile(atPath: namesURL(for: url).path, contents: nil)
+
+        guard let segment = PortHistorySegment(contentsOf: url, writable: true) else {
+            throw CocoaError(.fileReadCorruptFile)
+        }
+        return segment
+    }
+
+    /// Maps the segment at `url`; nil if it isn't a history segment of this version
+    init?(contentsOf url: URL, writable: Bool = false) {
+        let descriptor = open(url.path, (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC)
+        guard descriptor >= 0 else { return nil }
+        defer { close(descriptor) }
+
+        var status = stat()
+        guard fstat(descriptor, &status) == 0, status.st_size >= Self.recordsOffset else { return nil }
+        let length = Int(status.st_size)
+        let protection = writable ? PROT_READ | PROT_WRITE : PROT_READ
+        guard let mapping = mmap(nil, length, protection, MAP_SHARED, descriptor, 0),
+              mapping != MAP_FAILED else { return nil }
+
+        let capacity = Int(mapping.loadUnaligned(fromByteOffset: 12, as: UInt32.self))
+        guard mapping.loadUnaligned(as: UInt32.self) == Self.magic,
+              mapping.loadUnaligned(fromByteOffset: 4, as: UInt16.self) == Self.formatVersion,
+              Self.recordsOffset + capacity * Self.recordSize <= length else {
+            munmap(mapping, length)
+            return nil
+        }
+
+        self.url = url
+        self.base = mapping
+        self.length = length
+        self.capacity = capacity
+        self.startTime = mapping.loadUnaligned(fromByteOffset: 16, as: Int64.self)
+        self.isWritable = writable
+        if writable {
+            loadNames()
+            namesHandle = try? FileHandle(forWritingTo: Self.namesURL(for: url))
+            _ = try? namesHandle?.seekToEnd()
+        }
+    }
+
+    deinit {
+        try? namesHandle?.close()
+        munmap(base, length)
+    }
+
+    static func namesURL(for url: URL) -> URL {
+        url.deletingPathExtension().appendingPathExtension("names")
+    }
+
+    // MARK: - Header
+
+    /// Published records; grows while another process writes the segment. Records
+    /// published but not yet fully visible here are left out until they are.
+    var count: Int {
+        var count = min(Int(base.loadUnaligned(fromByteOffset: 8, as: UInt32.self)), capacity)
+        while !isWritable, count > 0, !isComplete(at: count - 1) {
+            count -= 1
+        }
+        return count
+    }
+
+    /// Time of the last record (the start time while empty)
+    var endTime: Int64 { base.loadUnaligned(fromByteOffset: 24, as: Int64.self) }
+
+    var isSealed: Bool { base.loadUnaligned(fromByteOffset: 6, as: UInt16.self) & Self.sealedFlag != 0 }
+
+    var isFull: Bool { count >= capacity }
+
+    // MARK: - Records
+
+    func record(at index: Int) -> Record {
+        let offset = Self.recordsOffset + index * Self.recordSize
+        return Record(
+            time: base.loadUnaligned(fromByteOffset: offset, as: Int64.self),
+            pid: base.loadUnaligned(fromByteOffset: offset + 8, as: Int32.self),
+            nameID: base.loadUnaligned(fromByteOffset: offset + 12, as: UInt32.self),
+            port: base.loadUnaligned(fromByteOffset: offset + 16, as: UInt16.self),
+            kind: PortHistoryEvent.Kind(rawValue: base.load(fromByteOffset: offset + 18, as: UInt8.self)) ?? .closed
+        )
+    }
+
+    /// Whether record `index` matches its checksum
+    private func isComplete(at index: Int) -> Bool {
+        let offset = Self.recordsOffset + index * Self.recordSize
+        let checksum = Self.checksum(UnsafeRawBufferPointer(start: base + offset, count: Self.checksummedSize))
+        return base.loadUnaligned(fromByteOffset: offset + Self.checksummedSize, as: UInt32.self) == checksum
+    }
+
+    /// Every published record, for compaction
+    var records: [Record] { (0..<count).map(record(at:)) }
+
+    /// Whether any record of this segment is for `port`
+    func mayContain(port: Int) -> Bool {
+        guard (0..<65_536).contains(port) else { return false }
+        return base.load(fromByteOffset: Self.headerSize + port / 8, as: UInt8.self) & (1 << UInt8(port % 8)) != 0
+    }
+
+    /// Index of the first record after `time` (`count` if none), by binary search
+    func firstIndex(after time: Int64) -> Int {
+        var low = 0
+        var high = count
+        while low < high {
+            let middle = (low + high) / 2
+            if base.loadUnaligned(fromByteOffset: Self.recordsOffset + middle * Self.recordSize, as: Int64.self) <= time {
+                low = middle + 1
+            } else {
+                high = middle
+            }
+        }
+        return low
+    }
+
+    func event(for record: Record) -> PortHistoryEvent {
+        PortHistoryEvent(
+            timestamp: Date(timeIntervalSince1970: Double(record.time) / 1_000),
+            port: Int(record.port),
+            pid: Int(record.pid),
+            processName: name(record.nameID),
+            kind: record.kind
+        )
+    }
+
+    // MARK: - Names
+
+    func name(_ id: UInt32) -> String {
+        if Int(id) >= names.count, !isWritable {
+            // The writer may have interned more names since we last read them
+            loadNames()
+        }
+        return Int(id) < names.count ? names[Int(id)] : ""
+    }
+
+    private func loadNames() {
+        let data = (try? Data(contentsOf: Self.namesURL(for: url))) ?? Data()
+        names = data.split(separator: UInt8(ascii: "\n"), omittingEmptySubsequences: false).dropLast().map {
+            String(decoding: $0, as: UTF8.self)
+        }
+        nameIDs = Dictionary(names.enumerated().map { ($1, UInt32($0)) }, uniquingKeysWith: { first, _ in first })
+    }
+
+    // MARK: - Writing
+
+    /// Appends a record; the segment must be writable and not full
+    func append(time: Int64, port: Int, pid: Int, processName: String, kind: PortHistoryEvent.Kind) {
+        precondition(isWritable && !isFull, "Appending to a read-only or full history segment")
+        let index = count
+        let offset = Self.recordsOffset + index * Self.recordSize
+        base.storeBytes(of: time, toByteOffset: offset, as: Int64.self)
+        base.storeBytes(of: Int32(truncatingIfNeeded: pid), toByteOffset: offset + 8, as: Int32.self)
+        base.storeBytes(of: intern(processName), toByteOffset: offset + 12, as: UInt32.self)
+        base.storeBytes(of: UInt16(truncatingIfNeeded: port), toByteOffset: offset + 16, as: UInt16.self)
+        base.storeBytes(of: kind.rawValue, toByteOffset: offset + 18, as: UInt8.self)
+        let checksum = Self.checksum(UnsafeRawBufferPointer(start: base + offset, count: Self.checksummedSize))
+        base.storeBytes(of: checksum, toByteOffset: offset + Self.checksummedSize, as: UInt32.self)
+
+        let bitmapOffset = Self.headerSize + Int(UInt16(truncatingIfNeeded: port)) / 8
+        let bits = base.load(fromByteOffset: bitmapOffset, as: UInt8.self)
+        base.storeBytes(of: bits | (1 << UInt8(port % 8)), toByteOffset: bitmapOffset, as: UInt8.self)
+        base.storeBytes(of: max(time, endTime), toByteOffset: 24, as: Int64.self)
+        // Publish last; readers in other processes still check the checksum
+        base.storeBytes(of: UInt32(index + 1), toByteOffset: 8, as: UInt32.self)
+    }
+
+    private func intern(_ name: String) -> UInt32 {
+        if let id = nameIDs[name] { return id }
+        // Names are line-delimited; a newline in a process name would shift every id after it
+        let line = name.replacingOccurrences(of: "\n", with: " ")
+        let id = UInt32(names.count)
+        names.append(line)
+        nameIDs[name] = id
+        try? namesHandle?.write(contentsOf: Data((line + "\n").utf8))
+        return id
+    }
+
+    /// Rewrites this segment at its used size, marked sealed
+    func seal() throws {
+        if !isWritable { loadNames() }
+        try Self.writeSealed(records, names: names, startTime: startTime, to: url)
+    }
+
+    /// Names as stored, for merging segments
+    var nameTable: [String] {
+        if !isWritable { loadNames() }
+        return names
+    }
+}
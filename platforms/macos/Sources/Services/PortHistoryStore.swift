@@ -0,0 +1,317 @@
+/**
+ * PortHistoryStore.swift
+ * PortKiller
+ *
+ * Persistent timeline of listeners opening and closing ports, so "what held 3000 at
+ * 10:14" can be answered after the fact.
+ */
+
+import Foundation
+import Defaults
+import os
+
+/// Append-only port history, fed by scan deltas and split into memory-mapped
+/// `PortHistorySegment` files under `~/Library/Application Support/PortKiller/History`.
+///
+/// Every segment starts with a `.running` record for each listener already open, so
+/// the state at any moment is computed from one segment: queries pick segments by
+/// their time span and port bitmap, binary-search the start, and read only the
+/// records in range. Full segments are sealed at their used size; adjacent small ones
+/// (one per short app session) are merged; the oldest are dropped once the history
+/// exceeds `Defaults[.portHistoryLimitMB]`.
+///
+/// Only one process writes (the background scanner if it runs, else the app), guarded
+/// by an advisory lock; any process can query.
+actor PortHistoryStore {
+    nonisolated private static let logger = Logger(subsystem: "com.portkiller.app", category: "History")
+
+    /// Records per segment, about 1.5 MB while it's active
+    nonisolated static let defaultSegmentCapacity = 65_536
+
+    nonisolated static var defaultDirectory: URL {
+        URL.applicationSupportDirectory
+            .appending(path: "PortKiller", directoryHint: .isDirectory)
+            .appending(path: "History", directoryHint: .isDirectory)
+    }
+
+    private let directory: URL
+    private let segmentCapacity: Int
+    private let retentionBytes: @Sendable () -> Int
+    private var lockDescriptor: Int32 = -1
+    private var active: PortHistorySegment?
+    /// Listeners as last recorded, with their process names
+    private var holding: [PortKey: String] = [:]
+    /// Where the last holders query of each port stopped reading
+    private var holdersCheckpoints: [Int: HoldersCheckpoint] = [:]
+
+    /// The holders of a port after the first `index` records of a segment, so a query
+    /// at the same or a later moment reads only the records after them
+    private struct HoldersCheckpoint {
+        let url: URL
+        let startTime: Int64
+        let index: Int
+        let held: [Int32: PortHistorySegment.Record]
+    }
+
+    init(
+        directory: URL = PortHistoryStore.defaultDirectory,
+        segmentCapacity: Int = PortHistoryStore.defaultSegmentCapacity,
+        retentionBytes: @escaping @Sendable () -> Int = { max(1, Defaults[.portHistoryLimitMB]) * 1024 * 1024 }
+    ) {
+        self.directory = directory
+        self.segmentCapacity = segmentCapacity
+        self.retentionBytes = retentionBytes
+    }
+
+    deinit {
+        if lockDescriptor >= 0 { close(lockDescriptor) }
+    }
+
+    // MARK: - Recording
+
+    /// Records the listeners that appeared or went away since the last call.
+    ///
+    /// Compares `delta.ports` against what was recorded rather than trusting the
+    /// delta's own diff, so it stays correct whichever scanner produced it. A no-op
+    /// while another process holds the history.
+    func record(_ delta: PortScanDelta, at date: Date = Date()) {
+        let time = Self.milliseconds(date)
+        if active == nil {
+            guard becomeWriter(at: time) else { return }
+        } else if delta.isEmpty {
+            return
+        }
+
+        var current: [PortKey: String] = [:]
+        for port in delta.ports where port.isActive {
+            current[port.key] = port.processName
+        }
+        let closed = holding.keys.filter { current[$0] == nil }.sorted(by: Self.order)
+        let opened = current.keys.filter { holding[$0] == nil }.sorted(by: Self.order)
+        defer { holding = current }
+        guard !closed.isEmpty || !opened.isEmpty else { return }
+
+        if let segment = active, segment.count + closed.count + opened.count > segment.capacity {
+            rollover(at: time)
+        }
+        guard let active else { return }
+        for key in closed where !active.isFull {
+            active.append(time: time, port: key.port, pid: key.pid, processName: holding[key] ?? "", kind: .closed)
+        }
+        for key in opened where !active.isFull {
+            active.append(time: time, port: key.port, pid: key.pid, processName: current[key] ?? "", kind: .opened)
+        }
+    }
+
+    /// Takes the writer lock and starts a segment from the previous writer's last state
+    private func becomeWriter(at time: Int64) -> Bool {
+        if lockDescriptor < 0 {
+            try? FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+            lockDescriptor = open(directory.appending(path: ".lock").path, O_RDWR | O_CREAT | O_CLOEXEC, 0o644)
+        }
+        guard lockDescriptor >= 0, flock(lockDescriptor, LOCK_EX | LOCK_NB) == 0 else { return false }
+
+        let segments = openSegments()
+        holding = segments.last.map(Self.state(atEndOf:)) ?? [:]
+        for segment in segments where !segment.isSealed {
+            // Left behind by a writer that didn't shut down cleanly
+            try? segment.seal()
+        }
+        startSegment(at: time)
+        compact()
+        enforceRetention()
+        return active != nil
+    }
+
+    private func startSegment(at time: Int64) {
+        let sequence = segmentURLs().last.flatMap { Int($0.deletingPathExtension().lastPathComponent) } ?? 0
+        let url = directory.appending(path: String(format: "%010d.%@", sequence + 1, PortHistorySegment.fileExtension))
+        do {
+            let segment = try PortHistorySegment.create(at: url, capacity: segmentCapacity, startTime: time)
+            for (key, name) in holding.sorted(by: { Self.order($0.key, $1.key) }) where !segment.isFull {
+                segment.append(time: time, port: key.port, pid: key.pid, processName: name, kind: .running)
+            }
+            active = segment
+        } catch {
+            Self.logger.error("Starting port history segment failed: \(error.localizedDescription)")
+            active = nil
+        }
+    }
+
+    private func rollover(at time: Int64) {
+        do {
+            try active?.seal()
+        } catch {
+            Self.logger.error("Sealing port history segment failed: \(error.localizedDescription)")
+        }
+        active = nil
+        startSegment(at: time)
+        compact()
+        enforceRetention()
+    }
+
+    // MARK: - Queries
+
+    /// Every open and close of `port` within `range`, oldest first. Listeners already
+    /// holding the port when the range starts come first, as `.running` events at its
+    /// lower bound.
+    func events(port: Int, in range: ClosedRange<Date>) -> [PortHistoryEvent] {
+        let lower = Self.milliseconds(range.lowerBound)
+        let upper = Self.milliseconds(range.upperBound)
+        let segments = openSegments()
+
+        var events = holders(of: port, through: lower - 1, in: segments).map {
+            PortHistoryEvent(timestamp: range.lowerBound, port: port, pid: $0.pid, processName: $0.processName, kind: .running)
+        }
+        var held = Set(events.map(\.pid))
+        for segment in segments
+        where segment.startTime <= upper && segment.endTime >= lower && segment.mayContain(port: port) {
+            for index in segment.firstIndex(after: lower - 1)..<segment.firstIndex(after: upper) {
+                let record = segment.record(at: index)
+                guard Int(record.port) == port else { continue }
+                let pid = Int(record.pid)
+                switch record.kind {
+                case .closed:
+                    held.remove(pid)
+                case .opened, .running:
+                    // A segment's `.running` records repeat what's already known
+                    guard held.insert(pid).inserted else { continue }
+                }
+                events.append(segment.event(for: record))
+            }
+        }
+        return events
+    }
+
+    /// Listeners holding `port` at `date`, each as the event that started its hold
+    func holders(of port: Int, at date: Date) -> [PortHistoryEvent] {
+        holders(of: port, through: Self.milliseconds(date), in: openSegments())
+    }
+
+    private func holders(of port: Int, through time: Int64, in segments: [PortHistorySegment]) -> [PortHistoryEvent] {
+        // The segment's `.running` records give the state at its start
+        guard let segment = segments.last(where: { $0.startTime <= time }), segment.mayContain(port: port) else {
+            return []
+        }
+        // Records are only ever appended (sealing and merging keep a segment's
+        // prefix), so a checkpoint at or before `end` stays valid. Without one this
+        // is linear in the records before `time`.
+        let end = segment.firstIndex(after: time)
+        var held: [Int32: PortHistorySegment.Record] = [:]
+        var start = 0
+        if let checkpoint = holdersCheckpoints[port],
+           checkpoint.url == segment.url, checkpoint.startTime == segment.startTime, checkpoint.index <= end {
+            held = checkpoint.held
+            start = checkpoint.index
+        }
+        for index in start..<end {
+            let record = segment.record(at: index)
+            guard Int(record.port) == port else { continue }
+            held[record.pid] = record.kind == .closed ? nil : record
+        }
+        holdersCheckpoints[port] = HoldersCheckpoint(url: segment.url, startTime: segment.startTime, index: end, held: held)
+        return held.values.sorted { ($0.time, $0.pid) < ($1.time, $1.pid) }.map(segment.event(for:))
+    }
+
+    // MARK: - Compaction and Retention
+
+    /// Merges adjacent sealed segments that fit in one; a merged segment drops the
+    /// `.running` records of the later one, which repeat the earlier one's end state.
+    func compact() {
+        var segments = openSegments().filter { $0.isSealed && $0.url != active?.url }
+        var index = 0
+        while index + 1 < segments.count {
+            let first = segments[index]
+            let second = segments[index + 1]
+            guard first.count + second.count <= segmentCapacity,
+                  let merged = merge(first, second) else {
+                index += 1
+                continue
+            }
+            segments[index] = merged
+            segments.remove(at: index + 1)
+        }
+    }
+
+    private func merge(_ first: PortHistorySegment, _ second: PortHistorySegment) -> PortHistorySegment? {
+        var names = first.nameTable
+        var nameIDs = Dictionary(names.enumerated().map { ($1, UInt32($0)) }, uniquingKeysWith: { first, _ in first })
+        var records = first.records
+        var held = Set(Self.state(atEndOf: first).keys)
+
+        for record in second.records {
+            let key = PortKey(port: Int(record.port), pid: Int(record.pid))
+            if record.kind == .running, held.contains(key) { continue }
+            let name = second.name(record.nameID)
+            let nameID = nameIDs[name] ?? {
+                names.append(name)
+                nameIDs[name] = UInt32(names.count - 1)
+                return UInt32(names.count - 1)
+            }()
+            let kind: PortHistoryEvent.Kind = record.kind == .running ? .opened : record.kind
+            if kind == .closed { held.remove(key) } else { held.insert(key) }
+            records.append(.init(time: record.time, pid: record.pid, nameID: nameID, port: record.port, kind: kind))
+        }
+
+        do {
+            try PortHistorySegment.writeSealed(records, names: names, startTime: first.startTime, to: first.url)
+            try Self.remove(second.url)
+        } catch {
+            Self.logger.error("Merging port history segments failed: \(error.localizedDescription)")
+            return nil
+        }
+        return PortHistorySegment(contentsOf: first.url)
+    }
+
+    /// Deletes the oldest segments until the history fits in its size limit
+    func enforceRetention() {
+        let limit = retentionBytes()
+        let sizes = segmentURLs().map { ($0, Self.fileSize($0) + Self.fileSize(PortHistorySegment.namesURL(for: $0))) }
+        var total = sizes.reduce(0) { $0 + $1.1 }
+        for (url, size) in sizes where total > limit && url != active?.url {
+            try? Self.remove(url)
+            total -= size
+        }
+    }
+
+    // MARK: - Helpers
+
+    /// Segment files, oldest first
+    private func segmentURLs() -> [URL] {
+        let contents = (try? FileManager.default.contentsOfDirectory(at: directory, includingPropertiesForKeys: nil)) ?? []
+        return contents
+            .filter { $0.pathExtension == PortHistorySegment.fileExtension }
+            .sorted { $0.lastPathComponent < $1.lastPathComponent }
+    }
+
+    private func openSegments() -> [PortHistorySegment] {
+        segmentURLs().compactMap { PortHistorySegment(contentsOf: $0) }
+    }
+
+    /// Listeners open after the last record of `segment`
+    nonisolated private static func state(atEndOf segment: PortHistorySegment) -> [PortKey: String] {
+        var state: [PortKey: String] = [:]
+        for record in segment.records {
+            let key = PortKey(port: Int(record.port), pid: Int(record.pid))
+            state[key] = record.kind == .closed ? nil : segment.name(record.nameID)
+        }
+        return state
+    }
+
+    nonisolated private static func remove(_ url: URL) throws {
+        try FileManager.default.removeItem(at: url)
+        try? FileManager.default.removeItem(at: PortHistorySegment.namesURL(for: url))
+    }
+
+    nonisolated private static func fileSize(_ url: URL) -> Int {
+        (try? url.resourceValues(forKeys: [.fileSizeKey]).fileSize) ?? 0
+    }
+
+    nonisolated private static func order(_ lhs: PortKey, _ rhs: PortKey) -> Bool {
+        (lhs.port, lhs.pid) < (rhs.port, rhs.pid)
+    }
+
+    nonisolated static func milliseconds(_ date: Date) -> Int64 {
+        Int64((date.timeIntervalSince1970 * 1_000).rounded(.down))
+    }
+}
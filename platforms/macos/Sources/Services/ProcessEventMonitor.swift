@@ -0,0 +1,130 @@
+import Foundation
+import Darwin
+
+/// Lifecycle event reported by `ProcessEventMonitor`
+enum ProcessLifecycleEvent: Sendable {
+    /// A watched process exited, so its listening sockets are gone
+    case exited
+    /// A watched process exec'd; a new listener may appear shortly
+    case spawned
+}
+
+/// Watches listener PIDs for exit/exec through a single kqueue (`EVFILT_PROC`).
+///
+/// Lets auto-refresh react to a listener going away within milliseconds instead of
+/// waiting for the next poll. One kqueue and one dispatch read source serve every PID,
+/// so an idle system costs no wakeups at all.
+///
+/// The kernel has no event for "some process started listening", so brand-new
+/// listeners from unrelated processes are still picked up by the safety-net poll.
+/// Forks aren't watched: a forked child only shares its parent's sockets, and busy
+/// preforking servers (postgres, gunicorn) would otherwise wake us constantly.
+nonisolated final class ProcessEventMonitor: @unchecked Sendable {
+
+    /// Upper bound of kevents drained per wakeup
+    private static let eventBatchSize = 32
+
+    /// Process events, coalesced while the consumer is busy
+    let events: AsyncStream<ProcessLifecycleEvent>
+
+    private let continuation: AsyncStream<ProcessLifecycleEvent>.Continuation
+    private let queue = DispatchQueue(label: "com.portkiller.process-events", qos: .utility)
+    private let kqueueDescriptor: Int32
+    private let readSource: DispatchSourceRead
+
+    /// PIDs currently registered with the kqueue. Only touched on `queue`.
+    private var watched: Set<pid_t> = []
+
+    /// Returns nil if a kqueue cannot be created.
+    init?() {
+        let descriptor = kqueue()
+        guard descriptor >= 0 else { return nil }
+        kqueueDescriptor = descriptor
+
+        (events, continuation) = AsyncStream.makeStream(
+            of: ProcessLifecycleEvent.self,
+            bufferingPolicy: .bufferingNewest(Self.eventBatchSize)
+        )
+
+        readSource = DispatchSource.makeReadSource(fileDescriptor: descriptor, queue: queue)
+        readSource.setEventHandler { [weak self] in
+            self?.drainEvents()
+        }
+        readSource.setCancelHandler {
+            close(descriptor)
+        }
+        readSource.resume()
+    }
+
+    deinit {
+        invalidate()
+    }
+
+    /// Replaces the watched PID set, registering new PIDs and dropping stale ones.
+    func watch(pids: Set<Int>) {
+        queue.async { [weak self] in
+            self?.updateRegistrations(Set(pids.map { pid_t($0) }))
+        }
+    }
+
+    /// Stops monitoring and finishes `events`.
+    func invalidate() {
+        readSource.cancel()
+        continuation.finish()
+    }
+
+    // MARK: - Private Methods
+
+    private func updateRegistrations(_ pids: Set<pid_t>) {
+        for pid in watched.subtracting(pids) {
+            register(pid, flags: EV_DELETE)
+        }
+
+        var exitedSinceScan = false
+        for pid in pids.subtracting(watched) {
+            // ESRCH: it exited between the scan and now. Other failures (e.g. EPERM for
+            // another user's process) are left to the safety-net poll.
+            if !register(pid, flags: EV_ADD | EV_ENABLE) && errno == ESRCH {
+                exitedSinceScan = true
+            }
+        }
+
+        watched = pids
+        if exitedSinceScan { continuation.yield(.exited) }
+    }
+
+    @discardableResult
+    private func register(_ pid: pid_t, flags: Int32) -> Bool {
+        var change = kevent(
+            ident: UInt(pid),
+            filter: Int16(EVFILT_PROC),
+            flags: UInt16(flags),
+            fflags: UInt32(NOTE_EXIT) | UInt32(NOTE_EXEC),
+            data: 0,
+            udata: nil
+        )
+        return kevent(kqueueDescriptor, &change, 1, nil, 0, nil) == 0
+    }
+
+    private func drainEvents() {
+        var received = [kevent](repeating: kevent(), count: Self.eventBatchSize)
+        var timeout = timespec(tv_sec: 0, tv_nsec: 0)
+        let count = kevent(kqueueDescriptor, nil, 0, &received, Int32(received.count), &timeout)
+        guard count > 0 else { return }
+
+        var sawExit = false
+        var sawSpawn = false
+        for event in received.prefix(Int(count)) {
+            if event.fflags & UInt32(NOTE_EXIT) != 0 {
+                // The kernel drops EVFILT_PROC registrations on exit.
+                watched.remove(pid_t(event.ident))
+                sawExit = true
+            } else {
+                sawSpawn = true
+            }
+        }
+
+        if sawExit { continuation.yield(.exited) }
+        if sawSpawn { continuation.yield(.spawned) }
+    }
+}
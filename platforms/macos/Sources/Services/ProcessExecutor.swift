@@ -1,12 +1,17 @@
 import Foundation
+import Darwin
+import Synchronization
 
 /// Result of running an external process.
-struct ProcessResult: Sendable {
+nonisolated struct ProcessResult: Sendable {
     let standardOutput: String
     let standardError: String
+    /// Exit code, or the signal number if the child was killed (like `Process.terminationStatus`)
     let exitCode: Int32
+    /// Killed by `ProcessExecutor` after running past its timeout
+    var timedOut = false
 
-    var succeeded: Bool { exitCode == 0 }
+    var succeeded: Bool { exitCode == 0 && !timedOut }
 
     /// Standard output trimmed of surrounding whitespace and newlines.
     var trimmedOutput: String {
@@ -14,84 +19,600 @@ struct ProcessResult: Sendable {
     }
 }
 
-/// Centralized launcher for external processes (`lsof`, `cloudflared`, `pkill`, `brew`, ...).
+/// Why a streamed run (`ProcessExecutor.chunks`) ended with an error
+nonisolated enum ProcessExecutorError: Error, Sendable, Equatable {
+    /// `posix_spawn` failed (binary missing, not executable, ...)
+    case launchFailed(errno: Int32)
+    /// The child ran past its timeout and was killed
+    case timedOut
+    /// The child exited unsuccessfully; its stderr is kept for error messages
+    case failed(exitCode: Int32, standardError: Data)
+}
+
+/// Running totals across every child `ProcessExecutor` has launched.
+nonisolated struct ProcessExecutorStatistics: Sendable, Equatable {
+    var spawns = 0
+    var launchFailures = 0
+    var timeouts = 0
+    /// Time spent inside `posix_spawn` itself
+    var totalSpawnTime: Duration = .zero
+    var maxSpawnTime: Duration = .zero
+    /// stdout and stderr bytes read from children
+    var bytesRead = 0
+
+    var averageSpawnTime: Duration {
+        spawns > 0 ? totalSpawnTime / spawns : .zero
+    }
+}
+
+/// Centralized launcher for external processes (`lsof`, `cloudflared`, `kubectl`, `pkill`, `brew`, ...).
 ///
-/// Every spawn in the app used to inline its own `Process`/`Pipe` boilerplate, each
-/// re-deriving the same subtle invariants: wrap the lifecycle in `autoreleasepool` so the
-/// Obj-C bridged objects don't accumulate across long-lived scanning tasks, and read the
-/// pipe *before* `waitUntilExit()` to avoid deadlocking when output exceeds the pipe buffer.
-/// `ProcessExecutor` is the single place that gets those right.
+/// Children are started with `posix_spawn` and `POSIX_SPAWN_CLOEXEC_DEFAULT`, so only
+/// stdin (`/dev/null`) and the stdout/stderr pipes reach them; nothing this app has open
+/// leaks into an lsof or kubectl run. No `Process`/`Pipe`/`FileHandle` objects are
+/// involved, so there is nothing for an autorelease pool to collect across long-lived
+/// scanning tasks.
 ///
-/// All work runs on a detached background task, so callers (including actors) never block
-/// their executor on the synchronous `Process` API.
-enum ProcessExecutor {
+/// Each run is driven by one kqueue on a background queue: pipe reads, the child's exit,
+/// the hard timeout and cancellation all arrive as kevents. Both pipes are drained
+/// together, so neither can fill up and stall the child, and output is read into
+/// buffers borrowed from a small pool instead of fresh allocations. A child that outlives
+/// its timeout is killed with its whole process group, so a hung `lsof` can't hold a
+/// scan forever.
+nonisolated enum ProcessExecutor {
+
+    /// Running totals, for diagnostics
+    static var statistics: ProcessExecutorStatistics {
+        counters.withLock { $0 }
+    }
+
+    // MARK: - Running
 
     /// Runs `executable` with `arguments`, capturing stdout and stderr.
     ///
     /// Returns `nil` only if the process could not be launched at all (e.g. the binary is
-    /// missing). A non-zero exit code still yields a `ProcessResult` so callers can inspect
-    /// `exitCode`/`standardError`.
+    /// missing). A non-zero exit code or a timeout still yields a `ProcessResult` so
+    /// callers can inspect `exitCode`/`standardError`.
     static func run(
         _ executable: String,
         arguments: [String],
-        captureStandardError: Bool = true
+        captureStandardError: Bool = true,
+        timeout: Duration = AppConstants.processTimeout
     ) async -> ProcessResult? {
-        await Task.detached(priority: .utility) {
-            autoreleasepool {
-                let process = Process()
-                process.executableURL = URL(fileURLWithPath: executable)
-                process.arguments = arguments
-
-                let stdoutPipe = Pipe()
-                process.standardOutput = stdoutPipe
-
-                let stderrPipe: Pipe?
-                if captureStandardError {
-                    let pipe = Pipe()
-                    process.standardError = pipe
-                    stderrPipe = pipe
-                } else {
-                    process.standardError = FileHandle.nullDevice
-                    stderrPipe = nil
+        let streams: Streams = captureStandardError ? [.output, .error] : [.output]
+        guard let collected = await collect(executable, arguments: arguments, streams: streams, timeout: timeout) else {
+            return nil
+        }
+        return ProcessResult(
+            standardOutput: String(decoding: collected.output, as: UTF8.self),
+            standardError: String(decoding: collected.error, as: UTF8.self),
+            exitCode: collected.outcome.exitCode,
+            timedOut: collected.outcome.timedOut
+        )
+    }
+
+    /// Runs a process and returns its raw, untrimmed stdout bytes, or `nil` on launch
+    /// failure or timeout. stderr is discarded.
+    ///
+    /// For byte-level parsers (e.g. lsof output) that never need a `String` of the whole
+    /// output.
+    static func outputData(
+        _ executable: String,
+        arguments: [String],
+        timeout: Duration = AppConstants.processTimeout
+    ) async -> Data? {
+        guard let collected = await collect(executable, arguments: arguments, streams: [.output], timeout: timeout),
+              !collected.outcome.timedOut else { return nil }
+        return collected.output
+    }
+
+    /// Convenience: run a process and return its trimmed stdout, or `nil` on launch failure.
+    /// stderr is discarded.
+    static func output(
+        _ executable: String,
+        arguments: [String],
+        timeout: Duration = AppConstants.processTimeout
+    ) async -> String? {
+        await run(executable, arguments: arguments, captureStandardError: false, timeout: timeout)?.trimmedOutput
+    }
+
+    /// Fire-and-forget launch (e.g. `pkill`). Discards all output and ignores failures.
+    static func runDiscardingOutput(
+        _ executable: String,
+        arguments: [String],
+        timeout: Duration = AppConstants.processTimeout
+    ) async {
+        _ = await collect(executable, arguments: arguments, streams: [], timeout: timeout)
+    }
+
+    /// Runs a process and yields its stdout chunk by chunk as it arrives, so large
+    /// outputs can be parsed without ever being held in full.
+    ///
+    /// At most `maxBufferedChunks` chunks wait for the consumer; past that, stdout isn't
+    /// read until it catches up, so a slow consumer holds the child back instead of
+    /// buffering its whole output. The timeout still counts meanwhile.
+    ///
+    /// The sequence finishes when the child exits with status 0, and throws
+    /// `ProcessExecutorError` if it couldn't be launched, timed out or failed. Ending the
+    /// iteration early (or cancelling the consuming task) kills the child.
+    static func chunks(
+        _ executable: String,
+        arguments: [String],
+        timeout: Duration = AppConstants.processTimeout
+    ) -> Chunks {
+        let (stream, continuation) = AsyncThrowingStream.makeStream(of: Data.self)
+        let run = Run()
+        continuation.onTermination = { termination in
+            if case .cancelled = termination {
+                run.cancel()
+            }
+        }
+
+        queue.async {
+            var error = Data()
+            let outcome = execute(executable, arguments: arguments, streams: [.output, .error], timeout: timeout, run: run) { stream, bytes in
+                switch stream {
+                case .output:
+                    run.bufferChunk(limit: maxBufferedChunks)
+                    continuation.yield(Data(bytes))
+                default:
+                    error.append(contentsOf: bytes)
+                }
+            }
+
+            switch outcome {
+            case .none:
+                continuation.finish(throwing: ProcessExecutorError.launchFailed(errno: run.launchError))
+            case .some(let outcome) where outcome.timedOut:
+                continuation.finish(throwing: ProcessExecutorError.timedOut)
+            case .some(let outcome) where outcome.exitCode != 0:
+                continuation.finish(throwing: ProcessExecutorError.failed(exitCode: outcome.exitCode, standardError: error))
+            default:
+                continuation.finish()
+            }
+        }
+        return Chunks(stream: stream, run: run)
+    }
+
+    /// stdout of a `chunks` run; each chunk taken lets the run read further
+    struct Chunks: AsyncSequence, Sendable {
+        typealias Element = Data
+
+        private let stream: AsyncThrowingStream<Data, any Error>
+        private let run: Run
+
+        fileprivate init(stream: AsyncThrowingStream<Data, any Error>, run: Run) {
+            self.stream = stream
+            self.run = run
+        }
+
+        func makeAsyncIterator() -> Iterator {
+            Iterator(base: stream.makeAsyncIterator(), run: run)
+        }
+
+        struct Iterator: AsyncIteratorProtocol {
+            private var base: AsyncThrowingStream<Data, any Error>.Iterator
+            private let run: Run
+
+            fileprivate init(base: AsyncThrowingStream<Data, any Error>.Iterator, run: Run) {
+                self.base = base
+                self.run = run
+            }
+
+            mutating func next() async throws -> Data? {
+                let chunk = try await base.next()
+                if chunk != nil {
+                    run.takeChunk(resumingBelow: maxBufferedChunks / 2)
                 }
+                return chunk
+            }
+        }
+    }
 
-                do {
-                    try process.run()
-                } catch {
-                    return nil
+    // MARK: - Private Types
+
+    /// Which of the child's output streams are read; the others go to /dev/null
+    nonisolated private struct Streams: OptionSet {
+        let rawValue: Int
+        static let output = Streams(rawValue: 1 << 0)
+        static let error = Streams(rawValue: 1 << 1)
+    }
+
+    /// How a run ended
+    nonisolated private struct Outcome {
+        let exitCode: Int32
+        let timedOut: Bool
+    }
+
+    /// Cancellation handle of one run, shared with the consumer of its output.
+    ///
+    /// Cancelling triggers a user kevent on the run's kqueue, so the kill happens on the
+    /// run's own thread, while the child is known not to be reaped yet.
+    nonisolated fileprivate final class Run: Sendable {
+        private struct State {
+            var kqueueDescriptor: Int32 = -1
+            var isCancelled = false
+            var launchError: Int32 = 0
+            /// Chunks yielded by `chunks` and not yet taken by its consumer
+            var bufferedChunks = 0
+            var isOutputPaused = false
+        }
+
+        private let state = Mutex(State())
+
+        var launchError: Int32 {
+            state.withLock { $0.launchError }
+        }
+
+        var isCancelled: Bool {
+            state.withLock { $0.isCancelled }
+        }
+
+        /// Whether stdout should not be read until the consumer takes more chunks
+        var isOutputPaused: Bool {
+            state.withLock { $0.isOutputPaused }
+        }
+
+        func cancel() {
+            state.withLock { state in
+                state.isCancelled = true
+                Self.trigger(ProcessExecutor.cancelEvent, on: state.kqueueDescriptor)
+            }
+        }
+
+        /// Counts a chunk handed to the consumer, pausing stdout once `limit` are waiting
+        func bufferChunk(limit: Int) {
+            state.withLock { state in
+                state.bufferedChunks += 1
+                if state.bufferedChunks >= limit {
+                    state.isOutputPaused = true
                 }
+            }
+        }
+
+        /// Counts a chunk taken by the consumer, resuming stdout once fewer than
+        /// `threshold` are waiting
+        func takeChunk(resumingBelow threshold: Int) {
+            state.withLock { state in
+                state.bufferedChunks -= 1
+                guard state.isOutputPaused, state.bufferedChunks < threshold else { return }
+                state.isOutputPaused = false
+                Self.trigger(ProcessExecutor.resumeEvent, on: state.kqueueDescriptor)
+            }
+        }
 
-                // Read BEFORE waitUntilExit to avoid a deadlock when output exceeds the
-                // pipe buffer (~64KB): the child blocks writing, we block waiting.
-                let outData = stdoutPipe.fileHandleForReading.readDataToEndOfFile()
-                let errData = stderrPipe?.fileHandleForReading.readDataToEndOfFile() ?? Data()
-                process.waitUntilExit()
+        private static func trigger(_ ident: UInt, on kqueueDescriptor: Int32) {
+            guard kqueueDescriptor >= 0 else { return }
+            var trigger = ProcessExecutor.event(ident: ident, filter: EVFILT_USER, fflags: UInt32(NOTE_TRIGGER))
+            _ = kevent(kqueueDescriptor, &trigger, 1, nil, 0, nil)
+        }
 
-                return ProcessResult(
-                    standardOutput: String(data: outData, encoding: .utf8) ?? "",
-                    standardError: String(data: errData, encoding: .utf8) ?? "",
-                    exitCode: process.terminationStatus
-                )
+        /// Publishes the run's kqueue; false if the run was cancelled before it started.
+        func attach(_ descriptor: Int32) -> Bool {
+            state.withLock { state in
+                state.kqueueDescriptor = descriptor
+                return !state.isCancelled
             }
-        }.value
+        }
+
+        func detach() {
+            state.withLock { $0.kqueueDescriptor = -1 }
+        }
+
+        func recordLaunchError(_ error: Int32) {
+            state.withLock { $0.launchError = error }
+        }
     }
 
-    /// Convenience: run a process and return its trimmed stdout, or `nil` on launch failure.
-    /// stderr is discarded.
-    static func output(_ executable: String, arguments: [String]) async -> String? {
-        await run(executable, arguments: arguments, captureStandardError: false)?.trimmedOutput
+    /// A fixed read buffer, only ever used by one run at a time
+    nonisolated private final class ReadBuffer: @unchecked Sendable {
+        static let size = 64 * 1024
+
+        let bytes = UnsafeMutableRawBufferPointer.allocate(byteCount: size, alignment: MemoryLayout<UInt64>.alignment)
+
+        deinit {
+            bytes.deallocate()
+        }
     }
 
-    /// Fire-and-forget launch (e.g. `pkill`). Discards all output and ignores failures.
-    static func runDiscardingOutput(_ executable: String, arguments: [String]) async {
-        await Task.detached(priority: .utility) {
-            let process = Process()
-            process.executableURL = URL(fileURLWithPath: executable)
-            process.arguments = arguments
-            process.standardOutput = FileHandle.nullDevice
-            process.standardError = FileHandle.nullDevice
-            try? process.run()
-            process.waitUntilExit()
-        }.value
+    // MARK: - Private Properties
+
+    /// Runs block on kevent, so they get their own threads rather than the cooperative pool
+    private static let queue = DispatchQueue(label: "com.portkiller.process-executor", qos: .utility, attributes: .concurrent)
+
+    private static let counters = Mutex(ProcessExecutorStatistics())
+
+    /// Idle read buffers; a run borrows one and returns it when done
+    private static let bufferPool = Mutex<[ReadBuffer]>([])
+    /// More concurrent runs than this allocate a buffer that is freed afterwards
+    private static let pooledBufferLimit = 4
+
+    private static let timeoutEvent: UInt = 1
+    private static let cancelEvent: UInt = 2
+    /// Triggered when a paused stdout may be read again
+    private static let resumeEvent: UInt = 3
+
+    /// Chunks of `chunks` output waiting for the consumer before stdout is paused, 1 MB
+    private static let maxBufferedChunks = 16
+
+    // MARK: - Private Methods
+
+    /// Runs a process to completion on `queue`, collecting the requested streams.
+    private static func collect(
+        _ executable: String,
+        arguments: [String],
+        streams: Streams,
+        timeout: Duration
+    ) async -> (output: Data, error: Data, outcome: Outcome)? {
+        let run = Run()
+        return await withTaskCancellationHandler {
+            await withCheckedContinuation { continuation in
+                queue.async {
+                    var output = Data()
+                    var error = Data()
+                    let outcome = execute(executable, arguments: arguments, streams: streams, timeout: timeout, run: run) { stream, bytes in
+                        if stream == .output {
+                            output.append(contentsOf: bytes)
+                        } else {
+                            error.append(contentsOf: bytes)
+                        }
+                    }
+                    continuation.resume(returning: outcome.map { (output, error, $0) })
+                }
+            }
+        } onCancel: {
+            run.cancel()
+        }
+    }
+
+    /// Spawns the child and services it until it has exited and its pipes are drained
+    /// (or it was killed). Blocks the calling thread. Returns nil on launch failure.
+    private static func execute(
+        _ executable: String,
+        arguments: [String],
+        streams: Streams,
+        timeout: Duration,
+        run: Run,
+        onBytes: (Streams, UnsafeRawBufferPointer) -> Void
+    ) -> Outcome? {
+        let kqueueDescriptor = kqueue()
+        guard kqueueDescriptor >= 0 else {
+            run.recordLaunchError(errno)
+            return nil
+        }
+        defer {
+            run.detach()
+            close(kqueueDescriptor)
+        }
+        guard run.attach(kqueueDescriptor) else {
+            run.recordLaunchError(ECANCELED)
+            return nil
+        }
+
+        guard let child = spawn(executable, arguments: arguments, streams: streams, run: run) else {
+            return nil
+        }
+
+        var pipes: [Int32: Streams] = [:]
+        for (descriptor, stream) in [(child.output, Streams.output), (child.error, Streams.error)] where descriptor >= 0 {
+            pipes[descriptor] = stream
+        }
+        var changes = [
+            event(ident: cancelEvent, filter: EVFILT_USER, flags: EV_ADD | EV_CLEAR),
+            event(ident: resumeEvent, filter: EVFILT_USER, flags: EV_ADD | EV_CLEAR),
+            event(ident: timeoutEvent, filter: EVFILT_TIMER, flags: EV_ADD | EV_ONESHOT,
+                  fflags: UInt32(NOTE_NSECONDS), data: Int(nanoseconds(of: timeout)))
+        ]
+        changes += pipes.keys.map { event(ident: UInt($0), filter: EVFILT_READ, flags: EV_ADD) }
+        _ = kevent(kqueueDescriptor, changes, Int32(changes.count), nil, 0, nil)
+
+        // A child that already exited can't be watched (ESRCH), but it is ours and unreaped.
+        var exitChange = event(ident: UInt(child.pid), filter: EVFILT_PROC, flags: EV_ADD | EV_ONESHOT, fflags: UInt32(NOTE_EXIT))
+        var hasExited = kevent(kqueueDescriptor, &exitChange, 1, nil, 0, nil) != 0
+
+        var timedOut = false
+        var bytesRead = 0
+        let readBuffer = borrowBuffer()
+        defer { returnBuffer(readBuffer) }
+        let buffer = readBuffer.bytes
+
+        func closePipes() {
+            for descriptor in pipes.keys {
+                close(descriptor)
+            }
+            pipes.removeAll()
+        }
+
+        func killChild() {
+            // The child leads its own process group; take its descendants with it.
+            _ = Darwin.kill(-child.pid, SIGKILL)
+            _ = Darwin.kill(child.pid, SIGKILL)
+            // Descendants that escaped the group could hold the pipes open forever.
+            closePipes()
+        }
+
+        func setReading(_ descriptor: Int32, enabled: Bool) {
+            var change = event(ident: UInt(descriptor), filter: EVFILT_READ, flags: enabled ? EV_ENABLE : EV_DISABLE)
+            _ = kevent(kqueueDescriptor, &change, 1, nil, 0, nil)
+        }
+
+        if run.isCancelled {
+            killChild()
+        }
+
+        var received = [kevent](repeating: kevent(), count: 4)
+        while !pipes.isEmpty || !hasExited {
+            let count = kevent(kqueueDescriptor, nil, 0, &received, Int32(received.count), nil)
+            guard count >= 0 else {
+                if errno == EINTR { continue }
+                killChild()
+                break
+            }
+
+            for event in received.prefix(Int(count)) {
+                switch Int32(event.filter) {
+                case EVFILT_READ:
+                    let descriptor = Int32(event.ident)
+                    guard let stream = pipes[descriptor] else { continue }
+                    let length = event.data > 0 ? read(descriptor, buffer.baseAddress, min(event.data, buffer.count)) : 0
+                    if length > 0 {
+                        bytesRead += length
+                        onBytes(stream, UnsafeRawBufferPointer(rebasing: buffer[..<length]))
+                        if stream == .output, run.isOutputPaused {
+                            setReading(descriptor, enabled: false)
+                        }
+                    } else if length == 0 || errno != EINTR && errno != EAGAIN {
+                        // EOF; closing the descriptor also removes its kevent
+                        close(descriptor)
+                        pipes[descriptor] = nil
+                    }
+                case EVFILT_PROC:
+                    hasExited = true
+                case EVFILT_TIMER:
+                    timedOut = true
+                    killChild()
+                case EVFILT_USER where event.ident == resumeEvent:
+                    for (descriptor, stream) in pipes where stream == .output {
+                        setReading(descriptor, enabled: true)
+                    }
+                case EVFILT_USER:
+                    killChild()
+                default:
+                    break
+                }
+            }
+        }
+        closePipes()
+
+        var status: Int32 = 0
+        while waitpid(child.pid, &status, 0) < 0 && errno == EINTR {}
+        let exit = ChildExit(pid: child.pid, waitStatus: status)
+
+        counters.withLock { counters in
+            counters.bytesRead += bytesRead
+            if timedOut { counters.timeouts += 1 }
+        }
+        return Outcome(exitCode: exit.status ?? -1, timedOut: timedOut)
+    }
+
+    /// Starts the child with its stdout/stderr on fresh pipes (or /dev/null) and nothing
+    /// else inherited. Returns the read ends of the pipes, -1 for streams not captured.
+    private static func spawn(
+        _ executable: String,
+        arguments: [String],
+        streams: Streams,
+        run: Run
+    ) -> (pid: pid_t, output: Int32, error: Int32)? {
+        var outputPipe: [Int32] = [-1, -1]
+        var errorPipe: [Int32] = [-1, -1]
+        func closeAll() {
+            for descriptor in outputPipe + errorPipe where descriptor >= 0 {
+                close(descriptor)
+            }
+        }
+        guard !streams.contains(.output) || makePipe(&outputPipe),
+              !streams.contains(.error) || makePipe(&errorPipe) else {
+            run.recordLaunchError(errno)
+            closeAll()
+            return nil
+        }
+
+        var fileActions: posix_spawn_file_actions_t?
+        posix_spawn_file_actions_init(&fileActions)
+        defer { posix_spawn_file_actions_destroy(&fileActions) }
+        posix_spawn_file_actions_addopen(&fileActions, STDIN_FILENO, "/dev/null", O_RDONLY, 0)
+        for (pipe, target) in [(outputPipe, STDOUT_FILENO), (errorPipe, STDERR_FILENO)] {
+            if pipe[1] >= 0 {
+                posix_spawn_file_actions_adddup2(&fileActions, pipe[1], target)
+            } else {
+                posix_spawn_file_actions_addopen(&fileActions, target, "/dev/null", O_WRONLY, 0)
+            }
+        }
+
+        var attributes: posix_spawnattr_t?
+        posix_spawnattr_init(&attributes)
+        defer { posix_spawnattr_destroy(&attributes) }
+        // Own process group, so a timeout can kill the child's descendants too; default
+        // signal dispositions and an empty mask, whatever this process has set up.
+        var allSignals = sigset_t()
+        var noSignals = sigset_t()
+        sigfillset(&allSignals)
+        sigemptyset(&noSignals)
+        posix_spawnattr_setsigdefault(&attributes, &allSignals)
+        posix_spawnattr_setsigmask(&attributes, &noSignals)
+        posix_spawnattr_setpgroup(&attributes, 0)
+        posix_spawnattr_setflags(
+            &attributes,
+            Int16(POSIX_SPAWN_CLOEXEC_DEFAULT | POSIX_SPAWN_SETPGROUP | POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETSIGMASK)
+        )
+
+        let argv = ([executable] + arguments).map { strdup($0) }
+        defer { argv.forEach { free($0) } }
+
+        var pid: pid_t = 0
+        let start = ContinuousClock.now
+        let result = (argv + [nil]).withUnsafeBufferPointer { argv in
+            posix_spawn(&pid, executable, &fileActions, &attributes, argv.baseAddress, _NSGetEnviron().pointee)
+        }
+        let elapsed = ContinuousClock.now - start
+
+        // The write ends now belong to the child; EOF arrives once it (and any
+        // descendant) closes them.
+        for descriptor in [outputPipe[1], errorPipe[1]] where descriptor >= 0 {
+            close(descriptor)
+        }
+
+        guard result == 0 else {
+            run.recordLaunchError(result)
+            counters.withLock { $0.launchFailures += 1 }
+            for descriptor in [outputPipe[0], errorPipe[0]] where descriptor >= 0 {
+                close(descriptor)
+            }
+            return nil
+        }
+
+        counters.withLock { counters in
+            counters.spawns += 1
+            counters.totalSpawnTime += elapsed
+            counters.maxSpawnTime = max(counters.maxSpawnTime, elapsed)
+        }
+        return (pid, outputPipe[0], errorPipe[0])
+    }
+
+    /// A pipe with close-on-exec on both ends, so a `Foundation.Process` launched by
+    /// another thread at the same moment can't inherit it and hold it open.
+    private static func makePipe(_ descriptors: inout [Int32]) -> Bool {
+        guard pipe(&descriptors) == 0 else { return false }
+        for descriptor in descriptors {
+            _ = fcntl(descriptor, F_SETFD, FD_CLOEXEC)
+        }
+        return true
+    }
+
+    private static func borrowBuffer() -> ReadBuffer {
+        bufferPool.withLock { $0.popLast() } ?? ReadBuffer()
+    }
+
+    private static func returnBuffer(_ buffer: ReadBuffer) {
+        bufferPool.withLock { pool in
+            if pool.count < pooledBufferLimit {
+                pool.append(buffer)
+            }
+        }
+    }
+
+    private static func nanoseconds(of duration: Duration) -> Int64 {
+        let (seconds, attoseconds) = duration.components
+        return max(1, seconds * 1_000_000_000 + attoseconds / 1_000_000_000)
+    }
+
+    private static func event(
+        ident: UInt,
+        filter: Int32,
+        flags: Int32 = 0,
+        fflags: UInt32 = 0,
+        data: Int = 0
+    ) -> kevent {
+        kevent(ident: ident, filter: Int16(filter), flags: UInt16(flags), fflags: fflags, data: data, udata: nil)
     }
 }
@@ -0,0 +1,93 @@
+import Foundation
+import Darwin
+
+/// Reads per-process metadata straight from the kernel (sysctl / libproc).
+///
+/// Shared by every `PortScannerProtocol` backend so they all resolve command lines the
+/// same way. Pure C syscalls: no fork/exec, no Pipe, no FileHandle, no Obj-C bridged objects.
+enum ProcessInspector {
+
+    /// Maximum number of argv entries joined into a command line.
+    nonisolated private static let maxArguments: Int32 = 64
+
+    /**
+     * Retrieves full command lines for specific processes via sysctl.
+     *
+     * Cost comparison per scan (typical system, ~30 listening ports):
+     *   ps approach:  fork+exec + pipe I/O + ~500KB string + parse = ~5ms, ~500KB peak RAM
+     *   sysctl:       ~30 syscalls × ~2KB each = ~0.3ms, ~4KB peak RAM
+     *
+     * @param pids - Set of process IDs to query
+     * @returns Dictionary mapping PID to full command string
+     */
+    nonisolated static func commandLines(for pids: Set<Int>) -> [Int: String] {
+        var commands: [Int: String] = [:]
+        commands.reserveCapacity(pids.count)
+
+        for pid in pids {
+            if let cmd = commandLine(for: pid) {
+                commands[pid] = cmd
+            }
+        }
+
+        return commands
+    }
+
+    /// Reads the process start time via `proc_pidinfo(PROC_PIDTBSDINFO)` to build a
+    /// reuse-safe identity. Returns nil if the process is gone or not inspectable.
+    nonisolated static func identity(of pid: Int) -> ProcessIdentity? {
+        var info = proc_bsdinfo()
+        let size = Int32(MemoryLayout<proc_bsdinfo>.size)
+        guard proc_pidinfo(Int32(pid), PROC_PIDTBSDINFO, 0, &info, size) == size else { return nil }
+        let startTime = UInt64(info.pbi_start_tvsec) * 1_000_000 + UInt64(info.pbi_start_tvusec)
+        return ProcessIdentity(pid: pid, startTime: startTime)
+    }
+
+    /// Reads a process's full command line (argv) from the kernel via sysctl.
+    ///
+    /// KERN_PROCARGS2 returns: [argc: Int32][exec_path\0][\0 padding][argv[0]\0][argv[1]\0]...
+    /// We parse argc arguments and join them with spaces to match `ps -o command` output.
+    /// Falls back to nil for system processes that restrict access (callers use the
+    /// process name instead).
+    nonisolated static func commandLine(for pid: Int) -> String? {
+        var mib: [Int32] = [CTL_KERN, KERN_PROCARGS2, Int32(pid)]
+        var size: Int = 0
+
+        // First call: get required buffer size
+        guard sysctl(&mib, 3, nil, &size, nil, 0) == 0,
+              size > MemoryLayout<Int32>.size else { return nil }
+
+        // Second call: read the data
+        var buffer = [UInt8](repeating: 0, count: size)
+        guard sysctl(&mib, 3, &buffer, &size, nil, 0) == 0 else { return nil }
+
+        // Read argc from the first 4 bytes
+        let argc = buffer.withUnsafeBytes { $0.load(as: Int32.self) }
+        guard argc > 0 else { return nil }
+
+        var pos = MemoryLayout<Int32>.size
+
+        // Skip the executable path
+        while pos < size && buffer[pos] != 0 { pos += 1 }
+        // Skip null padding between exec path and argv
+        while pos < size && buffer[pos] == 0 { pos += 1 }
+
+        // Collect up to argc arguments (capped for safety)
+        let argLimit = min(argc, maxArguments)
+        var args = [String]()
+        args.reserveCapacity(Int(argLimit))
+        var collected: Int32 = 0
+
+        while pos < size && collected < argLimit {
+            let start = pos
+            while pos < size && buffer[pos] != 0 { pos += 1 }
+            if pos > start {
+                args.append(String(decoding: buffer[start..<pos], as: UTF8.self))
+            }
+            pos += 1
+            collected += 1
+        }
+
+        return args.isEmpty ? nil : args.joined(separator: " ")
+    }
+}
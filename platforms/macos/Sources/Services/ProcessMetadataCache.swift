@@ -0,0 +1,74 @@
+/**
+ * ProcessMetadataCache.swift
+ * PortKiller
+ *
+ * Per-process metadata kept across scan cycles so unchanged processes are not
+ * re-inspected (argv, name decoding, user lookup, type detection) on every refresh.
+ */
+
+import Foundation
+
+/// Identity of a running process. PIDs are reused; (pid, start time) is not.
+struct ProcessIdentity: Hashable, Sendable {
+    let pid: Int
+    /// Process start time in microseconds since the epoch
+    let startTime: UInt64
+}
+
+/// Scanner-resolved details about a process, shared by all of its listening ports
+struct ProcessMetadata: Sendable {
+    let processName: String
+    let command: String
+    let user: String
+    let processType: ProcessType
+
+    /// Resolves metadata, applying a user process-type override when present.
+    nonisolated static func resolve(
+        processName: String,
+        command: String,
+        user: String,
+        classifier: ProcessClassifier
+    ) -> ProcessMetadata {
+        ProcessMetadata(
+            processName: processName,
+            command: command,
+            user: user,
+            processType: classifier.processType(of: processName)
+        )
+    }
+}
+
+/// Cache of `ProcessMetadata` keyed by `ProcessIdentity`.
+///
+/// Owned by a scanner actor. Entries are evicted as soon as their process stops holding
+/// a listening socket, and the whole cache is dropped when process-type overrides change.
+struct ProcessMetadataCache: Sendable {
+    private var entries: [ProcessIdentity: ProcessMetadata] = [:]
+    private var overrides: [String: String] = [:]
+
+    /// Classifier compiled with the overrides the cached entries were resolved with
+    private(set) var classifier = ProcessClassifier.builtIn
+
+    /// Drops every entry, and recompiles the classifier, if the user changed process-type
+    /// overrides since the last scan.
+    nonisolated mutating func validate(overrides latest: [String: String]) {
+        guard latest != overrides else { return }
+        overrides = latest
+        classifier = ProcessClassifier(overrides: latest)
+        entries.removeAll(keepingCapacity: true)
+    }
+
+    nonisolated subscript(identity: ProcessIdentity) -> ProcessMetadata? {
+        entries[identity]
+    }
+
+    nonisolated mutating func insert(_ metadata: ProcessMetadata, for identity: ProcessIdentity) {
+        entries[identity] = metadata
+    }
+
+    /// Evicts entries for processes not seen in the latest scan.
+    nonisolated mutating func retainOnly(_ live: Set<ProcessIdentity>) {
+        guard entries.keys.contains(where: { !live.contains($0) }) else { return }
+        entries = entries.filter { live.contains($0.key) }
+    }
+}
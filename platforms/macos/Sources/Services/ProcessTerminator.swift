@@ -0,0 +1,108 @@
+import Foundation
+import Darwin
+
+/// Terminates a set of processes at once: SIGTERM to all, SIGKILL to survivors.
+///
+/// Exits are watched on one kqueue (`EVFILT_PROC` / `NOTE_EXIT`), so the grace period
+/// ends as soon as the last target is gone instead of always running to its full length,
+/// and the whole batch takes as long as its slowest process rather than the sum of them.
+nonisolated enum ProcessTerminator {
+
+    /// Upper bound of kevents drained per wait
+    private static let eventBatchSize = 64
+
+    /// Sends SIGTERM to every PID, waits up to `gracePeriod` for them to exit, then sends
+    /// SIGKILL to the ones still running.
+    ///
+    /// - Returns: PIDs that are gone afterwards (exited on SIGTERM, were already gone,
+    ///   or accepted SIGKILL). PIDs we may not signal (EPERM) are not included.
+    @concurrent
+    static func terminate(pids: Set<Int>, gracePeriod: Duration = AppConstants.killGracePeriod) async -> Set<Int> {
+        guard !pids.isEmpty else { return [] }
+        return await withCheckedContinuation { continuation in
+            // kevent blocks for up to the grace period; keep it off the cooperative pool.
+            DispatchQueue.global(qos: .userInitiated).async {
+                continuation.resume(returning: terminateBlocking(pids.map { pid_t($0) }, gracePeriod: gracePeriod))
+            }
+        }
+    }
+
+    // MARK: - Private Helpers
+
+    private static func terminateBlocking(_ pids: [pid_t], gracePeriod: Duration) -> Set<Int> {
+        var gone = Set<Int>()
+        var pending = Set<pid_t>()
+
+        let queue = kqueue()
+        defer { if queue >= 0 { close(queue) } }
+
+        for pid in pids {
+            // Register before signalling so an immediate exit can't be missed.
+            if queue >= 0, !watchExit(of: pid, on: queue), errno == ESRCH {
+                gone.insert(Int(pid))
+                continue
+            }
+            if kill(pid, SIGTERM) == 0 {
+                pending.insert(pid)
+            } else if errno == ESRCH {
+                gone.insert(Int(pid))
+            }
+        }
+
+        if queue >= 0 {
+            waitForExits(of: &pending, on: queue, gone: &gone, until: .now + gracePeriod)
+        } else {
+            // No kqueue: fall back to the fixed grace period.
+            Thread.sleep(forTimeInterval: gracePeriod / .seconds(1))
+        }
+
+        for pid in pending {
+            if kill(pid, SIGKILL) == 0 || errno == ESRCH {
+                gone.insert(Int(pid))
+            }
+        }
+        return gone
+    }
+
+    /// Adds a one-shot exit watch for `pid`; false (with `errno` set) if it failed.
+    private static func watchExit(of pid: pid_t, on queue: Int32) -> Bool {
+        var change = kevent(
+            ident: UInt(pid),
+            filter: Int16(EVFILT_PROC),
+            flags: UInt16(EV_ADD | EV_ONESHOT),
+            fflags: UInt32(NOTE_EXIT),
+            data: 0,
+            udata: nil
+        )
+        return kevent(queue, &change, 1, nil, 0, nil) == 0
+    }
+
+    /// Collects exit events until `pending` is empty or `deadline` passes.
+    private static func waitForExits(
+        of pending: inout Set<pid_t>,
+        on queue: Int32,
+        gone: inout Set<Int>,
+        until deadline: ContinuousClock.Instant
+    ) {
+        var received = [kevent](repeating: kevent(), count: eventBatchSize)
+        while !pending.isEmpty {
+            let remaining = deadline - .now
+            guard remaining > .zero else { return }
+
+            let (seconds, attoseconds) = remaining.components
+            var timeout = timespec(tv_sec: Int(seconds), tv_nsec: Int(attoseconds / 1_000_000_000))
+            let count = kevent(queue, nil, 0, &received, Int32(received.count), &timeout)
+            if count < 0 {
+                if errno == EINTR { continue }
+                return
+            }
+
+            for event in received.prefix(Int(count)) where event.fflags & UInt32(NOTE_EXIT) != 0 {
+                let pid = pid_t(event.ident)
+                if pending.remove(pid) != nil {
+                    gone.insert(Int(pid))
+                }
+            }
+        }
+    }
+}
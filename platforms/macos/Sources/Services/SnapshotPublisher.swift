@@ -0,0 +1,98 @@
+import Foundation
+import os
+import PortSnapshot
+
+/// Publishes scan deltas as generations of the shared port snapshot (see `SnapshotFile`),
+/// for the CLI, scripts and other app instances.
+///
+/// Generations continue from whatever is on disk, so readers only ever see them grow,
+/// even across publishers. An unchanged scan is republished only once
+/// `AppConstants.snapshotHeartbeat` passes, unless forced.
+actor SnapshotPublisher {
+    nonisolated private static let logger = Logger(subsystem: "com.portkiller.app", category: "Snapshot")
+
+    private let url: URL
+    private let flags: SnapshotFile.Flags
+    private var generation: UInt64
+    private var lastPublished: ContinuousClock.Instant?
+
+    init(url: URL = SnapshotFile.defaultURL, headless: Bool = false) {
+        self.url = url
+        self.flags = headless ? .headless : []
+        self.generation = 0
+    }
+
+    /// Publishes `delta` as the next generation, or skips it if nothing changed and
+    /// the heartbeat isn't due.
+    ///
+    /// - Parameter force: Publish even an unchanged scan, e.g. to answer a rescan request
+    func publish(_ delta: PortScanDelta, force: Bool = false) {
+        if !force, delta.isEmpty, let lastPublished,
+           ContinuousClock.now - lastPublished < AppConstants.snapshotHeartbeat {
+            return
+        }
+        // Another publisher may have written since (the app before the background scanner took over)
+        generation = max(generation, SnapshotFile(contentsOf: url)?.generation ?? 0)
+
+        var updated = Set(delta.added.map(\.snapshotKey))
+        updated.formUnion(delta.changed.map(\.snapshotKey))
+        let data = SnapshotWriter.encode(
+            ports: delta.ports.map(SnapshotPort.init),
+            updated: updated,
+            removed: delta.removed.map(\.snapshotKey),
+            generation: generation + 1,
+            previousGeneration: generation,
+            flags: flags
+        )
+        do {
+            try SnapshotWriter.publish(data, to: url)
+        } catch {
+            Self.logger.error("Publishing port snapshot failed: \(error.localizedDescription)")
+            return
+        }
+
+        generation += 1
+        lastPublished = .now
+        SnapshotNotification.published.post()
+    }
+}
+
+// MARK: - PortInfo Conversion
+
+extension SnapshotPort {
+    nonisolated init(_ port: PortInfo) {
+        self.init(
+            port: port.port,
+            pid: port.pid,
+            processName: port.processName,
+            user: port.user,
+            command: port.command,
+            address: port.address,
+            fd: port.fd,
+            processType: port.processType.rawValue
+        )
+    }
+}
+
+extension PortInfo {
+    /// Identity of this listener in a shared snapshot
+    nonisolated var snapshotKey: SnapshotPort.Key {
+        SnapshotPort.Key(port: port, pid: pid)
+    }
+
+    /// An active port as published by another PortKiller process, whose process type
+    /// (overrides included) was already resolved there
+    nonisolated init(_ port: SnapshotPort) {
+        self.init(
+            port: port.port,
+            pid: port.pid,
+            processName: port.processName,
+            address: port.address,
+            user: port.user,
+            command: port.command,
+            fd: port.fd,
+            isActive: true,
+            processType: ProcessType(rawValue: port.processType) ?? ProcessClassifier.builtIn.processType(of: port.processName)
+        )
+    }
+}
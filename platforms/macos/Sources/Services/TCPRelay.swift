@@ -0,0 +1,451 @@
+import Foundation
+import Darwin
+
+/// Serial queue shared by every `TCPRelay`, so all relayed sockets are serviced by one
+/// dispatch queue (GCD multiplexes the read/write sources over kqueue).
+enum TCPRelayQueue {
+    nonisolated static let shared = DispatchQueue(label: "com.portkiller.tcp-relay", qos: .userInitiated)
+}
+
+enum TCPRelayError: Error, LocalizedError, Sendable {
+    case addressInUse(Int)
+    case listenFailed(Int, String)
+
+    var errorDescription: String? {
+        switch self {
+        case .addressInUse(let port):
+            return "Port \(port) is already in use"
+        case .listenFailed(let port, let reason):
+            return "Proxy failed to listen on port \(port): \(reason)"
+        }
+    }
+}
+
+/// In-process replacement for `socat TCP-LISTEN:<port>,fork,reuseaddr TCP:127.0.0.1:<target>`.
+///
+/// The listener and every relayed connection are non-blocking sockets driven by dispatch
+/// sources on `TCPRelayQueue.shared`; bytes are spliced through one reused buffer per relay.
+/// When a destination can't take more data, the remainder is parked and the source side
+/// is suspended until the destination drains, so a slow reader applies backpressure
+/// instead of growing memory.
+nonisolated final class TCPRelay: @unchecked Sendable {
+
+    /// Counters for one relayed client connection
+    struct ConnectionStats: Identifiable, Sendable {
+        let id: UInt64
+        let openedAt: Date
+        /// Time to connect to the target port; nil while connecting
+        var connectLatency: Duration?
+        /// Bytes relayed client → target
+        var bytesSent: UInt64 = 0
+        /// Bytes relayed target → client
+        var bytesReceived: UInt64 = 0
+    }
+
+    /// Snapshot of a relay's counters
+    struct Statistics: Sendable {
+        var active: [ConnectionStats] = []
+        /// Connections accepted since the relay started, including closed ones
+        var totalConnections: UInt64 = 0
+        var totalBytesSent: UInt64 = 0
+        var totalBytesReceived: UInt64 = 0
+    }
+
+    /// Reports relay problems; `isError` lines are treated like socat error output
+    typealias EventHandler = @Sendable (_ message: String, _ isError: Bool) -> Void
+
+    /// Bytes moved per read
+    private static var bufferSize: Int { 64 * 1024 }
+
+    let listenPort: Int
+    let targetPort: Int
+
+    private let queue = TCPRelayQueue.shared
+    private let onEvent: EventHandler
+
+    // Everything below is only touched on `queue`.
+    private var acceptSource: DispatchSourceRead?
+    private var sessions: [UInt64: Session] = [:]
+    private var nextSessionID: UInt64 = 0
+    /// Accepted-connection count and the byte counts of connections that already closed
+    private var totals = Statistics()
+    private var buffer: [UInt8]
+
+    init(listenPort: Int, targetPort: Int, onEvent: @escaping EventHandler) {
+        self.listenPort = listenPort
+        self.targetPort = targetPort
+        self.onEvent = onEvent
+        buffer = [UInt8](repeating: 0, count: Self.bufferSize)
+    }
+
+    /// Whether the listener is accepting connections
+    var isRunning: Bool {
+        queue.sync { acceptSource != nil }
+    }
+
+    /// Binds the listener. The relay is ready as soon as this returns.
+    func start() throws {
+        // Bind on the queue so a stopped relay's listener on this port is closed first
+        try queue.sync {
+            let descriptor = try Self.makeListener(port: listenPort)
+            let source = DispatchSource.makeReadSource(fileDescriptor: descriptor, queue: queue)
+            source.setEventHandler { [weak self] in
+                self?.acceptPending(on: descriptor)
+            }
+            source.setCancelHandler { close(descriptor) }
+            acceptSource = source
+            source.resume()
+        }
+    }
+
+    /// Closes the listener and every relayed connection.
+    func stop() {
+        queue.sync {
+            acceptSource?.cancel()
+            acceptSource = nil
+            for session in sessions.values {
+                session.cancel()
+            }
+            sessions.removeAll()
+        }
+    }
+
+    /// Current per-connection and cumulative counters.
+    func statistics() -> Statistics {
+        queue.sync {
+            var stats = totals
+            for session in sessions.values.sorted(by: { $0.stats.id < $1.stats.id }) {
+                stats.active.append(session.stats)
+                stats.totalBytesSent += session.stats.bytesSent
+                stats.totalBytesReceived += session.stats.bytesReceived
+            }
+            return stats
+        }
+    }
+
+    // MARK: - Private Types
+
+    /// One direction of a relayed connection
+    private final class Direction {
+        let from: Int32
+        let to: Int32
+        let readSource: DispatchSourceRead
+        let writeSource: DispatchSourceWrite
+        /// Bytes read but not yet accepted by `to`
+        var pending: [UInt8] = []
+        var isReadSuspended = false
+        var isWriteSuspended = true
+        /// `from` reached EOF and `to` was half-closed
+        var isFinished = false
+
+        init(from: Int32, to: Int32, queue: DispatchQueue) {
+            self.from = from
+            self.to = to
+            readSource = DispatchSource.makeReadSource(fileDescriptor: from, queue: queue)
+            writeSource = DispatchSource.makeWriteSource(fileDescriptor: to, queue: queue)
+        }
+
+        func suspendRead() {
+            guard !isReadSuspended else { return }
+            readSource.suspend()
+            isReadSuspended = true
+        }
+
+        func resumeRead() {
+            guard isReadSuspended else { return }
+            readSource.resume()
+            isReadSuspended = false
+        }
+
+        func suspendWrite() {
+            guard !isWriteSuspended else { return }
+            writeSource.suspend()
+            isWriteSuspended = true
+        }
+
+        func resumeWrite() {
+            guard isWriteSuspended else { return }
+            writeSource.resume()
+            isWriteSuspended = false
+        }
+
+        func cancel() {
+            readSource.cancel()
+            writeSource.cancel()
+            // A suspended source never runs its cancel handler (or may not be released)
+            resumeRead()
+            resumeWrite()
+        }
+    }
+
+    /// A client connection and its target connection
+    private final class Session {
+        let client: Int32
+        let upstream: Int32
+        let startedAt = ContinuousClock.now
+        var stats: ConnectionStats
+        var connectSource: DispatchSourceWrite?
+        var outbound: Direction?
+        var inbound: Direction?
+
+        /// Both descriptors are closed once every source on them has been cancelled
+        let sources = DispatchGroup()
+
+        init(id: UInt64, client: Int32, upstream: Int32) {
+            self.client = client
+            self.upstream = upstream
+            stats = ConnectionStats(id: id, openedAt: Date())
+        }
+
+        func track(_ source: DispatchSourceProtocol) {
+            sources.enter()
+            source.setCancelHandler { [sources] in sources.leave() }
+        }
+
+        func cancel() {
+            connectSource?.cancel()
+            connectSource = nil
+            outbound?.cancel()
+            inbound?.cancel()
+            let client = client
+            let upstream = upstream
+            sources.notify(queue: TCPRelayQueue.shared) {
+                close(client)
+                close(upstream)
+            }
+        }
+    }
+
+    // MARK: - Accepting
+
+    private func acceptPending(on listener: Int32) {
+        while true {
+            let client = accept(listener, nil, nil)
+            if client < 0 {
+                if errno == EINTR { continue }
+                if errno != EAGAIN && errno != ECONNABORTED {
+                    onEvent("accept failed: \(Self.errorString(errno))", true)
+                }
+                return
+            }
+            Self.configure(client)
+            startSession(client: client)
+        }
+    }
+
+    private func startSession(client: Int32) {
+        let upstream = socket(AF_INET, SOCK_STREAM, 0)
+        guard upstream >= 0 else {
+            onEvent("socket failed: \(Self.errorString(errno))", true)
+            close(client)
+            return
+        }
+        Self.configure(upstream)
+
+        var addr = sockaddr_in()
+        addr.sin_len = UInt8(MemoryLayout<sockaddr_in>.size)
+        addr.sin_family = sa_family_t(AF_INET)
+        addr.sin_port = in_port_t(targetPort).bigEndian
+        addr.sin_addr.s_addr = inet_addr("127.0.0.1")
+        let result = withUnsafePointer(to: &addr) {
+            $0.withMemoryRebound(to: sockaddr.self, capacity: 1) {
+                connect(upstream, $0, socklen_t(MemoryLayout<sockaddr_in>.size))
+            }
+        }
+        let connectError = result == 0 ? 0 : errno
+
+        guard connectError == 0 || connectError == EINPROGRESS else {
+            reportConnectFailure(connectError)
+            close(client)
+            close(upstream)
+            return
+        }
+
+        let id = nextSessionID
+        nextSessionID &+= 1
+        totals.totalConnections += 1
+        let session = Session(id: id, client: client, upstream: upstream)
+        sessions[id] = session
+
+        if connectError == 0 {
+            startRelaying(session)
+            return
+        }
+
+        // Wait for the connect to finish; the socket becomes writable either way
+        let source = DispatchSource.makeWriteSource(fileDescriptor: upstream, queue: queue)
+        session.track(source)
+        session.connectSource = source
+        source.setEventHandler { [weak self, weak session] in
+            guard let self, let session, session.connectSource != nil else { return }
+            session.connectSource?.cancel()
+            session.connectSource = nil
+
+            let error = Self.socketError(session.upstream)
+            if error == 0 {
+                self.startRelaying(session)
+            } else {
+                self.reportConnectFailure(error)
+                self.finish(session)
+            }
+        }
+        source.resume()
+    }
+
+    private func reportConnectFailure(_ error: Int32) {
+        onEvent("connect to 127.0.0.1:\(targetPort) failed: \(Self.errorString(error))", true)
+    }
+
+    // MARK: - Relaying
+
+    private func startRelaying(_ session: Session) {
+        session.stats.connectLatency = ContinuousClock.now - session.startedAt
+
+        let outbound = Direction(from: session.client, to: session.upstream, queue: queue)
+        let inbound = Direction(from: session.upstream, to: session.client, queue: queue)
+        session.outbound = outbound
+        session.inbound = inbound
+
+        for direction in [outbound, inbound] {
+            session.track(direction.readSource)
+            session.track(direction.writeSource)
+            direction.readSource.setEventHandler { [weak self, weak session, weak direction] in
+                guard let self, let session, let direction else { return }
+                self.pump(direction, in: session)
+            }
+            direction.writeSource.setEventHandler { [weak self, weak session, weak direction] in
+                guard let self, let session, let direction else { return }
+                self.flush(direction, in: session)
+            }
+            // Write sources stay inactive and are only resumed while data is parked
+            direction.readSource.resume()
+        }
+    }
+
+    /// Moves one buffer's worth of bytes from `direction.from` to `direction.to`.
+    private func pump(_ direction: Direction, in session: Session) {
+        let count = buffer.withUnsafeMutableBytes { bytes in
+            read(direction.from, bytes.baseAddress, bytes.count)
+        }
+
+        if count < 0 {
+            if errno == EAGAIN || errno == EINTR { return }
+            finish(session)
+            return
+        }
+
+        guard count > 0 else {
+            // EOF: pass the half-close on, and finish once both sides are done
+            shutdown(direction.to, SHUT_WR)
+            direction.isFinished = true
+            direction.suspendRead()
+            if session.outbound?.isFinished == true && session.inbound?.isFinished == true {
+                finish(session)
+            }
+            return
+        }
+
+        if direction === session.outbound {
+            session.stats.bytesSent += UInt64(count)
+        } else {
+            session.stats.bytesReceived += UInt64(count)
+        }
+
+        let written = buffer.withUnsafeBytes { bytes in
+            write(direction.to, bytes.baseAddress, count)
+        }
+        if written == count { return }
+        if written < 0 && errno != EAGAIN && errno != EINTR {
+            finish(session)
+            return
+        }
+
+        // Destination is full: park the rest and stop reading until it drains
+        direction.pending = Array(buffer[max(0, written)..<count])
+        direction.suspendRead()
+        direction.resumeWrite()
+    }
+
+    /// Writes parked bytes once the destination is writable again.
+    private func flush(_ direction: Direction, in session: Session) {
+        let written = direction.pending.withUnsafeBytes { bytes in
+            write(direction.to, bytes.baseAddress, bytes.count)
+        }
+        if written < 0 {
+            if errno == EAGAIN || errno == EINTR { return }
+            finish(session)
+            return
+        }
+
+        direction.pending.removeFirst(written)
+        if direction.pending.isEmpty {
+            direction.suspendWrite()
+            direction.resumeRead()
+        }
+    }
+
+    private func finish(_ session: Session) {
+        guard sessions.removeValue(forKey: session.stats.id) != nil else { return }
+        totals.totalBytesSent += session.stats.bytesSent
+        totals.totalBytesReceived += session.stats.bytesReceived
+        session.cancel()
+    }
+
+    // MARK: - Socket Helpers
+
+    /// Creates a non-blocking listener on all interfaces (what socat TCP-LISTEN binds).
+    private static func makeListener(port: Int) throws -> Int32 {
+        let descriptor = socket(AF_INET, SOCK_STREAM, 0)
+        guard descriptor >= 0 else {
+            throw TCPRelayError.listenFailed(port, errorString(errno))
+        }
+
+        var reuse: Int32 = 1
+        setsockopt(descriptor, SOL_SOCKET, SO_REUSEADDR, &reuse, socklen_t(MemoryLayout<Int32>.size))
+
+        var addr = sockaddr_in()
+        addr.sin_len = UInt8(MemoryLayout<sockaddr_in>.size)
+        addr.sin_family = sa_family_t(AF_INET)
+        addr.sin_port = in_port_t(port).bigEndian
+        addr.sin_addr.s_addr = INADDR_ANY
+        let bound = withUnsafePointer(to: &addr) {
+            $0.withMemoryRebound(to: sockaddr.self, capacity: 1) {
+                bind(descriptor, $0, socklen_t(MemoryLayout<sockaddr_in>.size))
+            }
+        }
+
+        guard bound == 0, listen(descriptor, SOMAXCONN) == 0 else {
+            let error = errno
+            Darwin.close(descriptor)
+            if error == EADDRINUSE {
+                throw TCPRelayError.addressInUse(port)
+            }
+            throw TCPRelayError.listenFailed(port, errorString(error))
+        }
+
+        configure(descriptor)
+        return descriptor
+    }
+
+    /// Non-blocking, no SIGPIPE on write to a closed peer, no Nagle delay.
+    private static func configure(_ descriptor: Int32) {
+        let flags = fcntl(descriptor, F_GETFL, 0)
+        _ = fcntl(descriptor, F_SETFL, flags | O_NONBLOCK)
+
+        var on: Int32 = 1
+        let size = socklen_t(MemoryLayout<Int32>.size)
+        setsockopt(descriptor, SOL_SOCKET, SO_NOSIGPIPE, &on, size)
+        setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &on, size)
+    }
+
+    private static func socketError(_ descriptor: Int32) -> Int32 {
+        var error: Int32 = 0
+        var length = socklen_t(MemoryLayout<Int32>.size)
+        guard getsockopt(descriptor, SOL_SOCKET, SO_ERROR, &error, &length) == 0 else { return errno }
+        return error
+    }
+
+    private static func errorString(_ error: Int32) -> String {
+        String(cString: strerror(error))
+    }
+}
@@ -0,0 +1,137 @@
+import Foundation
+import Defaults
+import PortSnapshot
+
+/**
+ * SharedSnapshotScanner shares one scan between every PortKiller process.
+ *
+ * While the headless background scanner (`HeadlessScanner`) is running, scans are
+ * answered from its shared snapshot instead of walking the process table again. The
+ * background scanner scans on the same refresh interval and publishes every change, so
+ * its snapshot is current within one interval: reads at polling rate use it as is. A
+ * read sooner than that after the previous one (a process exit, a kill, the user) gets
+ * a rescan request, unless the snapshot is younger than `snapshotFreshness`, and the
+ * next generation is read once it lands.
+ *
+ * Without a background scanner, the wrapped scanner runs and every change is published
+ * to the snapshot, so the `portkiller-cli` client and scripts still don't need a scan
+ * of their own.
+ *
+ * Deltas are always computed here, against what this instance last returned, so
+ * switching between the two sources never leaves the caller's list out of sync.
+ * Process termination goes to the wrapped scanner.
+ */
+actor SharedSnapshotScanner: PortScannerProtocol {
+
+    /// A background snapshot younger than this is returned without a rescan request,
+    /// however soon after the previous read
+    nonisolated private static let snapshotFreshness: Duration = .milliseconds(500)
+
+    /// Poll interval while waiting for a requested generation
+    nonisolated private static let rescanPollInterval: Duration = .milliseconds(10)
+
+    private let local: PortScannerProtocol
+    private let publisher: SnapshotPublisher
+    private let url: URL
+    private var differ = PortSnapshotDiffer()
+    /// When the background snapshot was last read, to tell polling from early refreshes
+    private var lastBackgroundRead: ContinuousClock.Instant?
+
+    init(local: PortScannerProtocol = LibprocPortScanner(), url: URL = SnapshotFile.defaultURL) {
+        self.local = local
+        self.url = url
+        self.publisher = SnapshotPublisher(url: url)
+    }
+
+    // MARK: - Scanning
+
+    func scanPorts() async -> [PortInfo] {
+        if let remote = await backgroundPorts() {
+            return remote
+        }
+        return await local.scanPorts()
+    }
+
+    func scanDelta() async -> PortScanDelta {
+        if let remote = await backgroundPorts() {
+            return differ.delta(for: remote)
+        }
+        let delta = differ.delta(for: await local.scanPorts())
+        await publisher.publish(delta)
+        return delta
+    }
+
+    /// The background scanner's current ports, or nil if none is running
+    private func backgroundPorts() async -> [PortInfo]? {
+        guard let current = Self.backgroundSnapshot(at: url) else { return nil }
+        let now = ContinuousClock.now
+        let interval = Duration.seconds(max(1, Defaults[.refreshInterval]))
+        let isEarly = lastBackgroundRead.map { now - $0 < interval } ?? false
+        lastBackgroundRead = now
+        guard isEarly, current.age > Self.snapshotFreshness / .seconds(1) else {
+            return current.ports.map(PortInfo.init)
+        }
+
+        SnapshotNotification.rescanRequested.post()
+        let deadline = ContinuousClock.now + AppConstants.snapshotRescanTimeout
+        while ContinuousClock.now < deadline {
+            try? await Task.sleep(for: Self.rescanPollInterval)
+            if let next = SnapshotFile(contentsOf: url), next.generation > current.generation {
+                return next.ports.map(PortInfo.init)
+            }
+        }
+        // It didn't answer in time; its last snapshot is still the best we have
+        return current.ports.map(PortInfo.init)
+    }
+
+    /// The snapshot at `url` if a running background scanner other than this process
+    /// published it recently enough to be trusted
+    nonisolated static func backgroundSnapshot(at url: URL = SnapshotFile.defaultURL) -> SnapshotFile? {
+        guard let snapshot = SnapshotFile(contentsOf: url),
+              snapshot.flags.contains(.headless),
+              snapshot.publisherPID != getpid(),
+              snapshot.age < AppConstants.snapshotMaxAge / .seconds(1),
+              snapshot.isPublisherRunning else { return nil }
+        return snapshot
+    }
+
+    /// Ports of the last snapshot published since boot, by the background scanner or an
+    /// earlier run of the app, so the menu bar can show them before the first scan; nil
+    /// if there is none. Its PIDs may be stale, but none predate a reboot, and AppState
+    /// doesn't kill them until that scan replaces them.
+    nonisolated static func publishedPorts(at url: URL = SnapshotFile.defaultURL) -> [PortInfo]? {
+        guard let snapshot = SnapshotFile(contentsOf: url),
+              let bootTime = systemBootTime(),
+              snapshot.publishedAt > bootTime else { return nil }
+        return snapshot.ports.map(PortInfo.init)
+    }
+
+    nonisolated private static func systemBootTime() -> Date? {
+        var bootTime = timeval()
+        var size = MemoryLayout<timeval>.size
+        guard sysctlbyname("kern.boottime", &bootTime, &size, nil, 0) == 0 else { return nil }
+        return Date(timeIntervalSince1970: Double(bootTime.tv_sec) + Double(bootTime.tv_usec) / 1_000_000)
+    }
+
+    // MARK: - Process Termination
+
+    func killProcess(pid: Int, force: Bool) async -> Bool {
+        await local.killProcess(pid: pid, force: force)
+    }
+
+    func killProcessGracefully(pid: Int) async -> Bool {
+        await local.killProcessGracefully(pid: pid)
+    }
+
+    func killProcesses(pids: Set<Int>) async -> Set<Int> {
+        await local.killProcesses(pids: pids)
+    }
+
+    func findEstablishedPids(for port: Int) async -> Set<Int> {
+        await local.findEstablishedPids(for: port)
+    }
+
+    func findEstablishedPids(for ports: Set<Int>) async -> Set<Int> {
+        await local.findEstablishedPids(for: ports)
+    }
+}
@@ -0,0 +1,283 @@
+/**
+ * PortViewPipeline.swift
+ * PortKiller
+ *
+ * Derived views of the port list: sidebar selection → filter → system-process
+ * visibility → sorted list / process groups. Each stage is memoized on its own
+ * inputs, including the generation of the stage before it, so a change only
+ * recomputes the stages downstream of it.
+ */
+
+import Foundation
+
+/// One memoized stage: recomputes its output only when its inputs change.
+struct MemoizedStage<Inputs: Equatable, Output> {
+    private var inputs: Inputs?
+    private var output: Output?
+
+    /// Bumped whenever the output changes; downstream stages include it in their inputs
+    private(set) var generation: UInt64 = 0
+
+    /// Returns the cached output for `inputs`, computing it if they changed.
+    mutating func output(for inputs: Inputs, compute: () -> Output) -> Output {
+        if let output, inputs == self.inputs { return output }
+        let value = compute()
+        self.inputs = inputs
+        self.output = value
+        generation &+= 1
+        return value
+    }
+
+    /// Like `output(for:compute:)`, but a recomputation that yields the same output
+    /// keeps the generation, so downstream stages stay cached (e.g. a new listener
+    /// that the current filter hides doesn't re-sort or re-group anything).
+    mutating func output(for inputs: Inputs, compute: () -> Output) -> Output where Output: Equatable {
+        if let output, inputs == self.inputs { return output }
+        let value = compute()
+        self.inputs = inputs
+        if value != output {
+            generation &+= 1
+        }
+        self.output = value
+        return value
+    }
+
+    /// Like `output(for:compute:)`, but first lets `update` patch the previous output,
+    /// given the inputs it was computed for, e.g. to merge a few new rows into a sorted
+    /// list. `update` returns nil when the change is too large and `compute` runs instead.
+    mutating func output(
+        for inputs: Inputs,
+        update: (_ previous: Output, _ previousInputs: Inputs) -> Output?,
+        compute: () -> Output
+    ) -> Output {
+        if let output, inputs == self.inputs { return output }
+        let value = output.flatMap { previous in self.inputs.flatMap { update(previous, $0) } } ?? compute()
+        self.inputs = inputs
+        self.output = value
+        generation &+= 1
+        return value
+    }
+}
+
+/// The memoized stages behind `AppState.filteredPorts`, its sorted list and process groups,
+/// and the menu bar's own search → priority-group chain.
+///
+/// Inputs that only matter for some settings (favorites for the Favorites sidebar item
+/// or filter, watched ports likewise) are passed as empty otherwise, so e.g. starring a
+/// port while browsing All Ports doesn't invalidate the selection stage.
+struct PortViewPipeline {
+    struct SelectionInputs: Equatable {
+        let tableGeneration: UInt64
+        let sidebarItem: SidebarItem
+        let favorites: Set<Int>
+        let watched: Set<Int>
+    }
+
+    struct FilterInputs: Equatable {
+        let selectionGeneration: UInt64
+        let filter: PortFilter
+        let favorites: Set<Int>
+        let watched: Set<Int>
+    }
+
+    struct VisibilityInputs: Equatable {
+        let filterGeneration: UInt64
+        let hideSystemProcesses: Bool
+    }
+
+    struct SortInputs: Equatable {
+        let visibleGeneration: UInt64
+        let order: SortOrder
+        let ascending: Bool
+        let favorites: Set<Int>
+        let watched: Set<Int>
+
+        /// Whether `other` sorts the same way, so its output can be patched
+        func hasSameOrder(as other: SortInputs) -> Bool {
+            (order, ascending, favorites, watched) == (other.order, other.ascending, other.favorites, other.watched)
+        }
+    }
+
+    struct GroupInputs: Equatable {
+        let visibleGeneration: UInt64
+    }
+
+    struct MenuBarInputs: Equatable {
+        let tableGeneration: UInt64
+        let searchText: String
+        let hideSystemProcesses: Bool
+        let favorites: Set<Int>
+    }
+
+    struct PriorityGroupInputs: Equatable {
+        let menuBarGeneration: UInt64
+        let favorites: Set<Int>
+        let watched: Set<Int>
+    }
+
+    var selection = MemoizedStage<SelectionInputs, [PortInfo]>()
+    var filtered = MemoizedStage<FilterInputs, [PortInfo]>()
+    var visible = MemoizedStage<VisibilityInputs, [PortInfo]>()
+    var sorted = MemoizedStage<SortInputs, [PortInfo]>()
+    var groups = MemoizedStage<GroupInputs, [ProcessGroup]>()
+    var menuBar = MemoizedStage<MenuBarInputs, [PortInfo]>()
+    var priorityGroups = MemoizedStage<PriorityGroupInputs, [ProcessGroup]>()
+
+    // MARK: - Stage Functions
+
+    /// Ports shown for a sidebar item; Favorites and Watched add inactive placeholders.
+    nonisolated static func select(
+        _ table: PortTable,
+        sidebarItem: SidebarItem,
+        favorites: Set<Int>,
+        watched: Set<Int>
+    ) -> [PortInfo] {
+        switch sidebarItem {
+        case .settings:
+            return []
+        case .allPorts, .sponsors, .kubernetesPortForward, .cloudflareTunnels:
+            return Array(table)
+        case .favorites:
+            return selectWithPlaceholders(table, ports: favorites)
+        case .watched:
+            return selectWithPlaceholders(table, ports: watched)
+        case .processType(let type):
+            return table.indices.compactMap { table.processType(at: $0) == type ? table[$0] : nil }
+        }
+    }
+
+    /// Menu bar rows: port number or process name containing `searchText`, favorites
+    /// first, then by port.
+    nonisolated static func selectForMenuBar(
+        _ table: PortTable,
+        searchText: String,
+        hideSystemProcesses: Bool,
+        favorites: Set<Int>
+    ) -> [PortInfo] {
+        let matching = table.indices.compactMap { row -> PortInfo? in
+            if hideSystemProcesses && table.processType(at: row) == .system { return nil }
+            if !searchText.isEmpty
+                && !String(table.port(at: row)).contains(searchText)
+                && !table.processName(at: row).localizedCaseInsensitiveContains(searchText) {
+                return nil
+            }
+            return table[row]
+        }
+        return matching.sorted { a, b in
+            let aFav = favorites.contains(a.port)
+            let bFav = favorites.contains(b.port)
+            if aFav != bFav { return aFav }
+            return a.port < b.port
+        }
+    }
+
+    /// Sorts ports by a table column; ties and descending order as in the table header.
+    nonisolated static func sort(
+        _ ports: [PortInfo],
+        by order: SortOrder,
+        ascending: Bool,
+        favorites: Set<Int>,
+        watched: Set<Int>
+    ) -> [PortInfo] {
+        ports.sorted(by: ordering(by: order, ascending: ascending, favorites: favorites, watched: watched))
+    }
+
+    /// `previous`, a `sort` result for an earlier list with the same order, patched to
+    /// hold `ports` instead: rows gone or changed since are dropped and the others
+    /// merged in. Nil when more than `maxPatchedFraction` of the rows are new.
+    nonisolated static func resort(
+        _ previous: [PortInfo],
+        to ports: [PortInfo],
+        by order: SortOrder,
+        ascending: Bool,
+        favorites: Set<Int>,
+        watched: Set<Int>
+    ) -> [PortInfo]? {
+        var pending = Set(ports)
+        let kept = previous.filter { pending.remove($0) != nil }
+        guard pending.count * maxPatchedFraction <= ports.count else { return nil }
+        let areInIncreasingOrder = ordering(by: order, ascending: ascending, favorites: favorites, watched: watched)
+        return kept.mergingSorted(pending.sorted(by: areInIncreasingOrder), by: areInIncreasingOrder)
+    }
+
+    /// `previous`, a `PortGroupingService.groupByProcess` result for an earlier list,
+    /// patched to group `ports` instead: only the groups of processes with rows added,
+    /// removed or changed are rebuilt. Nil when more than `maxPatchedFraction` of the
+    /// groups would be.
+    nonisolated static func regroup(_ previous: [ProcessGroup], to ports: [PortInfo]) -> [ProcessGroup]? {
+        var pending = Set(ports)
+        var changedNames = Set<String>()
+        for group in previous {
+            for port in group.ports where pending.remove(port) == nil {
+                changedNames.insert(group.processName)
+            }
+        }
+        changedNames.formUnion(pending.map(\.processName))
+        guard !changedNames.isEmpty else { return previous }
+        guard changedNames.count * maxPatchedFraction <= previous.count else { return nil }
+
+        let rebuilt = PortGroupingService.shared.groupByProcess(ports.filter { changedNames.contains($0.processName) })
+        return previous
+            .filter { !changedNames.contains($0.processName) }
+            .mergingSorted(rebuilt) { $0.processName.localizedCaseInsensitiveCompare($1.processName) == .orderedAscending }
+    }
+
+    // MARK: - Private Helpers
+
+    /// Patching a previous result beats recomputing it while at most one row (or
+    /// group) in this many is new
+    nonisolated private static let maxPatchedFraction = 8
+
+    /// The row order of a table column, as used by `sort`
+    nonisolated private static func ordering(
+        by order: SortOrder,
+        ascending: Bool,
+        favorites: Set<Int>,
+        watched: Set<Int>
+    ) -> (PortInfo, PortInfo) -> Bool {
+        { a, b in
+            let result: Bool
+            switch order {
+            case .port:
+                result = a.port < b.port
+            case .process:
+                result = a.processName.localizedCaseInsensitiveCompare(b.processName) == .orderedAscending
+            case .pid:
+                result = a.pid < b.pid
+            case .type:
+                result = a.processType.rawValue < b.processType.rawValue
+            case .address:
+                result = a.address.localizedCaseInsensitiveCompare(b.address) == .orderedAscending
+            case .user:
+                result = a.user.localizedCaseInsensitiveCompare(b.user) == .orderedAscending
+            case .actions:
+                // Priority: Favorite > Watching > Neither
+                let aPriority = favorites.contains(a.port) ? 2 : (watched.contains(a.port) ? 1 : 0)
+                let bPriority = favorites.contains(b.port) ? 2 : (watched.contains(b.port) ? 1 : 0)
+
+                if aPriority != bPriority {
+                    result = aPriority > bPriority
+                } else {
+                    // Same priority, sort by port number
+                    result = a.port < b.port
+                }
+            }
+            return ascending ? result : !result
+        }
+    }
+
+    /// Rows on `ports`, then an inactive placeholder for each of them not listening
+    nonisolated private static func selectWithPlaceholders(_ table: PortTable, ports: Set<Int>) -> [PortInfo] {
+        var activePorts = Set<Int>()
+        var result = table.indices.compactMap { row -> PortInfo? in
+            let port = table.port(at: row)
+            guard ports.contains(port) else { return nil }
+            activePorts.insert(port)
+            return table[row]
+        }
+        for port in ports where !activePorts.contains(port) {
+            result.append(PortInfo.inactive(port: port))
+        }
+        return result
+    }
+}
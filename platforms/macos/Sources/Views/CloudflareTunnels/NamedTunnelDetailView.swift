@@ -17,6 +17,11 @@ struct NamedTunnelDetailView: View {
 
                 metaSection
 
+                if tunnel.status == .running, tunnel.metricsPort != nil {
+                    Divider()
+                    metricsSection
+                }
+
                 if !tunnel.ingressRules.isEmpty {
                     Divider()
                     ingressSection
@@ -38,6 +43,17 @@ struct NamedTunnelDetailView: View {
             }
             .padding()
         }
+        // Scrape this tunnel's metrics at the fast interval while it's on screen
+        .onAppear {
+            appState.namedTunnelManager.setMetricsVisible(true, for: tunnel.tunnelID)
+        }
+        .onDisappear {
+            appState.namedTunnelManager.setMetricsVisible(false, for: tunnel.tunnelID)
+        }
+        .onChange(of: tunnel.tunnelID) { oldID, newID in
+            appState.namedTunnelManager.setMetricsVisible(false, for: oldID)
+            appState.namedTunnelManager.setMetricsVisible(true, for: newID)
+        }
     }
 
     // MARK: - Header
@@ -211,6 +227,69 @@ struct NamedTunnelDetailView: View {
         }
     }
 
+    // MARK: - Metrics
+
+    private var metricsSection: some View {
+        VStack(alignment: .leading, spacing: 8) {
+            Text("Traffic")
+                .font(.headline)
+
+            if tunnel.metrics.hasSamples {
+                LazyVGrid(columns: [
+                    GridItem(.flexible(), alignment: .topLeading),
+                    GridItem(.flexible(), alignment: .topLeading),
+                    GridItem(.flexible(), alignment: .topLeading)
+                ], spacing: 12) {
+                    metricTile("Requests", series: tunnel.metrics.requestsPerSecond, color: .blue) {
+                        String(format: "%.1f/s", $0)
+                    }
+                    metricTile("Latency p95", series: tunnel.metrics.latencyP95, color: .orange) {
+                        String(format: "%.0f ms", $0)
+                    }
+                    metricTile("Active Streams", series: tunnel.metrics.activeStreams, color: .purple) {
+                        String(format: "%.0f", $0)
+                    }
+                    metricTile("In", series: tunnel.metrics.bytesInPerSecond, color: .green, format: Self.byteRate)
+                    metricTile("Out", series: tunnel.metrics.bytesOutPerSecond, color: .teal, format: Self.byteRate)
+                    metricTile("Errors", series: tunnel.metrics.errorsPerSecond, color: .red) {
+                        String(format: "%.1f/s", $0)
+                    }
+                }
+            } else {
+                Text("Collecting metrics…")
+                    .font(.caption)
+                    .foregroundStyle(.secondary)
+            }
+        }
+    }
+
+    private static func byteRate(_ value: Double) -> String {
+        ByteCountFormatter.string(fromByteCount: Int64(max(0, value)), countStyle: .binary) + "/s"
+    }
+
+    private func metricTile(
+        _ label: String,
+        series: MetricSeries,
+        color: Color,
+        format: (Double) -> String
+    ) -> some View {
+        VStack(alignment: .leading, spacing: 4) {
+            HStack {
+                Text(label)
+                    .font(.caption)
+                    .foregroundStyle(.secondary)
+                Spacer()
+                Text(format(series.latest ?? 0))
+                    .font(.caption.monospacedDigit())
+            }
+            Sparkline(values: series.values, color: color)
+                .frame(height: 28)
+        }
+        .padding(8)
+        .background(Color(nsColor: .textBackgroundColor))
+        .clipShape(RoundedRectangle(cornerRadius: 6))
+    }
+
     // MARK: - Ingress
 
     private var ingressSection: some View {
@@ -299,8 +378,8 @@ struct NamedTunnelDetailView: View {
                 Text("Logs")
                     .font(.headline)
                 Spacer()
-                if !tunnel.logs.isEmpty {
-                    Text("\(tunnel.logs.count) entries")
+                if !tunnel.logBuffer.isEmpty {
+                    Text("\(tunnel.logBuffer.count) entries")
                         .font(.caption.monospacedDigit())
                         .foregroundStyle(.secondary)
                     Button {
@@ -323,7 +402,7 @@ struct NamedTunnelDetailView: View {
             }
 
             if showLogs {
-                if tunnel.logs.isEmpty {
+                if tunnel.logBuffer.isEmpty {
                     Text(tunnel.status == .running ? "Waiting for output…" : "No logs yet. Run the tunnel to see live output.")
                         .font(.caption)
                         .foregroundStyle(.secondary)
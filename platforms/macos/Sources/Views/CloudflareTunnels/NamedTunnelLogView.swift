@@ -26,8 +26,8 @@ struct NamedTunnelLogView: View {
                 .padding(.vertical, 4)
             }
             .background(Color.black.opacity(0.85))
-            .onChange(of: tunnel.logs.count) { _, _ in
-                if let last = tunnel.logs.last {
+            .onChange(of: tunnel.logBuffer.last?.id) { _, _ in
+                if let last = tunnel.logBuffer.last {
                     withAnimation(.easeOut(duration: 0.15)) {
                         proxy.scrollTo(last.id, anchor: .bottom)
                     }
@@ -68,7 +68,7 @@ struct TunnelLogView: View {
                 ContentUnavailableView {
                     Label("No Logs", systemImage: "doc.text")
                 } description: {
-                    Text(tunnel.logs.isEmpty ? "Logs will appear here as requests come in" : "No logs match the current filter")
+                    Text(tunnel.logBuffer.isEmpty ? "Logs will appear here as requests come in" : "No logs match the current filter")
                 }
                 .frame(maxWidth: .infinity, maxHeight: .infinity)
             } else {
@@ -81,7 +81,7 @@ struct TunnelLogView: View {
                             }
                         }
                     }
-                    .onChange(of: tunnel.logs.count) { _, _ in
+                    .onChange(of: tunnel.logBuffer.last?.id) { _, _ in
                         if let last = filteredLogs.last {
                             proxy.scrollTo(last.id, anchor: .bottom)
                         }
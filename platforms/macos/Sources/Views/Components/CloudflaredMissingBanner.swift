@@ -128,7 +128,11 @@ struct CloudflaredMissingBanner: View {
         installError = nil
 
         Task {
-            let result = await ProcessExecutor.run(brewPath, arguments: ["install", "cloudflared"])
+            let result = await ProcessExecutor.run(
+                brewPath,
+                arguments: ["install", "cloudflared"],
+                timeout: AppConstants.packageInstallTimeout
+            )
             isInstalling = false
             guard let result else {
                 installError = "Failed to run brew"
@@ -0,0 +1,49 @@
+import SwiftUI
+
+/// A compact line chart of recent samples, scaled from zero to the largest value.
+/// Used for the live tunnel metrics, where only the trend matters.
+struct Sparkline: View {
+    let values: [Double]
+    var color: Color = .accentColor
+
+    var body: some View {
+        ZStack {
+            SparklineShape(values: values, isClosed: true)
+                .fill(color.opacity(0.15))
+            SparklineShape(values: values, isClosed: false)
+                .stroke(color, style: StrokeStyle(lineWidth: 1.5, lineJoin: .round))
+        }
+        .accessibilityHidden(true)
+    }
+}
+
+/// The line (or, closed, the area under it) through `values`, newest at the trailing edge.
+struct SparklineShape: Shape {
+    let values: [Double]
+    let isClosed: Bool
+
+    func path(in rect: CGRect) -> Path {
+        var path = Path()
+        guard values.count > 1 else { return path }
+
+        let peak = max(values.max() ?? 0, .leastNonzeroMagnitude)
+        let step = rect.width / CGFloat(values.count - 1)
+        let points = values.enumerated().map { index, value in
+            CGPoint(
+                x: rect.minX + CGFloat(index) * step,
+                y: rect.maxY - rect.height * CGFloat(max(0, value) / peak)
+            )
+        }
+
+        path.move(to: points[0])
+        for point in points.dropFirst() {
+            path.addLine(to: point)
+        }
+        if isClosed {
+            path.addLine(to: CGPoint(x: rect.maxX, y: rect.maxY))
+            path.addLine(to: CGPoint(x: rect.minX, y: rect.maxY))
+            path.closeSubpath()
+        }
+        return path
+    }
+}
@@ -26,7 +26,7 @@ enum KillConfirmationMode {
     /// No confirmation, kill immediately
     case immediate
     /// Show inline confirmation UI
-    case inline(confirmingKill: Binding<String?>)
+    case inline(confirmingKill: Binding<PortInfo.ID?>)
 }
 
 /// Unified port row view supporting multiple display styles
@@ -214,7 +214,7 @@ struct PortRowView: View {
     }
 
     @ViewBuilder
-    private func menuBarConfirmContent(confirmingKill: Binding<String?>) -> some View {
+    private func menuBarConfirmContent(confirmingKill: Binding<PortInfo.ID?>) -> some View {
         Text("Kill \(port.processName)?")
             .font(.callout)
             .lineLimit(1)
@@ -76,9 +76,7 @@ struct ProcessGroupListRow: View {
                         showConfirm = false
                         isKilling = true
                         Task {
-                            for port in group.ports {
-                                await appState.killPort(port)
-                            }
+                            await appState.killPorts(group.ports)
                         }
                     } label: {
                         Image(systemName: "checkmark.circle.fill")
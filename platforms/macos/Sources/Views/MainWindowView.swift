@@ -127,9 +127,9 @@ struct MainWindowView: View {
             // Port count
             Group {
                 if appState.filter.isActive || appState.selectedSidebarItem != .allPorts {
-                    Text("\(appState.filteredPorts.count) of \(appState.ports.count) ports")
+                    Text("\(appState.filteredPorts.count) of \(appState.portTable.count) ports")
                 } else {
-                    Text("\(appState.ports.count) ports listening")
+                    Text("\(appState.portTable.count) ports listening")
                 }
             }
             .font(.caption)
@@ -33,7 +33,7 @@ struct MenuBarActions: View {
 
             if confirmingKillAll {
                 HStack {
-                    Text("Kill all \(state.ports.count) processes?")
+                    Text("Kill all \(state.portTable.count) processes?")
                         .font(.callout)
                     Spacer()
                     Button("Kill") {
@@ -53,7 +53,7 @@ struct MenuBarActions: View {
                 MenuItemButton(title: "Kill All", icon: "xmark.circle", shortcut: "K", isDestructive: true) {
                     confirmingKillAll = true
                 }
-                .disabled(state.ports.isEmpty)
+                .disabled(state.portTable.isEmpty || state.isShowingCachedPorts)
             }
 
             Divider()
@@ -15,7 +15,7 @@ struct MenuBarPortList: View {
     let groupedByProcess: [ProcessGroup]
     let useTreeView: Bool
     @Binding var expandedProcesses: Set<String>
-    @Binding var confirmingKillPort: String?
+    @Binding var confirmingKillPort: PortInfo.ID?
     @Bindable var state: AppState
 
     /// Named tunnels worth showing in the menu bar: currently running + any with
@@ -8,7 +8,7 @@ import SwiftUI
 struct MenuBarPortRow: View {
     let port: PortInfo
     @Bindable var state: AppState
-    @Binding var confirmingKill: String?
+    @Binding var confirmingKill: PortInfo.ID?
 
     var body: some View {
         PortRowView(
@@ -14,94 +14,24 @@ struct MenuBarView: View {
     @Bindable var state: AppState
     @State private var searchText = ""
     @State private var confirmingKillAll = false
-    @State private var confirmingKillPort: String?
-    @State private var hoveredPort: String?
+    @State private var confirmingKillPort: PortInfo.ID?
+    @State private var hoveredPort: PortInfo.ID?
     @State private var expandedProcesses: Set<String> = []
     @Default(.useTreeView) private var useTreeView
     @Default(.hideSystemProcesses) private var hideSystemProcesses
 
-    // MARK: - Cached Data (Memory Optimization)
-    @State private var cachedFilteredPorts: [PortInfo] = []
-    @State private var cachedGroups: [ProcessGroup] = []
-    @State private var lastCacheKey: CacheKey?
+    // MARK: - Derived Data
 
-    /// Cache key to detect when recalculation is needed
-    private struct CacheKey: Equatable {
-        let portsCount: Int
-        let firstPortHash: Int
-        let searchText: String
-        let hideSystem: Bool
+    /// Memoized in AppState's `PortViewPipeline`, so reading it on every body pass is cheap
+    private var filteredPorts: [PortInfo] {
+        state.menuBarPorts(searchText: searchText, hideSystemProcesses: hideSystemProcesses)
     }
 
-    private var groupedByProcess: [ProcessGroup] { cachedGroups }
-
-    /// Updates all cached data only when inputs change
-    private func updateCachedData() {
-        let currentKey = CacheKey(
-            portsCount: state.ports.count,
-            firstPortHash: state.ports.first?.hashValue ?? 0,
-            searchText: searchText,
-            hideSystem: hideSystemProcesses
-        )
-
-        // Skip if nothing changed
-        guard currentKey != lastCacheKey else { return }
-        lastCacheKey = currentKey
-
-        // Compute filtered ports once
-        var filtered: [PortInfo]
-        if searchText.isEmpty {
-            filtered = state.ports
-        } else {
-            filtered = state.ports.filter {
-                String($0.port).contains(searchText) || $0.processName.localizedCaseInsensitiveContains(searchText)
-            }
-        }
-
-        if hideSystemProcesses {
-            filtered = filtered.filter { $0.processType != .system }
-        }
-
-        cachedFilteredPorts = filtered.sorted { a, b in
-            let aFav = state.isFavorite(a.port)
-            let bFav = state.isFavorite(b.port)
-            if aFav != bFav { return aFav }
-            return a.port < b.port
-        }
-
-        // Compute groups from cached filtered ports
-        let grouped = Dictionary(grouping: cachedFilteredPorts) { $0.processName }
-        cachedGroups = grouped.map { name, ports in
-            ProcessGroup(
-                id: name,
-                processName: name,
-                pids: Array(Set(ports.map(\.pid))).sorted(),
-                ports: ports.sorted { $0.port < $1.port }
-            )
-        }.sorted { a, b in
-            let aHasFavorite = a.ports.contains(where: { state.isFavorite($0.port) })
-            let aHasWatched = a.ports.contains(where: { state.isWatching($0.port) })
-            let bHasFavorite = b.ports.contains(where: { state.isFavorite($0.port) })
-            let bHasWatched = b.ports.contains(where: { state.isWatching($0.port) })
-
-            let aPriority = aHasFavorite ? 2 : (aHasWatched ? 1 : 0)
-            let bPriority = bHasFavorite ? 2 : (bHasWatched ? 1 : 0)
-
-            if aPriority != bPriority {
-                return aPriority > bPriority
-            } else {
-                return a.processName.localizedCaseInsensitiveCompare(b.processName) == .orderedAscending
-            }
-        }
-
-        // Keep expansion state bounded to currently visible process IDs.
-        let visibleProcessIDs = Set(cachedGroups.map(\.id))
-        expandedProcesses = expandedProcesses.intersection(visibleProcessIDs)
+    /// Memoized like `filteredPorts`
+    private var groupedByProcess: [ProcessGroup] {
+        state.menuBarProcessGroups(searchText: searchText, hideSystemProcesses: hideSystemProcesses)
     }
 
-    /// Cached filtered ports (no allocation on access)
-    private var filteredPorts: [PortInfo] { cachedFilteredPorts }
-
     /// Filters port-forward connections based on search text
     private var filteredPortForwardConnections: [PortForwardConnectionState] {
         let connections = state.portForwardManager.connections
@@ -141,11 +71,11 @@ struct MenuBarView: View {
         }
         .frame(width: 340)
         .onAppear {
-            updateCachedData()
             state.namedTunnelManager.discoverIfNeeded()
         }
-        .onChange(of: state.ports) { _, _ in updateCachedData() }
-        .onChange(of: searchText) { _, _ in updateCachedData() }
-        .onChange(of: hideSystemProcesses) { _, _ in updateCachedData() }
+        .onChange(of: groupedByProcess.map(\.id)) { _, ids in
+            // Keep expansion state bounded to currently visible process IDs.
+            expandedProcesses.formIntersection(ids)
+        }
     }
 }
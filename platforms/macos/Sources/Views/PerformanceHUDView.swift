@@ -0,0 +1,132 @@
+/// PerformanceHUDView - Hidden debug panel with live timing of the scan pipeline
+///
+/// Shows p50/p99/max per `PerformancePhase`, the auto-refresh interval currently in
+/// effect, `ProcessExecutor` spawn counters and resident memory over time. Samples once
+/// a second, only while the window is open.
+///
+/// - Note: Reachable from the Window menu once enabled with
+///   `defaults write com.portkiller.app showPerformanceHUD -bool true`.
+
+import SwiftUI
+
+struct PerformanceHUDView: View {
+    /// Memory samples kept for the sparkline (two minutes at one per second)
+    private static let memoryHistoryLength = 120
+
+    @State private var summaries: [PerformancePhaseSummary] = []
+    @State private var refreshInterval: Duration?
+    @State private var executor = ProcessExecutorStatistics()
+    @State private var memory = MetricSeries(capacity: PerformanceHUDView.memoryHistoryLength)
+
+    var body: some View {
+        VStack(alignment: .leading, spacing: 16) {
+            phaseTable
+            Divider()
+            gauges
+        }
+        .padding(16)
+        .frame(minWidth: 460, minHeight: 420, alignment: .topLeading)
+        .task {
+            while !Task.isCancelled {
+                sample()
+                try? await Task.sleep(for: .seconds(1))
+            }
+        }
+    }
+
+    // MARK: - Phases
+
+    private var phaseTable: some View {
+        VStack(alignment: .leading, spacing: 8) {
+            HStack {
+                Text("Phases")
+                    .font(.headline)
+                Spacer()
+                Button("Reset") {
+                    PerformanceMonitor.shared.reset()
+                    sample()
+                }
+                .controlSize(.small)
+            }
+
+            if summaries.isEmpty {
+                Text("Nothing measured yet")
+                    .font(.caption)
+                    .foregroundStyle(.secondary)
+            } else {
+                Grid(alignment: .trailing, horizontalSpacing: 16, verticalSpacing: 4) {
+                    GridRow {
+                        Text("Phase").gridColumnAlignment(.leading)
+                        Text("Count")
+                        Text("p50")
+                        Text("p99")
+                        Text("Max")
+                    }
+                    .font(.caption.weight(.semibold))
+                    .foregroundStyle(.secondary)
+
+                    ForEach(summaries) { summary in
+                        GridRow {
+                            Text(summary.phase.title)
+                            Text("\(summary.count)")
+                            Text(Self.format(summary.p50))
+                            Text(Self.format(summary.p99))
+                            Text(Self.format(summary.maximum))
+                        }
+                        .font(.caption.monospacedDigit())
+                    }
+                }
+            }
+        }
+    }
+
+    // MARK: - Gauges
+
+    private var gauges: some View {
+        VStack(alignment: .leading, spacing: 8) {
+            LabeledContent("Refresh interval") {
+                Text(refreshInterval.map(Self.format) ?? "—")
+            }
+            LabeledContent("Processes spawned") {
+                Text("\(executor.spawns) (\(executor.timeouts) timed out, \(executor.launchFailures) failed)")
+            }
+            LabeledContent("Spawn time avg / max") {
+                Text("\(Self.format(executor.averageSpawnTime)) / \(Self.format(executor.maxSpawnTime))")
+            }
+            LabeledContent("Executor output read") {
+                Text(Self.bytes(Double(executor.bytesRead)))
+            }
+            LabeledContent("Resident memory") {
+                Text(memory.latest.map(Self.bytes) ?? "—")
+            }
+            Sparkline(values: memory.values, color: .purple)
+                .frame(height: 40)
+        }
+        .font(.caption.monospacedDigit())
+    }
+
+    // MARK: - Sampling
+
+    private func sample() {
+        let monitor = PerformanceMonitor.shared
+        summaries = monitor.summaries()
+        refreshInterval = monitor.effectiveRefreshInterval
+        executor = ProcessExecutor.statistics
+        if let resident = PerformanceMonitor.residentMemoryBytes() {
+            memory.append(Double(resident))
+        }
+    }
+
+    private static func format(_ duration: Duration) -> String {
+        let seconds = duration / .seconds(1)
+        switch seconds {
+        case ..<0.001: return String(format: "%.0f µs", seconds * 1_000_000)
+        case ..<1: return String(format: "%.1f ms", seconds * 1_000)
+        default: return String(format: "%.2f s", seconds)
+        }
+    }
+
+    private static func bytes(_ value: Double) -> String {
+        ByteCountFormatter.string(fromByteCount: Int64(max(0, value)), countStyle: .memory)
+    }
+}
@@ -23,6 +23,11 @@ struct PortDetailView: View {
                 // Notes
                 notesSection
 
+                Divider()
+
+                // Port history timeline
+                PortHistoryView(port: port.port)
+
                 // Tunnel exposures (only shown when ≥1 named tunnel maps to this port)
                 if !exposures.isEmpty {
                     Divider()
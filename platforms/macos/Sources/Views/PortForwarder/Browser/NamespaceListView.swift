@@ -18,6 +18,10 @@ struct NamespaceListView: View {
                     .font(.caption)
                     .foregroundStyle(.secondary)
                 Spacer()
+                if state == .loading && !namespaces.isEmpty {
+                    ProgressView()
+                        .controlSize(.mini)
+                }
                 Button {
                     showingAddSheet = true
                 } label: {
@@ -43,7 +47,7 @@ struct NamespaceListView: View {
 
             Group {
                 switch state {
-                case .loading:
+                case .loading where namespaces.isEmpty:
                     VStack {
                         Spacer()
                         ProgressView()
@@ -81,7 +85,8 @@ struct NamespaceListView: View {
                         Spacer()
                     }
 
-                case .idle, .loaded:
+                case .idle, .loaded, .loading:
+                    // Namespaces stream in while loading
                     if namespaces.isEmpty && state == .loaded {
                         VStack {
                             Spacer()
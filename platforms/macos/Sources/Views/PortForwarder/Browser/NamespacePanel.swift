@@ -17,6 +17,10 @@ struct NamespacePanel: View {
                 Text("Namespaces")
                     .font(.headline)
                 Spacer()
+                if state == .loading && !namespaces.isEmpty {
+                    ProgressView()
+                        .controlSize(.small)
+                }
                 Button {
                     showingAddSheet = true
                 } label: {
@@ -37,7 +41,7 @@ struct NamespacePanel: View {
 
             Divider()
 
-            if state == .loading {
+            if state == .loading && namespaces.isEmpty {
                 VStack {
                     Spacer()
                     ProgressView()
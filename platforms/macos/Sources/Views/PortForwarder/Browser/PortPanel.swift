@@ -41,7 +41,7 @@ struct PortPanel: View {
                         if selectedPort != nil {
                             Divider()
 
-                            Toggle("Enable Proxy (socat)", isOn: $proxyEnabled)
+                            Toggle("Enable Proxy", isOn: $proxyEnabled)
 
                             let localPort = discoveryManager.suggestLocalPort(for: selectedPort?.port ?? 0)
                             let proxyPort = discoveryManager.suggestProxyPort(for: localPort)
@@ -83,7 +83,7 @@ struct ServiceDetailView: View {
                                     .font(.system(.caption, design: .monospaced, weight: .medium))
                             }
 
-                            Toggle("Enable Proxy (socat)", isOn: $proxyEnabled)
+                            Toggle("Enable Proxy", isOn: $proxyEnabled)
                                 .toggleStyle(.checkbox)
 
                             if proxyEnabled {
@@ -13,6 +13,10 @@ struct ServiceListView: View {
                     .font(.caption)
                     .foregroundStyle(.secondary)
                 Spacer()
+                if state == .loading && !services.isEmpty {
+                    ProgressView()
+                        .controlSize(.mini)
+                }
                 if !services.isEmpty {
                     Text("\(services.count)")
                         .font(.caption)
@@ -26,7 +30,7 @@ struct ServiceListView: View {
 
             Group {
                 switch state {
-                case .loading:
+                case .loading where services.isEmpty:
                     VStack {
                         Spacer()
                         ProgressView()
@@ -61,7 +65,8 @@ struct ServiceListView: View {
                         Spacer()
                     }
 
-                case .loaded:
+                case .loaded, .loading:
+                    // Services stream in while loading
                     if services.isEmpty {
                         VStack {
                             Spacer()
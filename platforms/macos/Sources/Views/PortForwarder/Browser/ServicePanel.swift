@@ -12,6 +12,10 @@ struct ServicePanel: View {
                 Text("Services")
                     .font(.headline)
                 Spacer()
+                if state == .loading && !services.isEmpty {
+                    ProgressView()
+                        .controlSize(.small)
+                }
                 Text("\(services.count)")
                     .foregroundStyle(.secondary)
             }
@@ -19,7 +23,7 @@ struct ServicePanel: View {
 
             Divider()
 
-            if state == .loading {
+            if state == .loading && services.isEmpty {
                 VStack {
                     Spacer()
                     ProgressView()
@@ -144,7 +144,7 @@ struct ConnectionEditSection: View {
         isLoadingNamespaces = true
         Task {
             do {
-                let fetchedNamespaces = try await appState.portForwardManager.processManager.fetchNamespaces()
+                let fetchedNamespaces = try await appState.portForwardManager.discoveryCache.namespaces()
                 await MainActor.run {
                     // Merge with manual namespaces
                     let customNamespaceNames = Defaults[.customNamespaces]
@@ -180,7 +180,7 @@ struct ConnectionEditSection: View {
         services = []
         Task {
             do {
-                let result = try await appState.portForwardManager.processManager.fetchServices(namespace: ns)
+                let result = try await appState.portForwardManager.discoveryCache.services(in: ns)
                 await MainActor.run {
                     services = result
                     isLoadingServices = false
@@ -9,6 +9,32 @@ struct ConnectionLogsSection: View {
         return df
     }()
 
+    private static func relaySummary(_ stats: TCPRelay.Statistics) -> String {
+        let sent = ByteCountFormatter.string(fromByteCount: Int64(stats.totalBytesSent), countStyle: .binary)
+        let received = ByteCountFormatter.string(fromByteCount: Int64(stats.totalBytesReceived), countStyle: .binary)
+        var summary = "\(stats.active.count) client\(stats.active.count == 1 ? "" : "s") · ↑\(sent) ↓\(received)"
+        if let latency = stats.active.last?.connectLatency {
+            let millis = Double(latency.components.attoseconds) / 1e15 + Double(latency.components.seconds) * 1000
+            summary += String(format: " · %.1f ms", millis)
+        }
+        return summary
+    }
+
+    private static func seconds(_ duration: Duration) -> String {
+        let value = Double(duration.components.seconds) + Double(duration.components.attoseconds) / 1e18
+        return String(format: "%.2fs", value)
+    }
+
+    private static func startupSummary(_ timing: PortForwardStartupTiming) -> String {
+        [
+            timing.spawn.map { "spawn \(seconds($0))" },
+            timing.ready.map { "ready \(seconds($0))" },
+            timing.proxyReady.map { "proxy \(seconds($0))" }
+        ]
+        .compactMap { $0 }
+        .joined(separator: " · ")
+    }
+
     var body: some View {
         VStack(spacing: 0) {
             // Logs header
@@ -16,15 +42,29 @@ struct ConnectionLogsSection: View {
                 Text("Logs")
                     .font(.headline)
 
-                if !connection.logs.isEmpty {
-                    Text("(\(connection.logs.count))")
+                if !connection.logBuffer.isEmpty {
+                    Text("(\(connection.logBuffer.count))")
                         .font(.caption)
                         .foregroundStyle(.tertiary)
                 }
 
                 Spacer()
 
-                if !connection.logs.isEmpty {
+                if !connection.startupTiming.isEmpty {
+                    Label(Self.startupSummary(connection.startupTiming), systemImage: "timer")
+                        .font(.caption)
+                        .foregroundStyle(.secondary)
+                        .help("Startup time since the start request: child spawned, kubectl forwarding, proxy listening")
+                }
+
+                if let stats = connection.relayStats {
+                    Text(Self.relaySummary(stats))
+                        .font(.caption)
+                        .foregroundStyle(.secondary)
+                        .help("Proxy clients and bytes relayed (sent / received)")
+                }
+
+                if !connection.logBuffer.isEmpty {
                     Button {
                         ClipboardService.copyLogsAsMarkdown(connection.logs, connectionName: connection.config.name)
                     } label: {
@@ -47,7 +87,7 @@ struct ConnectionLogsSection: View {
 
             Divider()
 
-            if connection.logs.isEmpty {
+            if connection.logBuffer.isEmpty {
                 VStack(spacing: 8) {
                     Spacer()
                     Image(systemName: "text.alignleft")
@@ -68,7 +108,7 @@ struct ConnectionLogsSection: View {
                                         .font(.system(.caption, design: .monospaced))
                                         .foregroundStyle(.tertiary)
 
-                                    Text(log.type == .portForward ? "kubectl" : "socat")
+                                    Text(log.type == .portForward ? "kubectl" : "proxy")
                                         .font(.system(.caption, design: .monospaced))
                                         .foregroundStyle(log.type == .portForward ? .blue : .purple)
                                         .frame(width: 50, alignment: .leading)
@@ -85,8 +125,8 @@ struct ConnectionLogsSection: View {
                         .frame(maxWidth: .infinity, alignment: .leading)
                         .padding(12)
                     }
-                    .onChange(of: connection.logs.count) {
-                        if let lastLog = connection.logs.last {
+                    .onChange(of: connection.logBuffer.last?.id) {
+                        if let lastLog = connection.logBuffer.last {
                             withAnimation {
                                 proxy.scrollTo(lastLog.id, anchor: .bottom)
                             }
@@ -37,7 +37,7 @@ struct ConnectionsTab: View {
                     .help("Add Connection")
 
                     Button {
-                        let dm = KubernetesDiscoveryManager(processManager: appState.portForwardManager.processManager)
+                        let dm = KubernetesDiscoveryManager(cache: appState.portForwardManager.discoveryCache)
                         Task { await dm.loadNamespaces() }
                         discoveryManager = dm
                     } label: {
@@ -28,7 +28,7 @@ struct ServiceBrowserTab: View {
                         .frame(maxWidth: 400)
 
                     Button("Start Browsing") {
-                        let dm = KubernetesDiscoveryManager(processManager: appState.portForwardManager.processManager)
+                        let dm = KubernetesDiscoveryManager(cache: appState.portForwardManager.discoveryCache)
                         Task { await dm.loadNamespaces() }
                         discoveryManager = dm
                     }
@@ -64,7 +64,7 @@ struct ServiceBrowserEmbedded: View {
                         Task { await discoveryManager.selectNamespace(namespace) }
                     },
                     onRefresh: {
-                        Task { await discoveryManager.loadNamespaces() }
+                        Task { await discoveryManager.loadNamespaces(revalidate: true) }
                     },
                     onAddCustom: { namespaceNames in
                         discoveryManager.addCustomNamespaces(namespaceNames)
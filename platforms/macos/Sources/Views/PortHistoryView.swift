@@ -0,0 +1,90 @@
+import SwiftUI
+
+/// Today's opens and closes of one port, from the persistent port history.
+///
+/// Reloaded whenever the port list changes, so a listener that just restarted
+/// shows up without reopening the detail view.
+struct PortHistoryView: View {
+    let port: Int
+    @Environment(AppState.self) private var appState
+    @State private var events: [PortHistoryEvent] = []
+
+    /// Most recent events shown; the timeline of a flapping dev server can be long
+    private static let maxEvents = 50
+
+    var body: some View {
+        VStack(alignment: .leading, spacing: 8) {
+            HStack {
+                Text("History Today")
+                    .font(.headline)
+                Spacer()
+                if events.count > Self.maxEvents {
+                    Text("Last \(Self.maxEvents) of \(events.count)")
+                        .font(.caption)
+                        .foregroundStyle(.secondary)
+                }
+            }
+
+            if events.isEmpty {
+                Text("Nothing recorded on port \(String(port)) today")
+                    .font(.callout)
+                    .foregroundStyle(.tertiary)
+            } else {
+                VStack(alignment: .leading, spacing: 4) {
+                    ForEach(events.suffix(Self.maxEvents).reversed()) { event in
+                        row(event)
+                    }
+                }
+            }
+        }
+        .task(id: HistoryReload(port: port, generation: appState.portTable.generation)) {
+            let now = Date()
+            events = await appState.portHistory.events(
+                port: port,
+                in: Calendar.current.startOfDay(for: now)...now
+            )
+        }
+    }
+
+    private func row(_ event: PortHistoryEvent) -> some View {
+        HStack(spacing: 8) {
+            Image(systemName: symbol(for: event.kind))
+                .foregroundStyle(event.kind == .closed ? Color.secondary : Color.green)
+                .frame(width: 16)
+            Text(event.timestamp, format: .dateTime.hour().minute().second())
+                .font(.system(.callout, design: .monospaced))
+                .foregroundStyle(.secondary)
+            Text(event.processName)
+                .lineLimit(1)
+            Text("PID \(String(event.pid))")
+                .font(.caption)
+                .foregroundStyle(.secondary)
+            Spacer()
+            Text(label(for: event.kind))
+                .font(.caption)
+                .foregroundStyle(.secondary)
+        }
+    }
+
+    private func symbol(for kind: PortHistoryEvent.Kind) -> String {
+        switch kind {
+        case .opened: "arrow.up.circle.fill"
+        case .closed: "xmark.circle"
+        case .running: "circle.fill"
+        }
+    }
+
+    private func label(for kind: PortHistoryEvent.Kind) -> String {
+        switch kind {
+        case .opened: "Opened"
+        case .closed: "Closed"
+        case .running: "Listening"
+        }
+    }
+}
+
+/// Reload key of `PortHistoryView`: the port, and the port list generation
+private struct HistoryReload: Equatable {
+    let port: Int
+    let generation: UInt64
+}
@@ -51,7 +51,7 @@ struct PortTableView: View {
                 .help(useTreeView ? "Switch to List View" : "Switch to Tree View")
             }
         }
-        .onChange(of: appState.ports) { _, _ in
+        .onChange(of: appState.portTable.generation) { _, _ in
             let visibleProcessIDs = Set(groupedPorts.map(\.id))
             expandedProcesses = expandedProcesses.intersection(visibleProcessIDs)
         }
@@ -206,54 +206,11 @@ struct PortTableView: View {
 
     /// Groups ports by process for tree view
     private var groupedPorts: [ProcessGroup] {
-        let grouped = Dictionary(grouping: appState.filteredPorts) { $0.processName }
-        return grouped.map { name, ports in
-            ProcessGroup(
-                id: name,
-                processName: name,
-                pids: Array(Set(ports.map(\.pid))).sorted(),
-                ports: ports.sorted { $0.port < $1.port }
-            )
-        }.sorted { $0.processName.localizedCaseInsensitiveCompare($1.processName) == .orderedAscending }
+        appState.filteredProcessGroups
     }
 
     /// Sorts ports based on current sort order
     private var sortedPorts: [PortInfo] {
-        let ports = appState.filteredPorts
-        return ports.sorted { a, b in
-            let result: Bool
-            switch sortOrder {
-            case .port:
-                result = a.port < b.port
-            case .process:
-                result = a.processName.localizedCaseInsensitiveCompare(b.processName) == .orderedAscending
-            case .pid:
-                result = a.pid < b.pid
-            case .type:
-                result = a.processType.rawValue < b.processType.rawValue
-            case .address:
-                result = a.address.localizedCaseInsensitiveCompare(b.address) == .orderedAscending
-            case .user:
-                result = a.user.localizedCaseInsensitiveCompare(b.user) == .orderedAscending
-            case .actions:
-                // Sort by favorite/watched status
-                let aIsFavorite = appState.isFavorite(a.port)
-                let aIsWatching = appState.isWatching(a.port)
-                let bIsFavorite = appState.isFavorite(b.port)
-                let bIsWatching = appState.isWatching(b.port)
-
-                // Priority: Favorite > Watching > Neither
-                let aPriority = aIsFavorite ? 2 : (aIsWatching ? 1 : 0)
-                let bPriority = bIsFavorite ? 2 : (bIsWatching ? 1 : 0)
-
-                if aPriority != bPriority {
-                    result = aPriority > bPriority
-                } else {
-                    // Same priority, sort by port number
-                    result = a.port < b.port
-                }
-            }
-            return sortAscending ? result : !result
-        }
+        appState.sortedFilteredPorts(by: sortOrder, ascending: sortAscending)
     }
 }
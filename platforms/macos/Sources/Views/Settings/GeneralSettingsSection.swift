@@ -2,6 +2,11 @@
 ///
 /// Displays general settings including:
 /// - Launch at login toggle
+/// - Port scanner backend (native libproc or lsof)
+/// - Event-driven refresh toggle
+/// - Background scanner launch agent toggle
+/// - Log history kept per tunnel / port-forward connection
+/// - Disk space kept for the port history timeline
 ///
 /// - Note: Uses LaunchAtLogin package for login item management.
 
@@ -12,6 +17,14 @@ import Defaults
 struct GeneralSettingsSection: View {
     @Default(.hideSystemProcesses) private var hideSystemProcesses
     @Default(.skipKillConfirmation) private var skipKillConfirmation
+    @Default(.portScanBackend) private var portScanBackend
+    @Default(.eventDrivenRefresh) private var eventDrivenRefresh
+    @Default(.logLinesPerConnection) private var logLinesPerConnection
+    @Default(.portHistoryLimitMB) private var portHistoryLimitMB
+    @State private var backgroundScanner = BackgroundScannerService.shared
+
+    private static let logHistoryOptions = [100, 500, 2000, 5000]
+    private static let portHistoryOptions = [16, 64, 256, 1024]
 
     var body: some View {
         SettingsGroup("General", icon: "gearshape.fill") {
@@ -41,6 +54,98 @@ struct GeneralSettingsSection: View {
                 subtitle: "Kill processes immediately without confirmation prompt",
                 isOn: $skipKillConfirmation
             )
+
+            SettingsDivider()
+
+            SettingsRowContainer {
+                HStack {
+                    VStack(alignment: .leading, spacing: 2) {
+                        Text("Port scanner")
+                            .fontWeight(.medium)
+                        Text("Native reads sockets from the kernel; lsof is the fallback")
+                            .font(.caption)
+                            .foregroundStyle(.secondary)
+                    }
+
+                    Spacer()
+
+                    Picker("", selection: $portScanBackend) {
+                        ForEach(PortScanBackend.allCases, id: \.self) { backend in
+                            Text(backend.displayName).tag(backend)
+                        }
+                    }
+                    .labelsHidden()
+                    .pickerStyle(.segmented)
+                    .frame(width: 160)
+                }
+            }
+
+            SettingsDivider()
+
+            SettingsToggleRow(
+                title: "Instant change detection",
+                subtitle: "Rescan as soon as a listening process exits or restarts",
+                isOn: $eventDrivenRefresh
+            )
+
+            SettingsDivider()
+
+            SettingsToggleRow(
+                title: "Background scanner",
+                subtitle: "Keep one scan running for the menu bar, main window and portkiller-cli",
+                isOn: Binding(
+                    get: { backgroundScanner.isEnabled },
+                    set: { backgroundScanner.setEnabled($0) }
+                )
+            )
+
+            SettingsDivider()
+
+            SettingsRowContainer {
+                HStack {
+                    VStack(alignment: .leading, spacing: 2) {
+                        Text("Log history")
+                            .fontWeight(.medium)
+                        Text("Lines kept per tunnel and port-forward connection")
+                            .font(.caption)
+                            .foregroundStyle(.secondary)
+                    }
+
+                    Spacer()
+
+                    Picker("", selection: $logLinesPerConnection) {
+                        ForEach(Self.logHistoryOptions, id: \.self) { lines in
+                            Text("\(lines) lines").tag(lines)
+                        }
+                    }
+                    .labelsHidden()
+                    .frame(width: 120)
+                }
+            }
+
+            SettingsDivider()
+
+            SettingsRowContainer {
+                HStack {
+                    VStack(alignment: .leading, spacing: 2) {
+                        Text("Port history")
+                            .fontWeight(.medium)
+                        Text("Disk space for the timeline of ports opening and closing")
+                            .font(.caption)
+                            .foregroundStyle(.secondary)
+                    }
+
+                    Spacer()
+
+                    Picker("", selection: $portHistoryLimitMB) {
+                        ForEach(Self.portHistoryOptions, id: \.self) { megabytes in
+                            Text(megabytes < 1024 ? "\(megabytes) MB" : "\(megabytes / 1024) GB").tag(megabytes)
+                        }
+                    }
+                    .labelsHidden()
+                    .frame(width: 120)
+                }
+            }
         }
     }
 }
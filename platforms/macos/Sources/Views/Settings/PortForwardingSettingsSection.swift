@@ -4,12 +4,16 @@
 /// - kubectl path and custom path input
 /// - socat path and custom path input
 /// - Auto-start toggle
+/// - socat proxy fallback toggle
+/// - Start All concurrency
 
 import SwiftUI
 import Defaults
 
 struct PortForwardingSettingsSection: View {
     @AppStorage("portForwardAutoStart") private var autoStart = false
+    @Default(.portForwardUseSocatProxy) private var useSocatProxy
+    @Default(.portForwardStartConcurrency) private var startConcurrency
 
     var body: some View {
         SettingsGroup("Port Forwarding", icon: "point.3.connected.trianglepath.dotted") {
@@ -23,6 +27,32 @@ struct PortForwardingSettingsSection: View {
 
                 SettingsDivider()
 
+                SettingsToggleRow(
+                    title: "Use socat for proxies",
+                    subtitle: "Run each proxy as a socat process instead of the built-in relay",
+                    isOn: $useSocatProxy
+                )
+
+                SettingsDivider()
+
+                // Start All concurrency
+                SettingsRowContainer {
+                    HStack {
+                        VStack(alignment: .leading, spacing: 2) {
+                            Text("Parallel starts")
+                                .fontWeight(.medium)
+                            Text("Connections Start All brings up at the same time")
+                                .font(.caption)
+                                .foregroundStyle(.secondary)
+                        }
+                        Spacer()
+                        Stepper("\(startConcurrency)", value: $startConcurrency, in: 1...16)
+                            .monospacedDigit()
+                    }
+                }
+
+                SettingsDivider()
+
                 // kubectl dependency
                 DependencySettingsRow(
                     name: "kubectl",
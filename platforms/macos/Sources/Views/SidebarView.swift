@@ -11,7 +11,7 @@ struct SidebarView: View {
 
         List(selection: $state.selectedSidebarItem) {
             Section("Categories") {
-                sidebarRow(.allPorts, count: appState.ports.count)
+                sidebarRow(.allPorts, count: appState.portTable.count)
 
                 // Favorites row with add button
                 favoritesRow
@@ -245,6 +245,6 @@ struct SidebarView: View {
     }
 
     private func countForType(_ type: ProcessType) -> Int {
-        appState.ports.filter { $0.processType == type }.count
+        appState.portTable.count(of: type)
     }
 }
@@ -0,0 +1,82 @@
+import Foundation
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for AutoKillManager's rule timers.
+ *
+ * These tests inject the rules and shorten a timeout minute to a few
+ * milliseconds, then verify that a matching port is killed once its rule's
+ * timeout elapses, and that a port that closes first is never killed.
+ */
+@MainActor
+struct AutoKillManagerTests {
+
+    // MARK: - Test Fixtures
+
+    final class RecordingNotificationService: NotificationServiceProtocol {
+        private(set) var titles: [String] = []
+
+        func setup() {}
+        func notify(title: String, body: String) { titles.append(title) }
+        func requestPermission() async -> Bool { false }
+    }
+
+    /// Real length of a rule's timeout minute in these tests
+    let minute = Duration.milliseconds(20)
+
+    func makeManager(
+        _ rules: [AutoKillRule],
+        notifications: RecordingNotificationService = RecordingNotificationService()
+    ) -> AutoKillManager {
+        AutoKillManager(notificationService: notifications, rules: { rules }, minute: minute)
+    }
+
+    /// Waits until `condition` holds, or `timeout` passes
+    func wait(for timeout: Duration = .seconds(2), until condition: () -> Bool) async {
+        let deadline = ContinuousClock.now + timeout
+        while !condition(), ContinuousClock.now < deadline {
+            try? await Task.sleep(for: .milliseconds(5))
+        }
+    }
+
+    // MARK: - Timer Tests
+
+    @Test func killsAfterRuleTimeout() async {
+        let notifications = RecordingNotificationService()
+        let manager = makeManager([AutoKillRule(name: "Dev", processPattern: "node", timeoutMinutes: 2)], notifications: notifications)
+        let start = ContinuousClock.now
+        var killed: [Int] = []
+
+        manager.check(ports: [createPort(port: 3000), createPort(port: 5432, processName: "postgres")]) {
+            killed.append($0.port)
+        }
+        #expect(killed.isEmpty)
+
+        await wait { !killed.isEmpty }
+        #expect(killed == [3000])
+        #expect(ContinuousClock.now - start >= minute * 2)
+        #expect(notifications.titles == ["Auto-Kill: node"])
+    }
+
+    @Test func closedPortIsNotKilled() async {
+        let manager = makeManager([AutoKillRule(processPattern: "node", timeoutMinutes: 2, notifyBeforeKill: false)])
+        var killed: [Int] = []
+
+        manager.check(ports: [createPort(port: 3000)]) { killed.append($0.port) }
+        manager.check(ports: []) { killed.append($0.port) }
+
+        try? await Task.sleep(for: minute * 6)
+        #expect(killed.isEmpty)
+    }
+
+    @Test func disabledRulesNeverFire() async {
+        let manager = makeManager([AutoKillRule(processPattern: "node", timeoutMinutes: 1, isEnabled: false)])
+        var killed: [Int] = []
+
+        manager.check(ports: [createPort(port: 3000)]) { killed.append($0.port) }
+
+        try? await Task.sleep(for: minute * 4)
+        #expect(killed.isEmpty)
+    }
+}
@@ -0,0 +1,75 @@
+import Foundation
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for ChildProcessSupervisor exit tracking.
+ *
+ * These tests spawn real children and verify that exits are reported with
+ * their status or signal, that every handler for a child is called, and
+ * that children already gone when registered are still reported.
+ */
+struct ChildProcessSupervisorTests {
+
+    // MARK: - Test Fixtures
+
+    let supervisor = ChildProcessSupervisor()
+
+    func spawn(_ script: String) throws -> Process {
+        let process = Process()
+        process.executableURL = URL(fileURLWithPath: "/bin/sh")
+        process.arguments = ["-c", script]
+        try process.run()
+        return process
+    }
+
+    // MARK: - Exit Tests
+
+    @Test func reportsExitStatus() async throws {
+        let process = try spawn("sleep 0.2; exit 3")
+
+        let exit = await supervisor.exit(of: process)
+
+        #expect(exit.pid == process.processIdentifier)
+        #expect(exit.status == 3)
+        #expect(!exit.wasSignaled)
+        #expect(!exit.isSuccess)
+    }
+
+    @Test func reportsTerminatingSignal() async throws {
+        let process = try spawn("exec sleep 30")
+        async let exit = supervisor.exit(of: process)
+        try await Task.sleep(for: .milliseconds(100))
+
+        process.terminate()
+
+        #expect(await exit == ChildExit(pid: process.processIdentifier, status: SIGTERM, wasSignaled: true))
+    }
+
+    @Test func callsEveryHandler() async throws {
+        let process = try spawn("sleep 0.2")
+
+        async let first = supervisor.exit(of: process)
+        async let second = supervisor.exit(of: process)
+
+        #expect(await first.isSuccess)
+        #expect(await second.isSuccess)
+    }
+
+    @Test func reportsChildrenThatAlreadyExited() async throws {
+        let process = try spawn("exit 7")
+        process.waitUntilExit()
+
+        let exit = await supervisor.exit(of: process)
+
+        #expect(exit.status == 7)
+    }
+
+    // MARK: - Status Decoding Tests
+
+    @Test func decodesWaitStatus() {
+        #expect(ChildExit(pid: 1, waitStatus: 0).isSuccess)
+        #expect(ChildExit(pid: 1, waitStatus: 2 << 8) == ChildExit(pid: 1, status: 2, wasSignaled: false))
+        #expect(ChildExit(pid: 1, waitStatus: SIGKILL) == ChildExit(pid: 1, status: SIGKILL, wasSignaled: true))
+    }
+}
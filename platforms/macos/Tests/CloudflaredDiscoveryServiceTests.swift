@@ -1,3 +1,4 @@
+import Foundation
 import Testing
 @testable import PortKiller
 
@@ -93,4 +94,37 @@ struct CloudflaredDiscoveryServiceTests {
 
         #expect(service.parseConfigYAML(config) == nil)
     }
+
+    // MARK: - Incremental Discovery
+
+    func makeConfigDirectory() throws -> URL {
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("cloudflared-\(UUID().uuidString)", isDirectory: true)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        return directory
+    }
+
+    @Test("Picks up added, changed and removed local files")
+    func rereadsChangedLocalFiles() async throws {
+        let directory = try makeConfigDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let service = CloudflaredDiscoveryService(configDirectory: directory)
+        let id = "7c48df31-7c1f-4f87-a17d-a1a7f0622b9d"
+        let credentials = directory.appendingPathComponent("\(id).json")
+        let config = directory.appendingPathComponent("config.yml")
+
+        #expect(await service.discover(cloudflaredPath: nil).isEmpty)
+
+        try Data("{\"TunnelID\": \"\(id)\"}".utf8).write(to: credentials)
+        try "tunnel: \(id)\ningress:\n  - service: http://localhost:3000\n".write(to: config, atomically: true, encoding: .utf8)
+        let first = await service.discover(cloudflaredPath: nil)
+        #expect(first.map(\.tunnelID) == [id])
+        #expect(first.first?.localIngress.first?.localPort == 3000)
+
+        try "tunnel: \(id)\ningress:\n  - service: http://localhost:40000\n".write(to: config, atomically: true, encoding: .utf8)
+        #expect(await service.discover(cloudflaredPath: nil).first?.localIngress.first?.localPort == 40000)
+
+        try FileManager.default.removeItem(at: credentials)
+        #expect(await service.discover(cloudflaredPath: nil).isEmpty)
+    }
 }
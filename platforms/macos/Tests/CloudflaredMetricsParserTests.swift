@@ -0,0 +1,85 @@
+import Foundation
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for CloudflaredMetricsParser.
+ *
+ * These tests verify that only the wanted series are read from Prometheus
+ * text, that label sets are summed, that histogram buckets are collected by
+ * their `le` bound, and that malformed lines are skipped.
+ */
+struct CloudflaredMetricsParserTests {
+
+    // MARK: - Test Fixtures
+
+    func parse(_ lines: String...) -> CloudflaredMetricsSnapshot {
+        CloudflaredMetricsParser.snapshot(in: Data(lines.joined(separator: "\n").utf8))
+    }
+
+    // MARK: - Series Tests
+
+    @Test func readsCountersAndSkipsOtherSeries() {
+        let snapshot = parse(
+            "# HELP cloudflared_tunnel_total_requests Amount of requests proxied",
+            "# TYPE cloudflared_tunnel_total_requests counter",
+            "cloudflared_tunnel_total_requests 42",
+            "cloudflared_tunnel_total_requests_extra 1000",
+            "go_goroutines 31",
+            "cloudflared_tunnel_request_errors 3 1700000000000"
+        )
+
+        #expect(snapshot.totalRequests == 42)
+        #expect(snapshot.requestErrors == 3)
+    }
+
+    @Test func sumsLabelSets() {
+        let snapshot = parse(
+            "quic_client_sent_bytes{conn_index=\"0\"} 1.5e+03",
+            "quic_client_sent_bytes{conn_index=\"1\"} 500",
+            "quic_client_receive_bytes{conn_index=\"0\"} 20"
+        )
+
+        #expect(snapshot.bytesSent == 2000)
+        #expect(snapshot.bytesReceived == 20)
+    }
+
+    @Test func fallsBackToConcurrentRequestsGauge() {
+        #expect(parse("cloudflared_tunnel_concurrent_requests_per_tunnel 4").activeStreams == 4)
+        #expect(parse(
+            "cloudflared_tunnel_concurrent_requests_per_tunnel 4",
+            "cloudflared_tunnel_active_streams 2"
+        ).activeStreams == 2)
+    }
+
+    // MARK: - Histogram Tests
+
+    @Test func collectsLatencyBuckets() {
+        let snapshot = parse(
+            "cloudflared_proxy_connect_latency_bucket{le=\"+Inf\"} 10",
+            "cloudflared_proxy_connect_latency_bucket{le=\"1\"} 2",
+            "cloudflared_proxy_connect_latency_bucket{origin=\"a\",le=\"10\"} 6",
+            "cloudflared_proxy_connect_latency_bucket{origin=\"b\",le=\"10\"} 1",
+            "cloudflared_proxy_connect_latency_sum 55",
+            "cloudflared_proxy_connect_latency_bucket{handle=\"x\"} 99"
+        )
+
+        #expect(snapshot.latencyBuckets == [
+            .init(upperBound: 1, cumulativeCount: 2),
+            .init(upperBound: 10, cumulativeCount: 7),
+            .init(upperBound: .infinity, cumulativeCount: 10)
+        ])
+    }
+
+    @Test func skipsMalformedLines() {
+        let snapshot = parse(
+            "cloudflared_tunnel_total_requests",
+            "cloudflared_tunnel_total_requests{unterminated 5",
+            "cloudflared_tunnel_total_requests abc",
+            "",
+            "cloudflared_tunnel_total_requests 7"
+        )
+
+        #expect(snapshot.totalRequests == 7)
+    }
+}
@@ -0,0 +1,54 @@
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for DeadlineHeap ordering.
+ *
+ * These tests verify that entries come out earliest deadline first,
+ * including after out-of-order inserts and filtered removal.
+ */
+struct DeadlineHeapTests {
+
+    // MARK: - Test Fixtures
+
+    let start = ContinuousClock.now
+
+    func drain(_ heap: inout DeadlineHeap<Int>) -> [Int] {
+        var keys: [Int] = []
+        while let entry = heap.popFirst() {
+            keys.append(entry.key)
+        }
+        return keys
+    }
+
+    // MARK: - Ordering Tests
+
+    @Test func popsEarliestFirst() {
+        var heap = DeadlineHeap<Int>()
+        for offset in [5, 1, 4, 2, 3] {
+            heap.insert(offset, deadline: start + .seconds(offset))
+        }
+
+        #expect(heap.first?.key == 1)
+        #expect(drain(&heap) == [1, 2, 3, 4, 5])
+        #expect(heap.isEmpty)
+    }
+
+    @Test func removeAllWhereKeepsOrder() {
+        var heap = DeadlineHeap<Int>()
+        for offset in [9, 3, 7, 1, 8, 2, 6] {
+            heap.insert(offset, deadline: start + .seconds(offset))
+        }
+
+        heap.removeAll { $0.key.isMultiple(of: 2) }
+
+        #expect(heap.count == 4)
+        #expect(drain(&heap) == [1, 3, 7, 9])
+    }
+
+    @Test func popFromEmptyReturnsNil() {
+        var heap = DeadlineHeap<Int>()
+
+        #expect(heap.popFirst() == nil)
+    }
+}
@@ -0,0 +1,46 @@
+import Foundation
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for DirectoryWatcher FSEvents delivery.
+ *
+ * These tests verify that file changes inside the watched directory are
+ * reported with their paths, and that a missing directory is not watched.
+ */
+struct DirectoryWatcherTests {
+
+    // MARK: - Test Fixtures
+
+    func makeDirectory() throws -> URL {
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("watcher-\(UUID().uuidString)", isDirectory: true)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        return directory
+    }
+
+    // MARK: - Watch Tests
+
+    @Test(.timeLimit(.minutes(1)))
+    func reportsChangedFiles() async throws {
+        let directory = try makeDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let watcher = try #require(DirectoryWatcher(directory: directory, latency: 0.05))
+        defer { watcher.invalidate() }
+
+        try Data("tunnel: dev".utf8).write(to: directory.appendingPathComponent("config.yml"))
+
+        var reported: [String] = []
+        for await paths in watcher.changes {
+            reported += paths
+            if reported.contains(where: { $0.hasSuffix("/config.yml") }) { break }
+        }
+        #expect(reported.contains { $0.hasSuffix("/config.yml") })
+    }
+
+    @Test func refusesMissingDirectory() {
+        let missing = FileManager.default.temporaryDirectory.appendingPathComponent("missing-\(UUID().uuidString)")
+
+        #expect(DirectoryWatcher(directory: missing) == nil)
+    }
+}
@@ -0,0 +1,110 @@
+import Foundation
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for KubernetesListDecoder incremental list decoding.
+ *
+ * These tests verify that items are cut out of the top-level "items" array
+ * regardless of how the response is split into chunks, that braces in
+ * strings and nested objects don't confuse the scanner, that undecodable items
+ * are counted and skipped, and that the list's resourceVersion is read from
+ * its metadata.
+ */
+struct KubernetesListDecoderTests {
+
+    // MARK: - Test Fixtures
+
+    let response = """
+    {
+        "apiVersion": "v1",
+        "kind": "List",
+        "metadata": { "items": "not the array", "resourceVersion": "4711", "x": { "y": {} } },
+        "items": [
+            {
+                "metadata": { "name": "api", "namespace": "prod", "labels": { "app": "{weird}\\"" } },
+                "spec": { "type": "ClusterIP", "clusterIP": "10.0.0.1",
+                          "ports": [ { "name": "http", "port": 80, "targetPort": 8080 } ] }
+            },
+            {
+                "metadata": { "name": "db", "namespace": "prod" },
+                "spec": { "ports": [ { "port": 5432, "targetPort": "postgres" } ] }
+            }
+        ]
+    }
+    """
+
+    func decode(chunkSize: Int) -> KubernetesListDecoder<KubernetesService.ListResponse.Item> {
+        let decoder = KubernetesListDecoder<KubernetesService.ListResponse.Item>()
+        let bytes = Array(response.utf8)
+        var offset = 0
+        while offset < bytes.count {
+            let end = min(offset + chunkSize, bytes.count)
+            decoder.feed(Data(bytes[offset..<end]))
+            offset = end
+        }
+        return decoder
+    }
+
+    // MARK: - Decoding Tests
+
+    @Test func decodesAllItemsInOneChunk() {
+        let decoder = decode(chunkSize: .max)
+
+        #expect(decoder.isComplete)
+        #expect(decoder.items.map(\.metadata.name) == ["api", "db"])
+        #expect(decoder.failedItemCount == 0)
+    }
+
+    @Test(arguments: [1, 3, 7, 64])
+    func decodesAcrossChunkBoundaries(chunkSize: Int) {
+        let decoder = decode(chunkSize: chunkSize)
+
+        #expect(decoder.isComplete)
+        #expect(decoder.items.map(\.metadata.name) == ["api", "db"])
+    }
+
+    @Test(arguments: [1, 5, Int.max])
+    func readsListResourceVersion(chunkSize: Int) {
+        let decoder = decode(chunkSize: chunkSize)
+
+        #expect(decoder.resourceVersion == "4711")
+        #expect(decoder.items.count == 2)
+    }
+
+    @Test func mapsItemsToServices() {
+        let services = decode(chunkSize: 16).items.map(KubernetesService.from(item:))
+
+        #expect(services[0].type == "ClusterIP")
+        #expect(services[0].ports.first?.targetPort == 8080)
+        #expect(services[1].type == "ClusterIP")
+        #expect(services[1].ports.first?.targetPort == 5432)
+    }
+
+    @Test func reportsProgressPerChunk() {
+        let decoder = KubernetesListDecoder<KubernetesService.ListResponse.Item>()
+        let bytes = Array(response.utf8)
+        let split = bytes.count / 2
+
+        let first = decoder.feed(Data(bytes[..<split]))
+        let second = decoder.feed(Data(bytes[split...]))
+
+        #expect(first + second == 2)
+    }
+
+    @Test func truncatedResponseIsIncomplete() {
+        let decoder = KubernetesListDecoder<KubernetesService.ListResponse.Item>()
+        decoder.feed(Data(response.utf8.prefix(response.utf8.count - 20)))
+
+        #expect(!decoder.isComplete)
+    }
+
+    @Test func countsUndecodableItems() {
+        let decoder = KubernetesListDecoder<KubernetesService.ListResponse.Item>()
+        decoder.feed(Data(#"{ "items": [ { "metadata": { "name": "api", "namespace": "prod" }, "spec": {} }, { "spec": 42 } ] }"#.utf8))
+
+        #expect(decoder.isComplete)
+        #expect(decoder.items.map(\.metadata.name) == ["api"])
+        #expect(decoder.failedItemCount == 1)
+    }
+}
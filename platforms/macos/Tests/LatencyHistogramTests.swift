@@ -0,0 +1,85 @@
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for LatencyHistogram bucketing and quantiles.
+ *
+ * These tests verify that quantiles land within the histogram's 1/8 relative
+ * error, that tiny and huge durations are bucketed without trapping, and
+ * that count, mean and maximum track every sample exactly.
+ */
+struct LatencyHistogramTests {
+
+    // MARK: - Test Fixtures
+
+    func histogram(milliseconds values: [Int]) -> LatencyHistogram {
+        var histogram = LatencyHistogram()
+        for value in values {
+            histogram.record(.milliseconds(value))
+        }
+        return histogram
+    }
+
+    func isClose(_ duration: Duration, to expected: Duration) -> Bool {
+        abs(duration / expected - 1) <= 0.125
+    }
+
+    // MARK: - Quantile Tests
+
+    @Test func emptyHistogramReportsZero() {
+        let histogram = LatencyHistogram()
+
+        #expect(histogram.isEmpty)
+        #expect(histogram.quantile(0.5) == .zero)
+        #expect(histogram.mean == .zero)
+    }
+
+    @Test func quantilesAreWithinBucketPrecision() {
+        let histogram = histogram(milliseconds: Array(1...100))
+
+        #expect(isClose(histogram.quantile(0.5), to: .milliseconds(50)))
+        #expect(isClose(histogram.quantile(0.99), to: .milliseconds(99)))
+    }
+
+    @Test func outlierShowsInP99NotP50() {
+        let histogram = histogram(milliseconds: Array(repeating: 2, count: 98) + [800, 800])
+
+        #expect(isClose(histogram.quantile(0.5), to: .milliseconds(2)))
+        #expect(isClose(histogram.quantile(0.99), to: .milliseconds(800)))
+    }
+
+    @Test func quantileNeverExceedsMaximum() {
+        let histogram = histogram(milliseconds: [9])
+
+        #expect(histogram.quantile(0.99) <= .milliseconds(9))
+    }
+
+    // MARK: - Range Tests
+
+    @Test func bucketsExtremeDurations() {
+        var histogram = LatencyHistogram()
+
+        histogram.record(.zero)
+        histogram.record(.nanoseconds(3))
+        histogram.record(.seconds(86_400 * 365))
+
+        #expect(histogram.count == 3)
+        #expect(histogram.quantile(0) == .zero)
+        #expect(histogram.maximum == .seconds(86_400 * 365))
+    }
+
+    // MARK: - Totals Tests
+
+    @Test func tracksCountMeanAndMaximum() {
+        var histogram = histogram(milliseconds: [10, 20, 30])
+
+        #expect(histogram.count == 3)
+        #expect(histogram.mean == .milliseconds(20))
+        #expect(histogram.maximum == .milliseconds(30))
+
+        histogram.reset()
+
+        #expect(histogram.isEmpty)
+        #expect(histogram.maximum == .zero)
+    }
+}
@@ -0,0 +1,58 @@
+import Foundation
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for LogRingBuffer eviction and lazy entry decoding.
+ *
+ * These tests verify that the buffer keeps only the newest lines up to its
+ * capacity and that entries decode their stored bytes correctly. Capacities
+ * are given explicitly, so the user's log history setting doesn't matter.
+ */
+@MainActor
+struct LogRingBufferTests {
+
+    @Test("Keeps the newest lines once full")
+    func evictsOldest() {
+        let capacity = 8
+        let buffer = LogRingBuffer<TunnelLogEntry>(capacity: capacity)
+
+        for index in 0..<(capacity + 10) {
+            buffer.append("line \(index)", severity: TunnelLogEntry.LogLevel.info.rawValue)
+        }
+
+        #expect(buffer.count == capacity)
+        #expect(buffer.entries.first?.message == "line 10")
+        #expect(buffer.last?.message == "line \(capacity + 9)")
+    }
+
+    @Test("Entries decode level, tag and message")
+    func decodesEntries() {
+        let buffer = LogRingBuffer<PortForwardLogEntry>(capacity: 4)
+        buffer.append("bind: address already in use", severity: 1, tag: PortForwardLogEntry.tag(for: .proxy))
+
+        let entry = buffer.entries.first
+        #expect(entry?.message == "bind: address already in use")
+        #expect(entry?.isError == true)
+        #expect(entry?.type == .proxy)
+    }
+
+    @Test("Truncates oversized lines")
+    func truncatesLongLines() {
+        let buffer = LogRingBuffer<TunnelLogEntry>(capacity: 4)
+        buffer.append(String(repeating: "x", count: LogSlot.maxLineBytes * 2), severity: 0)
+
+        #expect(buffer.last?.message.utf8.count == LogSlot.maxLineBytes)
+    }
+
+    @Test("Truncates on a scalar boundary")
+    func truncatesWholeScalars() {
+        let buffer = LogRingBuffer<TunnelLogEntry>(capacity: 4)
+        // "é" is two bytes, so the byte limit falls inside one
+        buffer.append("x" + String(repeating: "é", count: LogSlot.maxLineBytes), severity: 0)
+
+        let message = buffer.last?.message ?? ""
+        #expect(message.utf8.count == LogSlot.maxLineBytes - 1)
+        #expect(!message.contains("\u{FFFD}"))
+    }
+}
@@ -0,0 +1,84 @@
+import Foundation
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for LsofOutputParser byte-level parsing.
+ *
+ * These tests verify that raw lsof output is split into records with the
+ * correct PID, port and field ranges, and that escaped names are decoded.
+ */
+struct LsofOutputParserTests {
+
+    // MARK: - Test Fixtures
+
+    let header = "COMMAND    PID  USER   FD   TYPE             DEVICE SIZE/OFF NODE NAME\n"
+
+    func parse(_ lines: String...) -> [(record: LsofOutputParser.Record, fields: [String])] {
+        let data = Data((header + lines.joined(separator: "\n") + "\n").utf8)
+        return data.withUnsafeBytes { bytes in
+            LsofOutputParser.records(in: bytes).map { record in
+                let fields = [record.command, record.user, record.fd, record.address].map {
+                    LsofOutputParser.text($0, in: bytes)
+                }
+                return (record, fields)
+            }
+        }
+    }
+
+    // MARK: - Record Tests
+
+    @Test("Parses IPv4 listener")
+    func parsesIPv4() {
+        let parsed = parse("node     34805  code   19u  IPv4 0x3d8015e195af1f3f      0t0  TCP 127.0.0.1:3000 (LISTEN)")
+
+        #expect(parsed.count == 1)
+        #expect(parsed[0].record.pid == 34805)
+        #expect(parsed[0].record.port == 3000)
+        #expect(parsed[0].fields == ["node", "code", "19u", "127.0.0.1"])
+    }
+
+    @Test("Parses IPv6 and wildcard listeners")
+    func parsesIPv6AndWildcard() {
+        let parsed = parse(
+            "node     34805  code   20u  IPv6 0x3d8015e195af1f3f      0t0  TCP [::1]:3000 (LISTEN)",
+            "postgres   512  code    7u  IPv4 0x3d8015e195af1f40      0t0  TCP *:5432 (LISTEN)"
+        )
+
+        #expect(parsed.map(\.record.port) == [3000, 5432])
+        #expect(parsed.map { $0.fields[3] } == ["[::1]", "*"])
+    }
+
+    @Test("Skips header, blank and malformed lines")
+    func skipsMalformedLines() {
+        let parsed = parse(
+            "",
+            "node   notapid  code   19u  IPv4 0x1 0t0 TCP 127.0.0.1:3000 (LISTEN)",
+            "node     100  code   19u  IPv4 0x1 0t0 TCP 127.0.0.1:http (LISTEN)",
+            "short line",
+            "node     101  code   19u  IPv4 0x1 0t0 TCP 127.0.0.1:8080 (LISTEN)"
+        )
+
+        #expect(parsed.map(\.record.pid) == [101])
+    }
+
+    @Test("Extracts unique PIDs")
+    func extractsPids() {
+        let output = header
+            + "curl 200 code 5u IPv4 0x1 0t0 TCP 127.0.0.1:50000->127.0.0.1:3000 (ESTABLISHED)\n"
+            + "curl 200 code 6u IPv4 0x2 0t0 TCP 127.0.0.1:50001->127.0.0.1:3000 (ESTABLISHED)\n"
+            + "node 300 code 7u IPv4 0x3 0t0 TCP 127.0.0.1:3000->127.0.0.1:50000 (ESTABLISHED)\n"
+
+        #expect(LsofOutputParser.pids(in: Data(output.utf8)) == [200, 300])
+    }
+
+    // MARK: - Escape Decoding Tests
+
+    @Test("Decodes hex escapes as UTF-8")
+    func decodesEscapes() {
+        #expect(PortScanner.decodeLsofEscapes("Code\\x20Helper") == "Code Helper")
+        #expect(PortScanner.decodeLsofEscapes("\\xe4\\xbc\\x81\\xe4\\xb8\\x9a") == "企业")
+        #expect(PortScanner.decodeLsofEscapes("plain") == "plain")
+        #expect(PortScanner.decodeLsofEscapes("bad\\xZZ") == "bad\\xZZ")
+    }
+}
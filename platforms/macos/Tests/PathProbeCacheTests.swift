@@ -0,0 +1,79 @@
+import Testing
+import Synchronization
+@testable import PortKiller
+
+/**
+ * Tests for PathProbeCache.
+ *
+ * These tests count probes through an injected file check and verify that
+ * repeated lookups are answered from the cache, that results expire after
+ * the lifetime, that invalidation forces a fresh probe, and that
+ * `firstExisting` keeps the candidates' order.
+ */
+struct PathProbeCacheTests {
+
+    // MARK: - Test Fixtures
+
+    final class Probe: Sendable {
+        let existing: Mutex<Set<String>>
+        let calls = Mutex(0)
+
+        init(existing: Set<String>) {
+            self.existing = Mutex(existing)
+        }
+
+        func callAsFunction(_ path: String) -> Bool {
+            calls.withLock { $0 += 1 }
+            return existing.withLock { $0.contains(path) }
+        }
+    }
+
+    func cache(existing: Set<String>, lifetime: Duration = .seconds(60)) -> (PathProbeCache, Probe) {
+        let probe = Probe(existing: existing)
+        return (PathProbeCache(lifetime: lifetime, probe: { probe($0) }), probe)
+    }
+
+    // MARK: - Caching Tests
+
+    @Test func repeatedLookupsProbeOnce() {
+        let (cache, probe) = cache(existing: ["/usr/local/bin/kubectl"])
+
+        for _ in 0..<10 {
+            #expect(cache.exists("/usr/local/bin/kubectl"))
+            #expect(!cache.exists("/opt/homebrew/bin/kubectl"))
+        }
+
+        #expect(probe.calls.withLock { $0 } == 2)
+    }
+
+    @Test func expiredResultsAreProbedAgain() {
+        let (cache, probe) = cache(existing: [], lifetime: .zero)
+
+        _ = cache.exists("/usr/local/bin/socat")
+        _ = cache.exists("/usr/local/bin/socat")
+
+        #expect(probe.calls.withLock { $0 } == 2)
+    }
+
+    @Test func invalidateSeesNewInstalls() {
+        let (cache, probe) = cache(existing: [])
+        #expect(!cache.exists("/opt/homebrew/bin/cloudflared"))
+
+        probe.existing.withLock { _ = $0.insert("/opt/homebrew/bin/cloudflared") }
+        #expect(!cache.exists("/opt/homebrew/bin/cloudflared"))
+
+        cache.invalidate()
+        #expect(cache.exists("/opt/homebrew/bin/cloudflared"))
+    }
+
+    // MARK: - Lookup Tests
+
+    @Test func firstExistingKeepsCandidateOrder() {
+        let (cache, _) = cache(existing: ["/usr/local/bin/kubectl", "/usr/bin/kubectl"])
+
+        let path = cache.firstExisting(["/opt/homebrew/bin/kubectl", "/usr/local/bin/kubectl", "/usr/bin/kubectl"])
+
+        #expect(path == "/usr/local/bin/kubectl")
+        #expect(cache.firstExisting(["/opt/homebrew/bin/socat"]) == nil)
+    }
+}
@@ -0,0 +1,93 @@
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for PerformanceMonitor phase timing.
+ *
+ * These tests use a private monitor and verify that sync and async
+ * measurements land in their phase's histogram, that only measured phases
+ * are summarized, that errors thrown by the measured work are still timed,
+ * that launch time is recorded once, and that reset clears everything.
+ */
+struct PerformanceMonitorTests {
+
+    // MARK: - Test Fixtures
+
+    struct Failure: Error {}
+
+    let monitor = PerformanceMonitor()
+
+    func summary(of phase: PerformancePhase) -> PerformancePhaseSummary? {
+        monitor.summaries().first { $0.phase == phase }
+    }
+
+    // MARK: - Measuring Tests
+
+    @Test func measuresSyncWork() {
+        let value = monitor.measure(.lsofParse) { 42 }
+
+        #expect(value == 42)
+        #expect(summary(of: .lsofParse)?.count == 1)
+        #expect(monitor.summaries().map(\.phase) == [.lsofParse])
+    }
+
+    @Test func measuresAsyncWork() async throws {
+        await monitor.measure(.scan) {
+            try? await Task.sleep(for: .milliseconds(20))
+        }
+
+        let scan = try #require(summary(of: .scan))
+        #expect(scan.maximum >= .milliseconds(20))
+        #expect(scan.p50 <= scan.maximum)
+    }
+
+    @Test func timesWorkThatThrows() {
+        #expect(throws: Failure.self) {
+            try monitor.measure(.commandLine) { throw Failure() }
+        }
+        #expect(summary(of: .commandLine)?.count == 1)
+    }
+
+    @Test func recordsGivenDurations() throws {
+        for milliseconds in [1, 2, 3, 4, 100] {
+            monitor.record(.refresh, duration: .milliseconds(milliseconds))
+        }
+
+        let refresh = try #require(summary(of: .refresh))
+        #expect(refresh.count == 5)
+        #expect(refresh.p99 > .milliseconds(80))
+        #expect(refresh.p50 < .milliseconds(4))
+    }
+
+    @Test func recordsLaunchOnlyOnFirstFrame() throws {
+        monitor.recordFirstFrame()
+        monitor.recordFirstFrame()
+
+        let launch = try #require(summary(of: .launch))
+        #expect(launch.count == 1)
+        #expect(launch.maximum > .zero)
+    }
+
+    // MARK: - Gauge Tests
+
+    @Test func keepsEffectiveRefreshInterval() {
+        #expect(monitor.effectiveRefreshInterval == nil)
+
+        monitor.setEffectiveRefreshInterval(.seconds(7.5))
+
+        #expect(monitor.effectiveRefreshInterval == .seconds(7.5))
+    }
+
+    @Test func readsResidentMemory() {
+        #expect((PerformanceMonitor.residentMemoryBytes() ?? 0) > 0)
+    }
+
+    @Test func resetClearsAllPhases() {
+        monitor.record(.scan, duration: .milliseconds(1))
+        monitor.record(.autoKillCheck, duration: .milliseconds(1))
+
+        monitor.reset()
+
+        #expect(monitor.summaries().isEmpty)
+    }
+}
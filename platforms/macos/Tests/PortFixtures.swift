@@ -0,0 +1,26 @@
+import Foundation
+@testable import PortKiller
+
+/**
+ * Listeners shared by the port list, snapshot and history tests.
+ *
+ * An active port as a scan would report it, with test defaults for every field a
+ * test doesn't care about.
+ */
+func createPort(
+    port: Int,
+    pid: Int = 100,
+    processName: String = "node",
+    command: String? = nil,
+    fd: String = "19u"
+) -> PortInfo {
+    PortInfo.active(
+        port: port,
+        pid: pid,
+        processName: processName,
+        address: "127.0.0.1",
+        user: "testuser",
+        command: command ?? "\(processName) server.js",
+        fd: fd
+    )
+}
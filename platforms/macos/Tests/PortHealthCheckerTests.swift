@@ -0,0 +1,129 @@
+import Foundation
+import Darwin
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for PortHealthChecker batched TCP probes.
+ *
+ * These tests open real loopback listeners and verify that one probe pass
+ * reports listeners as open (with a latency) and unused ports as closed.
+ */
+struct PortHealthCheckerTests {
+
+    // MARK: - Test Fixtures
+
+    /// Binds an IPv4 loopback listener on an ephemeral port.
+    func makeListener() throws -> (descriptor: Int32, port: Int) {
+        let descriptor = socket(AF_INET, SOCK_STREAM, 0)
+        try #require(descriptor >= 0)
+
+        var addr = sockaddr_in()
+        addr.sin_len = UInt8(MemoryLayout<sockaddr_in>.size)
+        addr.sin_family = sa_family_t(AF_INET)
+        addr.sin_port = 0
+        addr.sin_addr.s_addr = inet_addr("127.0.0.1")
+        var length = socklen_t(MemoryLayout<sockaddr_in>.size)
+
+        let bound = withUnsafeMutablePointer(to: &addr) {
+            $0.withMemoryRebound(to: sockaddr.self, capacity: 1) {
+                bind(descriptor, $0, length) == 0 && listen(descriptor, 8) == 0
+                    && getsockname(descriptor, $0, &length) == 0
+            }
+        }
+        try #require(bound)
+        return (descriptor, Int(in_port_t(bigEndian: addr.sin_port)))
+    }
+
+    /// Finds a loopback port with nothing listening on it.
+    func unusedPort() throws -> Int {
+        let listener = try makeListener()
+        close(listener.descriptor)
+        return listener.port
+    }
+
+    // MARK: - Probe Tests
+
+    @Test func reportsListenerAsOpen() async throws {
+        let listener = try makeListener()
+        defer { close(listener.descriptor) }
+
+        let results = await PortHealthChecker.probe(ports: [listener.port], timeout: .seconds(1))
+
+        #expect(results[listener.port]?.isOpen == true)
+        #expect(results[listener.port]?.latency != nil)
+    }
+
+    @Test func reportsUnusedPortAsClosed() async throws {
+        let port = try unusedPort()
+
+        let results = await PortHealthChecker.probe(ports: [port], timeout: .milliseconds(200))
+
+        #expect(results[port]?.isOpen == false)
+        #expect(results[port]?.latency == nil)
+    }
+
+    @Test func probesManyPortsInOnePass() async throws {
+        let listeners = try (0..<4).map { _ in try makeListener() }
+        defer { listeners.forEach { close($0.descriptor) } }
+        let closedPort = try unusedPort()
+
+        let ports = Set(listeners.map(\.port)).union([closedPort])
+        let results = await PortHealthChecker.probe(ports: ports, timeout: .seconds(1))
+
+        #expect(results.count == ports.count)
+        #expect(listeners.allSatisfy { results[$0.port]?.isOpen == true })
+        #expect(results[closedPort]?.isOpen == false)
+    }
+
+    @Test func treatsOutOfRangePortsAsClosed() async {
+        let results = await PortHealthChecker.probe(ports: [0, 70_000], timeout: .milliseconds(100))
+
+        #expect(results[0]?.isOpen == false)
+        #expect(results[70_000]?.isOpen == false)
+    }
+
+    @Test func waitUntilOpenReturnsOnceListenerBinds() async throws {
+        let port = try unusedPort()
+
+        // Bind the listener shortly after waiting starts
+        let binder = Task {
+            try? await Task.sleep(for: .milliseconds(150))
+            let descriptor = socket(AF_INET, SOCK_STREAM, 0)
+            var on: Int32 = 1
+            setsockopt(descriptor, SOL_SOCKET, SO_REUSEADDR, &on, socklen_t(MemoryLayout<Int32>.size))
+            var addr = sockaddr_in()
+            addr.sin_len = UInt8(MemoryLayout<sockaddr_in>.size)
+            addr.sin_family = sa_family_t(AF_INET)
+            addr.sin_port = in_port_t(port).bigEndian
+            addr.sin_addr.s_addr = inet_addr("127.0.0.1")
+            _ = withUnsafePointer(to: &addr) {
+                $0.withMemoryRebound(to: sockaddr.self, capacity: 1) {
+                    bind(descriptor, $0, socklen_t(MemoryLayout<sockaddr_in>.size))
+                }
+            }
+            listen(descriptor, 8)
+            return descriptor
+        }
+
+        let opened = await PortHealthChecker.waitUntilOpen(port: port, timeout: .seconds(2))
+        close(await binder.value)
+
+        #expect(opened)
+    }
+
+    @Test func waitUntilOpenTimesOut() async throws {
+        let port = try unusedPort()
+
+        let opened = await PortHealthChecker.waitUntilOpen(port: port, timeout: .milliseconds(150))
+
+        #expect(!opened)
+    }
+
+    @Test func isPortOpenMatchesProbe() throws {
+        let listener = try makeListener()
+        defer { close(listener.descriptor) }
+
+        #expect(PortHealthChecker.isPortOpen(port: listener.port))
+    }
+}
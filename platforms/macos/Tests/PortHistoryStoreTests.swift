@@ -0,0 +1,154 @@
+import Foundation
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for the persistent port history.
+ *
+ * These tests verify that scan deltas become open/close events, that the
+ * holder of a port can be found at any moment, and that history survives
+ * restarts, segment rollover, compaction and the size limit.
+ */
+struct PortHistoryStoreTests {
+
+    // MARK: - Test Fixtures
+
+    let start = Date(timeIntervalSince1970: 1_800_000_000)
+
+    func temporaryDirectory() -> URL {
+        FileManager.default.temporaryDirectory
+            .appending(path: "PortHistoryStoreTests-\(UUID().uuidString)", directoryHint: .isDirectory)
+    }
+
+    /// Records each scan one minute after the previous one
+    func record(_ scans: [[PortInfo]], into store: PortHistoryStore, from offset: Int = 0) async {
+        var differ = PortSnapshotDiffer()
+        for (index, ports) in scans.enumerated() {
+            await store.record(differ.delta(for: ports), at: minute(offset + index))
+        }
+    }
+
+    func minute(_ index: Int) -> Date {
+        start.addingTimeInterval(Double(index) * 60)
+    }
+
+    func segmentCount(in directory: URL) -> Int {
+        let contents = (try? FileManager.default.contentsOfDirectory(atPath: directory.path)) ?? []
+        return contents.filter { $0.hasSuffix(".history") }.count
+    }
+
+    // MARK: - Recording Tests
+
+    @Test("Scans become open and close events of each port")
+    func recordsOpensAndCloses() async {
+        let store = PortHistoryStore(directory: temporaryDirectory())
+        await record([
+            [createPort(port: 5432, processName: "postgres")],
+            [createPort(port: 5432, processName: "postgres"), createPort(port: 3000)],
+            [createPort(port: 3000, pid: 200)]
+        ], into: store)
+
+        let postgres = await store.events(port: 5432, in: start...minute(10))
+        #expect(postgres.map(\.kind) == [.opened, .closed])
+        #expect(postgres.map(\.processName) == ["postgres", "postgres"])
+        #expect(postgres.last?.timestamp == minute(2))
+
+        let node = await store.events(port: 3000, in: start...minute(10))
+        #expect(node.map(\.kind) == [.opened, .closed, .opened])
+        #expect(node.map(\.pid) == [100, 100, 200])
+    }
+
+    @Test("Finds what held a port at a given moment")
+    func holdersAtMoment() async {
+        let store = PortHistoryStore(directory: temporaryDirectory())
+        await record([
+            [createPort(port: 3000)],
+            [createPort(port: 3000)],
+            [createPort(port: 3000, pid: 200, processName: "vite")]
+        ], into: store)
+
+        #expect(await store.holders(of: 3000, at: minute(1)).map(\.pid) == [100])
+        #expect(await store.holders(of: 3000, at: minute(2).addingTimeInterval(1)).map(\.processName) == ["vite"])
+        #expect(await store.holders(of: 3000, at: start.addingTimeInterval(-1)).isEmpty)
+        #expect(await store.holders(of: 8080, at: minute(1)).isEmpty)
+    }
+
+    @Test("Repeated queries see records appended since the last one")
+    func holdersAfterLaterRecords() async {
+        let store = PortHistoryStore(directory: temporaryDirectory())
+        var differ = PortSnapshotDiffer()
+        await store.record(differ.delta(for: [createPort(port: 3000)]), at: minute(0))
+        #expect(await store.holders(of: 3000, at: minute(1)).map(\.pid) == [100])
+
+        await store.record(differ.delta(for: [createPort(port: 3000, pid: 200)]), at: minute(2))
+        #expect(await store.holders(of: 3000, at: minute(3)).map(\.pid) == [200])
+        #expect(await store.holders(of: 3000, at: minute(1)).map(\.pid) == [100])
+        #expect(await store.holders(of: 3000, at: minute(3)).map(\.pid) == [200])
+    }
+
+    @Test("A range starting mid-hold reports the holder as running")
+    func rangeStartsMidHold() async {
+        let store = PortHistoryStore(directory: temporaryDirectory())
+        await record([[createPort(port: 3000)], [], [createPort(port: 3000)]], into: store)
+
+        let events = await store.events(port: 3000, in: start.addingTimeInterval(30)...minute(5))
+        #expect(events.map(\.kind) == [.running, .closed, .opened])
+        #expect(events.first?.timestamp == start.addingTimeInterval(30))
+    }
+
+    // MARK: - Persistence Tests
+
+    @Test("A new session continues where the last one stopped")
+    func continuesAcrossSessions() async {
+        let directory = temporaryDirectory()
+        await record([[createPort(port: 3000), createPort(port: 5432)]], into: PortHistoryStore(directory: directory))
+
+        // 5432 went away while the app wasn't running; 3000 kept listening
+        await record([[createPort(port: 3000)]], into: PortHistoryStore(directory: directory), from: 60)
+
+        let store = PortHistoryStore(directory: directory)
+        #expect(await store.events(port: 3000, in: start...minute(120)).map(\.kind) == [.opened])
+        #expect(await store.events(port: 5432, in: start...minute(120)).map(\.kind) == [.opened, .closed])
+        #expect(await store.events(port: 5432, in: start...minute(120)).last?.timestamp == minute(60))
+    }
+
+    @Test("Sessions too small for a segment of their own are merged")
+    func mergesSmallSegments() async {
+        let directory = temporaryDirectory()
+        for session in 0..<3 {
+            await record([[createPort(port: 3000)]], into: PortHistoryStore(directory: directory), from: session * 60)
+        }
+
+        // The two sealed sessions become one; the third is still being written
+        #expect(segmentCount(in: directory) == 2)
+        let events = await PortHistoryStore(directory: directory).events(port: 3000, in: start...minute(180))
+        #expect(events.map(\.kind) == [.opened])
+    }
+
+    @Test("Full segments roll over without losing the open listeners")
+    func rollsOverFullSegments() async {
+        let directory = temporaryDirectory()
+        let store = PortHistoryStore(directory: directory, segmentCapacity: 4)
+        let scans = (0..<6).map { index in [createPort(port: 3000), createPort(port: 4000 + index)] }
+        await record(scans, into: store)
+
+        #expect(segmentCount(in: directory) > 1)
+        #expect(await store.holders(of: 3000, at: minute(5)).map(\.pid) == [100])
+        #expect(await store.events(port: 3000, in: start...minute(10)).map(\.kind) == [.opened])
+        #expect(await store.holders(of: 4005, at: minute(5)).count == 1)
+        #expect(await store.holders(of: 4004, at: minute(5)).isEmpty)
+    }
+
+    @Test("Oldest segments are dropped beyond the size limit")
+    func enforcesSizeLimit() async {
+        let directory = temporaryDirectory()
+        let oneSegment = PortHistorySegment.recordsOffset + 3 * PortHistorySegment.recordSize
+        let store = PortHistoryStore(directory: directory, segmentCapacity: 4, retentionBytes: { oneSegment * 2 })
+        let scans = (0..<20).map { index in [createPort(port: 4000 + index)] }
+        await record(scans, into: store)
+
+        #expect(segmentCount(in: directory) <= 2)
+        #expect(await store.events(port: 4000, in: start...minute(30)).isEmpty)
+        #expect(await store.holders(of: 4019, at: minute(19)).count == 1)
+    }
+}
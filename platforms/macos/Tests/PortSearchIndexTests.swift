@@ -0,0 +1,75 @@
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for PortSearchIndex matching.
+ *
+ * These tests verify that the index finds the same rows as PortFilter's
+ * direct search, including when a query narrows the previous one or
+ * starts over.
+ */
+struct PortSearchIndexTests {
+
+    // MARK: - Test Fixtures
+
+    let ports: [PortInfo] = [
+        PortInfo.active(port: 3000, pid: 12345, processName: "node", address: "127.0.0.1",
+                        user: "alice", command: "node /srv/App/server.js", fd: "19u"),
+        PortInfo.active(port: 5432, pid: 200, processName: "postgres", address: "*",
+                        user: "postgres", command: "/usr/lib/postgresql/bin/postgres -D /data", fd: "5u"),
+        PortInfo.active(port: 8080, pid: 3001, processName: "java", address: "[::1]",
+                        user: "bob", command: "java -Xmx2g -jar Gateway.jar", fd: "40u")
+    ]
+
+    func indexedPorts(_ rows: [Int]) -> [Int] {
+        rows.map { ports[$0].port }
+    }
+
+    /// Rows PortFilter's direct search accepts, for comparison
+    func directMatches(_ query: String) -> [Int] {
+        let filter = PortFilter(searchText: query)
+        return ports.filter { filter.matchesSearch($0) }.map(\.port)
+    }
+
+    // MARK: - Matching Tests
+
+    @Test(arguments: ["node", "POST", "gateway", "app/server", "12345", "30", "::1", "bob", "xyz"])
+    func matchesLikeDirectSearch(query: String) {
+        var index = PortSearchIndex(table: PortTable(ports))
+
+        #expect(indexedPorts(index.matchingRows(for: query)) == directMatches(query))
+    }
+
+    @Test func narrowsWhenQueryExtends() {
+        var index = PortSearchIndex(table: PortTable(ports))
+
+        #expect(indexedPorts(index.matchingRows(for: "o")) == [3000, 5432, 8080])
+        #expect(indexedPorts(index.matchingRows(for: "os")) == [5432])
+        #expect(indexedPorts(index.matchingRows(for: "ost")) == [5432])
+    }
+
+    @Test func startsOverWhenQueryChanges() {
+        var index = PortSearchIndex(table: PortTable(ports))
+
+        #expect(indexedPorts(index.matchingRows(for: "postgres")) == [5432])
+        #expect(indexedPorts(index.matchingRows(for: "java")) == [8080])
+        #expect(indexedPorts(index.matchingRows(for: "")) == [3000, 5432, 8080])
+    }
+
+    @Test func numericQueryMatchesPortAndPid() {
+        var index = PortSearchIndex(table: PortTable(ports))
+
+        // 3000 by port, 8080 by pid 3001
+        #expect(indexedPorts(index.matchingRows(for: "300")) == [3000, 8080])
+    }
+
+    @Test func filterUsesSearchHits() {
+        var index = PortSearchIndex(table: PortTable(ports))
+        let hits = index.matchingIDs(for: "java")
+        let filter = PortFilter(searchText: "java")
+
+        let matched = ports.filter { filter.matches($0, favorites: [], watched: [], searchHits: hits) }
+
+        #expect(matched.map(\.port) == [8080])
+    }
+}
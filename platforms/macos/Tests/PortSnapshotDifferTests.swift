@@ -0,0 +1,56 @@
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for PortSnapshotDiffer delta computation.
+ *
+ * These tests verify that consecutive scans are reduced to the ports
+ * that were added, removed or changed in between.
+ */
+struct PortSnapshotDifferTests {
+
+    // MARK: - Delta Tests
+
+    @Test("First scan reports every port as added")
+    func firstScanAddsAll() {
+        var differ = PortSnapshotDiffer()
+        let delta = differ.delta(for: [createPort(port: 3000), createPort(port: 5432)])
+
+        #expect(delta.added.count == 2)
+        #expect(delta.removed.isEmpty)
+        #expect(delta.changed.isEmpty)
+    }
+
+    @Test("Identical scan produces an empty delta")
+    func identicalScanIsEmpty() {
+        var differ = PortSnapshotDiffer()
+        _ = differ.delta(for: [createPort(port: 3000)])
+        let delta = differ.delta(for: [createPort(port: 3000)])
+
+        #expect(delta.isEmpty)
+        #expect(delta.ports.count == 1)
+    }
+
+    @Test("Detects added, removed and changed ports")
+    func detectsAllChangeKinds() {
+        var differ = PortSnapshotDiffer()
+        _ = differ.delta(for: [createPort(port: 3000), createPort(port: 8080)])
+
+        let delta = differ.delta(for: [createPort(port: 3000, fd: "21u"), createPort(port: 9000)])
+
+        #expect(delta.added.map(\.port) == [9000])
+        #expect(delta.removed.map(\.port) == [8080])
+        #expect(delta.changed.map(\.port) == [3000])
+    }
+
+    @Test("Same port with a new PID is a remove plus an add")
+    func pidChangeIsReplacement() {
+        var differ = PortSnapshotDiffer()
+        _ = differ.delta(for: [createPort(port: 3000, pid: 1)])
+        let delta = differ.delta(for: [createPort(port: 3000, pid: 2)])
+
+        #expect(delta.added.map(\.pid) == [2])
+        #expect(delta.removed.map(\.pid) == [1])
+        #expect(delta.changed.isEmpty)
+    }
+}
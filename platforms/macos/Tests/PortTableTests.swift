@@ -0,0 +1,88 @@
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for the columnar PortTable and PortInfo stable IDs.
+ *
+ * These tests verify that rows round-trip through the columns unchanged,
+ * that repeated strings are stored once, and that ID lookups, per-type
+ * counts and removals stay consistent.
+ */
+struct PortTableTests {
+
+    // MARK: - Storage Tests
+
+    @Test func rowsRoundTrip() {
+        let ports = [createPort(port: 3000), createPort(port: 5432, pid: 7, processName: "postgres", fd: "5u")]
+        let table = PortTable(ports)
+
+        #expect(table.count == 2)
+        #expect(Array(table) == ports)
+        #expect(table.port(at: 1) == 5432)
+        #expect(table.processName(at: 1) == "postgres")
+    }
+
+    @Test func internsRepeatedStrings() {
+        // 5,000 listeners of one test runner: name, user, command and address once each
+        let ports = (0..<5_000).map { createPort(port: 40_000 + $0, fd: "\($0)u") }
+        let table = PortTable(ports)
+
+        #expect(table.count == 5_000)
+        #expect(table.internedStringCount == 4)
+    }
+
+    @Test func looksUpRowsByID() {
+        let ports = [createPort(port: 3000), createPort(port: 8080)]
+        let table = PortTable(ports)
+
+        #expect(table.row(for: ports[1].id) == 1)
+        #expect(table[id: ports[0].id] == ports[0])
+        #expect(table[id: PortInfo.inactive(port: 3000).id] == nil)
+    }
+
+    @Test func countsRowsPerType() {
+        let table = PortTable([
+            createPort(port: 3000),
+            createPort(port: 3001),
+            createPort(port: 5432, processName: "postgres")
+        ])
+
+        #expect(table.count(of: .development) == 2)
+        #expect(table.count(of: .database) == 1)
+        #expect(table.count(of: .webServer) == 0)
+    }
+
+    // MARK: - Mutation Tests
+
+    @Test func removeDropsRowAndBumpsGeneration() {
+        let ports = [createPort(port: 3000), createPort(port: 8080)]
+        var table = PortTable(ports)
+        let generation = table.generation
+
+        #expect(table.remove(id: ports[0].id))
+        #expect(table.map(\.port) == [8080])
+        #expect(table.row(for: ports[1].id) == 0)
+        #expect(table.generation != generation)
+        #expect(!table.remove(id: ports[0].id))
+    }
+
+    @Test func replaceAllResetsCounts() {
+        var table = PortTable([createPort(port: 5432, processName: "postgres")])
+        table.replaceAll(with: [createPort(port: 3000)])
+
+        #expect(table.count(of: .database) == 0)
+        #expect(table.count(of: .development) == 1)
+    }
+
+    // MARK: - Stable ID Tests
+
+    @Test func stableIDDistinguishesListeners() {
+        let base = createPort(port: 3000)
+
+        #expect(base.id == createPort(port: 3000).id)
+        #expect(base.id != createPort(port: 3001).id)
+        #expect(base.id != createPort(port: 3000, pid: 101).id)
+        #expect(base.id != createPort(port: 3000, fd: "20u").id)
+        #expect(PortInfo.inactive(port: 3000).id != base.id)
+    }
+}
@@ -0,0 +1,153 @@
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for the memoized derived port views.
+ *
+ * These tests verify that stages recompute only when their inputs change,
+ * that an unchanged result keeps downstream stages cached, and that the
+ * selection and sort stages produce the lists the views expect.
+ */
+struct PortViewPipelineTests {
+
+    // MARK: - MemoizedStage Tests
+
+    @Test func reusesOutputForSameInputs() {
+        var stage = MemoizedStage<Int, [Int]>()
+        var computations = 0
+
+        _ = stage.output(for: 1) { computations += 1; return [1] }
+        _ = stage.output(for: 1) { computations += 1; return [1] }
+
+        #expect(computations == 1)
+        #expect(stage.generation == 1)
+    }
+
+    @Test func recomputesForNewInputs() {
+        var stage = MemoizedStage<Int, [Int]>()
+
+        _ = stage.output(for: 1) { [1] }
+        let output = stage.output(for: 2) { [2] }
+
+        #expect(output == [2])
+        #expect(stage.generation == 2)
+    }
+
+    @Test func unchangedOutputKeepsGeneration() {
+        var stage = MemoizedStage<Int, [Int]>()
+
+        _ = stage.output(for: 1) { [7] }
+        _ = stage.output(for: 2) { [7] }
+
+        #expect(stage.generation == 1)
+    }
+
+    @Test func updatePatchesPreviousOutput() {
+        var stage = MemoizedStage<Int, [Int]>()
+        var computations = 0
+
+        _ = stage.output(for: 1) { _, _ in nil } compute: { computations += 1; return [1] }
+        let output = stage.output(for: 2) { previous, inputs in previous + [inputs + 1] } compute: {
+            computations += 1
+            return []
+        }
+
+        #expect(output == [1, 2])
+        #expect(computations == 1)
+        #expect(stage.generation == 2)
+    }
+
+    // MARK: - Stage Function Tests
+
+    @Test func selectsProcessTypeFromTable() {
+        let table = PortTable([createPort(port: 3000), createPort(port: 5432, processName: "postgres")])
+
+        let selected = PortViewPipeline.select(table, sidebarItem: .processType(.database), favorites: [], watched: [])
+
+        #expect(selected.map(\.port) == [5432])
+    }
+
+    @Test func favoritesAddPlaceholders() {
+        let table = PortTable([createPort(port: 3000), createPort(port: 8080)])
+
+        let selected = PortViewPipeline.select(table, sidebarItem: .favorites, favorites: [3000, 9999], watched: [])
+
+        #expect(selected.count == 2)
+        #expect(selected.first { $0.port == 3000 }?.isActive == true)
+        #expect(selected.first { $0.port == 9999 }?.isActive == false)
+    }
+
+    @Test func settingsSelectsNothing() {
+        let table = PortTable([createPort(port: 3000)])
+
+        #expect(PortViewPipeline.select(table, sidebarItem: .settings, favorites: [], watched: []).isEmpty)
+    }
+
+    @Test func sortsByActionPriority() {
+        let ports = [createPort(port: 3000), createPort(port: 4000), createPort(port: 5000)]
+
+        let sorted = PortViewPipeline.sort(ports, by: .actions, ascending: true, favorites: [5000], watched: [4000])
+
+        #expect(sorted.map(\.port) == [5000, 4000, 3000])
+    }
+
+    @Test func sortsDescending() {
+        let ports = [createPort(port: 3000), createPort(port: 8080)]
+
+        let sorted = PortViewPipeline.sort(ports, by: .port, ascending: false, favorites: [], watched: [])
+
+        #expect(sorted.map(\.port) == [8080, 3000])
+    }
+
+    @Test func menuBarSearchesAndPutsFavoritesFirst() {
+        let table = PortTable([
+            createPort(port: 3000),
+            createPort(port: 5432, processName: "postgres"),
+            createPort(port: 8080),
+            createPort(port: 30001, processName: "launchd")
+        ])
+
+        let all = PortViewPipeline.selectForMenuBar(table, searchText: "", hideSystemProcesses: false, favorites: [8080])
+        let search = PortViewPipeline.selectForMenuBar(table, searchText: "300", hideSystemProcesses: false, favorites: [])
+        let byName = PortViewPipeline.selectForMenuBar(table, searchText: "POST", hideSystemProcesses: false, favorites: [])
+
+        #expect(all.map(\.port) == [8080, 3000, 5432, 30001])
+        #expect(search.map(\.port) == [3000, 30001])
+        #expect(byName.map(\.port) == [5432])
+    }
+
+    // MARK: - Patching Tests
+
+    @Test func resortMergesNewRows() {
+        let ports = (0..<20).map { createPort(port: 3000 + $0, processName: "proc\($0 % 7)") }
+        let previous = PortViewPipeline.sort(ports, by: .process, ascending: true, favorites: [], watched: [])
+        let next = Array(ports.dropFirst()) + [createPort(port: 9000, processName: "aaa")]
+
+        let patched = PortViewPipeline.resort(previous, to: next, by: .process, ascending: true, favorites: [], watched: [])
+        let expected = PortViewPipeline.sort(next, by: .process, ascending: true, favorites: [], watched: [])
+
+        #expect(patched?.map(\.processName) == expected.map(\.processName))
+        #expect(patched?.count == 20)
+        #expect(patched?.first?.port == 9000)
+    }
+
+    @Test func resortGivesUpOnLargeChanges() {
+        let previous = [createPort(port: 3000), createPort(port: 4000)]
+        let next = [createPort(port: 5000), createPort(port: 6000)]
+
+        #expect(PortViewPipeline.resort(previous, to: next, by: .port, ascending: true, favorites: [], watched: []) == nil)
+    }
+
+    @Test func regroupRebuildsChangedGroups() {
+        let ports = (0..<40).map { createPort(port: 3000 + $0, processName: "proc\($0 % 20)") }
+        let previous = PortGroupingService.shared.groupByProcess(ports)
+        let next = Array(ports.dropFirst()) + [createPort(port: 9000, processName: "proc3")]
+
+        let patched = PortViewPipeline.regroup(previous, to: next)
+        let expected = PortGroupingService.shared.groupByProcess(next)
+
+        #expect(patched?.map(\.processName) == expected.map(\.processName))
+        #expect(patched?.map { $0.ports.map(\.port) } == expected.map { $0.ports.map(\.port) })
+        #expect(PortViewPipeline.regroup(previous, to: ports)?.map(\.processName) == previous.map(\.processName))
+    }
+}
@@ -0,0 +1,95 @@
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for the compiled ProcessClassifier.
+ *
+ * These tests verify that the keyword automaton finds overlapping and
+ * nested keywords, that category precedence and overrides match the
+ * previous detection, and that auto-kill patterns are matched per name.
+ */
+struct ProcessClassifierTests {
+
+    // MARK: - Test Fixtures
+
+    func rule(_ pattern: String, port: Int = 0) -> AutoKillRule {
+        AutoKillRule(name: pattern, processPattern: pattern, port: port)
+    }
+
+    // MARK: - Type Detection Tests
+
+    @Test func findsKeywordsAfterPartialMatches() {
+        let classifier = ProcessClassifier()
+
+        // "no" starts "node" but fails; the automaton must not lose "node" at offset 2
+        #expect(classifier.processType(of: "nonode") == .development)
+        // "mongo" contains the development keyword "go"
+        #expect(classifier.processType(of: "xmongod") == .database)
+        #expect(classifier.processType(of: "ccaddy") == .webServer)
+    }
+
+    @Test func firstCategoryWins() {
+        let classifier = ProcessClassifier()
+
+        #expect(classifier.processType(of: "node-nginx") == .webServer)
+        #expect(classifier.processType(of: "spotlight-redis") == .database)
+    }
+
+    @Test func ignoresNonASCIIBytes() {
+        #expect(ProcessClassifier().processType(of: "Überpython") == .development)
+        #expect(ProcessClassifier().processType(of: "日本") == .other)
+    }
+
+    @Test func overrideWinsOverDetection() {
+        let classifier = ProcessClassifier(overrides: ["node": ProcessType.system.rawValue, "bad": "Nope"])
+
+        #expect(classifier.processType(of: "node") == .system)
+        #expect(classifier.processType(of: "node2") == .development)
+        #expect(classifier.processType(of: "bad") == .other)
+    }
+
+    // MARK: - Rule Matching Tests
+
+    @Test func matchesGlobAndExactRules() {
+        let rules = [rule("node*"), rule("*server"), rule("vite"), rule("py*on*3")]
+        let classifier = ProcessClassifier(rules: rules)
+
+        #expect(classifier.classify("node").matchingRules == [0])
+        #expect(classifier.classify("Node-Server").matchingRules == [0, 1])
+        #expect(classifier.classify("VITE").matchingRules == [2])
+        #expect(classifier.classify("vite-server").matchingRules == [1])
+        #expect(classifier.classify("python3").matchingRules == [3])
+        #expect(classifier.classify("3python").matchingRules == [])
+    }
+
+    @Test func rulesAgreeWithRuleMatching() {
+        let rules = [rule("node*"), rule("*d"), rule("redis-server"), rule("*")]
+        let classifier = ProcessClassifier(rules: rules)
+
+        for name in ["node", "mongod", "redis-server", "nginx", "nodemon"] {
+            let port = PortInfo.active(port: 3000, pid: 1, processName: name, address: "*",
+                                       user: "u", command: name, fd: "3u")
+            let expected = rules.indices.filter { rules[$0].matches(port) }
+            #expect(classifier.classify(name).matchingRules == expected)
+        }
+    }
+
+    @Test func rulesWithoutPatternAreLeftToCaller() {
+        let classifier = ProcessClassifier(rules: [rule("", port: 8080), rule(""), rule("any*")])
+
+        #expect(classifier.classify("anything").matchingRules == [2])
+    }
+
+    // MARK: - Memo Tests
+
+    @Test func memoizedClassificationMatchesDirect() {
+        var classifier = ProcessClassifier(rules: [rule("java*")])
+
+        let first = classifier.classification(for: "java")
+        let second = classifier.classification(for: "java")
+
+        #expect(first == second)
+        #expect(first == classifier.classify("java"))
+        #expect(first.processType == .development)
+    }
+}
@@ -0,0 +1,134 @@
+import Foundation
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for ProcessExecutor's posix_spawn runner.
+ *
+ * These tests spawn real children through /bin/sh and verify captured output
+ * and exit codes, that both pipes are drained together, streaming through
+ * `chunks`, the hard timeout, and the spawn and byte counters.
+ */
+struct ProcessExecutorTests {
+
+    // MARK: - Test Fixtures
+
+    func shell(_ script: String, timeout: Duration = .seconds(10)) async -> ProcessResult? {
+        await ProcessExecutor.run("/bin/sh", arguments: ["-c", script], timeout: timeout)
+    }
+
+    // MARK: - Run Tests
+
+    @Test func capturesOutputAndExitCode() async throws {
+        let result = try #require(await shell("echo out; echo err >&2; exit 4"))
+
+        #expect(result.standardOutput == "out\n")
+        #expect(result.standardError == "err\n")
+        #expect(result.exitCode == 4)
+        #expect(!result.succeeded)
+    }
+
+    @Test func returnsNilWhenLaunchFails() async {
+        #expect(await ProcessExecutor.run("/nonexistent/binary", arguments: []) == nil)
+    }
+
+    @Test func drainsLargeOutputOnBothStreams() async throws {
+        // Well past the pipe buffer on both streams: reading one pipe after the other deadlocks
+        let script = "head -c 1000000 /dev/zero | tr '\\0' e >&2; head -c 1000000 /dev/zero | tr '\\0' o"
+        let result = try #require(await shell(script))
+
+        #expect(result.succeeded)
+        #expect(result.standardOutput.utf8.count == 1_000_000)
+        #expect(result.standardError.utf8.count == 1_000_000)
+    }
+
+    @Test func doesNotInheritOpenDescriptors() async throws {
+        let file = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        FileManager.default.createFile(atPath: file.path, contents: nil)
+        defer { try? FileManager.default.removeItem(at: file) }
+        let handle = try FileHandle(forReadingFrom: file)
+        defer { try? handle.close() }
+
+        let output = await ProcessExecutor.output(
+            "/bin/sh",
+            arguments: ["-c", "[ -e /dev/fd/\(handle.fileDescriptor) ] && echo leaked || echo clean"]
+        )
+
+        #expect(output == "clean")
+    }
+
+    // MARK: - Timeout Tests
+
+    @Test func killsChildAfterTimeout() async throws {
+        let start = ContinuousClock.now
+        let result = try #require(await shell("sleep 30", timeout: .milliseconds(200)))
+
+        #expect(result.timedOut)
+        #expect(!result.succeeded)
+        #expect(result.exitCode == SIGKILL)
+        #expect(ContinuousClock.now - start < .seconds(5))
+    }
+
+    @Test func timeoutKillsDescendantsHoldingThePipe() async throws {
+        let start = ContinuousClock.now
+        let result = try #require(await shell("sleep 30 & wait", timeout: .milliseconds(200)))
+
+        #expect(result.timedOut)
+        #expect(ContinuousClock.now - start < .seconds(5))
+    }
+
+    // MARK: - Streaming Tests
+
+    @Test func streamsOutputInOrder() async throws {
+        var output = Data()
+        for try await chunk in ProcessExecutor.chunks("/bin/sh", arguments: ["-c", "for i in 1 2 3; do echo $i; sleep 0.05; done"]) {
+            output.append(chunk)
+        }
+
+        #expect(String(decoding: output, as: UTF8.self) == "1\n2\n3\n")
+    }
+
+    @Test func slowConsumerReceivesAllOutput() async throws {
+        // Many more chunks than are buffered, so stdout is paused and resumed repeatedly
+        var total = 0
+        for try await chunk in ProcessExecutor.chunks("/bin/sh", arguments: ["-c", "head -c 4000000 /dev/zero"]) {
+            total += chunk.count
+            try await Task.sleep(for: .milliseconds(1))
+        }
+
+        #expect(total == 4_000_000)
+    }
+
+    @Test func streamThrowsOnFailureWithStandardError() async {
+        await #expect(throws: ProcessExecutorError.failed(exitCode: 2, standardError: Data("bad\n".utf8))) {
+            for try await _ in ProcessExecutor.chunks("/bin/sh", arguments: ["-c", "echo bad >&2; exit 2"]) {}
+        }
+    }
+
+    @Test func streamThrowsOnTimeout() async {
+        await #expect(throws: ProcessExecutorError.timedOut) {
+            for try await _ in ProcessExecutor.chunks("/bin/sh", arguments: ["-c", "sleep 30"], timeout: .milliseconds(200)) {}
+        }
+    }
+
+    @Test func streamThrowsWhenLaunchFails() async {
+        await #expect(throws: ProcessExecutorError.launchFailed(errno: ENOENT)) {
+            for try await _ in ProcessExecutor.chunks("/nonexistent/binary", arguments: []) {}
+        }
+    }
+
+    // MARK: - Statistics Tests
+
+    @Test func countsSpawnsAndBytes() async throws {
+        let before = ProcessExecutor.statistics
+
+        _ = try #require(await shell("printf 12345"))
+
+        let after = ProcessExecutor.statistics
+        // Other tests may spawn concurrently; the counters only ever grow
+        #expect(after.spawns > before.spawns)
+        #expect(after.bytesRead >= before.bytesRead + 5)
+        #expect(after.totalSpawnTime > before.totalSpawnTime)
+        #expect(after.maxSpawnTime >= after.averageSpawnTime)
+    }
+}
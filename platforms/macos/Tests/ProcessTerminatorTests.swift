@@ -0,0 +1,62 @@
+import Foundation
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for ProcessTerminator batch kills.
+ *
+ * These tests spawn real child processes and verify that a batch returns
+ * as soon as its targets exit, escalates to SIGKILL only for processes
+ * that ignore SIGTERM, and reports PIDs that were already gone.
+ */
+struct ProcessTerminatorTests {
+
+    // MARK: - Test Fixtures
+
+    /// Starts `/bin/sh -c script` and returns its PID.
+    func spawn(_ script: String) throws -> Process {
+        let process = Process()
+        process.executableURL = URL(fileURLWithPath: "/bin/sh")
+        process.arguments = ["-c", script]
+        try process.run()
+        return process
+    }
+
+    // MARK: - Termination Tests
+
+    @Test func returnsOnceAllTargetsExit() async throws {
+        let processes = try (0..<5).map { _ in try spawn("exec sleep 30") }
+        let pids = Set(processes.map { Int($0.processIdentifier) })
+
+        let started = ContinuousClock.now
+        let gone = await ProcessTerminator.terminate(pids: pids, gracePeriod: .seconds(5))
+
+        #expect(gone == pids)
+        // Far below the grace period: nobody waited for it to run out
+        #expect(ContinuousClock.now - started < .seconds(2))
+    }
+
+    @Test func escalatesForProcessesIgnoringTerm() async throws {
+        let stubborn = try spawn("trap '' TERM; while :; do sleep 1; done")
+        // Give the shell a moment to install its trap
+        try await Task.sleep(for: .milliseconds(200))
+        let pid = Int(stubborn.processIdentifier)
+
+        let gone = await ProcessTerminator.terminate(pids: [pid], gracePeriod: .milliseconds(200))
+
+        #expect(gone == [pid])
+        stubborn.waitUntilExit()
+        #expect(stubborn.terminationReason == .uncaughtSignal)
+        #expect(stubborn.terminationStatus == SIGKILL)
+    }
+
+    @Test func reportsAlreadyExitedProcesses() async throws {
+        let finished = try spawn("exit 0")
+        finished.waitUntilExit()
+        let pid = Int(finished.processIdentifier)
+
+        let gone = await ProcessTerminator.terminate(pids: [pid], gracePeriod: .milliseconds(100))
+
+        #expect(gone == [pid])
+    }
+}
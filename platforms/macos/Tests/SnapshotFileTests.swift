@@ -0,0 +1,131 @@
+import Foundation
+import Testing
+@testable import PortKiller
+@testable import PortSnapshot
+
+/**
+ * Tests for the shared port snapshot format and its publisher.
+ *
+ * These tests verify that encoded generations map back to the same ports, that
+ * readers reject files they can't trust, and that the publisher numbers
+ * generations and skips unchanged scans.
+ */
+struct SnapshotFileTests {
+
+    // MARK: - Test Fixtures
+
+    func temporaryURL() -> URL {
+        FileManager.default.temporaryDirectory
+            .appending(path: "SnapshotFileTests-\(UUID().uuidString)", directoryHint: .isDirectory)
+            .appending(path: "ports.snapshot")
+    }
+
+    func write(_ data: Data) throws -> URL {
+        let url = temporaryURL()
+        try SnapshotWriter.publish(data, to: url)
+        return url
+    }
+
+    // MARK: - Format Tests
+
+    @Test("Encoded generation reads back unchanged")
+    func roundTrip() throws {
+        let ports = [createPort(port: 3000), createPort(port: 5432, pid: 200, processName: "postgres")].map(SnapshotPort.init)
+        let url = try write(SnapshotWriter.encode(
+            ports: ports,
+            updated: [],
+            removed: [],
+            generation: 7,
+            previousGeneration: 6,
+            publisherPID: 4242,
+            flags: .headless
+        ))
+
+        let snapshot = try #require(SnapshotFile(contentsOf: url))
+        #expect(snapshot.ports == ports)
+        #expect(snapshot.generation == 7)
+        #expect(snapshot.previousGeneration == 6)
+        #expect(snapshot.publisherPID == 4242)
+        #expect(snapshot.flags.contains(.headless))
+    }
+
+    @Test("Updated and removed listeners are relative to the previous generation")
+    func updatedAndRemoved() throws {
+        let ports = [createPort(port: 3000), createPort(port: 8080, pid: 300)].map(SnapshotPort.init)
+        let url = try write(SnapshotWriter.encode(
+            ports: ports,
+            updated: [ports[1].key],
+            removed: [SnapshotPort.Key(port: 9000, pid: 400)],
+            generation: 2,
+            previousGeneration: 1
+        ))
+
+        let snapshot = try #require(SnapshotFile(contentsOf: url))
+        #expect(snapshot.updated == [ports[1]])
+        #expect(snapshot.removed == [SnapshotPort.Key(port: 9000, pid: 400)])
+    }
+
+    @Test("Lookup by port decodes only its listeners")
+    func portsOnPort() throws {
+        let ports = [createPort(port: 3000), createPort(port: 3000, pid: 101), createPort(port: 5173)].map(SnapshotPort.init)
+        let url = try write(SnapshotWriter.encode(ports: ports, updated: [], removed: [], generation: 1, previousGeneration: 0))
+
+        let snapshot = try #require(SnapshotFile(contentsOf: url))
+        #expect(snapshot.ports(on: 3000).map(\.pid) == [100, 101])
+        #expect(snapshot.ports(on: 8080).isEmpty)
+    }
+
+    @Test("Rejects files with a foreign magic, another version, or a truncated body")
+    func rejectsUntrustedFiles() throws {
+        let valid = SnapshotWriter.encode(ports: [createPort(port: 3000)].map(SnapshotPort.init), updated: [], removed: [], generation: 1, previousGeneration: 0)
+
+        var badMagic = valid
+        badMagic[0] ^= 0xFF
+        var badVersion = valid
+        badVersion[4] &+= 1
+        let truncated = valid.dropLast()
+
+        for data in [badMagic, badVersion, Data(truncated), Data(count: 8)] {
+            #expect(SnapshotFile(contentsOf: try write(data)) == nil)
+        }
+        #expect(SnapshotFile(contentsOf: temporaryURL()) == nil)
+    }
+
+    // MARK: - Publisher Tests
+
+    @Test("Publisher numbers generations and skips unchanged scans until forced")
+    func publisherGenerations() async throws {
+        let url = temporaryURL()
+        let publisher = SnapshotPublisher(url: url)
+        var differ = PortSnapshotDiffer()
+        let port = createPort(port: 3000)
+
+        await publisher.publish(differ.delta(for: [port]))
+        let first = try #require(SnapshotFile(contentsOf: url))
+        #expect(first.generation == 1)
+        #expect(first.updated.map(\.port) == [3000])
+
+        await publisher.publish(differ.delta(for: [port]))
+        #expect(SnapshotFile(contentsOf: url)?.generation == 1)
+
+        await publisher.publish(differ.delta(for: [port]), force: true)
+        #expect(SnapshotFile(contentsOf: url)?.generation == 2)
+
+        await publisher.publish(differ.delta(for: []))
+        let last = try #require(SnapshotFile(contentsOf: url))
+        #expect(last.generation == 3)
+        #expect(last.removed == [SnapshotPort.Key(port: 3000, pid: 100)])
+    }
+
+    @Test("Generations continue from another publisher's file")
+    func publisherContinuesGeneration() async throws {
+        let url = try write(SnapshotWriter.encode(ports: [], updated: [], removed: [], generation: 41, previousGeneration: 40))
+        var differ = PortSnapshotDiffer()
+
+        await SnapshotPublisher(url: url).publish(differ.delta(for: [createPort(port: 3000)]))
+
+        let snapshot = try #require(SnapshotFile(contentsOf: url))
+        #expect(snapshot.generation == 42)
+        #expect(snapshot.previousGeneration == 41)
+    }
+}
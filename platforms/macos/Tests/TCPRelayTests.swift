@@ -0,0 +1,141 @@
+import Foundation
+import Darwin
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for the in-process TCP relay.
+ *
+ * These tests run a relay between two loopback ports and verify that bytes
+ * flow both ways, that counters are kept, and that busy ports are reported.
+ */
+struct TCPRelayTests {
+
+    // MARK: - Test Fixtures
+
+    /// Binds a blocking IPv4 listener (loopback unless `anyAddress`) on an ephemeral port.
+    func makeListener(anyAddress: Bool = false) throws -> (descriptor: Int32, port: Int) {
+        let descriptor = socket(AF_INET, SOCK_STREAM, 0)
+        try #require(descriptor >= 0)
+
+        var addr = sockaddr_in()
+        addr.sin_len = UInt8(MemoryLayout<sockaddr_in>.size)
+        addr.sin_family = sa_family_t(AF_INET)
+        addr.sin_addr.s_addr = anyAddress ? INADDR_ANY : inet_addr("127.0.0.1")
+        var length = socklen_t(MemoryLayout<sockaddr_in>.size)
+
+        let bound = withUnsafeMutablePointer(to: &addr) {
+            $0.withMemoryRebound(to: sockaddr.self, capacity: 1) {
+                bind(descriptor, $0, length) == 0 && listen(descriptor, 8) == 0
+                    && getsockname(descriptor, $0, &length) == 0
+            }
+        }
+        try #require(bound)
+        return (descriptor, Int(in_port_t(bigEndian: addr.sin_port)))
+    }
+
+    /// Finds a port with nothing listening on it.
+    func unusedPort() throws -> Int {
+        let listener = try makeListener()
+        close(listener.descriptor)
+        return listener.port
+    }
+
+    /// Opens a blocking loopback connection (with a receive timeout) to `port`.
+    func connectTo(_ port: Int) throws -> Int32 {
+        let descriptor = socket(AF_INET, SOCK_STREAM, 0)
+        try #require(descriptor >= 0)
+
+        var timeout = timeval(tv_sec: 2, tv_usec: 0)
+        setsockopt(descriptor, SOL_SOCKET, SO_RCVTIMEO, &timeout, socklen_t(MemoryLayout<timeval>.size))
+
+        var addr = sockaddr_in()
+        addr.sin_len = UInt8(MemoryLayout<sockaddr_in>.size)
+        addr.sin_family = sa_family_t(AF_INET)
+        addr.sin_port = in_port_t(port).bigEndian
+        addr.sin_addr.s_addr = inet_addr("127.0.0.1")
+        let result = withUnsafePointer(to: &addr) {
+            $0.withMemoryRebound(to: sockaddr.self, capacity: 1) {
+                connect(descriptor, $0, socklen_t(MemoryLayout<sockaddr_in>.size))
+            }
+        }
+        try #require(result == 0)
+        return descriptor
+    }
+
+    func send(_ text: String, to descriptor: Int32) {
+        _ = Array(text.utf8).withUnsafeBytes { write(descriptor, $0.baseAddress, $0.count) }
+    }
+
+    func receive(_ count: Int, from descriptor: Int32) -> String {
+        var bytes: [UInt8] = []
+        var chunk = [UInt8](repeating: 0, count: count)
+        while bytes.count < count {
+            let read = chunk.withUnsafeMutableBytes { Darwin.read(descriptor, $0.baseAddress, count - bytes.count) }
+            guard read > 0 else { break }
+            bytes.append(contentsOf: chunk[0..<read])
+        }
+        return String(decoding: bytes, as: UTF8.self)
+    }
+
+    // MARK: - Relay Tests
+
+    @Test func relaysBytesInBothDirections() throws {
+        let target = try makeListener()
+        defer { close(target.descriptor) }
+        let relay = TCPRelay(listenPort: try unusedPort(), targetPort: target.port) { _, _ in }
+        try relay.start()
+        defer { relay.stop() }
+
+        let client = try connectTo(relay.listenPort)
+        defer { close(client) }
+        let upstream = accept(target.descriptor, nil, nil)
+        try #require(upstream >= 0)
+        defer { close(upstream) }
+
+        send("ping", to: client)
+        #expect(receive(4, from: upstream) == "ping")
+
+        send("pong!", to: upstream)
+        #expect(receive(5, from: client) == "pong!")
+
+        let stats = relay.statistics()
+        #expect(stats.totalConnections == 1)
+        #expect(stats.active.count == 1)
+        #expect(stats.totalBytesSent == 4)
+        #expect(stats.totalBytesReceived == 5)
+        #expect(stats.active.first?.connectLatency != nil)
+    }
+
+    @Test func isRunningUntilStopped() throws {
+        let relay = TCPRelay(listenPort: try unusedPort(), targetPort: try unusedPort()) { _, _ in }
+        try relay.start()
+        #expect(relay.isRunning)
+
+        relay.stop()
+        #expect(!relay.isRunning)
+    }
+
+    @Test func reportsBusyListenPort() throws {
+        // The relay listens on all interfaces, like socat
+        let busy = try makeListener(anyAddress: true)
+        defer { close(busy.descriptor) }
+
+        let relay = TCPRelay(listenPort: busy.port, targetPort: try unusedPort()) { _, _ in }
+
+        #expect(throws: TCPRelayError.self) {
+            try relay.start()
+        }
+    }
+
+    @Test func portCanBeReusedAfterStop() throws {
+        let port = try unusedPort()
+        let first = TCPRelay(listenPort: port, targetPort: try unusedPort()) { _, _ in }
+        try first.start()
+        first.stop()
+
+        let second = TCPRelay(listenPort: port, targetPort: try unusedPort()) { _, _ in }
+        try second.start()
+        second.stop()
+    }
+}
@@ -0,0 +1,105 @@
+import Foundation
+import Testing
+@testable import PortKiller
+
+/**
+ * Tests for TunnelMetrics rate derivation.
+ *
+ * These tests verify that series keep a fixed number of samples, that
+ * counters become per-second rates against the previous scrape, that a
+ * counter reset starts a new baseline, and that latency quantiles are
+ * interpolated from histogram bucket deltas.
+ */
+struct TunnelMetricsTests {
+
+    // MARK: - Test Fixtures
+
+    let start = ContinuousClock.now
+
+    func snapshot(requests: Double, sent: Double = 0, streams: Double = 0) -> CloudflaredMetricsSnapshot {
+        var snapshot = CloudflaredMetricsSnapshot()
+        snapshot.totalRequests = requests
+        snapshot.bytesSent = sent
+        snapshot.activeStreams = streams
+        return snapshot
+    }
+
+    func buckets(_ counts: [(Double, Double)]) -> [CloudflaredMetricsSnapshot.LatencyBucket] {
+        counts.map { .init(upperBound: $0.0, cumulativeCount: $0.1) }
+    }
+
+    // MARK: - Series Tests
+
+    @Test func seriesDropsOldestBeyondCapacity() {
+        var series = MetricSeries(capacity: 3)
+        for value in 1...5 {
+            series.append(Double(value))
+        }
+
+        #expect(series.values == [3, 4, 5])
+        #expect(series.latest == 5)
+    }
+
+    // MARK: - Rate Tests
+
+    @Test func derivesRatesFromSuccessiveScrapes() {
+        var metrics = TunnelMetrics(capacity: 10)
+
+        metrics.record(snapshot(requests: 100, sent: 1000), at: start)
+        #expect(!metrics.hasSamples)
+
+        metrics.record(snapshot(requests: 120, sent: 5000, streams: 3), at: start + .seconds(2))
+        #expect(metrics.requestsPerSecond.values == [10])
+        #expect(metrics.bytesOutPerSecond.values == [2000])
+        #expect(metrics.activeStreams.values == [3])
+    }
+
+    @Test func counterResetStartsNewBaseline() {
+        var metrics = TunnelMetrics(capacity: 10)
+
+        metrics.record(snapshot(requests: 500), at: start)
+        metrics.record(snapshot(requests: 4), at: start + .seconds(1))
+        #expect(!metrics.hasSamples)
+
+        metrics.record(snapshot(requests: 8), at: start + .seconds(3))
+        #expect(metrics.requestsPerSecond.values == [2])
+    }
+
+    @Test func idleIntervalKeepsPreviousLatency() {
+        var metrics = TunnelMetrics(capacity: 10)
+        var busy = snapshot(requests: 0)
+        busy.latencyBuckets = buckets([(10, 0), (100, 0), (.infinity, 0)])
+
+        metrics.record(busy, at: start)
+        metrics.record(busy, at: start + .seconds(1))
+        #expect(metrics.latencyP95.isEmpty)
+
+        busy.totalRequests = 100
+        busy.latencyBuckets = buckets([(10, 100), (100, 100), (.infinity, 100)])
+        metrics.record(busy, at: start + .seconds(2))
+        metrics.record(busy, at: start + .seconds(3))
+
+        #expect(metrics.latencyP95.values == [9.5, 9.5])
+        #expect(metrics.requestsPerSecond.values == [0, 100, 0])
+    }
+
+    // MARK: - Quantile Tests
+
+    @Test func interpolatesQuantileWithinBucket() {
+        let old = buckets([(10, 0), (100, 0), (.infinity, 0)])
+        let new = buckets([(10, 50), (100, 100), (.infinity, 100)])
+
+        // Rank 95 of 100 falls 45/50 of the way through the 10–100 ms bucket
+        #expect(TunnelMetrics.quantile(0.95, from: old, to: new) == 91)
+        #expect(TunnelMetrics.quantile(0.5, from: old, to: new) == 10)
+    }
+
+    @Test func quantileUsesOnlyNewObservations() {
+        let old = buckets([(10, 90), (100, 90), (.infinity, 90)])
+        let new = buckets([(10, 90), (100, 100), (.infinity, 110)])
+
+        // All 20 new observations are above 10 ms, half of them beyond the last bound
+        #expect(TunnelMetrics.quantile(0.95, from: old, to: new) == 100)
+        #expect(TunnelMetrics.quantile(0.95, from: new, to: new) == nil)
+    }
+}
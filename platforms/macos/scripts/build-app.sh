@@ -135,8 +135,13 @@ mkdir -p "$CONTENTS_DIR/Frameworks"
 
 echo "📋 Copying files..."
 cp "$BUILD_DIR/$APP_NAME" "$MACOS_DIR/"
+cp "$BUILD_DIR/portkiller-cli" "$MACOS_DIR/"
 cp "Resources/Info.plist" "$CONTENTS_DIR/"
 
+# Background scanner agent, registered from Settings through SMAppService
+mkdir -p "$CONTENTS_DIR/Library/LaunchAgents"
+cp Resources/LaunchAgents/*.plist "$CONTENTS_DIR/Library/LaunchAgents/"
+
 # Debug: List contents of build directory
 echo "📂 Contents of $BUILD_DIR:"
 ls -la "$BUILD_DIR/" | grep -E "\.bundle$|^total" || echo "  (no bundles found)"
@@ -0,0 +1,102 @@
+using System.Diagnostics;
+using System.Text.Json;
+
+namespace PortKiller.Benchmarks;
+
+/// <summary>
+/// Timing harness: a few untimed warmup runs, then the median of a fixed number of
+/// timed runs, checked against the budget in Baselines/windows.json.
+/// Budgets are absolute, so a shared CI runner only reports medians over them; they
+/// fail the run when enforced, on a machine whose speed the baseline was taken on.
+/// Failures are collected rather than thrown, so one run reports every regression.
+/// </summary>
+public sealed class Benchmark
+{
+    private const int WarmupIterations = 3;
+    private const int DefaultIterations = 25;
+
+    private readonly Baseline _baseline;
+    private readonly double _scale;
+    private readonly bool _enforce;
+
+    public List<string> Failures { get; } = new();
+
+    public Benchmark(Baseline baseline, double tolerance, bool enforce)
+    {
+        _baseline = baseline;
+        _enforce = enforce;
+#if DEBUG
+        _scale = tolerance * baseline.DebugMultiplier;
+#else
+        _scale = tolerance;
+#endif
+    }
+
+    /// <summary>
+    /// Times <paramref name="body"/> and, when enforced, records a failure if its median
+    /// is over budget.
+    /// The body returns what it computed, so the JIT can't drop the work.
+    /// </summary>
+    public TimeSpan Run<T>(string name, Func<T> body, int iterations = DefaultIterations)
+    {
+        for (var i = 0; i < WarmupIterations; i++)
+        {
+            GC.KeepAlive(body());
+        }
+
+        var samples = new TimeSpan[iterations];
+        for (var i = 0; i < iterations; i++)
+        {
+            var start = Stopwatch.GetTimestamp();
+            GC.KeepAlive(body());
+            samples[i] = Stopwatch.GetElapsedTime(start);
+        }
+        Array.Sort(samples);
+        var median = samples[iterations / 2];
+
+        if (!_baseline.BudgetsMilliseconds.TryGetValue(name, out var budgetMilliseconds))
+        {
+            Fail($"{name}: no budget in the baseline");
+            return median;
+        }
+
+        var budget = TimeSpan.FromMilliseconds(budgetMilliseconds * _scale);
+        var verdict = median <= budget ? "ok  " : _enforce ? "FAIL" : "SLOW";
+        Console.WriteLine($"{verdict} {name,-28} median {median.TotalMilliseconds,9:F3} ms  budget {budget.TotalMilliseconds,9:F3} ms  max {samples[^1].TotalMilliseconds,9:F3} ms");
+        if (median > budget && _enforce)
+            Failures.Add($"{name}: median {median.TotalMilliseconds:F3} ms over budget {budget.TotalMilliseconds:F3} ms");
+        return median;
+    }
+
+    public void Fail(string message)
+    {
+        Console.WriteLine($"FAIL {message}");
+        Failures.Add(message);
+    }
+}
+
+/// <summary>
+/// Budgets of one platform, read from Baselines/windows.json
+/// </summary>
+public sealed record Baseline(Dictionary<string, double> BudgetsMilliseconds, double DebugMultiplier, SoakBaseline Soak)
+{
+    public static Baseline Load()
+    {
+        var path = Path.Combine(AppContext.BaseDirectory, "Baselines", "windows.json");
+        var options = new JsonSerializerOptions { PropertyNameCaseInsensitive = true };
+        return JsonSerializer.Deserialize<Baseline>(File.ReadAllText(path), options)
+            ?? throw new InvalidDataException($"{path} is empty");
+    }
+}
+
+/// <summary>
+/// Soak parameters and the working-set growth it tolerates
+/// </summary>
+/// <param name="WarmupCycles">Cycles run before the starting working set is taken</param>
+/// <param name="ScanInterval">One real TCP table scan every this many cycles</param>
+public sealed record SoakBaseline(
+    int Cycles,
+    int WarmupCycles,
+    int SocketsPerCycle,
+    int ScanInterval,
+    double MaxWorkingSetGrowthMegabytes);
@@ -0,0 +1,69 @@
+using PortKiller.Models;
+using PortKiller.Services;
+
+namespace PortKiller.Benchmarks;
+
+/// <summary>
+/// Deterministic synthetic listeners, the Windows counterpart of the macOS
+/// BenchmarkFixtures: the same arguments always produce the same ports.
+/// </summary>
+public static class Fixtures
+{
+    /// <summary>Socket counts every size-dependent benchmark runs at</summary>
+    public static readonly int[] SocketCounts = [100, 1_000, 10_000];
+
+    /// <summary>Process names covering every process type</summary>
+    public static readonly string[] ProcessNames =
+    [
+        "node.exe", "postgres.exe", "nginx.exe", "Code.exe", "redis-server.exe",
+        "python.exe", "svchost.exe", "lsass.exe", "java.exe", "企业微信.exe",
+        "Docker Desktop.exe", "mongod.exe", "vite.exe", "httpd.exe", "sqlservr.exe", "dotnet.exe"
+    ];
+
+    /// <summary>
+    /// Listener of row <paramref name="index"/>: two sockets per process (IPv4 and IPv6).
+    /// <paramref name="generation"/> moves a tenth of the processes to new PIDs and ports,
+    /// cycling every four generations, so repeated scans see a bounded set of listeners.
+    /// </summary>
+    public static (int Pid, int Port, string Address) Listener(int index, int generation)
+    {
+        var process = index / 2;
+        var variant = process % 10 == generation % 10 ? generation % 4 : 0;
+        var pid = 1_000 + process + variant * 100_000;
+        var port = 1_024 + index + variant * 15_000;
+        return (pid, port, index % 2 == 0 ? "127.0.0.1" : "::1");
+    }
+
+    /// <summary>
+    /// Ports a scan builds for <paramref name="count"/> sockets, resolving metadata once
+    /// per process through <paramref name="cache"/> like PortScannerService does
+    /// </summary>
+    public static List<PortInfo> Ports(int count, int generation, ProcessMetadataCache cache)
+    {
+        var ports = new List<PortInfo>(count);
+        var present = new HashSet<int>();
+
+        for (var index = 0; index < count; index++)
+        {
+            var (pid, port, address) = Listener(index, generation);
+            present.Add(pid);
+
+            var identity = new ProcessIdentity(pid, pid * 10_000L);
+            if (!cache.TryGet(identity, out var metadata))
+            {
+                var name = ProcessNames[(index / 2) % ProcessNames.Length];
+                metadata = new ProcessMetadata(name, $@"C:\Program Files\{name} --port {port}", "DESKTOP\\user");
+                cache.Set(identity, metadata);
+            }
+            ports.Add(PortInfo.Active(port, pid, metadata.Name, address, metadata.User, metadata.Command));
+        }
+
+        cache.RetainOnly(present);
+        ports.Sort((a, b) => a.Port.CompareTo(b.Port));
+        return ports;
+    }
+
+    /// <summary>Ports of a synthetic scan with <paramref name="count"/> sockets and a cold cache</summary>
+    public static List<PortInfo> Ports(int count, int generation = 0) =>
+        Ports(count, generation, new ProcessMetadataCache());
+}
@@ -0,0 +1,134 @@
+using System.Collections.ObjectModel;
+using System.Diagnostics;
+using PortKiller.Helpers;
+using PortKiller.Models;
+using PortKiller.Services;
+
+namespace PortKiller.Benchmarks;
+
+/// <summary>
+/// Benchmarks and memory soak of the Windows scan and filter path.
+/// Usage: <c>dotnet run -c Release --project PortKiller.Benchmarks [-- --soak]</c>.
+/// PORTKILLER_BENCHMARK_TOLERANCE scales every budget (e.g. 2 on a slow machine).
+/// Exits non-zero if the soak's working set grows too much, a benchmark has no budget,
+/// or, with PORTKILLER_BENCHMARK_ENFORCE set, a median is over budget.
+/// </summary>
+public static class Program
+{
+    private static readonly HashSet<int> Favorites = [3_000, 5_432, 8_080];
+    private static readonly List<WatchedPort> Watched = [new WatchedPort { Port = 3_000 }, new WatchedPort { Port = 6_379 }];
+
+    public static async Task<int> Main(string[] args)
+    {
+        var baseline = Baseline.Load();
+        var tolerance = double.TryParse(Environment.GetEnvironmentVariable("PORTKILLER_BENCHMARK_TOLERANCE"), out var value) ? value : 1;
+        var enforce = Environment.GetEnvironmentVariable("PORTKILLER_BENCHMARK_ENFORCE") is not null;
+        var benchmark = new Benchmark(baseline, tolerance, enforce);
+
+        await RunBenchmarks(benchmark);
+        if (args.Contains("--soak"))
+            await RunSoak(benchmark, baseline.Soak);
+
+        foreach (var failure in benchmark.Failures)
+        {
+            Console.Error.WriteLine(failure);
+        }
+        return benchmark.Failures.Count == 0 ? 0 : 1;
+    }
+
+    private static async Task RunBenchmarks(Benchmark benchmark)
+    {
+        // The real listener table of this machine: size varies, so the budget is generous
+        var scanner = new PortScannerService();
+        await scanner.ScanPortsAsync();
+        benchmark.Run("scan.portTable", () => scanner.ScanPortsAsync().GetAwaiter().GetResult());
+
+        foreach (var count in Fixtures.SocketCounts)
+        {
+            // Warm cache with a tenth of the processes churned, as between two refreshes
+            var cache = new ProcessMetadataCache();
+            Fixtures.Ports(count, 0, cache);
+            var generation = 0;
+            benchmark.Run($"metadataCache.{count}", () => Fixtures.Ports(count, ++generation % 2, cache));
+
+            var ports = Fixtures.Ports(count);
+            var filter = new PortFilter { MinPort = 2_000 };
+            filter.ProcessTypes.Remove(ProcessType.System);
+            benchmark.Run($"filter.matches.{count}", () => ports.Where(p => filter.Matches(p, Favorites, Watched)).ToList());
+
+            var search = new PortFilter { SearchText = "code" };
+            benchmark.Run($"filter.search.{count}", () => ports.Where(p => search.Matches(p, Favorites, Watched)).ToList());
+
+            var next = Fixtures.Ports(count, 1);
+            var rows = new ObservableCollection<PortInfo>(ports);
+            var flip = false;
+            benchmark.Run($"state.syncRows.{count}", () =>
+            {
+                flip = !flip;
+                rows.SyncWith(flip ? next : ports, p => p.Key, (a, b) => a.HasSameDetails(b));
+                return rows;
+            });
+        }
+
+        var names = Fixtures.Ports(10_000).Select(p => p.ProcessName).ToArray();
+        benchmark.Run("processType.detect.10000", () => Array.ConvertAll(names, ProcessTypeExtensions.Detect));
+    }
+
+    /// <summary>
+    /// Simulated refreshes as MainViewModel runs them (resolve, sync rows, filter, sort),
+    /// with a real TCP table scan every few cycles. The working set after warmup and at
+    /// the end must not differ by more than the baseline allows.
+    /// </summary>
+    private static async Task RunSoak(Benchmark benchmark, SoakBaseline soak)
+    {
+        var scanner = new PortScannerService();
+        var cache = new ProcessMetadataCache();
+        var rows = new ObservableCollection<PortInfo>();
+        var filter = new PortFilter();
+        filter.ProcessTypes.Remove(ProcessType.System);
+
+        long baselineBytes = 0;
+        long peakGrowth = 0;
+        var stopwatch = Stopwatch.StartNew();
+
+        for (var cycle = 0; cycle < soak.Cycles; cycle++)
+        {
+            if (cycle == soak.WarmupCycles)
+                baselineBytes = WorkingSet();
+
+            using (PerformanceMonitor.Measure(PerformancePhase.Refresh))
+            {
+                var ports = Fixtures.Ports(soak.SocketsPerCycle, cycle, cache);
+                rows.SyncWith(ports, p => p.Key, (a, b) => a.HasSameDetails(b));
+                var filtered = ports
+                    .Where(p => filter.Matches(p, Favorites, Watched))
+                    .OrderBy(p => p.Port)
+                    .ToList();
+                GC.KeepAlive(filtered);
+            }
+
+            if (cycle % soak.ScanInterval == 0)
+                await scanner.ScanPortsAsync();
+            if (cycle > soak.WarmupCycles && cycle % 1_000 == 0)
+                peakGrowth = Math.Max(peakGrowth, WorkingSet() - baselineBytes);
+        }
+
+        var growthMegabytes = (WorkingSet() - baselineBytes) / (1024.0 * 1024.0);
+        var peakMegabytes = Math.Max(peakGrowth / (1024.0 * 1024.0), growthMegabytes);
+        Console.WriteLine($"soak: {soak.Cycles} cycles in {stopwatch.Elapsed.TotalSeconds:F1} s, working set grew {growthMegabytes:F1} MB (peak {peakMegabytes:F1} MB)");
+        if (growthMegabytes > soak.MaxWorkingSetGrowthMegabytes)
+            benchmark.Fail($"soak: working set grew {growthMegabytes:F1} MB, over {soak.MaxWorkingSetGrowthMegabytes} MB");
+        if (rows.Count != soak.SocketsPerCycle)
+            benchmark.Fail($"soak: {rows.Count} rows after the last sync, expected {soak.SocketsPerCycle}");
+    }
+
+    // After a full collection, so the number reflects what is still reachable plus native growth
+    private static long WorkingSet()
+    {
+        GC.Collect();
+        GC.WaitForPendingFinalizers();
+        GC.Collect();
+        using var process = Process.GetCurrentProcess();
+        return process.WorkingSet64;
+    }
+}
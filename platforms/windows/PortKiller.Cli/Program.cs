@@ -0,0 +1,122 @@
+using System.Text.Json;
+using PortKiller.Services;
+
+namespace PortKiller.Cli;
+
+/// <summary>
+/// <c>portkiller</c>: reads the port snapshot a running PortKiller serves instead of
+/// scanning, so scripts and terminals share the app's scan. Equivalent of the macOS
+/// portkiller-cli.
+/// <code>
+/// portkiller list [--json] [--refresh]
+/// portkiller who &lt;port&gt; [--json] [--refresh]
+/// portkiller watch [--json]
+/// </code>
+/// Exit status: 0 on success, 1 when <c>who</c> finds nothing, 2 when no PortKiller is
+/// running or the arguments are wrong.
+/// </summary>
+public static class Program
+{
+    private const string Usage = """
+        usage: portkiller list [--json] [--refresh]
+               portkiller who <port> [--json] [--refresh]
+               portkiller watch [--json]
+        """;
+
+    private static readonly JsonSerializerOptions PrettyJson = new(SnapshotProtocol.JsonOptions) { WriteIndented = true };
+
+    public static async Task<int> Main(string[] args)
+    {
+        var json = args.Contains("--json");
+        var refresh = args.Contains("--refresh");
+        var positional = args.Where(a => a is not ("--json" or "--refresh")).ToArray();
+
+        using var cancel = new CancellationTokenSource();
+        Console.CancelKeyPress += (_, e) =>
+        {
+            e.Cancel = true;
+            cancel.Cancel();
+        };
+
+        switch (positional)
+        {
+            case ["list"]:
+                return Write(await SnapshotPipeClient.ListAsync(refresh, cancel.Token), json);
+            case ["who", var argument] when int.TryParse(argument, out var port) && port is > 0 and <= 65_535:
+                var holders = await SnapshotPipeClient.WhoAsync(port, refresh, cancel.Token);
+                var status = Write(holders, json);
+                if (status == 0 && holders!.Ports.Count == 0)
+                {
+                    if (!json)
+                        Console.Error.WriteLine($"Nothing is listening on port {port}");
+                    return 1;
+                }
+                return status;
+            case ["watch"]:
+                return await WatchAsync(json, cancel.Token);
+            default:
+                Console.Error.WriteLine(Usage);
+                return 2;
+        }
+    }
+
+    private static int Write(SnapshotEvent? snapshot, bool json)
+    {
+        if (snapshot == null)
+            return NotRunning();
+
+        if (json)
+        {
+            Console.WriteLine(JsonSerializer.Serialize(snapshot.Ports, PrettyJson));
+            return 0;
+        }
+
+        Console.WriteLine("PORT\tPID\tPROCESS\tUSER\tADDRESS");
+        foreach (var port in snapshot.Ports)
+        {
+            Console.WriteLine($"{port.Port}\t{port.Pid}\t{port.ProcessName}\t{port.User}\t{port.Address}");
+        }
+        return 0;
+    }
+
+    // The first event is the full snapshot; print changes from there on
+    private static async Task<int> WatchAsync(bool json, CancellationToken token)
+    {
+        var received = false;
+        try
+        {
+            await foreach (var change in SnapshotPipeClient.WatchAsync(token))
+            {
+                var isFirst = !received;
+                received = true;
+                if (json)
+                {
+                    Console.WriteLine(JsonSerializer.Serialize(change, SnapshotProtocol.JsonOptions));
+                    continue;
+                }
+                if (isFirst)
+                    continue;
+
+                foreach (var port in change.Ports)
+                {
+                    Console.WriteLine($"+ {port.Port}\t{port.Pid}\t{port.ProcessName}");
+                }
+                foreach (var key in change.Removed)
+                {
+                    Console.WriteLine($"- {key.Port}\t{key.Pid}");
+                }
+            }
+        }
+        catch (OperationCanceledException)
+        {
+            return 0;
+        }
+        return received ? 0 : NotRunning();
+    }
+
+    private static int NotRunning()
+    {
+        Console.Error.WriteLine("PortKiller is not running. Start it, or run `PortKiller.exe --headless` in the background.");
+        return 2;
+    }
+}
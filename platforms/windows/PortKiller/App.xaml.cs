@@ -1,3 +1,5 @@
+using System.Linq;
+using System.Threading;
 using System.Windows;
 using Microsoft.Extensions.DependencyInjection;
 using PortKiller.Services;
@@ -27,6 +29,32 @@ public partial class App : Application
         Services = services.BuildServiceProvider();
     }
 
+    protected override void OnStartup(StartupEventArgs e)
+    {
+        base.OnStartup(e);
+
+        if (e.Args.Contains(HeadlessScanner.LaunchArgument))
+        {
+            RunHeadless();
+            return;
+        }
+
+        MainWindow = new MainWindow();
+        MainWindow.Show();
+    }
+
+    // Background scanner only: serves the snapshot pipe until logoff, or exits if
+    // another instance already does
+    private async void RunHeadless()
+    {
+        ShutdownMode = ShutdownMode.OnExplicitShutdown;
+        using var stop = new CancellationTokenSource();
+        SessionEnding += (_, _) => stop.Cancel();
+
+        await Services.GetRequiredService<HeadlessScanner>().RunAsync(stop.Token);
+        Shutdown();
+    }
+
     private void ConfigureServices(IServiceCollection services)
     {
         // Services
@@ -35,6 +63,9 @@ public partial class App : Application
         services.AddSingleton<SettingsService>();
         services.AddSingleton<NotificationService>();
         services.AddSingleton<TunnelService>();
+        services.AddSingleton<ProcessExitWatcher>();
+        services.AddSingleton<SnapshotPipeServer>();
+        services.AddSingleton<HeadlessScanner>();
 
         // ViewModels
         services.AddSingleton<MainViewModel>(sp => new MainViewModel(
@@ -42,6 +73,8 @@ public partial class App : Application
             sp.GetRequiredService<ProcessKillerService>(),
             sp.GetRequiredService<SettingsService>(),
             NotificationService.Instance,
+            sp.GetRequiredService<ProcessExitWatcher>(),
+            sp.GetRequiredService<SnapshotPipeServer>(),
             System.Windows.Threading.Dispatcher.CurrentDispatcher
         ));
         services.AddSingleton<TunnelViewModel>(sp => new TunnelViewModel(
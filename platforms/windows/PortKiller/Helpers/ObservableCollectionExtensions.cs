@@ -0,0 +1,81 @@
+using System.Collections.ObjectModel;
+
+namespace PortKiller.Helpers;
+
+/// <summary>
+/// Keyed, minimal updates for bound collections.
+/// Clearing and re-adding a bound ObservableCollection raises one CollectionChanged per
+/// item and makes WPF rebuild every row container, losing scroll position and selection;
+/// syncing by key only touches the rows that actually changed.
+/// </summary>
+public static class ObservableCollectionExtensions
+{
+    /// <summary>
+    /// Makes <paramref name="target"/> equal to <paramref name="source"/> (same keys, same
+    /// order) with the fewest Remove/Move/Insert/Replace operations.
+    /// Items whose key and details are unchanged keep their existing instance, so their
+    /// containers and UI state (e.g. a kill in progress) survive the update.
+    /// Keys must be unique within each list. Call on the dispatcher thread.
+    /// </summary>
+    public static void SyncWith<T, TKey>(
+        this ObservableCollection<T> target,
+        IReadOnlyList<T> source,
+        Func<T, TKey> keySelector,
+        Func<T, T, bool> hasSameDetails) where TKey : notnull
+    {
+        var sourceKeys = new HashSet<TKey>(source.Count);
+        foreach (var item in source)
+        {
+            sourceKeys.Add(keySelector(item));
+        }
+
+        // 1. Drop items that are gone (back to front keeps indices valid)
+        for (var i = target.Count - 1; i >= 0; i--)
+        {
+            if (!sourceKeys.Contains(keySelector(target[i])))
+            {
+                target.RemoveAt(i);
+            }
+        }
+
+        var existing = new Dictionary<TKey, T>(target.Count);
+        foreach (var item in target)
+        {
+            existing[keySelector(item)] = item;
+        }
+
+        // 2. Walk the source order; positions before i are final
+        for (var i = 0; i < source.Count; i++)
+        {
+            var wanted = source[i];
+            var key = keySelector(wanted);
+
+            if (existing.TryGetValue(key, out var current))
+            {
+                if (!EqualityComparer<TKey>.Default.Equals(keySelector(target[i]), key))
+                {
+                    target.Move(IndexOf(target, key, keySelector, from: i + 1), i);
+                }
+                if (!hasSameDetails(current, wanted))
+                {
+                    target[i] = wanted;
+                }
+            }
+            else
+            {
+                target.Insert(i, wanted);
+            }
+        }
+    }
+
+    private static int IndexOf<T, TKey>(ObservableCollection<T> target, TKey key, Func<T, TKey> keySelector, int from)
+        where TKey : notnull
+    {
+        for (var i = from; i < target.Count; i++)
+        {
+            if (EqualityComparer<TKey>.Default.Equals(keySelector(target[i]), key))
+                return i;
+        }
+        return -1;
+    }
+}
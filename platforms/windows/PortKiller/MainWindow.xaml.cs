@@ -112,6 +112,9 @@ public partial class MainWindow : Window
         await _viewModel.InitializeAsync();
         UpdateUI();
 
+        // Counts and empty state follow the lists, which change without a property change
+        _viewModel.PortListsUpdated += (s, e) => Dispatcher.Invoke(UpdateUI);
+
         // Subscribe to property changes
         _viewModel.PropertyChanged += (s, e) =>
         {
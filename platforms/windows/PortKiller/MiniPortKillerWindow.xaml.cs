@@ -1,7 +1,9 @@
+using System.Collections.ObjectModel;
 using System.Windows;
 using System.Windows.Controls;
 using System.Windows.Input;
 using Microsoft.Extensions.DependencyInjection;
+using PortKiller.Helpers;
 using PortKiller.Models;
 using PortKiller.ViewModels;
 using PortKiller.Services;
@@ -20,6 +22,9 @@ public partial class MiniPortKillerWindow : Window
     private bool _isManualRefresh = false; // Track manual refresh vs auto-refresh
     private bool _isClosing = false; // Track if window is closing to prevent UI updates
 
+    // Rows shown in PortsList, synced by key so unchanged rows keep their containers
+    private readonly ObservableCollection<PortInfo> _visiblePorts = new();
+
     public MiniPortKillerWindow()
     {
         InitializeComponent();
@@ -29,11 +34,10 @@ public partial class MiniPortKillerWindow : Window
         
         System.Diagnostics.Debug.WriteLine($"[MiniPortKiller] Constructor - TunnelViewModel has {_tunnelViewModel.Tunnels.Count} tunnels");
         
-        // Subscribe to the Ports collection changes directly
-        _viewModel.Ports.CollectionChanged += (s, e) =>
-        {
-            Dispatcher.Invoke(UpdatePortList);
-        };
+        PortsList.ItemsSource = _visiblePorts;
+
+        // One notification per refresh, after all of its collection changes are applied
+        _viewModel.PortListsUpdated += OnPortListsUpdated;
 
         // Also subscribe to scanning state changes to update immediately
         _viewModel.PropertyChanged += (s, e) =>
@@ -118,13 +122,17 @@ public partial class MiniPortKillerWindow : Window
         
         System.Diagnostics.Debug.WriteLine($"[MiniPortKiller] Filtered ports to display: {filteredPorts.Count}");
         
-        // Update ItemsSource - WPF will handle the diff automatically
-        PortsList.ItemsSource = filteredPorts;
+        _visiblePorts.SyncWith(filteredPorts, p => p.Key, (a, b) => a.HasSameDetails(b));
         PortCountText.Text = allPorts.Count.ToString(); // Show total count, not filtered
         
         EmptyStateText.Visibility = filteredPorts.Any() ? Visibility.Collapsed : Visibility.Visible;
     }
 
+    private void OnPortListsUpdated(object? sender, EventArgs e)
+    {
+        Dispatcher.Invoke(UpdatePortList);
+    }
+
     private void UpdateTunnelsList()
     {
         // Don't update UI if window is closing
@@ -279,6 +287,7 @@ public partial class MiniPortKillerWindow : Window
     {
         // Set closing flag to prevent UI updates
         _isClosing = true;
+        _viewModel.PortListsUpdated -= OnPortListsUpdated;
         
         // Stop and cleanup all timers
         try
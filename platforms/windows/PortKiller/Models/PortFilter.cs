@@ -55,6 +55,19 @@ public class PortFilter
         return true;
     }
 
+    /// <summary>
+    /// Independent copy, so filtering can run off the UI thread while the user keeps typing
+    /// </summary>
+    public PortFilter Clone() => new()
+    {
+        SearchText = SearchText,
+        MinPort = MinPort,
+        MaxPort = MaxPort,
+        ProcessTypes = new(ProcessTypes),
+        ShowOnlyFavorites = ShowOnlyFavorites,
+        ShowOnlyWatched = ShowOnlyWatched
+    };
+
     public void Reset()
     {
         SearchText = string.Empty;
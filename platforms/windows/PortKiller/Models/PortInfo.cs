@@ -87,6 +87,23 @@ public class PortInfo : INotifyPropertyChanged
         }
     }
 
+    /// <summary>
+    /// Identity of the listener across scans (the scanner reports one row per port and PID)
+    /// </summary>
+    public (int Port, int Pid) Key => (Port, Pid);
+
+    /// <summary>
+    /// Whether another scan's row for this listener shows the same details
+    /// (UI state such as <see cref="IsKilling"/> is not compared)
+    /// </summary>
+    public bool HasSameDetails(PortInfo other) =>
+        Key == other.Key &&
+        IsActive == other.IsActive &&
+        ProcessName == other.ProcessName &&
+        Address == other.Address &&
+        User == other.User &&
+        Command == other.Command;
+
     /// <summary>
     /// Formatted port number for display (e.g., ":3000")
     /// </summary>
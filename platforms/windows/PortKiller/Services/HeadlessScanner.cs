@@ -0,0 +1,70 @@
+using System;
+using System.Diagnostics;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace PortKiller.Services;
+
+/// <summary>
+/// PortKiller started with <c>--headless</c>: no window and no tray icon, just the scan
+/// loop feeding <see cref="SnapshotPipeServer"/> on the refresh interval and on request.
+/// Other instances and the portkiller CLI then read its snapshot instead of scanning.
+/// Equivalent of the macOS HeadlessScanner (launch agent).
+/// </summary>
+public sealed class HeadlessScanner
+{
+    public const string LaunchArgument = "--headless";
+
+    private readonly PortScannerService _scanner;
+    private readonly SnapshotPipeServer _server;
+    private readonly SettingsService _settings;
+    private readonly SemaphoreSlim _trigger = new(0, 1);
+
+    public HeadlessScanner(PortScannerService scanner, SnapshotPipeServer server, SettingsService settings)
+    {
+        _scanner = scanner;
+        _server = server;
+        _settings = settings;
+    }
+
+    /// <summary>
+    /// Scans until cancelled. Returns false right away if another instance already serves
+    /// the snapshot.
+    /// </summary>
+    public async Task<bool> RunAsync(CancellationToken token)
+    {
+        if (!_server.Start())
+            return false;
+
+        _server.RescanRequested += (_, _) => Trigger();
+        while (!token.IsCancellationRequested)
+        {
+            try
+            {
+                _server.Publish(await _scanner.ScanPortsAsync());
+                await _trigger.WaitAsync(TimeSpan.FromSeconds(Math.Max(1, _settings.GetRefreshInterval())), token);
+            }
+            catch (OperationCanceledException)
+            {
+                break;
+            }
+            catch (Exception ex)
+            {
+                Debug.WriteLine($"Headless scan failed: {ex.Message}");
+            }
+        }
+        return true;
+    }
+
+    // Requests arriving during a scan collapse into one follow-up scan
+    private void Trigger()
+    {
+        try
+        {
+            _trigger.Release();
+        }
+        catch (SemaphoreFullException)
+        {
+        }
+    }
+}
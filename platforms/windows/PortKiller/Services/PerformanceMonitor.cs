@@ -0,0 +1,254 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Diagnostics.Tracing;
+using System.Numerics;
+
+namespace PortKiller.Services;
+
+/// <summary>
+/// Work timed by <see cref="PerformanceMonitor"/>, one histogram and counter pair each
+/// </summary>
+public enum PerformancePhase
+{
+    /// <summary>One whole ScanPortsAsync</summary>
+    Scan,
+    /// <summary>Reading the IPv4 and IPv6 listener tables</summary>
+    TableQuery,
+    /// <summary>Name, owner and command line of listener processes</summary>
+    ResolveMetadata,
+    /// <summary>One RefreshPortsAsync pass: scan, merge, filter, apply</summary>
+    Refresh,
+    /// <summary>BuildFilteredPorts</summary>
+    FilterPorts,
+    /// <summary>Parsing one line of cloudflared output</summary>
+    TunnelOutput
+}
+
+/// <summary>
+/// Times scan and refresh phases into an in-memory histogram per phase and reports them
+/// through <see cref="PerformanceEventSource"/>. Equivalent of the macOS
+/// PerformanceMonitor (os_signpost).
+/// Usage: <c>using (PerformanceMonitor.Measure(PerformancePhase.Scan)) { ... }</c>
+/// </summary>
+public static class PerformanceMonitor
+{
+    private static readonly LatencyHistogram[] Histograms =
+        Array.ConvertAll(Enum.GetValues<PerformancePhase>(), _ => new LatencyHistogram());
+
+    /// <summary>
+    /// Starts timing <paramref name="phase"/>; the measurement ends when the scope is disposed
+    /// </summary>
+    public static PhaseScope Measure(PerformancePhase phase)
+    {
+        PerformanceEventSource.Log.PhaseStart(phase);
+        return new PhaseScope(phase, Stopwatch.GetTimestamp());
+    }
+
+    public static void Record(PerformancePhase phase, TimeSpan duration)
+    {
+        Histograms[(int)phase].Record(duration);
+    }
+
+    /// <summary>
+    /// p50/p99/max of a phase since launch (or the last reset), null if never measured
+    /// </summary>
+    public static PhaseSummary? Summary(PerformancePhase phase) => Histograms[(int)phase].Summarize(phase);
+
+    public static void Reset()
+    {
+        foreach (var histogram in Histograms)
+        {
+            histogram.Reset();
+        }
+    }
+
+    public readonly struct PhaseScope : IDisposable
+    {
+        private readonly PerformancePhase _phase;
+        private readonly long _start;
+
+        internal PhaseScope(PerformancePhase phase, long start)
+        {
+            _phase = phase;
+            _start = start;
+        }
+
+        public void Dispose()
+        {
+            var elapsed = Stopwatch.GetElapsedTime(_start);
+            Record(_phase, elapsed);
+            PerformanceEventSource.Log.PhaseStop(_phase, elapsed.TotalMilliseconds);
+        }
+    }
+}
+
+/// <summary>
+/// Latency summary of one phase
+/// </summary>
+public sealed record PhaseSummary(PerformancePhase Phase, long Count, TimeSpan P50, TimeSpan P99, TimeSpan Max);
+
+/// <summary>
+/// Log-linear histogram of durations in ticks: each power of two is split into
+/// eight linear buckets, so a quantile is off by at most 1/8 of its value.
+/// Same bucketing as the macOS LatencyHistogram.
+/// </summary>
+internal sealed class LatencyHistogram
+{
+    private const int SubBucketBits = 3;
+    private const int SubBucketCount = 1 << SubBucketBits;
+    private const int BucketCount = (64 - SubBucketBits + 1) * SubBucketCount;
+
+    private readonly long[] _buckets = new long[BucketCount];
+    private readonly object _lock = new();
+    private long _count;
+    private long _maxTicks;
+
+    public void Record(TimeSpan duration)
+    {
+        var ticks = Math.Max(0, duration.Ticks);
+        lock (_lock)
+        {
+            _buckets[BucketIndex((ulong)ticks)]++;
+            _count++;
+            _maxTicks = Math.Max(_maxTicks, ticks);
+        }
+    }
+
+    public PhaseSummary? Summarize(PerformancePhase phase)
+    {
+        lock (_lock)
+        {
+            if (_count == 0)
+                return null;
+            return new PhaseSummary(phase, _count, Quantile(0.5), Quantile(0.99), TimeSpan.FromTicks(_maxTicks));
+        }
+    }
+
+    public void Reset()
+    {
+        lock (_lock)
+        {
+            Array.Clear(_buckets);
+            _count = 0;
+            _maxTicks = 0;
+        }
+    }
+
+    // Midpoint of the bucket holding the rank, never more than was observed. Caller holds _lock.
+    private TimeSpan Quantile(double q)
+    {
+        var rank = Math.Max(1, (long)Math.Ceiling(q * _count));
+        long seen = 0;
+        for (var index = 0; index < _buckets.Length; index++)
+        {
+            seen += _buckets[index];
+            if (_buckets[index] > 0 && seen >= rank)
+            {
+                var (lower, width) = Bounds(index);
+                return TimeSpan.FromTicks(Math.Min((long)(lower + width / 2), _maxTicks));
+            }
+        }
+        return TimeSpan.FromTicks(_maxTicks);
+    }
+
+    private static int BucketIndex(ulong value)
+    {
+        if (value < SubBucketCount)
+            return (int)value;
+        var exponent = 63 - BitOperations.LeadingZeroCount(value);
+        var mantissa = (int)(value >> (exponent - SubBucketBits)) & (SubBucketCount - 1);
+        return (exponent - SubBucketBits + 1) * SubBucketCount + mantissa;
+    }
+
+    private static (ulong Lower, ulong Width) Bounds(int index)
+    {
+        if (index < SubBucketCount)
+            return ((ulong)index, 1);
+        var exponent = index / SubBucketCount + SubBucketBits - 1;
+        var mantissa = (ulong)(index % SubBucketCount);
+        var width = 1UL << (exponent - SubBucketBits);
+        return (((ulong)SubBucketCount + mantissa) * width, width);
+    }
+}
+
+/// <summary>
+/// ETW provider "PortKiller-Performance": a Start/Stop event pair per measured phase
+/// (visible in PerfView and WPA) and p50/p99 counters per phase, e.g.
+/// <c>dotnet-counters monitor -n PortKiller --counters PortKiller-Performance</c>.
+/// Counters are only created once a listener enables them.
+/// </summary>
+[EventSource(Name = "PortKiller-Performance")]
+public sealed class PerformanceEventSource : EventSource
+{
+    public static readonly PerformanceEventSource Log = new();
+
+    private readonly List<DiagnosticCounter> _counters = new();
+
+    private PerformanceEventSource()
+    {
+    }
+
+    [Event(1, Opcode = EventOpcode.Start, Level = EventLevel.Informational)]
+    public void PhaseStart(PerformancePhase phase)
+    {
+        if (IsEnabled())
+            WriteEvent(1, (int)phase);
+    }
+
+    [Event(2, Opcode = EventOpcode.Stop, Level = EventLevel.Informational)]
+    public void PhaseStop(PerformancePhase phase, double milliseconds)
+    {
+        if (IsEnabled())
+            WriteEvent(2, (int)phase, milliseconds);
+    }
+
+    // EventSource has no (int, double) overload, and the params object[] fallback would
+    // box both arguments on every measured phase
+    [NonEvent]
+    private unsafe void WriteEvent(int eventId, int arg1, double arg2)
+    {
+        var data = stackalloc EventData[2];
+        data[0] = new EventData { DataPointer = (IntPtr)(&arg1), Size = sizeof(int) };
+        data[1] = new EventData { DataPointer = (IntPtr)(&arg2), Size = sizeof(double) };
+        WriteEventCore(eventId, 2, data);
+    }
+
+    protected override void OnEventCommand(EventCommandEventArgs command)
+    {
+        if (command.Command != EventCommand.Enable || _counters.Count > 0)
+            return;
+
+        foreach (var phase in Enum.GetValues<PerformancePhase>())
+        {
+            _counters.Add(new PollingCounter($"{phase}-p50", this,
+                () => PerformanceMonitor.Summary(phase)?.P50.TotalMilliseconds ?? 0)
+            {
+                DisplayName = $"{phase} p50",
+                DisplayUnits = "ms"
+            });
+            _counters.Add(new PollingCounter($"{phase}-p99", this,
+                () => PerformanceMonitor.Summary(phase)?.P99.TotalMilliseconds ?? 0)
+            {
+                DisplayName = $"{phase} p99",
+                DisplayUnits = "ms"
+            });
+        }
+        _counters.Add(new PollingCounter("working-set", this,
+            () => Environment.WorkingSet / (1024.0 * 1024.0))
+        {
+            DisplayName = "Working Set",
+            DisplayUnits = "MB"
+        });
+    }
+
+    protected override void Dispose(bool disposing)
+    {
+        foreach (var counter in _counters)
+        {
+            counter.Dispose();
+        }
+        _counters.Clear();
+        base.Dispose(disposing);
+    }
+}
@@ -3,9 +3,9 @@ using System.Collections.Generic;
 using System.Diagnostics;
 using System.Linq;
 using System.Net.NetworkInformation;
+using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 using System.Runtime.Versioning;
-using System.Security.Principal;
 using System.Threading.Tasks;
 using PortKiller.Models;
 
@@ -13,7 +13,8 @@ namespace PortKiller.Services;
 
 /// <summary>
 /// Service for scanning listening TCP ports on Windows.
-/// Uses GetExtendedTcpTable Win32 API for best performance and accuracy.
+/// Uses GetExtendedTcpTable Win32 API for best performance and accuracy:
+/// only listener rows are requested, and they are read in place from a reused buffer.
 /// </summary>
 [SupportedOSPlatform("windows")]
 public class PortScannerService
@@ -21,7 +22,7 @@ public class PortScannerService
     // Win32 API imports for TCP table
     [DllImport("iphlpapi.dll", SetLastError = true)]
     private static extern uint GetExtendedTcpTable(
-        IntPtr pTcpTable,
+        byte[] pTcpTable,
         ref int dwOutBufLen,
         bool sort,
         int ipVersion,
@@ -41,62 +42,63 @@ public class PortScannerService
         TCP_TABLE_OWNER_MODULE_ALL = 8
     }
 
+    // Blittable row layouts, read in place from the table buffer (no per-row marshalling)
     [StructLayout(LayoutKind.Sequential)]
-    private struct MIB_TCPROW_OWNER_PID
+    private readonly struct MIB_TCPROW_OWNER_PID
     {
-        public uint state;
-        public uint localAddr;
-        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 4)]
-        public byte[] localPort;
-        public uint remoteAddr;
-        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 4)]
-        public byte[] remotePort;
-        public int owningPid;
-
-        public ushort LocalPort => BitConverter.ToUInt16(new byte[2] { localPort[1], localPort[0] }, 0);
-        public string LocalAddress => new System.Net.IPAddress(localAddr).ToString();
+        public readonly uint state;
+        public readonly uint localAddr;
+        public readonly uint localPort;
+        public readonly uint remoteAddr;
+        public readonly uint remotePort;
+        public readonly int owningPid;
+
+        public int LocalPort => NetworkPort(localPort);
     }
 
-    [StructLayout(LayoutKind.Sequential)]
-    private struct MIB_TCPTABLE_OWNER_PID
-    {
-        public uint dwNumEntries;
-        [MarshalAs(UnmanagedType.ByValArray, ArraySubType = UnmanagedType.Struct, SizeConst = 1)]
-        public MIB_TCPROW_OWNER_PID[] table;
-    }
-
-    // IPv6 structures
-    [StructLayout(LayoutKind.Sequential)]
-    private struct MIB_TCP6ROW_OWNER_PID
+    [InlineArray(16)]
+    private struct IPv6AddressBytes
     {
-        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 16)]
-        public byte[] localAddr;
-        public uint localScopeId;
-        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 4)]
-        public byte[] localPort;
-        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 16)]
-        public byte[] remoteAddr;
-        public uint remoteScopeId;
-        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 4)]
-        public byte[] remotePort;
-        public uint state;
-        public int owningPid;
-
-        public ushort LocalPort => BitConverter.ToUInt16(new byte[2] { localPort[1], localPort[0] }, 0);
-        public string LocalAddress => new System.Net.IPAddress(localAddr).ToString();
+        private byte _element0;
     }
 
     [StructLayout(LayoutKind.Sequential)]
-    private struct MIB_TCP6TABLE_OWNER_PID
+    private readonly struct MIB_TCP6ROW_OWNER_PID
     {
-        public uint dwNumEntries;
-        [MarshalAs(UnmanagedType.ByValArray, ArraySubType = UnmanagedType.Struct, SizeConst = 1)]
-        public MIB_TCP6ROW_OWNER_PID[] table;
+        public readonly IPv6AddressBytes localAddr;
+        public readonly uint localScopeId;
+        public readonly uint localPort;
+        public readonly IPv6AddressBytes remoteAddr;
+        public readonly uint remoteScopeId;
+        public readonly uint remotePort;
+        public readonly uint state;
+        public readonly int owningPid;
+
+        public int LocalPort => NetworkPort(localPort);
+        public string LocalAddress => new System.Net.IPAddress(localAddr, localScopeId).ToString();
     }
 
     private const int AF_INET = 2;  // IPv4
     private const int AF_INET6 = 23; // IPv6
-    private const uint MIB_TCP_STATE_LISTEN = 2;
+    private const uint ERROR_INSUFFICIENT_BUFFER = 122;
+
+    // The table can grow between the size query and the read; retry this many times
+    private const int MaxTableQueryAttempts = 3;
+    private const int InitialTableBufferSize = 16 * 1024;
+    private const int TableBufferHeadroom = 4 * 1024;
+
+    // Reused across scans; grown when a table doesn't fit
+    private byte[] _tableBuffer = new byte[InitialTableBufferSize];
+    private readonly object _tableLock = new();
+
+    // Listeners mostly bind a handful of IPv4 addresses (0.0.0.0, 127.0.0.1, ...)
+    private readonly Dictionary<uint, string> _ipv4AddressStrings = new();
+
+    // Longest command line shown before truncating with "..."
+    private const int MaxCommandLength = 200;
+
+    // Survives across scans; evicted as PIDs leave the TCP table
+    private readonly ProcessMetadataCache _metadataCache = new();
 
     /// <summary>
     /// Scans all listening TCP ports using Windows API.
@@ -106,88 +108,42 @@ public class PortScannerService
     {
         return await Task.Run(() =>
         {
+            using var scan = PerformanceMonitor.Measure(PerformancePhase.Scan);
             try
             {
-                var ports = new List<PortInfo>();
-                var processCache = new Dictionary<int, (string name, string command, string user)>();
-
-                // Scan IPv4 ports
-                var tcpRows = GetAllTcpConnections();
-                var listeningRows = tcpRows.Where(row => row.state == MIB_TCP_STATE_LISTEN).ToList();
-
-                foreach (var row in listeningRows)
+                var listeners = new List<(int pid, int port, string address)>();
+                using (PerformanceMonitor.Measure(PerformancePhase.TableQuery))
                 {
-                    try
+                    lock (_tableLock)
                     {
-                        var pid = row.owningPid;
-                        var port = row.LocalPort;
-                        var address = row.LocalAddress;
-
-                        // Get process info (with caching)
-                        if (!processCache.TryGetValue(pid, out var processInfo))
-                        {
-                            processInfo = GetProcessInfo(pid);
-                            processCache[pid] = processInfo;
-                        }
-
-                        var portInfo = PortInfo.Active(
-                            port: port,
-                            pid: pid,
-                            processName: processInfo.name,
-                            address: address,
-                            user: processInfo.user,
-                            command: processInfo.command);
-                        
-                        // Explicitly set IsKilling to false when creating new Active ports
-                        portInfo.IsKilling = false;
-                        portInfo.IsConfirmingKill = false;
-
-                        ports.Add(portInfo);
-                    }
-                    catch
-                    {
-                        // Skip ports we can't get info for
-                        continue;
+                        AddIPv4Listeners(listeners);
+                        AddIPv6Listeners(listeners);
                     }
                 }
 
-                // Scan IPv6 ports
-                var tcp6Rows = GetAllTcp6Connections();
-                var listening6Rows = tcp6Rows.Where(row => row.state == MIB_TCP_STATE_LISTEN).ToList();
+                Dictionary<int, ProcessMetadata> metadata;
+                using (PerformanceMonitor.Measure(PerformancePhase.ResolveMetadata))
+                {
+                    metadata = ResolveProcessMetadata(listeners.Select(l => l.pid).ToHashSet());
+                }
+                var ports = new List<PortInfo>(listeners.Count);
 
-                foreach (var row in listening6Rows)
+                foreach (var (pid, port, address) in listeners)
                 {
-                    try
-                    {
-                        var pid = row.owningPid;
-                        var port = row.LocalPort;
-                        var address = row.LocalAddress;
-
-                        // Get process info (with caching)
-                        if (!processCache.TryGetValue(pid, out var processInfo))
-                        {
-                            processInfo = GetProcessInfo(pid);
-                            processCache[pid] = processInfo;
-                        }
-
-                        var portInfo = PortInfo.Active(
-                            port: port,
-                            pid: pid,
-                            processName: processInfo.name,
-                            address: address,
-                            user: processInfo.user,
-                            command: processInfo.command);
-                        
-                        portInfo.IsKilling = false;
-                        portInfo.IsConfirmingKill = false;
-
-                        ports.Add(portInfo);
-                    }
-                    catch
-                    {
-                        // Skip ports we can't get info for
-                        continue;
-                    }
+                    var processInfo = metadata[pid];
+                    var portInfo = PortInfo.Active(
+                        port: port,
+                        pid: pid,
+                        processName: processInfo.Name,
+                        address: address,
+                        user: processInfo.User,
+                        command: processInfo.Command);
+
+                    // Explicitly set IsKilling to false when creating new Active ports
+                    portInfo.IsKilling = false;
+                    portInfo.IsConfirmingKill = false;
+
+                    ports.Add(portInfo);
                 }
 
                 // Remove duplicates (same port + pid)
@@ -206,210 +162,159 @@ public class PortScannerService
     }
 
     /// <summary>
-    /// Gets all TCP connections using Win32 API
+    /// Reads IPv4 listeners straight out of the TCP_TABLE_OWNER_PID_LISTENER table
     /// </summary>
-    private List<MIB_TCPROW_OWNER_PID> GetAllTcpConnections()
+    private void AddIPv4Listeners(List<(int pid, int port, string address)> listeners)
     {
-        var tcpRows = new List<MIB_TCPROW_OWNER_PID>();
-        int bufferSize = 0;
-
-        // First call to get buffer size
-        uint result = GetExtendedTcpTable(
-            IntPtr.Zero,
-            ref bufferSize,
-            true,
-            AF_INET,
-            TCP_TABLE_CLASS.TCP_TABLE_OWNER_PID_ALL,
-            0);
-
-        IntPtr tcpTablePtr = Marshal.AllocHGlobal(bufferSize);
-
-        try
+        foreach (ref readonly var row in QueryListenerTable<MIB_TCPROW_OWNER_PID>(AF_INET))
         {
-            // Second call to get actual data
-            result = GetExtendedTcpTable(
-                tcpTablePtr,
-                ref bufferSize,
-                true,
-                AF_INET,
-                TCP_TABLE_CLASS.TCP_TABLE_OWNER_PID_ALL,
-                0);
-
-            if (result != 0)
-                return tcpRows;
-
-            var table = Marshal.PtrToStructure<MIB_TCPTABLE_OWNER_PID>(tcpTablePtr);
-            var rowPtr = (IntPtr)((long)tcpTablePtr + Marshal.SizeOf(table.dwNumEntries));
-
-            for (int i = 0; i < table.dwNumEntries; i++)
+            if (!_ipv4AddressStrings.TryGetValue(row.localAddr, out var address))
             {
-                var row = Marshal.PtrToStructure<MIB_TCPROW_OWNER_PID>(rowPtr);
-                tcpRows.Add(row);
-                rowPtr = (IntPtr)((long)rowPtr + Marshal.SizeOf<MIB_TCPROW_OWNER_PID>());
+                address = new System.Net.IPAddress(row.localAddr).ToString();
+                _ipv4AddressStrings[row.localAddr] = address;
             }
+            listeners.Add((row.owningPid, row.LocalPort, address));
         }
-        finally
+    }
+
+    /// <summary>
+    /// Reads IPv6 listeners straight out of the TCP_TABLE_OWNER_PID_LISTENER table
+    /// </summary>
+    private void AddIPv6Listeners(List<(int pid, int port, string address)> listeners)
+    {
+        foreach (ref readonly var row in QueryListenerTable<MIB_TCP6ROW_OWNER_PID>(AF_INET6))
         {
-            Marshal.FreeHGlobal(tcpTablePtr);
+            listeners.Add((row.owningPid, row.LocalPort, row.LocalAddress));
         }
-
-        return tcpRows;
     }
 
     /// <summary>
-    /// Gets all IPv6 TCP connections using Win32 API
+    /// Fills the shared table buffer with listening sockets only, and returns its rows
+    /// as a span over that buffer. Valid until the next query; callers hold _tableLock.
+    /// Grows the buffer and retries when the table outgrows it between calls.
     /// </summary>
-    private List<MIB_TCP6ROW_OWNER_PID> GetAllTcp6Connections()
+    private ReadOnlySpan<TRow> QueryListenerTable<TRow>(int ipVersion) where TRow : struct
     {
-        var tcpRows = new List<MIB_TCP6ROW_OWNER_PID>();
-        int bufferSize = 0;
-
-        // First call to get buffer size
-        uint result = GetExtendedTcpTable(
-            IntPtr.Zero,
-            ref bufferSize,
-            true,
-            AF_INET6,
-            TCP_TABLE_CLASS.TCP_TABLE_OWNER_PID_ALL,
-            0);
-
-        if (bufferSize == 0)
-            return tcpRows;
-
-        IntPtr tcpTablePtr = Marshal.AllocHGlobal(bufferSize);
-
-        try
+        for (var attempt = 0; attempt < MaxTableQueryAttempts; attempt++)
         {
-            // Second call to get actual data
-            result = GetExtendedTcpTable(
-                tcpTablePtr,
+            var bufferSize = _tableBuffer.Length;
+            var result = GetExtendedTcpTable(
+                _tableBuffer,
                 ref bufferSize,
                 true,
-                AF_INET6,
-                TCP_TABLE_CLASS.TCP_TABLE_OWNER_PID_ALL,
+                ipVersion,
+                TCP_TABLE_CLASS.TCP_TABLE_OWNER_PID_LISTENER,
                 0);
 
-            if (result != 0)
-                return tcpRows;
-
-            var numEntries = Marshal.ReadInt32(tcpTablePtr);
-            var rowPtr = (IntPtr)((long)tcpTablePtr + sizeof(int));
-
-            for (int i = 0; i < numEntries; i++)
+            if (result == ERROR_INSUFFICIENT_BUFFER)
             {
-                var row = Marshal.PtrToStructure<MIB_TCP6ROW_OWNER_PID>(rowPtr);
-                tcpRows.Add(row);
-                rowPtr = (IntPtr)((long)rowPtr + Marshal.SizeOf<MIB_TCP6ROW_OWNER_PID>());
+                _tableBuffer = new byte[bufferSize + TableBufferHeadroom];
+                continue;
             }
-        }
-        finally
-        {
-            Marshal.FreeHGlobal(tcpTablePtr);
+
+            if (result != 0)
+                return ReadOnlySpan<TRow>.Empty;
+
+            // MIB_TCPTABLE_OWNER_PID / MIB_TCP6TABLE_OWNER_PID: DWORD dwNumEntries, then the rows
+            var table = _tableBuffer.AsSpan(0, bufferSize);
+            var numEntries = (int)MemoryMarshal.Read<uint>(table);
+            var rows = MemoryMarshal.Cast<byte, TRow>(table.Slice(sizeof(uint)));
+            return rows.Slice(0, Math.Min(numEntries, rows.Length));
         }
 
-        return tcpRows;
+        Debug.WriteLine($"TCP table (family {ipVersion}) kept outgrowing the buffer");
+        return ReadOnlySpan<TRow>.Empty;
     }
 
     /// <summary>
-    /// Gets detailed process information (name, command line, user)
+    /// The low 16 bits of a row's port DWORD hold the port in network byte order
+    /// </summary>
+    private static int NetworkPort(uint port) =>
+        (int)(((port & 0xFF) << 8) | ((port >> 8) & 0xFF));
+
+    /// <summary>
+    /// Returns metadata for every listening PID. Processes seen in earlier scans
+    /// (same PID and creation time) come from the cache; new ones are read natively,
+    /// and any command lines the native query couldn't read are fetched with one
+    /// batched WMI query instead of one query per PID.
     /// </summary>
-    private (string name, string command, string user) GetProcessInfo(int pid)
+    private Dictionary<int, ProcessMetadata> ResolveProcessMetadata(HashSet<int> pids)
     {
-        try
+        var resolved = new Dictionary<int, ProcessMetadata>(pids.Count);
+        var pending = new List<(ProcessIdentity identity, string name, string? imagePath, string user)>();
+
+        foreach (var pid in pids)
         {
-            using var process = Process.GetProcessById(pid);
-            var name = process.ProcessName;
-            
-            // Try to get full command line
-            string command;
+            var handle = ProcessInspector.Open(pid);
             try
             {
-                // Use WMI to get command line
-                command = GetProcessCommandLine(pid) ?? process.MainModule?.FileName ?? name;
-                
-                // Truncate if too long
-                if (command.Length > 200)
-                    command = command.Substring(0, 200) + "...";
-            }
-            catch
-            {
-                command = name;
-            }
+                var identity = new ProcessIdentity(pid, ProcessInspector.GetCreationTime(handle));
+                if (_metadataCache.TryGet(identity, out var cached))
+                {
+                    resolved[pid] = cached;
+                    continue;
+                }
 
-            // Get process owner (user)
-            string user;
-            try
-            {
-                user = GetProcessOwner(process) ?? Environment.UserName;
+                var imagePath = ProcessInspector.GetImagePath(handle);
+                var name = ProcessInspector.GetProcessName(imagePath) ?? GetProcessNameById(pid);
+                if (name == null)
+                {
+                    // Gone (or never inspectable); not cached so a later scan can retry
+                    resolved[pid] = new ProcessMetadata("Unknown", "Unknown", "Unknown");
+                    continue;
+                }
+
+                var user = ProcessInspector.GetOwner(handle) ?? Environment.UserName;
+                var commandLine = ProcessInspector.GetCommandLine(handle);
+                if (commandLine != null)
+                {
+                    var metadata = new ProcessMetadata(name, TruncateCommand(commandLine), user);
+                    _metadataCache.Set(identity, metadata);
+                    resolved[pid] = metadata;
+                }
+                else
+                {
+                    pending.Add((identity, name, imagePath, user));
+                }
             }
-            catch
+            finally
             {
-                user = Environment.UserName;
+                ProcessInspector.Close(handle);
             }
-
-            return (name, command, user);
-        }
-        catch
-        {
-            return ("Unknown", "Unknown", "Unknown");
         }
-    }
 
-    /// <summary>
-    /// Gets the command line of a process using WMI
-    /// </summary>
-    private string? GetProcessCommandLine(int pid)
-    {
-        try
+        if (pending.Count > 0)
         {
-            using var searcher = new System.Management.ManagementObjectSearcher(
-                $"SELECT CommandLine FROM Win32_Process WHERE ProcessId = {pid}");
-            using var objects = searcher.Get();
-            
-            foreach (System.Management.ManagementObject obj in objects)
+            var commandLines = ProcessInspector.GetCommandLinesViaWmi(pending.Select(p => p.identity.Pid).ToList());
+            foreach (var (identity, name, imagePath, user) in pending)
             {
-                return obj["CommandLine"]?.ToString();
+                var command = commandLines.GetValueOrDefault(identity.Pid) ?? imagePath ?? name;
+                var metadata = new ProcessMetadata(name, TruncateCommand(command), user);
+                _metadataCache.Set(identity, metadata);
+                resolved[identity.Pid] = metadata;
             }
         }
-        catch
-        {
-            // Ignore - we'll fallback to process name
-        }
-        return null;
+
+        _metadataCache.RetainOnly(pids);
+        return resolved;
     }
 
     /// <summary>
-    /// Gets the owner (username) of a process
+    /// Name lookup for processes we can't open (e.g. PID 4 "System")
     /// </summary>
-    private string? GetProcessOwner(Process process)
+    private static string? GetProcessNameById(int pid)
     {
         try
         {
-            var processHandle = process.Handle;
-            if (OpenProcessToken(processHandle, 8, out IntPtr tokenHandle))
-            {
-                try
-                {
-                    using var identity = new WindowsIdentity(tokenHandle);
-                    return identity.Name;
-                }
-                finally
-                {
-                    CloseHandle(tokenHandle);
-                }
-            }
+            using var process = Process.GetProcessById(pid);
+            return process.ProcessName;
         }
         catch
         {
-            // Ignore - we'll fallback
+            return null;
         }
-        return null;
     }
 
-    [DllImport("advapi32.dll", SetLastError = true)]
-    private static extern bool OpenProcessToken(IntPtr ProcessHandle, uint DesiredAccess, out IntPtr TokenHandle);
-
-    [DllImport("kernel32.dll", SetLastError = true)]
-    [return: MarshalAs(UnmanagedType.Bool)]
-    private static extern bool CloseHandle(IntPtr hObject);
+    private static string TruncateCommand(string command) =>
+        command.Length > MaxCommandLength ? command.Substring(0, MaxCommandLength) + "..." : command;
 }
@@ -0,0 +1,99 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using System.Runtime.Versioning;
+
+namespace PortKiller.Services;
+
+/// <summary>
+/// Raises <see cref="ProcessExited"/> as soon as a watched listener process exits.
+/// Backed by each process's wait handle (Process.Exited), so idle processes cost no polling.
+/// Equivalent of the macOS ProcessEventMonitor (kqueue EVFILT_PROC).
+/// </summary>
+[SupportedOSPlatform("windows")]
+public class ProcessExitWatcher : IDisposable
+{
+    // PIDs 0 (Idle) and 4 (System) cannot be opened
+    private const int MaxReservedPid = 4;
+
+    private readonly Dictionary<int, Process> _watched = new();
+    private readonly object _lock = new();
+
+    /// <summary>
+    /// Raised on a thread-pool thread when any watched process exits.
+    /// </summary>
+    public event EventHandler? ProcessExited;
+
+    /// <summary>
+    /// Replaces the watched PID set: opens wait handles for new PIDs and releases stale ones.
+    /// Processes we can't open (access denied, already gone) are left to the polling loop.
+    /// </summary>
+    public void Watch(IEnumerable<int> pids)
+    {
+        var wanted = new HashSet<int>(pids);
+
+        lock (_lock)
+        {
+            foreach (var pid in _watched.Keys.Where(p => !wanted.Contains(p)).ToList())
+            {
+                Release(pid);
+            }
+
+            foreach (var pid in wanted)
+            {
+                if (pid <= MaxReservedPid || _watched.ContainsKey(pid))
+                    continue;
+
+                Process? process = null;
+                try
+                {
+                    process = Process.GetProcessById(pid);
+                    process.EnableRaisingEvents = true;
+                    process.Exited += OnProcessExited;
+                    _watched[pid] = process;
+                }
+                catch
+                {
+                    process?.Dispose();
+                }
+            }
+        }
+    }
+
+    private void OnProcessExited(object? sender, EventArgs e)
+    {
+        if (sender is not Process process)
+            return;
+
+        lock (_lock)
+        {
+            var pid = _watched.FirstOrDefault(kv => ReferenceEquals(kv.Value, process)).Key;
+            if (pid != 0)
+                Release(pid);
+        }
+
+        ProcessExited?.Invoke(this, EventArgs.Empty);
+    }
+
+    private void Release(int pid)
+    {
+        if (_watched.Remove(pid, out var process))
+        {
+            process.Exited -= OnProcessExited;
+            process.Dispose();
+        }
+    }
+
+    public void Dispose()
+    {
+        lock (_lock)
+        {
+            foreach (var pid in _watched.Keys.ToList())
+            {
+                Release(pid);
+            }
+        }
+        GC.SuppressFinalize(this);
+    }
+}
@@ -0,0 +1,212 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Runtime.InteropServices;
+using System.Runtime.Versioning;
+using System.Security.Principal;
+using System.Text;
+
+namespace PortKiller.Services;
+
+/// <summary>
+/// Reads per-process metadata straight from the kernel via a single
+/// PROCESS_QUERY_LIMITED_INFORMATION handle: creation time, image path,
+/// command line (NtQueryInformationProcess) and owner token.
+/// No WMI round-trip unless the native command-line query is refused.
+/// Equivalent of the macOS ProcessInspector (sysctl / libproc).
+/// </summary>
+[SupportedOSPlatform("windows")]
+internal static class ProcessInspector
+{
+    private const uint PROCESS_QUERY_LIMITED_INFORMATION = 0x1000;
+    private const uint TOKEN_QUERY = 0x0008;
+    private const int ProcessCommandLineInformation = 60;
+    private const int STATUS_SUCCESS = 0;
+    private const int MaxImagePathLength = 1024;
+
+    // WQL has no IN operator; keep the OR chain well below the query length limit
+    private const int WmiBatchSize = 64;
+
+    /// <summary>
+    /// Opens a query handle, or IntPtr.Zero for processes we can't open
+    /// (System/Idle, protected processes, already exited).
+    /// </summary>
+    public static IntPtr Open(int pid) =>
+        OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, false, pid);
+
+    public static void Close(IntPtr handle)
+    {
+        if (handle != IntPtr.Zero)
+            CloseHandle(handle);
+    }
+
+    /// <summary>
+    /// Builds a reuse-safe identity from the process creation time.
+    /// Processes that can't be opened get creation time 0.
+    /// </summary>
+    public static ProcessIdentity GetIdentity(int pid)
+    {
+        var handle = Open(pid);
+        try
+        {
+            return new ProcessIdentity(pid, GetCreationTime(handle));
+        }
+        finally
+        {
+            Close(handle);
+        }
+    }
+
+    public static long GetCreationTime(IntPtr handle)
+    {
+        if (handle == IntPtr.Zero)
+            return 0;
+        return GetProcessTimes(handle, out var creation, out _, out _, out _) ? creation : 0;
+    }
+
+    /// <summary>
+    /// Gets the full path of the process executable
+    /// </summary>
+    public static string? GetImagePath(IntPtr handle)
+    {
+        if (handle == IntPtr.Zero)
+            return null;
+
+        var buffer = new StringBuilder(MaxImagePathLength);
+        var size = buffer.Capacity;
+        return QueryFullProcessImageName(handle, 0, buffer, ref size) ? buffer.ToString(0, size) : null;
+    }
+
+    /// <summary>
+    /// Reads the command line via NtQueryInformationProcess(ProcessCommandLineInformation),
+    /// which returns a UNICODE_STRING followed by its characters in the same buffer.
+    /// Works with a limited-information handle (no PEB walk, no PROCESS_VM_READ).
+    /// </summary>
+    public static string? GetCommandLine(IntPtr handle)
+    {
+        if (handle == IntPtr.Zero)
+            return null;
+
+        // First call reports the required size (STATUS_INFO_LENGTH_MISMATCH)
+        NtQueryInformationProcess(handle, ProcessCommandLineInformation, IntPtr.Zero, 0, out var needed);
+        if (needed <= 0)
+            return null;
+
+        var buffer = Marshal.AllocHGlobal(needed);
+        try
+        {
+            if (NtQueryInformationProcess(handle, ProcessCommandLineInformation, buffer, needed, out _) != STATUS_SUCCESS)
+                return null;
+
+            // UNICODE_STRING { USHORT Length; USHORT MaximumLength; PWSTR Buffer; }
+            var byteLength = (ushort)Marshal.ReadInt16(buffer);
+            var text = Marshal.ReadIntPtr(buffer, IntPtr.Size);
+            if (byteLength == 0 || text == IntPtr.Zero)
+                return null;
+
+            var commandLine = Marshal.PtrToStringUni(text, byteLength / sizeof(char));
+            return string.IsNullOrWhiteSpace(commandLine) ? null : commandLine;
+        }
+        finally
+        {
+            Marshal.FreeHGlobal(buffer);
+        }
+    }
+
+    /// <summary>
+    /// Gets the owner (DOMAIN\user) of a process from its token
+    /// </summary>
+    public static string? GetOwner(IntPtr handle)
+    {
+        if (handle == IntPtr.Zero || !OpenProcessToken(handle, TOKEN_QUERY, out var tokenHandle))
+            return null;
+
+        try
+        {
+            using var identity = new WindowsIdentity(tokenHandle);
+            return identity.Name;
+        }
+        catch
+        {
+            return null;
+        }
+        finally
+        {
+            CloseHandle(tokenHandle);
+        }
+    }
+
+    /// <summary>
+    /// Process name as Process.ProcessName reports it (file name without extension)
+    /// </summary>
+    public static string? GetProcessName(string? imagePath) =>
+        string.IsNullOrEmpty(imagePath) ? null : Path.GetFileNameWithoutExtension(imagePath);
+
+    /// <summary>
+    /// Fetches command lines for several processes with one WMI query per batch.
+    /// Fallback for processes whose command line the native query couldn't read.
+    /// </summary>
+    public static Dictionary<int, string> GetCommandLinesViaWmi(IReadOnlyCollection<int> pids)
+    {
+        var commandLines = new Dictionary<int, string>();
+
+        foreach (var batch in pids.Chunk(WmiBatchSize))
+        {
+            try
+            {
+                var filter = string.Join(" OR ", batch.Select(pid => $"ProcessId = {pid}"));
+                using var searcher = new System.Management.ManagementObjectSearcher(
+                    $"SELECT ProcessId, CommandLine FROM Win32_Process WHERE {filter}");
+                using var objects = searcher.Get();
+
+                foreach (System.Management.ManagementObject obj in objects)
+                {
+                    using (obj)
+                    {
+                        if (obj["CommandLine"]?.ToString() is { Length: > 0 } commandLine)
+                            commandLines[Convert.ToInt32(obj["ProcessId"])] = commandLine;
+                    }
+                }
+            }
+            catch
+            {
+                // Ignore - callers fall back to the image path or process name
+            }
+        }
+
+        return commandLines;
+    }
+
+    [DllImport("kernel32.dll", SetLastError = true)]
+    private static extern IntPtr OpenProcess(uint dwDesiredAccess, bool bInheritHandle, int dwProcessId);
+
+    [DllImport("kernel32.dll", SetLastError = true)]
+    [return: MarshalAs(UnmanagedType.Bool)]
+    private static extern bool GetProcessTimes(
+        IntPtr hProcess,
+        out long lpCreationTime,
+        out long lpExitTime,
+        out long lpKernelTime,
+        out long lpUserTime);
+
+    [DllImport("kernel32.dll", SetLastError = true, CharSet = CharSet.Unicode, EntryPoint = "QueryFullProcessImageNameW")]
+    [return: MarshalAs(UnmanagedType.Bool)]
+    private static extern bool QueryFullProcessImageName(IntPtr hProcess, int dwFlags, StringBuilder lpExeName, ref int lpdwSize);
+
+    [DllImport("ntdll.dll")]
+    private static extern int NtQueryInformationProcess(
+        IntPtr processHandle,
+        int processInformationClass,
+        IntPtr processInformation,
+        int processInformationLength,
+        out int returnLength);
+
+    [DllImport("advapi32.dll", SetLastError = true)]
+    [return: MarshalAs(UnmanagedType.Bool)]
+    private static extern bool OpenProcessToken(IntPtr ProcessHandle, uint DesiredAccess, out IntPtr TokenHandle);
+
+    [DllImport("kernel32.dll", SetLastError = true)]
+    [return: MarshalAs(UnmanagedType.Bool)]
+    private static extern bool CloseHandle(IntPtr hObject);
+}
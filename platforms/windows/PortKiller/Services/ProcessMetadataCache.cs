@@ -0,0 +1,66 @@
+using System.Collections.Generic;
+
+namespace PortKiller.Services;
+
+/// <summary>
+/// Identifies a process instance across scans. Windows reuses PIDs, so the
+/// creation time (FILETIME ticks, 0 if unreadable) tells instances apart.
+/// </summary>
+public readonly record struct ProcessIdentity(int Pid, long CreationTime);
+
+/// <summary>
+/// Name, command line and owner of a listening process
+/// </summary>
+public sealed record ProcessMetadata(string Name, string Command, string User);
+
+/// <summary>
+/// Process metadata kept across scans, so only processes that are new since the
+/// previous scan pay for command-line and owner lookups.
+/// Entries are evicted once their PID no longer appears in the TCP table.
+/// </summary>
+public class ProcessMetadataCache
+{
+    private readonly Dictionary<int, (long CreationTime, ProcessMetadata Metadata)> _entries = new();
+    private readonly object _lock = new();
+
+    /// <summary>
+    /// Returns cached metadata if the PID still belongs to the same process instance
+    /// </summary>
+    public bool TryGet(ProcessIdentity identity, out ProcessMetadata metadata)
+    {
+        lock (_lock)
+        {
+            if (_entries.TryGetValue(identity.Pid, out var entry) && entry.CreationTime == identity.CreationTime)
+            {
+                metadata = entry.Metadata;
+                return true;
+            }
+        }
+
+        metadata = null!;
+        return false;
+    }
+
+    public void Set(ProcessIdentity identity, ProcessMetadata metadata)
+    {
+        lock (_lock)
+        {
+            _entries[identity.Pid] = (identity.CreationTime, metadata);
+        }
+    }
+
+    /// <summary>
+    /// Drops entries for PIDs that are no longer listening
+    /// </summary>
+    public void RetainOnly(IReadOnlySet<int> pids)
+    {
+        lock (_lock)
+        {
+            foreach (var pid in _entries.Keys)
+            {
+                if (!pids.Contains(pid))
+                    _entries.Remove(pid);
+            }
+        }
+    }
+}
@@ -34,6 +34,7 @@ public class SettingsService
         public int RefreshInterval { get; set; } = 5;
         public bool AutoStart { get; set; }
         public bool ShowNotifications { get; set; } = true;
+        public bool EventDrivenRefresh { get; set; } = true;
         public string CloudflaredProtocol { get; set; } = "http2";
     }
 
@@ -137,6 +138,20 @@ public class SettingsService
         SaveSettingsData(data);
     }
 
+    // Event-driven Refresh
+    public bool GetEventDrivenRefresh()
+    {
+        var data = LoadSettingsData();
+        return data.EventDrivenRefresh;
+    }
+
+    public void SaveEventDrivenRefresh(bool enabled)
+    {
+        var data = LoadSettingsData();
+        data.EventDrivenRefresh = enabled;
+        SaveSettingsData(data);
+    }
+
     // Cloudflared Protocol
     public CloudflaredProtocol GetCloudflaredProtocol()
     {
@@ -0,0 +1,270 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.IO.Pipes;
+using System.Linq;
+using System.Text.Json;
+using System.Threading;
+using System.Threading.Channels;
+using System.Threading.Tasks;
+using PortKiller.Models;
+
+namespace PortKiller.Services;
+
+/// <summary>
+/// Serves the latest scan to other PortKiller instances and the portkiller CLI over a
+/// per-user named pipe (see <see cref="SnapshotProtocol"/>), so they don't scan on
+/// their own. Only the first instance of the user gets the pipe; <see cref="IsServing"/>
+/// tells the others to read from it instead.
+/// Equivalent of the macOS SnapshotPublisher.
+/// </summary>
+public sealed class SnapshotPipeServer : IDisposable
+{
+    // Wait before retrying a pipe instance that couldn't be created or connected
+    private static readonly TimeSpan InstanceRetryDelay = TimeSpan.FromMilliseconds(500);
+
+    private readonly object _lock = new();
+    private readonly List<Channel<SnapshotEvent>> _watchers = new();
+    private readonly CancellationTokenSource _stop = new();
+    private Dictionary<(int Port, int Pid), SnapshotPortDto> _current = new();
+    private SnapshotEvent _snapshot = new(0, DateTimeOffset.UtcNow, Array.Empty<SnapshotPortDto>(), Array.Empty<SnapshotKeyDto>());
+    private TaskCompletionSource _nextGeneration = NewGeneration();
+
+    /// <summary>
+    /// Raised on a thread-pool thread when a client asks for a fresh scan; the owner
+    /// should scan and <see cref="Publish"/>.
+    /// </summary>
+    public event EventHandler? RescanRequested;
+
+    /// <summary>
+    /// Whether this instance owns the pipe; false when another instance (usually the
+    /// headless one) already serves it
+    /// </summary>
+    public bool IsServing { get; private set; }
+
+    /// <summary>
+    /// Claims the pipe and starts accepting clients, unless another instance holds it
+    /// </summary>
+    public bool Start()
+    {
+        if (IsServing)
+            return true;
+
+        NamedPipeServerStream first;
+        try
+        {
+            first = CreateInstance(PipeOptions.FirstPipeInstance);
+        }
+        catch (Exception ex) when (ex is IOException or UnauthorizedAccessException)
+        {
+            return false;
+        }
+
+        IsServing = true;
+        _ = Task.Run(() => AcceptLoopAsync(first, _stop.Token));
+        return true;
+    }
+
+    /// <summary>
+    /// Publishes a scan as the next generation, if anything changed since the last one.
+    /// Watchers receive only the updated and removed listeners.
+    /// </summary>
+    public void Publish(IReadOnlyList<PortInfo> ports)
+    {
+        var next = new Dictionary<(int Port, int Pid), SnapshotPortDto>(ports.Count);
+        foreach (var port in ports)
+        {
+            next[port.Key] = new SnapshotPortDto(port.Port, port.Pid, port.ProcessName, port.Address, port.User, port.Command);
+        }
+
+        TaskCompletionSource published;
+        lock (_lock)
+        {
+            var updated = next.Values
+                .Where(p => !_current.TryGetValue((p.Port, p.Pid), out var old) || old != p)
+                .ToList();
+            var removed = _current.Keys
+                .Where(key => !next.ContainsKey(key))
+                .Select(key => new SnapshotKeyDto(key.Port, key.Pid))
+                .ToList();
+
+            published = _nextGeneration;
+            _nextGeneration = NewGeneration();
+            if (updated.Count == 0 && removed.Count == 0 && _snapshot.Generation > 0)
+            {
+                published.TrySetResult();
+                return;
+            }
+
+            var now = DateTimeOffset.UtcNow;
+            _current = next;
+            _snapshot = new SnapshotEvent(_snapshot.Generation + 1, now, next.Values.OrderBy(p => p.Port).ToList(), Array.Empty<SnapshotKeyDto>());
+
+            var change = new SnapshotEvent(_snapshot.Generation, now, updated, removed);
+            _watchers.RemoveAll(watcher => !watcher.Writer.TryWrite(change));
+        }
+        // Wake refresh requests outside the lock
+        published.TrySetResult();
+    }
+
+    private static TaskCompletionSource NewGeneration() =>
+        new(TaskCreationOptions.RunContinuationsAsynchronously);
+
+    // No instance limit: every watch client keeps its instance for as long as it runs
+    private static NamedPipeServerStream CreateInstance(PipeOptions options = PipeOptions.None) =>
+        new(SnapshotProtocol.PipeName, PipeDirection.InOut, NamedPipeServerStream.MaxAllowedServerInstances, PipeTransmissionMode.Byte,
+            PipeOptions.Asynchronous | PipeOptions.CurrentUserOnly | options);
+
+    private async Task AcceptLoopAsync(NamedPipeServerStream first, CancellationToken token)
+    {
+        // The instance waiting for the next client; null once handed to ServeAsync,
+        // which then owns it
+        NamedPipeServerStream? pipe = first;
+        while (!token.IsCancellationRequested)
+        {
+            try
+            {
+                pipe ??= CreateInstance();
+                await pipe.WaitForConnectionAsync(token);
+            }
+            catch (OperationCanceledException)
+            {
+                break;
+            }
+            catch (IOException ex)
+            {
+                Debug.WriteLine($"Snapshot pipe error: {ex.Message}");
+                pipe?.Dispose();
+                pipe = null;
+                try
+                {
+                    await Task.Delay(InstanceRetryDelay, token);
+                }
+                catch (OperationCanceledException)
+                {
+                    break;
+                }
+                continue;
+            }
+
+            var connected = pipe;
+            pipe = null;
+            _ = Task.Run(() => ServeAsync(connected, token));
+        }
+        pipe?.Dispose();
+    }
+
+    private async Task ServeAsync(NamedPipeServerStream pipe, CancellationToken token)
+    {
+        await using var connection = pipe;
+        try
+        {
+            using var reader = new StreamReader(pipe);
+            await using var writer = new StreamWriter(pipe) { AutoFlush = true };
+            var request = (await reader.ReadLineAsync(token) ?? string.Empty)
+                .Split(' ', StringSplitOptions.RemoveEmptyEntries);
+            if (request.Length == 0)
+                return;
+
+            if (request[^1] == SnapshotProtocol.Refresh)
+                await RequestRescanAsync(token);
+
+            switch (request[0])
+            {
+                case SnapshotProtocol.List:
+                    await WriteAsync(writer, Current(), token);
+                    break;
+                case SnapshotProtocol.Who when request.Length > 1 && int.TryParse(request[1], out var port):
+                    var current = Current();
+                    await WriteAsync(writer, current with { Ports = current.Ports.Where(p => p.Port == port).ToList() }, token);
+                    break;
+                case SnapshotProtocol.Watch:
+                    await StreamAsync(writer, token);
+                    break;
+            }
+        }
+        catch (Exception ex) when (ex is IOException or OperationCanceledException)
+        {
+            // Client went away
+        }
+    }
+
+    private async Task RequestRescanAsync(CancellationToken token)
+    {
+        Task published;
+        lock (_lock)
+        {
+            published = _nextGeneration.Task;
+        }
+        RescanRequested?.Invoke(this, EventArgs.Empty);
+        try
+        {
+            await published.WaitAsync(SnapshotProtocol.RescanTimeout, token);
+        }
+        catch (TimeoutException)
+        {
+            // Answer with the current generation
+        }
+    }
+
+    private async Task StreamAsync(StreamWriter writer, CancellationToken token)
+    {
+        var channel = Channel.CreateUnbounded<SnapshotEvent>(new UnboundedChannelOptions { SingleReader = true });
+        SnapshotEvent first;
+        lock (_lock)
+        {
+            first = _snapshot;
+            _watchers.Add(channel);
+        }
+
+        try
+        {
+            await WriteAsync(writer, first, token);
+            await foreach (var change in channel.Reader.ReadAllAsync(token))
+            {
+                await WriteAsync(writer, change, token);
+            }
+        }
+        finally
+        {
+            lock (_lock)
+            {
+                _watchers.Remove(channel);
+            }
+        }
+    }
+
+    private SnapshotEvent Current()
+    {
+        lock (_lock)
+        {
+            return _snapshot;
+        }
+    }
+
+    private static Task WriteAsync(StreamWriter writer, SnapshotEvent snapshot, CancellationToken token) =>
+        writer.WriteLineAsync(JsonSerializer.Serialize(snapshot, SnapshotProtocol.JsonOptions).AsMemory(), token);
+
+    /// <summary>
+    /// Ports of a snapshot received from the serving instance
+    /// </summary>
+    public static List<PortInfo> ToPorts(SnapshotEvent snapshot) =>
+        snapshot.Ports
+            .Select(p => PortInfo.Active(p.Port, p.Pid, p.ProcessName, p.Address, p.User, p.Command))
+            .ToList();
+
+    public void Dispose()
+    {
+        _stop.Cancel();
+        lock (_lock)
+        {
+            foreach (var watcher in _watchers)
+            {
+                watcher.Writer.TryComplete();
+            }
+            _watchers.Clear();
+        }
+        _stop.Dispose();
+    }
+}
@@ -0,0 +1,129 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.IO.Pipes;
+using System.Runtime.CompilerServices;
+using System.Text.Json;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace PortKiller.Services;
+
+/// <summary>
+/// Wire format of the shared port snapshot served by <see cref="SnapshotPipeServer"/>.
+/// Equivalent of the macOS PortSnapshot module (a memory-mapped file there).
+/// Also compiled into the portkiller CLI, so it only uses plain types.
+/// </summary>
+/// <remarks>
+/// One request line per connection, answered with JSON lines:
+/// <c>list</c> and <c>who &lt;port&gt;</c> get one <see cref="SnapshotEvent"/> with every
+/// (matching) listener; <c>watch</c> gets the current one, then one per new generation
+/// with only the updated and removed listeners. A trailing <c> refresh</c> asks for a
+/// fresh scan first.
+/// </remarks>
+public static class SnapshotProtocol
+{
+    /// <summary>Per-user pipe name (\\.\pipe\PortKiller.Snapshot.&lt;user&gt;)</summary>
+    public static string PipeName => $"PortKiller.Snapshot.{Environment.UserName}";
+
+    public const string List = "list";
+    public const string Who = "who";
+    public const string Watch = "watch";
+    public const string Refresh = "refresh";
+
+    /// <summary>How long a refresh request waits for the next generation</summary>
+    public static readonly TimeSpan RescanTimeout = TimeSpan.FromSeconds(1);
+
+    public static readonly JsonSerializerOptions JsonOptions = new(JsonSerializerDefaults.Web);
+}
+
+/// <summary>
+/// One listener as published in the shared snapshot
+/// </summary>
+public sealed record SnapshotPortDto(int Port, int Pid, string ProcessName, string Address, string User, string Command);
+
+/// <summary>
+/// Listener identity, for removals
+/// </summary>
+public sealed record SnapshotKeyDto(int Port, int Pid);
+
+/// <summary>
+/// One generation of the snapshot: every listener for list/who and the first watch
+/// line, only the changes after that
+/// </summary>
+public sealed record SnapshotEvent(
+    long Generation,
+    DateTimeOffset PublishedAt,
+    IReadOnlyList<SnapshotPortDto> Ports,
+    IReadOnlyList<SnapshotKeyDto> Removed);
+
+/// <summary>
+/// Client of the snapshot pipe, used by app instances that don't own it and by the CLI
+/// </summary>
+public static class SnapshotPipeClient
+{
+    private static readonly TimeSpan ConnectTimeout = TimeSpan.FromMilliseconds(500);
+
+    /// <summary>
+    /// Every current listener, or null if no PortKiller instance serves the snapshot
+    /// </summary>
+    public static async Task<SnapshotEvent?> ListAsync(bool refresh = false, CancellationToken cancellationToken = default)
+    {
+        await foreach (var snapshot in RequestAsync(Request(SnapshotProtocol.List, refresh), cancellationToken))
+            return snapshot;
+        return null;
+    }
+
+    /// <summary>
+    /// Listeners on <paramref name="port"/>, or null if no PortKiller instance serves the snapshot
+    /// </summary>
+    public static async Task<SnapshotEvent?> WhoAsync(int port, bool refresh = false, CancellationToken cancellationToken = default)
+    {
+        await foreach (var snapshot in RequestAsync(Request($"{SnapshotProtocol.Who} {port}", refresh), cancellationToken))
+            return snapshot;
+        return null;
+    }
+
+    /// <summary>
+    /// The current snapshot, then the changes of every new generation until cancelled
+    /// or the server goes away
+    /// </summary>
+    public static IAsyncEnumerable<SnapshotEvent> WatchAsync(CancellationToken cancellationToken = default) =>
+        RequestAsync(SnapshotProtocol.Watch, cancellationToken);
+
+    private static string Request(string verb, bool refresh) =>
+        refresh ? $"{verb} {SnapshotProtocol.Refresh}" : verb;
+
+    private static async IAsyncEnumerable<SnapshotEvent> RequestAsync(
+        string request,
+        [EnumeratorCancellation] CancellationToken cancellationToken)
+    {
+        using var pipe = new NamedPipeClientStream(".", SnapshotProtocol.PipeName, PipeDirection.InOut, PipeOptions.Asynchronous);
+        if (!await TryConnectAsync(pipe, cancellationToken))
+            yield break;
+
+        using var reader = new StreamReader(pipe);
+        await using var writer = new StreamWriter(pipe) { AutoFlush = true };
+        await writer.WriteLineAsync(request.AsMemory(), cancellationToken);
+
+        while (await reader.ReadLineAsync(cancellationToken) is { } line)
+        {
+            var snapshot = JsonSerializer.Deserialize<SnapshotEvent>(line, SnapshotProtocol.JsonOptions);
+            if (snapshot != null)
+                yield return snapshot;
+        }
+    }
+
+    private static async Task<bool> TryConnectAsync(NamedPipeClientStream pipe, CancellationToken cancellationToken)
+    {
+        try
+        {
+            await pipe.ConnectAsync((int)ConnectTimeout.TotalMilliseconds, cancellationToken);
+            return true;
+        }
+        catch (TimeoutException)
+        {
+            return false;
+        }
+    }
+}
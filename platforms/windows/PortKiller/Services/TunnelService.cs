@@ -1,3 +1,4 @@
+using System.Collections.Concurrent;
 using System.Diagnostics;
 using System.IO;
 using System.Text.RegularExpressions;
@@ -13,6 +14,8 @@ public class TunnelService
     private readonly Dictionary<Guid, Process> _processes = new();
     private readonly Dictionary<Guid, Action<string>> _urlHandlers = new();
     private readonly Dictionary<Guid, Action<string>> _errorHandlers = new();
+    // Set and removed on the UI thread, taken by Process.Exited on the thread pool
+    private readonly ConcurrentDictionary<Guid, Action<int>> _exitHandlers = new();
 
     // Possible cloudflared.exe installation paths
     private static readonly string[] CloudflaredPaths = {
@@ -113,6 +116,11 @@ public class TunnelService
                 ParseOutput(tunnel.Id, e.Data);
         };
 
+        // Exited is signalled from the process wait handle, so a tunnel that dies is
+        // reported at once without anyone polling HasExited.
+        process.EnableRaisingEvents = true;
+        process.Exited += (sender, e) => OnProcessExited(tunnel.Id, process);
+
         try
         {
             process.Start();
@@ -145,6 +153,9 @@ public class TunnelService
     /// </summary>
     public async Task StopTunnelAsync(Guid tunnelId)
     {
+        // An exit we caused is not reported
+        _exitHandlers.TryRemove(tunnelId, out _);
+
         if (!_processes.TryGetValue(tunnelId, out var process))
             return;
 
@@ -208,6 +219,15 @@ public class TunnelService
         _errorHandlers[tunnelId] = handler;
     }
 
+    /// <summary>
+    /// Registers a handler for the tunnel process exiting on its own; receives the exit code.
+    /// Called on a thread-pool thread.
+    /// </summary>
+    public void SetExitHandler(Guid tunnelId, Action<int> handler)
+    {
+        _exitHandlers[tunnelId] = handler;
+    }
+
     /// <summary>
     /// Checks if a tunnel process is running
     /// </summary>
@@ -216,11 +236,31 @@ public class TunnelService
         return _processes.TryGetValue(tunnelId, out var process) && !process.HasExited;
     }
 
+    private void OnProcessExited(Guid tunnelId, Process process)
+    {
+        if (!_exitHandlers.TryRemove(tunnelId, out var exitHandler))
+            return;
+
+        int exitCode;
+        try
+        {
+            exitCode = process.ExitCode;
+        }
+        catch (InvalidOperationException)
+        {
+            // Disposed by a concurrent stop
+            return;
+        }
+        exitHandler(exitCode);
+    }
+
     /// <summary>
     /// Parses cloudflared output to extract tunnel URL
     /// </summary>
     private void ParseOutput(Guid tunnelId, string line)
     {
+        using var measure = PerformanceMonitor.Measure(PerformancePhase.TunnelOutput);
+
         // cloudflared outputs URLs in format:
         // "https://something-random.trycloudflare.com"
         // Can appear in table format or plain text
@@ -8,6 +8,7 @@ using System.Threading.Tasks;
 using CommunityToolkit.Mvvm.ComponentModel;
 using CommunityToolkit.Mvvm.Input;
 using System.Windows.Threading;
+using PortKiller.Helpers;
 using PortKiller.Models;
 using PortKiller.Services;
 
@@ -23,11 +24,38 @@ public partial class MainViewModel : ObservableObject
     private readonly ProcessKillerService _killer;
     private readonly SettingsService _settings;
     private readonly NotificationService _notifications;
+    private readonly ProcessExitWatcher _exitWatcher;
+    private readonly SnapshotPipeServer _snapshotServer;
     private readonly Dispatcher _dispatcher;
-    
+
+    // Delay before rescanning after a watched listener exits
+    private static readonly TimeSpan ProcessExitRescanDelay = TimeSpan.FromMilliseconds(50);
+
     private CancellationTokenSource? _refreshCancellation;
+    private bool _hasPendingRefresh;
+    private long _lastSharedRead;
     private Dictionary<int, bool> _previousPortStates = new();
 
+    // Immutable copy of Ports, readable from background threads
+    private IReadOnlyList<PortInfo> _portSnapshot = Array.Empty<PortInfo>();
+
+    // Bumped (on the UI thread) whenever a filter input changes; a filter result computed
+    // for an older generation is stale and dropped
+    private int _filterGeneration;
+
+    /// <summary>
+    /// Raised on the UI thread once per update of Ports/FilteredPorts, after all changes
+    /// of that update are applied (instead of once per CollectionChanged)
+    /// </summary>
+    public event EventHandler? PortListsUpdated;
+
+    // Inputs of the filtered list, copied so they can be read off the UI thread
+    private sealed record PortViewState(
+        SidebarItem SidebarItem,
+        PortFilter Filter,
+        HashSet<int> Favorites,
+        List<WatchedPort> WatchedPorts);
+
     // Observable Properties
     [ObservableProperty]
     private ObservableCollection<PortInfo> _ports = new();
@@ -59,20 +87,29 @@ public partial class MainViewModel : ObservableObject
     [ObservableProperty]
     private bool _showNotifications = true;
 
+    [ObservableProperty]
+    private bool _eventDrivenRefresh = true;
+
     public MainViewModel(
         PortScannerService scanner,
         ProcessKillerService killer,
         SettingsService settings,
         NotificationService notifications,
+        ProcessExitWatcher exitWatcher,
+        SnapshotPipeServer snapshotServer,
         Dispatcher dispatcher)
     {
         _scanner = scanner;
         _killer = killer;
         _settings = settings;
         _notifications = notifications;
+        _exitWatcher = exitWatcher;
+        _snapshotServer = snapshotServer;
         _dispatcher = dispatcher;
 
         LoadSettings();
+        _exitWatcher.ProcessExited += OnWatchedProcessExited;
+        _snapshotServer.RescanRequested += OnRescanRequested;
     }
 
     partial void OnSelectedSidebarItemChanged(SidebarItem value)
@@ -100,6 +137,7 @@ public partial class MainViewModel : ObservableObject
         WatchedPorts = _settings.GetWatchedPorts();
         RefreshInterval = _settings.GetRefreshInterval();
         ShowNotifications = _settings.GetShowNotifications();
+        EventDrivenRefresh = _settings.GetEventDrivenRefresh();
     }
 
     private void SaveSettings()
@@ -108,6 +146,7 @@ public partial class MainViewModel : ObservableObject
         _settings.SaveWatchedPorts(WatchedPorts);
         _settings.SaveRefreshInterval(RefreshInterval);
         _settings.SaveShowNotifications(ShowNotifications);
+        _settings.SaveEventDrivenRefresh(EventDrivenRefresh);
     }
 
     // Port Scanning
@@ -115,26 +154,56 @@ public partial class MainViewModel : ObservableObject
     public async Task RefreshPortsAsync()
     {
         if (IsScanning)
+        {
+            // Coalesce: run one more scan when the current one finishes
+            _hasPendingRefresh = true;
             return;
+        }
 
         IsScanning = true;
 
         try
         {
-            var scannedPorts = await _scanner.ScanPortsAsync();
-            
-            // Update on UI thread
-            _dispatcher.Invoke(() =>
+            do
             {
-                Ports.Clear();
-                foreach (var port in scannedPorts)
+                _hasPendingRefresh = false;
+                using var refresh = PerformanceMonitor.Measure(PerformancePhase.Refresh);
+                var scannedPorts = await ScanOrFetchSharedAsync();
+
+                var (generation, view) = _dispatcher.Invoke(() => (_filterGeneration, CaptureViewState()));
+                var previous = _portSnapshot;
+
+                // Reuse unchanged rows, filter and sort off the UI thread
+                var (ports, filtered) = await Task.Run(() =>
                 {
-                    Ports.Add(port);
-                }
+                    var merged = ReuseUnchangedRows(previous, scannedPorts);
+                    return (merged, BuildFilteredPorts(merged, view));
+                });
+
+                // Apply both lists in one dispatcher operation
+                _dispatcher.Invoke(() =>
+                {
+                    _portSnapshot = ports;
+                    Ports.SyncWith(ports, p => p.Key, (a, b) => a.HasSameDetails(b));
+
+                    if (generation == _filterGeneration)
+                    {
+                        // Also supersedes a filter update still computing on the old snapshot
+                        _filterGeneration++;
+                        FilteredPorts.SyncWith(filtered, p => p.Key, (a, b) => a.HasSameDetails(b));
+                    }
+                    else
+                    {
+                        // The filter changed while we were computing; redo it for the new one
+                        UpdateFilteredPorts();
+                    }
+
+                    CheckWatchedPorts();
+                    PortListsUpdated?.Invoke(this, EventArgs.Empty);
+                });
 
-                UpdateFilteredPorts();
-                CheckWatchedPorts();
-            });
+                _exitWatcher.Watch(EventDrivenRefresh ? scannedPorts.Select(p => p.Pid) : Enumerable.Empty<int>());
+            } while (_hasPendingRefresh);
         }
         catch (Exception ex)
         {
@@ -146,6 +215,65 @@ public partial class MainViewModel : ObservableObject
         }
     }
 
+    // Reads the snapshot of the instance serving the pipe (usually the headless one)
+    // instead of scanning again; otherwise scans and serves the result to others.
+    // The pipe is claimed on every pass, so this instance takes over if the owner exits.
+    // A read sooner than one refresh interval after the last one didn't come from the
+    // polling loop (a kill, an exit, the refresh button), so it asks the owner to
+    // rescan first, like the macOS SharedSnapshotScanner.
+    private async Task<List<PortInfo>> ScanOrFetchSharedAsync()
+    {
+        if (!_snapshotServer.Start())
+        {
+            var isEarly = _lastSharedRead != 0
+                && Stopwatch.GetElapsedTime(_lastSharedRead) < TimeSpan.FromSeconds(Math.Max(1, RefreshInterval));
+            _lastSharedRead = Stopwatch.GetTimestamp();
+            var shared = await SnapshotPipeClient.ListAsync(refresh: isEarly);
+            if (shared != null)
+                return SnapshotPipeServer.ToPorts(shared);
+        }
+
+        var ports = await _scanner.ScanPortsAsync();
+        _snapshotServer.Publish(ports);
+        return ports;
+    }
+
+    private async void OnRescanRequested(object? sender, EventArgs e)
+    {
+        try
+        {
+            // Raised on a thread-pool thread by the snapshot pipe server
+            await RefreshOnDispatcherAsync();
+        }
+        catch (Exception ex)
+        {
+            Debug.WriteLine($"Error refreshing for a snapshot client: {ex.Message}");
+        }
+    }
+
+    // Event-driven refresh: rescan right away when a listener exits instead of
+    // waiting for the next polling tick (the loop below remains as a safety net)
+    private async void OnWatchedProcessExited(object? sender, EventArgs e)
+    {
+        if (!EventDrivenRefresh)
+            return;
+
+        try
+        {
+            await Task.Delay(ProcessExitRescanDelay);
+            await RefreshOnDispatcherAsync();
+        }
+        catch (Exception ex)
+        {
+            Debug.WriteLine($"Error refreshing after process exit: {ex.Message}");
+        }
+    }
+
+    // IsScanning and _hasPendingRefresh are only read and set on the UI thread, so
+    // refreshes triggered from thread-pool callbacks are marshalled there first
+    private Task RefreshOnDispatcherAsync() =>
+        _dispatcher.InvokeAsync<Task>(RefreshPortsAsync).Task.Unwrap();
+
     // Auto-refresh
     private void StartAutoRefresh()
     {
@@ -162,7 +290,7 @@ public partial class MainViewModel : ObservableObject
                     await Task.Delay(TimeSpan.FromSeconds(RefreshInterval), token);
                     if (!token.IsCancellationRequested)
                     {
-                        await RefreshPortsAsync();
+                        await RefreshOnDispatcherAsync();
                     }
                 }
                 catch (TaskCanceledException)
@@ -196,6 +324,9 @@ public partial class MainViewModel : ObservableObject
                 // Refresh immediately to show change
                 await Task.Delay(500);
                 await RefreshPortsAsync();
+
+                // Rows are kept across refreshes; clear the spinner if the process is still listed
+                port.IsKilling = false;
             }
             else
             {
@@ -290,77 +421,91 @@ public partial class MainViewModel : ObservableObject
     }
 
     // Filtering
-    private void UpdateFilteredPorts()
+    // Recomputes FilteredPorts for the current filter off the UI thread. Call on the UI thread.
+    private async void UpdateFilteredPorts()
     {
-        var result = GetFilteredPorts();
-        
-        FilteredPorts.Clear();
-        foreach (var port in result)
+        var generation = ++_filterGeneration;
+        var ports = _portSnapshot;
+        var view = CaptureViewState();
+
+        try
+        {
+            var filtered = await Task.Run(() => BuildFilteredPorts(ports, view));
+
+            // A newer filter change or refresh has superseded this result
+            if (generation != _filterGeneration)
+                return;
+
+            FilteredPorts.SyncWith(filtered, p => p.Key, (a, b) => a.HasSameDetails(b));
+            PortListsUpdated?.Invoke(this, EventArgs.Empty);
+        }
+        catch (Exception ex)
         {
-            FilteredPorts.Add(port);
+            Debug.WriteLine($"Error filtering ports: {ex.Message}");
         }
     }
 
-    private List<PortInfo> GetFilteredPorts()
+    private PortViewState CaptureViewState() => new(
+        SelectedSidebarItem,
+        Filter.Clone(),
+        new HashSet<int>(Favorites),
+        WatchedPorts.ToList());
+
+    // Scanned rows whose listener is unchanged are replaced by the instance already shown,
+    // so the keyed sync leaves them (and their UI state) alone
+    private static List<PortInfo> ReuseUnchangedRows(IReadOnlyList<PortInfo> previous, List<PortInfo> scanned)
     {
-        // Start with all or filtered by sidebar
-        var result = SelectedSidebarItem switch
+        var existing = new Dictionary<(int Port, int Pid), PortInfo>(previous.Count);
+        foreach (var port in previous)
         {
-            SidebarItem.AllPorts => Ports.ToList(),
-            SidebarItem.Favorites => GetFavoritePorts(),
-            SidebarItem.Watched => GetWatchedPortInfos(),
-            SidebarItem.Settings => new List<PortInfo>(),
-            _ when SelectedSidebarItem.GetProcessType() is ProcessType type 
-                => Ports.Where(p => p.ProcessType == type).ToList(),
-            _ => Ports.ToList()
-        };
+            existing[port.Key] = port;
+        }
 
-        // Apply additional filters
-        if (Filter.IsActive)
+        var result = new List<PortInfo>(scanned.Count);
+        foreach (var port in scanned)
         {
-            result = result.Where(p => Filter.Matches(p, Favorites, WatchedPorts)).ToList();
+            result.Add(existing.TryGetValue(port.Key, out var current) && current.HasSameDetails(port)
+                ? current
+                : port);
         }
-
-        return result.OrderBy(p => p.Port).ToList();
+        return result;
     }
 
-    private List<PortInfo> GetFavoritePorts()
+    private static List<PortInfo> BuildFilteredPorts(IReadOnlyList<PortInfo> ports, PortViewState view)
     {
-        var result = new List<PortInfo>();
-        var activePorts = Ports.ToLookup(p => p.Port);
+        using var measure = PerformanceMonitor.Measure(PerformancePhase.FilterPorts);
 
-        foreach (var favPort in Favorites)
+        // Start with all or filtered by sidebar
+        var result = view.SidebarItem switch
         {
-            var activePort = activePorts[favPort].FirstOrDefault();
-            if (activePort != null)
-            {
-                result.Add(activePort);
-            }
-            else
-            {
-                result.Add(PortInfo.Inactive(favPort));
-            }
+            SidebarItem.AllPorts => ports.ToList(),
+            SidebarItem.Favorites => GetPortsWithPlaceholders(ports, view.Favorites),
+            SidebarItem.Watched => GetPortsWithPlaceholders(ports, view.WatchedPorts.Select(w => w.Port)),
+            SidebarItem.Settings => new List<PortInfo>(),
+            _ when view.SidebarItem.GetProcessType() is ProcessType type
+                => ports.Where(p => p.ProcessType == type).ToList(),
+            _ => ports.ToList()
+        };
+
+        // Apply additional filters
+        if (view.Filter.IsActive)
+        {
+            result = result.Where(p => view.Filter.Matches(p, view.Favorites, view.WatchedPorts)).ToList();
         }
 
-        return result;
+        return result.OrderBy(p => p.Port).ToList();
     }
 
-    private List<PortInfo> GetWatchedPortInfos()
+    // Active row for each of `portNumbers`, or an inactive placeholder when nothing listens on it
+    private static List<PortInfo> GetPortsWithPlaceholders(IReadOnlyList<PortInfo> ports, IEnumerable<int> portNumbers)
     {
         var result = new List<PortInfo>();
-        var activePorts = Ports.ToLookup(p => p.Port);
+        var activePorts = ports.ToLookup(p => p.Port);
 
-        foreach (var watched in WatchedPorts)
+        foreach (var port in portNumbers)
         {
-            var activePort = activePorts[watched.Port].FirstOrDefault();
-            if (activePort != null)
-            {
-                result.Add(activePort);
-            }
-            else
-            {
-                result.Add(PortInfo.Inactive(watched.Port));
-            }
+            var activePort = activePorts[port].FirstOrDefault();
+            result.Add(activePort ?? PortInfo.Inactive(port));
         }
 
         return result;
@@ -143,6 +143,16 @@ public class TunnelViewModel : INotifyPropertyChanged
             });
         });
 
+        _tunnelService.SetExitHandler(tunnel.Id, exitCode =>
+        {
+            Application.Current.Dispatcher.Invoke(() =>
+            {
+                tunnel.Status = TunnelStatus.Error;
+                tunnel.LastError ??= $"cloudflared exited with code {exitCode}";
+                OnPropertyChanged(nameof(ActiveTunnelCount));
+            });
+        });
+
         try
         {
             await _tunnelService.StartTunnelAsync(tunnel, CloudflaredProtocol);